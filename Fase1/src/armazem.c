@@ -0,0 +1,323 @@
+/**
+ * @file armazem.c
+ * @author Hugo Baptista
+ * @brief Implementação do armazém compacto de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "leitor.h"
+#include "vetorial.h"
+#include "armazem.h"
+
+/**
+ * @brief Maior dimensão do mapa cujas coordenadas cabem em 16 bits
+ */
+#define MAX_DIMENSAO_16 65536
+
+/**
+ * @brief Aumenta a capacidade dos vetores do armazém
+ * @internal
+ * @param armazem Armazém de antenas
+ * @param cap Nova capacidade
+ * @return int 1 se a capacidade foi aumentada com sucesso, 0 caso contrário
+ */
+static int aumentarArmazem(ArmazemAntenas* armazem, int cap) {
+    unsigned char* f = (unsigned char*)realloc(armazem->frequencias, (size_t)cap);
+    if (!f) return 0;
+    armazem->frequencias = f;
+    if (armazem->x16) {
+        uint16_t* x = (uint16_t*)realloc(armazem->x16, (size_t)cap * sizeof(uint16_t));
+        if (!x) return 0;
+        armazem->x16 = x;
+        uint16_t* y = (uint16_t*)realloc(armazem->y16, (size_t)cap * sizeof(uint16_t));
+        if (!y) return 0;
+        armazem->y16 = y;
+    } else {
+        uint32_t* x = (uint32_t*)realloc(armazem->x32, (size_t)cap * sizeof(uint32_t));
+        if (!x) return 0;
+        armazem->x32 = x;
+        uint32_t* y = (uint32_t*)realloc(armazem->y32, (size_t)cap * sizeof(uint32_t));
+        if (!y) return 0;
+        armazem->y32 = y;
+    }
+    armazem->cap = cap;
+    return 1;
+}
+
+/**
+ * @brief Cria um armazém de antenas vazio
+ *
+ * As coordenadas são guardadas em 16 bits quando o mapa tem no máximo 65536 linhas e colunas, e em 32 bits caso contrário.
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param cap Capacidade inicial (número de antenas)
+ * @return ArmazemAntenas* Apontador para o armazém criado, ou NULL em caso de erro
+ */
+ArmazemAntenas* criarArmazem(int linhas, int colunas, int cap) {
+    if (linhas < 0 || colunas < 0) return NULL;
+    ArmazemAntenas* armazem = (ArmazemAntenas*)calloc(1, sizeof(ArmazemAntenas));
+    if (!armazem) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    armazem->linhas = linhas;
+    armazem->colunas = colunas;
+    int estreito = linhas <= MAX_DIMENSAO_16 && colunas <= MAX_DIMENSAO_16;
+    if (cap < 16) cap = 16;
+    armazem->frequencias = (unsigned char*)malloc((size_t)cap);
+    if (estreito) {
+        armazem->x16 = (uint16_t*)malloc((size_t)cap * sizeof(uint16_t));
+        armazem->y16 = (uint16_t*)malloc((size_t)cap * sizeof(uint16_t));
+    } else {
+        armazem->x32 = (uint32_t*)malloc((size_t)cap * sizeof(uint32_t));
+        armazem->y32 = (uint32_t*)malloc((size_t)cap * sizeof(uint32_t));
+    }
+    if (!armazem->frequencias || (estreito ? !armazem->x16 || !armazem->y16 : !armazem->x32 || !armazem->y32)) {
+        printf("Erro ao alocar memoria!\n");
+        libertarArmazem(armazem);
+        return NULL;
+    }
+    armazem->cap = cap;
+    return armazem;
+}
+
+/**
+ * @brief Liberta a memória alocada para o armazém
+ *
+ * @param armazem Armazém a libertar
+ */
+void libertarArmazem(ArmazemAntenas* armazem) {
+    if (!armazem) return;
+    free(armazem->frequencias);
+    free(armazem->x16);
+    free(armazem->y16);
+    free(armazem->x32);
+    free(armazem->y32);
+    free(armazem);
+}
+
+/**
+ * @brief Acrescenta uma antena ao armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param freq Frequência da antena
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @return int Índice da antena, ou -1 se a antena for inválida ou em caso de erro
+ */
+int armazemInserir(ArmazemAntenas* armazem, char freq, int x, int y) {
+    if (!armazem || freq == '.' || freq == '#') return -1;
+    if (x < 0 || y < 0 || x >= armazem->colunas || y >= armazem->linhas) return -1;
+    if (armazem->num == armazem->cap && !aumentarArmazem(armazem, armazem->cap * 2)) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+    int i = armazem->num++;
+    armazem->frequencias[i] = (unsigned char)freq;
+    if (armazem->x16) {
+        armazem->x16[i] = (uint16_t)x;
+        armazem->y16[i] = (uint16_t)y;
+    } else {
+        armazem->x32[i] = (uint32_t)x;
+        armazem->y32[i] = (uint32_t)y;
+    }
+    return i;
+}
+
+/**
+ * @brief Remove uma antena do armazém, mantendo os índices das restantes
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena a remover
+ * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ */
+int armazemRemover(ArmazemAntenas* armazem, int indice) {
+    if (!armazem || indice < 0 || indice >= armazem->num) return 0;
+    if (armazem->frequencias[indice] == FREQUENCIA_REMOVIDA) return 0;
+    armazem->frequencias[indice] = FREQUENCIA_REMOVIDA;
+    armazem->removidas++;
+    return 1;
+}
+
+/**
+ * @brief Devolve a coordenada x de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada x
+ */
+int armazemX(const ArmazemAntenas* armazem, int indice) {
+    return armazem->x16 ? armazem->x16[indice] : (int)armazem->x32[indice];
+}
+
+/**
+ * @brief Devolve a coordenada y de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada y
+ */
+int armazemY(const ArmazemAntenas* armazem, int indice) {
+    return armazem->y16 ? armazem->y16[indice] : (int)armazem->y32[indice];
+}
+
+/**
+ * @brief Cria um armazém com as antenas de uma lista, pela ordem da lista
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return ArmazemAntenas* Armazém criado (o índice de cada antena é a sua posição na lista), ou NULL em caso de erro
+ */
+ArmazemAntenas* armazemDeLista(Antena* lista, int linhas, int colunas) {
+    int num = 0;
+    for (Antena* a = lista; a; a = a->prox) num++;
+    ArmazemAntenas* armazem = criarArmazem(linhas, colunas, num);
+    if (!armazem) return NULL;
+    for (Antena* a = lista; a; a = a->prox) {
+        if (armazemInserir(armazem, a->frequencia, a->x, a->y) < 0) {
+            libertarArmazem(armazem);
+            return NULL;
+        }
+    }
+    return armazem;
+}
+
+/**
+ * @brief Carrega as antenas de um ficheiro diretamente para um armazém, sem criar a lista
+ *
+ * @param filename Nome do ficheiro a carregar
+ * @return ArmazemAntenas* Armazém com as antenas por ordem de leitura (y e depois x), ou NULL em caso de erro
+ * @attention O mapa tem tantas linhas como em contarLinhas (fins de linha mais 1, mas sem o limite de
+ * MAX_LINHAS) e tantas colunas como a linha mais comprida; as linhas não são divididas aos 99 caracteres,
+ * ao contrário de carregarAntenas
+ */
+ArmazemAntenas* carregarArmazem(const char* filename) {
+    size_t tamanho;
+    char* dados = mapearFicheiro(filename, &tamanho);
+    if (!dados) return NULL;
+
+    // Primeira passagem: dimensões do mapa e número de antenas, para escolher a largura das coordenadas
+    int linhas = 0, colunas = 0, x = 0, num = 0;
+    for (size_t i = 0; i < tamanho; i++) {
+        if (dados[i] == '\n') {
+            if (x > colunas) colunas = x;
+            x = 0;
+            linhas++;
+            continue;
+        }
+        if (dados[i] != '.' && dados[i] != '#') num++;
+        x++;
+    }
+    if (x > colunas) colunas = x;
+    linhas++; // Como em contarLinhas: um fim de linha no fim do ficheiro abre uma linha vazia
+
+    ArmazemAntenas* armazem = criarArmazem(linhas, colunas, num);
+    if (armazem) {
+        int y = 0;
+        x = 0;
+        for (size_t i = 0; i < tamanho; i++) {
+            if (dados[i] == '\n') {
+                x = 0;
+                y++;
+                continue;
+            }
+            if (dados[i] != '.' && dados[i] != '#') armazemInserir(armazem, dados[i], x, y);
+            x++;
+        }
+    }
+    libertarFicheiro(dados, tamanho);
+    return armazem;
+}
+
+/**
+ * @brief Conta os bits a 1 de uma palavra
+ * @internal
+ * @param v Palavra
+ * @return int Número de bits a 1
+ */
+static inline int contarBits(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos das antenas do armazém
+ *
+ * As antenas são agrupadas por frequência e as coordenadas de cada grupo são alargadas para int32 uma
+ * única vez, pelo que os pares de cada grupo são gerados pelo núcleo vetorial sobre vetores contíguos.
+ *
+ * @param armazem Armazém de antenas
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa do armazém
+ */
+long long calcularEfeitosArmazem(const ArmazemAntenas* armazem, uint64_t* mapa) {
+    size_t palavras = ((size_t)armazem->linhas * armazem->colunas + 63) / 64;
+    memset(mapa, 0, palavras * sizeof(uint64_t));
+    int vivas = armazem->num - armazem->removidas;
+    int32_t* xs = (int32_t*)malloc((size_t)(vivas > 0 ? vivas : 1) * sizeof(int32_t));
+    int32_t* ys = (int32_t*)malloc((size_t)(vivas > 0 ? vivas : 1) * sizeof(int32_t));
+    if (!xs || !ys) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        return -1;
+    }
+    int inicioFreq[257] = {0}, pos[256];
+    for (int i = 0; i < armazem->num; i++) {
+        if (armazem->frequencias[i] != FREQUENCIA_REMOVIDA) inicioFreq[armazem->frequencias[i] + 1]++;
+    }
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (int i = 0; i < armazem->num; i++) {
+        if (armazem->frequencias[i] == FREQUENCIA_REMOVIDA) continue;
+        int p = pos[armazem->frequencias[i]]++;
+        xs[p] = armazemX(armazem, i);
+        ys[p] = armazemY(armazem, i);
+    }
+
+    for (int f = 0; f < 256; f++) {
+        marcarEfeitosGrupo(xs + inicioFreq[f], ys + inicioFreq[f], inicioFreq[f + 1] - inicioFreq[f], armazem->linhas, armazem->colunas, mapa);
+    }
+    free(xs);
+    free(ys);
+
+    long long total = 0;
+    for (size_t p = 0; p < palavras; p++) total += contarBits(mapa[p]);
+    return total;
+}
+
+/**
+ * @brief Calcula os efeitos nefastos das antenas do armazém como uma lista
+ *
+ * @param armazem Armazém de antenas
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa do armazém (linhas x colunas), ordenada por y e depois por x
+ * @attention Os efeitos são cortados pelo mapa do armazém, como em detetarEfeitosNefastosMapa; os que ficam
+ * dentro do mapa mas fora de MAX_LINHAS x MAX_COLUNAS também não entram, porque criarNefasto os recusa
+ */
+Nefasto* detetarEfeitosNefastosArmazem(const ArmazemAntenas* armazem) {
+    size_t celulas = (size_t)armazem->linhas * armazem->colunas;
+    uint64_t* mapa = (uint64_t*)malloc(((celulas + 63) / 64 + 1) * sizeof(uint64_t)); // +1 para mapas vazios
+    if (!mapa) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    Nefasto* efeitos = calcularEfeitosArmazem(armazem, mapa) > 0 ? listaDeMapa(mapa, armazem->linhas, armazem->colunas) : NULL;
+    free(mapa);
+    return efeitos;
+}
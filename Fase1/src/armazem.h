@@ -0,0 +1,111 @@
+/**
+ * @file armazem.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções do armazém compacto de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef ARMAZEM_H
+#define ARMAZEM_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Frequência que marca uma antena removida do armazém
+ */
+#define FREQUENCIA_REMOVIDA '.'
+
+/**
+ * @brief Cria um armazém de antenas vazio
+ *
+ * As coordenadas são guardadas em 16 bits quando o mapa tem no máximo 65536 linhas e colunas, e em 32 bits caso contrário.
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param cap Capacidade inicial (número de antenas)
+ * @return ArmazemAntenas* Apontador para o armazém criado, ou NULL em caso de erro
+ */
+ArmazemAntenas* criarArmazem(int linhas, int colunas, int cap);
+/**
+ * @brief Liberta a memória alocada para o armazém
+ *
+ * @param armazem Armazém a libertar
+ */
+void libertarArmazem(ArmazemAntenas* armazem);
+/**
+ * @brief Acrescenta uma antena ao armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param freq Frequência da antena
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @return int Índice da antena, ou -1 se a antena for inválida ou em caso de erro
+ */
+int armazemInserir(ArmazemAntenas* armazem, char freq, int x, int y);
+/**
+ * @brief Remove uma antena do armazém, mantendo os índices das restantes
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena a remover
+ * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ */
+int armazemRemover(ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Devolve a coordenada x de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada x
+ */
+int armazemX(const ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Devolve a coordenada y de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada y
+ */
+int armazemY(const ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Cria um armazém com as antenas de uma lista, pela ordem da lista
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return ArmazemAntenas* Armazém criado (o índice de cada antena é a sua posição na lista), ou NULL em caso de erro
+ */
+ArmazemAntenas* armazemDeLista(Antena* lista, int linhas, int colunas);
+/**
+ * @brief Carrega as antenas de um ficheiro diretamente para um armazém, sem criar a lista
+ *
+ * @param filename Nome do ficheiro a carregar
+ * @return ArmazemAntenas* Armazém com as antenas por ordem de leitura (y e depois x), ou NULL em caso de erro
+ * @attention O mapa tem tantas linhas como em contarLinhas (fins de linha mais 1, mas sem o limite de
+ * MAX_LINHAS) e tantas colunas como a linha mais comprida; as linhas não são divididas aos 99 caracteres,
+ * ao contrário de carregarAntenas
+ */
+ArmazemAntenas* carregarArmazem(const char* filename);
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos das antenas do armazém
+ *
+ * As antenas são agrupadas por frequência e as coordenadas de cada grupo são alargadas para int32 uma
+ * única vez, pelo que os pares de cada grupo são gerados pelo núcleo vetorial sobre vetores contíguos.
+ *
+ * @param armazem Armazém de antenas
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa do armazém
+ */
+long long calcularEfeitosArmazem(const ArmazemAntenas* armazem, uint64_t* mapa);
+/**
+ * @brief Calcula os efeitos nefastos das antenas do armazém como uma lista
+ *
+ * @param armazem Armazém de antenas
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa do armazém (linhas x colunas), ordenada por y e depois por x
+ * @attention Os efeitos são cortados pelo mapa do armazém, como em detetarEfeitosNefastosMapa; os que ficam
+ * dentro do mapa mas fora de MAX_LINHAS x MAX_COLUNAS também não entram, porque criarNefasto os recusa
+ */
+Nefasto* detetarEfeitosNefastosArmazem(const ArmazemAntenas* armazem);
+
+#endif
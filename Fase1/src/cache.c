@@ -0,0 +1,447 @@
+/**
+ * @file cache.c
+ * @author Hugo Baptista
+ * @brief Implementação da cache persistente de resultados, indexada pelo hash do conteúdo do mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "leitor.h"
+#include "saida.h"
+#include "cache.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+/**
+ * @brief Tamanho máximo do caminho de um ficheiro da cache
+ */
+#define TAMANHO_CAMINHO 512
+/**
+ * @brief Número mágico no início dos ficheiros da cache ("EDAC")
+ */
+#define MAGIA_CACHE 0x43414445u
+/**
+ * @brief Versão do formato dos resultados da Fase 1, também usada como semente do hash
+ */
+#define VERSAO_EFEITOS 0x4631000000000001ULL
+
+/**
+ * @brief Cabeçalho de um ficheiro da cache
+ * @internal
+ */
+typedef struct CabecalhoCache {
+    uint32_t magia;       /**< MAGIA_CACHE */
+    uint32_t reservado;   /**< Zero */
+    uint64_t versao;      /**< Versão do formato do resultado */
+    uint64_t hash;        /**< Hash do conteúdo do mapa */
+    uint64_t tamanho;     /**< Número de bytes do mapa */
+    uint64_t verificacao; /**< Hash do resto do ficheiro, para detetar ficheiros corrompidos */
+    uint64_t numA;        /**< Número de antenas */
+    uint64_t numB;        /**< Número de efeitos nefastos */
+} CabecalhoCache;
+
+/**
+ * @brief Primos do xxHash de 64 bits
+ */
+#define PRIMO64_1 0x9E3779B185EBCA87ULL
+#define PRIMO64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIMO64_3 0x165667B19E3779F9ULL
+#define PRIMO64_4 0x85EBCA77C2B2AE63ULL
+#define PRIMO64_5 0x27D4EB2F165667C5ULL
+
+/**
+ * @brief Roda os bits de uma palavra para a esquerda
+ * @internal
+ * @param v Palavra a rodar
+ * @param r Número de bits (1 a 63)
+ * @return uint64_t Palavra rodada
+ */
+static inline uint64_t rodar(uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+/**
+ * @brief Lê 8 bytes em little-endian de um endereço possivelmente desalinhado
+ * @internal
+ * @param p Endereço a ler
+ * @return uint64_t Palavra lida
+ */
+static inline uint64_t ler64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Lê 4 bytes em little-endian de um endereço possivelmente desalinhado
+ * @internal
+ * @param p Endereço a ler
+ * @return uint32_t Palavra lida
+ */
+static inline uint32_t ler32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Acumula uma palavra num acumulador do xxHash
+ * @internal
+ * @param acc Acumulador
+ * @param v Palavra
+ * @return uint64_t Novo valor do acumulador
+ */
+static inline uint64_t rondaXXH64(uint64_t acc, uint64_t v) {
+    acc += v * PRIMO64_2;
+    acc = rodar(acc, 31);
+    return acc * PRIMO64_1;
+}
+
+/**
+ * @brief Junta um acumulador ao hash
+ * @internal
+ * @param h Hash
+ * @param acc Acumulador
+ * @return uint64_t Novo valor do hash
+ */
+static inline uint64_t juntarXXH64(uint64_t h, uint64_t acc) {
+    h ^= rondaXXH64(0, acc);
+    return h * PRIMO64_1 + PRIMO64_4;
+}
+
+/**
+ * @brief Calcula o hash XXH64 de um bloco de memória
+ *
+ * Implementação do algoritmo xxHash de 64 bits (não criptográfico): o bloco é consumido em faixas de
+ * 32 bytes por quatro acumuladores independentes, pelo que o custo é próximo do de ler o bloco.
+ *
+ * @param dados Bloco a resumir
+ * @param tamanho Número de bytes do bloco
+ * @param semente Semente do hash
+ * @return uint64_t Hash do bloco
+ */
+uint64_t hashXXH64(const void* dados, size_t tamanho, uint64_t semente) {
+    const unsigned char* p = (const unsigned char*)dados;
+    const unsigned char* fim = p + tamanho;
+    uint64_t h;
+    if (tamanho >= 32) {
+        uint64_t v1 = semente + PRIMO64_1 + PRIMO64_2, v2 = semente + PRIMO64_2;
+        uint64_t v3 = semente, v4 = semente - PRIMO64_1;
+        const unsigned char* limite = fim - 32;
+        do {
+            v1 = rondaXXH64(v1, ler64(p));
+            v2 = rondaXXH64(v2, ler64(p + 8));
+            v3 = rondaXXH64(v3, ler64(p + 16));
+            v4 = rondaXXH64(v4, ler64(p + 24));
+            p += 32;
+        } while (p <= limite);
+        h = rodar(v1, 1) + rodar(v2, 7) + rodar(v3, 12) + rodar(v4, 18);
+        h = juntarXXH64(h, v1);
+        h = juntarXXH64(h, v2);
+        h = juntarXXH64(h, v3);
+        h = juntarXXH64(h, v4);
+    } else {
+        h = semente + PRIMO64_5;
+    }
+    h += (uint64_t)tamanho;
+    for (; p + 8 <= fim; p += 8) {
+        h ^= rondaXXH64(0, ler64(p));
+        h = rodar(h, 27) * PRIMO64_1 + PRIMO64_4;
+    }
+    if (p + 4 <= fim) {
+        h ^= (uint64_t)ler32(p) * PRIMO64_1;
+        h = rodar(h, 23) * PRIMO64_2 + PRIMO64_3;
+        p += 4;
+    }
+    for (; p < fim; p++) {
+        h ^= (*p) * PRIMO64_5;
+        h = rodar(h, 11) * PRIMO64_1;
+    }
+    h ^= h >> 33;
+    h *= PRIMO64_2;
+    h ^= h >> 29;
+    h *= PRIMO64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Entrada da cache considerada por limitarCache
+ * @internal
+ */
+typedef struct EntradaCache {
+    char caminho[TAMANHO_CAMINHO]; /**< Caminho do ficheiro */
+    time_t modificado;             /**< Data da última modificação (ou reaproveitamento) */
+    unsigned long long tamanho;    /**< Número de bytes do ficheiro */
+} EntradaCache;
+
+/**
+ * @brief Compara duas entradas da cache pela data de modificação (mais antiga primeiro)
+ * @internal
+ * @param a Primeira entrada
+ * @param b Segunda entrada
+ * @return int Negativo, zero ou positivo, como no qsort
+ */
+static int compararEntradas(const void* a, const void* b) {
+    time_t ta = ((const EntradaCache*)a)->modificado, tb = ((const EntradaCache*)b)->modificado;
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite
+ *
+ * Os ficheiros são removidos do mais antigo para o mais recente, pela data de modificação, que é
+ * atualizada sempre que um ficheiro é reaproveitado.
+ *
+ * @param diretorio Diretório da cache
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache
+ * @return int Número de ficheiros removidos, ou -1 se o diretório não puder ser lido
+ */
+int limitarCache(const char* diretorio, size_t limite) {
+    DIR* dir = opendir(diretorio);
+    if (!dir) return -1;
+    EntradaCache* entradas = NULL;
+    int num = 0, cap = 0;
+    unsigned long long total = 0;
+    size_t tamExtensao = strlen(EXTENSAO_CACHE);
+    struct dirent* e;
+    while ((e = readdir(dir))) {
+        size_t tam = strlen(e->d_name);
+        if (tam <= tamExtensao || strcmp(e->d_name + tam - tamExtensao, EXTENSAO_CACHE) != 0) continue;
+        if (num == cap) {
+            int novaCap = cap ? cap * 2 : 16;
+            EntradaCache* novas = (EntradaCache*)realloc(entradas, (size_t)novaCap * sizeof(EntradaCache));
+            if (!novas) {
+                printf("Erro ao alocar memoria!\n");
+                break;
+            }
+            entradas = novas;
+            cap = novaCap;
+        }
+        struct stat info;
+        EntradaCache* entrada = &entradas[num];
+        if (snprintf(entrada->caminho, TAMANHO_CAMINHO, "%s/%s", diretorio, e->d_name) >= TAMANHO_CAMINHO) continue;
+        if (stat(entrada->caminho, &info) != 0 || !S_ISREG(info.st_mode)) continue;
+        entrada->modificado = info.st_mtime;
+        entrada->tamanho = (unsigned long long)info.st_size;
+        total += entrada->tamanho;
+        num++;
+    }
+    closedir(dir);
+    if (total > limite) qsort(entradas, (size_t)num, sizeof(EntradaCache), compararEntradas);
+    int removidos = 0;
+    for (int i = 0; i < num && total > limite; i++) {
+        if (remove(entradas[i].caminho) == 0) removidos++;
+        total -= entradas[i].tamanho;
+    }
+    free(entradas);
+    return removidos;
+}
+
+/**
+ * @brief Reconstrói as listas a partir de um ficheiro da cache, se for válido para o mapa
+ * @internal
+ * @param caminho Caminho do ficheiro da cache
+ * @param hash Hash do conteúdo do mapa
+ * @param tamanho Número de bytes do mapa
+ * @param antenas Lista de antenas (saída)
+ * @param efeitos Lista de efeitos nefastos (saída)
+ * @return int 1 se as listas foram reconstruídas, 0 caso contrário
+ */
+static int lerEfeitosCache(const char* caminho, uint64_t hash, size_t tamanho, Antena** antenas, Nefasto** efeitos) {
+    struct stat info;
+    if (stat(caminho, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoCache)) return 0;
+    size_t tamCache;
+    char* dados = mapearFicheiro(caminho, &tamCache);
+    if (!dados) return 0;
+    CabecalhoCache cab;
+    memcpy(&cab, dados, sizeof(cab));
+    int valido = tamCache >= sizeof(cab) && cab.magia == MAGIA_CACHE && cab.versao == VERSAO_EFEITOS &&
+                 cab.hash == hash && cab.tamanho == (uint64_t)tamanho &&
+                 cab.numA <= tamCache && cab.numB <= tamCache &&
+                 tamCache == sizeof(cab) + (cab.numA * 3 + cab.numB * 2) * sizeof(int32_t) &&
+                 hashXXH64(dados + sizeof(cab), tamCache - sizeof(cab), 0) == cab.verificacao;
+    Antena* listaA = NULL, *fimA = NULL;
+    Nefasto* listaE = NULL, *fimE = NULL;
+    const char* p = dados + sizeof(cab);
+    for (uint64_t i = 0; valido && i < cab.numA; i++, p += 3 * sizeof(int32_t)) {
+        int32_t r[3];
+        memcpy(r, p, sizeof(r));
+        Antena* nova = criarAntena((char)r[0], r[1], r[2]);
+        if (!nova) valido = 0;
+        else {
+            if (fimA) fimA->prox = nova;
+            else listaA = nova;
+            fimA = nova;
+        }
+    }
+    for (uint64_t i = 0; valido && i < cab.numB; i++, p += 2 * sizeof(int32_t)) {
+        int32_t r[2];
+        memcpy(r, p, sizeof(r));
+        Nefasto* novo = criarNefasto(r[0], r[1]);
+        if (!novo) valido = 0;
+        else {
+            if (fimE) fimE->prox = novo;
+            else listaE = novo;
+            fimE = novo;
+        }
+    }
+    libertarFicheiro(dados, tamCache);
+    if (!valido) {
+        while (listaA) {
+            Antena* seguinte = listaA->prox;
+            free(listaA);
+            listaA = seguinte;
+        }
+        while (listaE) {
+            Nefasto* seguinte = listaE->prox;
+            free(listaE);
+            listaE = seguinte;
+        }
+        return 0;
+    }
+    utime(caminho, NULL); // Marca o ficheiro como usado, para limitarCache
+    *antenas = listaA;
+    *efeitos = listaE;
+    return 1;
+}
+
+/**
+ * @brief Escreve as listas num ficheiro da cache
+ * @internal
+ * O ficheiro é escrito com um nome temporário e depois renomeado, pelo que outro processo nunca lê um
+ * resultado incompleto.
+ * @param caminho Caminho do ficheiro da cache
+ * @param hash Hash do conteúdo do mapa
+ * @param tamanho Número de bytes do mapa
+ * @param antenas Lista de antenas
+ * @param efeitos Lista de efeitos nefastos
+ * @return int 1 se o ficheiro foi escrito com sucesso, 0 caso contrário
+ */
+static int escreverEfeitosCache(const char* caminho, uint64_t hash, size_t tamanho, Antena* antenas, Nefasto* efeitos) {
+    char temporario[TAMANHO_CAMINHO + 32];
+    snprintf(temporario, sizeof(temporario), "%s.%ld.tmp", caminho, (long)getpid());
+    CabecalhoCache cab;
+    memset(&cab, 0, sizeof(cab));
+    cab.magia = MAGIA_CACHE;
+    cab.versao = VERSAO_EFEITOS;
+    cab.hash = hash;
+    cab.tamanho = (uint64_t)tamanho;
+    for (Antena* a = antenas; a; a = a->prox) cab.numA++;
+    for (Nefasto* e = efeitos; e; e = e->prox) cab.numB++;
+    size_t numInteiros = (size_t)(cab.numA * 3 + cab.numB * 2);
+    int32_t* corpo = (int32_t*)malloc((numInteiros > 0 ? numInteiros : 1) * sizeof(int32_t));
+    if (!corpo) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    size_t k = 0;
+    for (Antena* a = antenas; a; a = a->prox) {
+        corpo[k++] = a->frequencia;
+        corpo[k++] = a->x;
+        corpo[k++] = a->y;
+    }
+    for (Nefasto* e = efeitos; e; e = e->prox) {
+        corpo[k++] = e->x;
+        corpo[k++] = e->y;
+    }
+    cab.verificacao = hashXXH64(corpo, numInteiros * sizeof(int32_t), 0);
+    Saida saida;
+    int aberta = abrirSaidaBinaria(&saida, temporario);
+    if (aberta) {
+        escreverBytes(&saida, (const char*)&cab, sizeof(cab));
+        escreverBytes(&saida, (const char*)corpo, numInteiros * sizeof(int32_t));
+    }
+    free(corpo);
+    if (!aberta) return 0;
+    if (!fecharSaida(&saida) || rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+#else
+
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite
+ *
+ * @param diretorio Diretório da cache
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache
+ * @return int -1, porque a cache não é usada em Windows
+ */
+int limitarCache(const char* diretorio, size_t limite) {
+    (void)diretorio;
+    (void)limite;
+    return -1;
+}
+
+#endif
+
+/**
+ * @brief Carrega as antenas de um ficheiro e calcula os efeitos nefastos, reaproveitando a cache
+ *
+ * O conteúdo do ficheiro é resumido com hashXXH64; se o diretório da cache tiver um resultado íntegro com esse
+ * hash e esse tamanho, as listas são reconstruídas a partir dele, sem voltar a ler o mapa nem a procurar
+ * os efeitos. Caso contrário são calculadas com carregarAntenasParalelo e detetarEfeitosNefastos e
+ * guardadas na cache, que é depois limitada com limitarCache. As listas ficam iguais nos dois casos.
+ *
+ * @param filename Nome do ficheiro com o mapa
+ * @param diretorio Diretório da cache (criado se não existir), ou NULL para não usar a cache
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache
+ * @param antenas Lista de antenas carregada (saída)
+ * @param efeitos Lista de efeitos nefastos (saída)
+ * @return int 1 se o resultado veio da cache, 0 se foi calculado, -1 em caso de erro ou se o mapa não tiver antenas
+ * @attention A cache também é ignorada quando a variável de ambiente VARIAVEL_SEM_CACHE está definida, e em Windows
+ */
+int detetarEfeitosCache(const char* filename, const char* diretorio, size_t limite, Antena** antenas, Nefasto** efeitos) {
+    *antenas = NULL;
+    *efeitos = NULL;
+#ifndef _WIN32
+    int usarCache = diretorio && !getenv(VARIAVEL_SEM_CACHE);
+    char caminho[TAMANHO_CAMINHO];
+    uint64_t hash = 0;
+    size_t tamanho = 0;
+    if (usarCache) {
+        char* dados = mapearFicheiro(filename, &tamanho);
+        if (!dados) return -1;
+        hash = hashXXH64(dados, tamanho, VERSAO_EFEITOS);
+        libertarFicheiro(dados, tamanho);
+        usarCache = snprintf(caminho, sizeof(caminho), "%s/%016llx%s", diretorio, (unsigned long long)hash, EXTENSAO_CACHE) < (int)sizeof(caminho);
+        if (usarCache && lerEfeitosCache(caminho, hash, tamanho, antenas, efeitos)) return 1;
+    }
+#else
+    (void)diretorio;
+    (void)limite;
+#endif
+    *antenas = carregarAntenasParalelo(filename);
+    if (!*antenas) return -1;
+    *efeitos = detetarEfeitosNefastos(*antenas);
+#ifndef _WIN32
+    if (usarCache) {
+        mkdir(diretorio, 0777);
+        if (escreverEfeitosCache(caminho, hash, tamanho, *antenas, *efeitos)) limitarCache(diretorio, limite);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file cache.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da cache persistente de resultados, indexada pelo hash do conteúdo do mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "estruturas.h"
+
+/**
+ * @brief Extensão dos ficheiros da cache (os outros ficheiros do diretório são ignorados)
+ */
+#define EXTENSAO_CACHE ".cache"
+/**
+ * @brief Variável de ambiente que, quando definida, faz ignorar a cache
+ */
+#define VARIAVEL_SEM_CACHE "EDA_SEM_CACHE"
+/**
+ * @brief Tamanho máximo por omissão, em bytes, dos ficheiros da cache de um diretório
+ */
+#define LIMITE_CACHE (64 * 1024 * 1024)
+
+/**
+ * @brief Calcula o hash XXH64 de um bloco de memória
+ *
+ * Implementação do algoritmo xxHash de 64 bits (não criptográfico): o bloco é consumido em faixas de
+ * 32 bytes por quatro acumuladores independentes, pelo que o custo é próximo do de ler o bloco.
+ *
+ * @param dados Bloco a resumir
+ * @param tamanho Número de bytes do bloco
+ * @param semente Semente do hash
+ * @return uint64_t Hash do bloco
+ */
+uint64_t hashXXH64(const void* dados, size_t tamanho, uint64_t semente);
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite
+ *
+ * Os ficheiros são removidos do mais antigo para o mais recente, pela data de modificação, que é
+ * atualizada sempre que um ficheiro é reaproveitado.
+ *
+ * @param diretorio Diretório da cache
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache
+ * @return int Número de ficheiros removidos, ou -1 se o diretório não puder ser lido
+ */
+int limitarCache(const char* diretorio, size_t limite);
+/**
+ * @brief Carrega as antenas de um ficheiro e calcula os efeitos nefastos, reaproveitando a cache
+ *
+ * O conteúdo do ficheiro é resumido com hashXXH64; se o diretório da cache tiver um resultado íntegro com esse
+ * hash e esse tamanho, as listas são reconstruídas a partir dele, sem voltar a ler o mapa nem a procurar
+ * os efeitos. Caso contrário são calculadas com carregarAntenasParalelo e detetarEfeitosNefastos e
+ * guardadas na cache, que é depois limitada com limitarCache. As listas ficam iguais nos dois casos.
+ *
+ * @param filename Nome do ficheiro com o mapa
+ * @param diretorio Diretório da cache (criado se não existir), ou NULL para não usar a cache
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache
+ * @param antenas Lista de antenas carregada (saída)
+ * @param efeitos Lista de efeitos nefastos (saída)
+ * @return int 1 se o resultado veio da cache, 0 se foi calculado, -1 em caso de erro ou se o mapa não tiver antenas
+ * @attention A cache também é ignorada quando a variável de ambiente VARIAVEL_SEM_CACHE está definida, e em Windows
+ */
+int detetarEfeitosCache(const char* filename, const char* diretorio, size_t limite, Antena** antenas, Nefasto** efeitos);
+
+#endif
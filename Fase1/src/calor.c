@@ -0,0 +1,383 @@
+/**
+ * @file calor.c
+ * @author Hugo Baptista
+ * @brief Implementação do mapa de calor (multiplicidade) dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "saida.h"
+#include "calor.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Número de antenas de uma frequência tratadas por cada tarefa.
+ */
+#define BLOCO_ANTENAS 256
+
+/**
+ * @brief Cria um mapa de calor vazio
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return MapaCalor* Apontador para o mapa criado, ou NULL em caso de erro
+ */
+MapaCalor* criarMapaCalor(int linhas, int colunas) {
+    if (linhas < 1 || colunas < 1) return NULL;
+    MapaCalor* mapa = (MapaCalor*)malloc(sizeof(MapaCalor));
+    if (!mapa) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    mapa->linhas = linhas;
+    mapa->colunas = colunas;
+    mapa->contagens = (uint32_t*)calloc((size_t)linhas * colunas, sizeof(uint32_t));
+    if (!mapa->contagens) {
+        printf("Erro ao alocar memoria!\n");
+        free(mapa);
+        return NULL;
+    }
+    return mapa;
+}
+
+/**
+ * @brief Liberta a memória alocada para o mapa de calor
+ *
+ * @param mapa Mapa a libertar
+ */
+void libertarMapaCalor(MapaCalor* mapa) {
+    if (!mapa) return;
+    free(mapa->contagens);
+    free(mapa);
+}
+
+/**
+ * @brief Soma um vetor de contadores a outro (destino += origem), com SSE2 quando disponível
+ *
+ * @param destino Vetor a atualizar
+ * @param origem Vetor a somar
+ * @param num Número de contadores
+ */
+void somarContagens(uint32_t* destino, const uint32_t* origem, size_t num) {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= num; i += 16) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(destino + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(destino + i + 4));
+        __m128i a2 = _mm_loadu_si128((const __m128i*)(destino + i + 8));
+        __m128i a3 = _mm_loadu_si128((const __m128i*)(destino + i + 12));
+        a0 = _mm_add_epi32(a0, _mm_loadu_si128((const __m128i*)(origem + i)));
+        a1 = _mm_add_epi32(a1, _mm_loadu_si128((const __m128i*)(origem + i + 4)));
+        a2 = _mm_add_epi32(a2, _mm_loadu_si128((const __m128i*)(origem + i + 8)));
+        a3 = _mm_add_epi32(a3, _mm_loadu_si128((const __m128i*)(origem + i + 12)));
+        _mm_storeu_si128((__m128i*)(destino + i), a0);
+        _mm_storeu_si128((__m128i*)(destino + i + 4), a1);
+        _mm_storeu_si128((__m128i*)(destino + i + 8), a2);
+        _mm_storeu_si128((__m128i*)(destino + i + 12), a3);
+    }
+#endif
+    for (; i < num; i++) destino[i] += origem[i];
+}
+
+/**
+ * @brief Acumula numa grelha os efeitos das antenas [inicio, fim) de um grupo com todas as do grupo
+ * @internal
+ * @param grelha Grelha de contadores
+ * @param linhas Número de linhas da grelha
+ * @param colunas Número de colunas da grelha
+ * @param xs Coordenadas x do grupo
+ * @param ys Coordenadas y do grupo
+ * @param num Número de antenas do grupo
+ * @param inicio Primeira antena tratada
+ * @param fim Fim (exclusivo) das antenas tratadas
+ */
+static void acumularBloco(uint32_t* grelha, int linhas, int colunas, const int* xs, const int* ys, int num, int inicio, int fim) {
+    for (int i = inicio; i < fim; i++) {
+        int x2 = 2 * xs[i], y2 = 2 * ys[i];
+        for (int j = 0; j < num; j++) {
+            if (j == i) continue;
+            int x = x2 - xs[j], y = y2 - ys[j];
+            if ((unsigned)x < (unsigned)colunas && (unsigned)y < (unsigned)linhas) grelha[(size_t)y * colunas + x]++;
+        }
+    }
+}
+
+/**
+ * @brief Acumula no mapa de calor os efeitos nefastos de todos os pares de antenas
+ *
+ * Cada par de antenas da mesma frequência soma 1 a cada um dos seus dois efeitos dentro do mapa.
+ * O trabalho é dividido por blocos de antenas de cada frequência entre as threads; cada thread
+ * acumula numa grelha própria e no fim as grelhas são somadas à do mapa com instruções SIMD.
+ * Quando o orçamento não chega para duas grelhas próprias, a acumulação é feita diretamente no mapa.
+ *
+ * @param mapa Mapa de calor onde acumular
+ * @param lista Lista de antenas
+ * @param orcamento Memória extra (em bytes) que pode ser usada para as grelhas das threads
+ * @return int 1 se os efeitos foram acumulados com sucesso, 0 caso contrário
+ */
+int acumularMapaCalor(MapaCalor* mapa, Antena* lista, size_t orcamento) {
+    if (!mapa) return 0;
+
+    // Agrupa as coordenadas por frequência (ordenação por contagem)
+    int inicioFreq[257] = {0}, num = 0;
+    for (Antena* a = lista; a; a = a->prox, num++) inicioFreq[(unsigned char)a->frequencia + 1]++;
+    if (num == 0) return 1;
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    int* xs = (int*)malloc((size_t)num * sizeof(int));
+    int* ys = (int*)malloc((size_t)num * sizeof(int));
+    if (!xs || !ys) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        return 0;
+    }
+    int pos[256];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (Antena* a = lista; a; a = a->prox) {
+        int p = pos[(unsigned char)a->frequencia]++;
+        xs[p] = a->x;
+        ys[p] = a->y;
+    }
+
+    // Tarefas: blocos de BLOCO_ANTENAS antenas de uma frequência
+    int numTarefas = 0;
+    for (int f = 0; f < 256; f++) {
+        int n = inicioFreq[f + 1] - inicioFreq[f];
+        if (n > 1) numTarefas += (n + BLOCO_ANTENAS - 1) / BLOCO_ANTENAS;
+    }
+    int* tarefas = (int*)malloc((size_t)(numTarefas > 0 ? numTarefas : 1) * 2 * sizeof(int));
+    if (!tarefas) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        return 0;
+    }
+    numTarefas = 0;
+    for (int f = 0; f < 256; f++) {
+        int n = inicioFreq[f + 1] - inicioFreq[f];
+        if (n < 2) continue;
+        for (int i = 0; i < n; i += BLOCO_ANTENAS) {
+            tarefas[2 * numTarefas] = f;
+            tarefas[2 * numTarefas++ + 1] = i;
+        }
+    }
+
+    size_t celulas = (size_t)mapa->linhas * mapa->colunas;
+    int numGrelhas = 1;
+#ifdef _OPENMP
+    numGrelhas = omp_get_max_threads();
+    if (numGrelhas > numTarefas) numGrelhas = numTarefas;
+    if ((size_t)numGrelhas > orcamento / (celulas * sizeof(uint32_t))) numGrelhas = (int)(orcamento / (celulas * sizeof(uint32_t)));
+#else
+    (void)orcamento;
+#endif
+    uint32_t** grelhas = NULL;
+    if (numGrelhas >= 2) {
+        grelhas = (uint32_t**)calloc((size_t)numGrelhas, sizeof(uint32_t*));
+        for (int g = 0; grelhas && g < numGrelhas; g++) {
+            grelhas[g] = (uint32_t*)calloc(celulas, sizeof(uint32_t));
+            if (!grelhas[g]) { // Sem memória para todas: usa as que conseguiu alocar
+                numGrelhas = g;
+                break;
+            }
+        }
+        if (!grelhas || numGrelhas < 2) {
+            for (int g = 0; grelhas && g < numGrelhas; g++) free(grelhas[g]);
+            free(grelhas);
+            grelhas = NULL;
+        }
+    }
+
+    if (!grelhas) {
+        for (int t = 0; t < numTarefas; t++) {
+            int f = tarefas[2 * t], i = tarefas[2 * t + 1], n = inicioFreq[f + 1] - inicioFreq[f];
+            acumularBloco(mapa->contagens, mapa->linhas, mapa->colunas, xs + inicioFreq[f], ys + inicioFreq[f],
+                          n, i, i + BLOCO_ANTENAS < n ? i + BLOCO_ANTENAS : n);
+        }
+    } else {
+#ifdef _OPENMP
+        #pragma omp parallel num_threads(numGrelhas)
+        {
+            uint32_t* grelha = grelhas[omp_get_thread_num()];
+            #pragma omp for schedule(dynamic, 1)
+            for (int t = 0; t < numTarefas; t++) {
+                int f = tarefas[2 * t], i = tarefas[2 * t + 1], n = inicioFreq[f + 1] - inicioFreq[f];
+                acumularBloco(grelha, mapa->linhas, mapa->colunas, xs + inicioFreq[f], ys + inicioFreq[f],
+                              n, i, i + BLOCO_ANTENAS < n ? i + BLOCO_ANTENAS : n);
+            }
+            // Fusão: cada thread soma todas as grelhas numa fatia do mapa
+            #pragma omp for schedule(static)
+            for (long long y = 0; y < mapa->linhas; y++) {
+                size_t inicio = (size_t)y * mapa->colunas;
+                for (int g = 0; g < numGrelhas; g++) somarContagens(mapa->contagens + inicio, grelhas[g] + inicio, mapa->colunas);
+            }
+        }
+#endif
+        for (int g = 0; g < numGrelhas; g++) free(grelhas[g]);
+        free(grelhas);
+    }
+
+    free(tarefas);
+    free(xs);
+    free(ys);
+    return 1;
+}
+
+/**
+ * @brief Indica se a célula a é mais quente do que b (mais contagens; empate pela menor posição)
+ * @internal
+ * @param a Primeira célula
+ * @param b Segunda célula
+ * @return int 1 se a é mais quente do que b, 0 caso contrário
+ */
+static int maisQuente(const CelulaCalor* a, const CelulaCalor* b) {
+    if (a->contagem != b->contagem) return a->contagem > b->contagem;
+    if (a->y != b->y) return a->y < b->y;
+    return a->x < b->x;
+}
+
+/**
+ * @brief Desce uma célula num min-heap (a raiz é a menos quente)
+ * @internal
+ * @param heap Heap de células
+ * @param num Número de células no heap
+ * @param i Posição a descer
+ */
+static void descerCelula(CelulaCalor* heap, int num, int i) {
+    CelulaCalor c = heap[i];
+    for (;;) {
+        int f = 2 * i + 1;
+        if (f >= num) break;
+        if (f + 1 < num && maisQuente(&heap[f], &heap[f + 1])) f++;
+        if (!maisQuente(&c, &heap[f])) break;
+        heap[i] = heap[f];
+        i = f;
+    }
+    heap[i] = c;
+}
+
+/**
+ * @brief Procura as n células mais atingidas do mapa de calor
+ *
+ * @param mapa Mapa de calor
+ * @param n Número de células pretendido
+ * @param resultado Vetor com espaço para n células, ordenado por contagem decrescente (empates por y e x)
+ * @return int Número de células devolvidas (só células com contagem positiva)
+ */
+int celulasMaisQuentes(const MapaCalor* mapa, int n, CelulaCalor* resultado) {
+    if (!mapa || n < 1) return 0;
+    int num = 0;
+    for (int y = 0; y < mapa->linhas; y++) {
+        const uint32_t* linha = mapa->contagens + (size_t)y * mapa->colunas;
+        for (int x = 0; x < mapa->colunas; x++) {
+            if (!linha[x]) continue;
+            if (num == n && linha[x] <= resultado[0].contagem) continue; // Não supera a menos quente
+            CelulaCalor c = { x, y, linha[x] };
+            if (num < n) {
+                int i = num++;
+                while (i > 0 && maisQuente(&resultado[(i - 1) / 2], &c)) {
+                    resultado[i] = resultado[(i - 1) / 2];
+                    i = (i - 1) / 2;
+                }
+                resultado[i] = c;
+            } else {
+                resultado[0] = c;
+                descerCelula(resultado, num, 0);
+            }
+        }
+    }
+    // Ordena da mais quente para a menos quente
+    for (int fim = num - 1; fim > 0; fim--) {
+        CelulaCalor c = resultado[fim];
+        resultado[fim] = resultado[0];
+        resultado[0] = c;
+        descerCelula(resultado, fim, 0);
+    }
+    return num;
+}
+
+/**
+ * @brief Exporta o mapa de calor em binário (uint32 little-endian, por linhas, sem cabeçalho)
+ *
+ * @param mapa Mapa a exportar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se o mapa foi exportado com sucesso, 0 caso contrário
+ */
+int exportarMapaCalorBinario(const MapaCalor* mapa, const char* filename) {
+    if (!mapa) return 0;
+    Saida saida;
+    if (!abrirSaidaBinaria(&saida, filename)) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return 0;
+    }
+    unsigned char bytes[4 * 1024];
+    size_t total = (size_t)mapa->linhas * mapa->colunas;
+    for (size_t i = 0; i < total; ) {
+        size_t n = 0;
+        for (; i < total && n < sizeof(bytes); i++, n += 4) {
+            uint32_t v = mapa->contagens[i];
+            bytes[n] = (unsigned char)v;
+            bytes[n + 1] = (unsigned char)(v >> 8);
+            bytes[n + 2] = (unsigned char)(v >> 16);
+            bytes[n + 3] = (unsigned char)(v >> 24);
+        }
+        escreverBytes(&saida, (const char*)bytes, n);
+    }
+    return fecharSaida(&saida);
+}
+
+/**
+ * @brief Exporta o mapa de calor como imagem PGM (P5)
+ *
+ * Usa 8 bits por píxel quando a contagem máxima não passa de 255 e 16 bits (big-endian) caso contrário;
+ * contagens acima de 65535 são saturadas.
+ *
+ * @param mapa Mapa a exportar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se o mapa foi exportado com sucesso, 0 caso contrário
+ */
+int exportarMapaCalorPGM(const MapaCalor* mapa, const char* filename) {
+    if (!mapa) return 0;
+    size_t total = (size_t)mapa->linhas * mapa->colunas;
+    uint32_t maximo = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (mapa->contagens[i] > maximo) maximo = mapa->contagens[i];
+    }
+    if (maximo > 65535) maximo = 65535;
+    if (maximo == 0) maximo = 1; // O PGM exige um valor máximo positivo
+
+    Saida saida;
+    if (!abrirSaidaBinaria(&saida, filename)) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return 0;
+    }
+    escreverTexto(&saida, "P5\n");
+    escreverInteiro(&saida, mapa->colunas);
+    escreverCaracter(&saida, ' ');
+    escreverInteiro(&saida, mapa->linhas);
+    escreverCaracter(&saida, '\n');
+    escreverInteiro(&saida, (int)maximo);
+    escreverCaracter(&saida, '\n');
+
+    unsigned char bytes[4 * 1024];
+    for (size_t i = 0; i < total; ) {
+        size_t n = 0;
+        for (; i < total && n + 2 <= sizeof(bytes); i++) {
+            uint32_t v = mapa->contagens[i] > maximo ? maximo : mapa->contagens[i];
+            if (maximo > 255) bytes[n++] = (unsigned char)(v >> 8);
+            bytes[n++] = (unsigned char)v;
+        }
+        escreverBytes(&saida, (const char*)bytes, n);
+    }
+    return fecharSaida(&saida);
+}
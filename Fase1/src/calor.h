@@ -0,0 +1,79 @@
+/**
+ * @file calor.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções do mapa de calor (multiplicidade) dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef CALOR_H
+#define CALOR_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Cria um mapa de calor vazio
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return MapaCalor* Apontador para o mapa criado, ou NULL em caso de erro
+ */
+MapaCalor* criarMapaCalor(int linhas, int colunas);
+/**
+ * @brief Liberta a memória alocada para o mapa de calor
+ *
+ * @param mapa Mapa a libertar
+ */
+void libertarMapaCalor(MapaCalor* mapa);
+/**
+ * @brief Acumula no mapa de calor os efeitos nefastos de todos os pares de antenas
+ *
+ * Cada par de antenas da mesma frequência soma 1 a cada um dos seus dois efeitos dentro do mapa.
+ * O trabalho é dividido por blocos de antenas de cada frequência entre as threads; cada thread
+ * acumula numa grelha própria e no fim as grelhas são somadas à do mapa com instruções SIMD.
+ * Quando o orçamento não chega para duas grelhas próprias, a acumulação é feita diretamente no mapa.
+ *
+ * @param mapa Mapa de calor onde acumular
+ * @param lista Lista de antenas
+ * @param orcamento Memória extra (em bytes) que pode ser usada para as grelhas das threads
+ * @return int 1 se os efeitos foram acumulados com sucesso, 0 caso contrário
+ */
+int acumularMapaCalor(MapaCalor* mapa, Antena* lista, size_t orcamento);
+/**
+ * @brief Soma um vetor de contadores a outro (destino += origem), com SSE2 quando disponível
+ *
+ * @param destino Vetor a atualizar
+ * @param origem Vetor a somar
+ * @param num Número de contadores
+ */
+void somarContagens(uint32_t* destino, const uint32_t* origem, size_t num);
+/**
+ * @brief Procura as n células mais atingidas do mapa de calor
+ *
+ * @param mapa Mapa de calor
+ * @param n Número de células pretendido
+ * @param resultado Vetor com espaço para n células, ordenado por contagem decrescente (empates por y e x)
+ * @return int Número de células devolvidas (só células com contagem positiva)
+ */
+int celulasMaisQuentes(const MapaCalor* mapa, int n, CelulaCalor* resultado);
+/**
+ * @brief Exporta o mapa de calor em binário (uint32 little-endian, por linhas, sem cabeçalho)
+ *
+ * @param mapa Mapa a exportar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se o mapa foi exportado com sucesso, 0 caso contrário
+ */
+int exportarMapaCalorBinario(const MapaCalor* mapa, const char* filename);
+/**
+ * @brief Exporta o mapa de calor como imagem PGM (P5)
+ *
+ * Usa 8 bits por píxel quando a contagem máxima não passa de 255 e 16 bits (big-endian) caso contrário;
+ * contagens acima de 65535 são saturadas.
+ *
+ * @param mapa Mapa a exportar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se o mapa foi exportado com sucesso, 0 caso contrário
+ */
+int exportarMapaCalorPGM(const MapaCalor* mapa, const char* filename);
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * @file diferencas.c
+ * @author Hugo Baptista
+ * @brief Implementação da comparação incremental de duas versões de um mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "leitor.h"
+#include "saida.h"
+#include "vetorial.h"
+#include "diferencas.h"
+
+/**
+ * @brief Tamanho do buffer de linha usado por carregarAntenas (as linhas maiores são divididas)
+ */
+#define TAMANHO_LINHA 100
+/**
+ * @brief Número de palavras de um mapa de bits de MAX_LINHAS x MAX_COLUNAS células
+ */
+#define PALAVRAS_MAPA ((MAX_LINHAS * MAX_COLUNAS + 63) / 64)
+
+/**
+ * @brief Linhas de um mapa, divididas como o fgets de carregarAntenas as leria
+ * @internal
+ */
+typedef struct LinhasMapa {
+    char* dados;          /**< Conteúdo do ficheiro mapeado */
+    size_t tamanho;       /**< Número de bytes do ficheiro */
+    const char** inicio;  /**< Início de cada linha */
+    int* celulas;         /**< Número de células de cada linha (até ao '\n' ou ao primeiro '\0') */
+    int num;              /**< Número de linhas (no máximo MAX_LINHAS, as seguintes não têm antenas válidas) */
+} LinhasMapa;
+
+/**
+ * @brief Mapeia um ficheiro e divide-o em linhas
+ * @internal
+ * Uma linha termina num '\n' ou ao fim de TAMANHO_LINHA - 1 caracteres, e um '\0' termina as células
+ * da linha atual, como no ciclo de carregarAntenas.
+ * @param filename Nome do ficheiro
+ * @param linhas Linhas do mapa (saída)
+ * @return int 1 se o ficheiro foi lido com sucesso, 0 caso contrário
+ */
+static int dividirLinhas(const char* filename, LinhasMapa* linhas) {
+    memset(linhas, 0, sizeof(LinhasMapa));
+    linhas->dados = mapearFicheiro(filename, &linhas->tamanho);
+    if (!linhas->dados) return 0;
+    linhas->inicio = (const char**)malloc(MAX_LINHAS * sizeof(const char*));
+    linhas->celulas = (int*)malloc(MAX_LINHAS * sizeof(int));
+    if (!linhas->inicio || !linhas->celulas) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    const char* p = linhas->dados, *fim = linhas->dados + linhas->tamanho;
+    while (p < fim && linhas->num < MAX_LINHAS) {
+        int lidos = 0, celulas = 0, ativa = 1;
+        linhas->inicio[linhas->num] = p;
+        while (p < fim && lidos < TAMANHO_LINHA - 1) {
+            char c = *p++;
+            lidos++;
+            if (c == '\n') break;
+            if (c == '\0') ativa = 0;
+            if (ativa) celulas++;
+        }
+        linhas->celulas[linhas->num++] = celulas;
+    }
+    return 1;
+}
+
+/**
+ * @brief Liberta as linhas de um mapa
+ * @internal
+ * @param linhas Linhas a libertar
+ */
+static void libertarLinhas(LinhasMapa* linhas) {
+    libertarFicheiro(linhas->dados, linhas->tamanho);
+    free(linhas->inicio);
+    free(linhas->celulas);
+}
+
+/**
+ * @brief Devolve o caracter de uma célula do mapa
+ * @internal
+ * @param linhas Linhas do mapa
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return char Caracter da célula, ou '.' fora do mapa
+ */
+static inline char celula(const LinhasMapa* linhas, int x, int y) {
+    if (y < 0 || y >= linhas->num || x < 0 || x >= linhas->celulas[y]) return '.';
+    return linhas->inicio[y][x];
+}
+
+/**
+ * @brief Indica se um caracter do mapa é uma antena
+ * @internal
+ * @param c Caracter
+ * @return int 1 se é uma antena, 0 caso contrário
+ */
+static inline int ehAntena(char c) {
+    return c != '.' && c != '#';
+}
+
+/**
+ * @brief Acrescenta uma antena ao fim de uma lista
+ * @internal
+ * @param cauda Apontador para o campo prox do último nó (ou para a lista, se vazia), atualizado
+ * @param freq Frequência da antena
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @return int 1 se a antena foi acrescentada com sucesso, 0 caso contrário
+ */
+static int acrescentarAntena(Antena*** cauda, char freq, int x, int y) {
+    Antena* nova = criarAntena(freq, x, y);
+    if (!nova) return 0;
+    **cauda = nova;
+    *cauda = &nova->prox;
+    return 1;
+}
+
+/**
+ * @brief Indica se uma célula é um efeito nefasto de alguma frequência que não mudou
+ * @internal
+ * Como as antenas dessas frequências são as mesmas nos dois mapas, basta procurar no mapa novo, para cada
+ * antena a do grupo, uma antena da mesma frequência em 2 * a - c.
+ * @param novo Linhas do mapa novo
+ * @param inicioFreq Início das antenas de cada frequência nos vetores de coordenadas
+ * @param xs Coordenadas x das antenas do mapa novo, agrupadas por frequência
+ * @param ys Coordenadas y das antenas do mapa novo, agrupadas por frequência
+ * @param afetada Indica, para cada frequência, se mudou
+ * @param x Coordenada x da célula
+ * @param y Coordenada y da célula
+ * @return int 1 se a célula é um efeito de uma frequência que não mudou, 0 caso contrário
+ */
+static int efeitoInalterado(const LinhasMapa* novo, const int* inicioFreq, const int32_t* xs, const int32_t* ys, const unsigned char* afetada, int x, int y) {
+    for (int f = 0; f < 256; f++) {
+        if (afetada[f] || inicioFreq[f + 1] - inicioFreq[f] < 2) continue;
+        for (int i = inicioFreq[f]; i < inicioFreq[f + 1]; i++) {
+            if (xs[i] == x && ys[i] == y) continue; // A antena não forma par consigo própria
+            if (celula(novo, 2 * xs[i] - x, 2 * ys[i] - y) == (char)f) return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Compara duas versões de um mapa e calcula as antenas e os efeitos nefastos que mudaram
+ *
+ * Os dois ficheiros são mapeados em memória e divididos nas mesmas linhas que carregarAntenas leria; as
+ * linhas iguais são saltadas com memcmp (vetorizado na biblioteca C) e só as diferentes são comparadas
+ * célula a célula. Os efeitos só são recalculados para as frequências com antenas adicionadas ou
+ * removidas, antes e depois da alteração; as células que mudam nessas frequências só contam quando
+ * nenhuma das outras frequências (que não mudaram) também lá tem um efeito. O resultado é igual à
+ * diferença entre os efeitos de detetarEfeitosNefastos nos dois mapas.
+ *
+ * @param antigo Nome do ficheiro com a versão antiga do mapa
+ * @param novo Nome do ficheiro com a versão nova do mapa
+ * @param diferenca Diferenças entre os mapas (saída, libertar com libertarDiferenca)
+ * @return int 1 se os mapas foram comparados com sucesso, 0 caso contrário
+ */
+int compararMapas(const char* antigo, const char* novo, DiferencaMapas* diferenca) {
+    memset(diferenca, 0, sizeof(DiferencaMapas));
+    LinhasMapa la, ln;
+    int okA = dividirLinhas(antigo, &la);
+    int okN = okA && dividirLinhas(novo, &ln);
+    if (!okN) {
+        libertarLinhas(&la);
+        if (okA) libertarLinhas(&ln);
+        return 0;
+    }
+
+    // Antenas adicionadas e removidas, só nas linhas diferentes
+    unsigned char afetada[256] = {0};
+    Antena** caudaAdicionadas = &diferenca->adicionadas, **caudaRemovidas = &diferenca->removidas;
+    int ok = 1;
+    int numLinhas = la.num > ln.num ? la.num : ln.num;
+    for (int y = 0; y < numLinhas && ok; y++) {
+        int ca = y < la.num ? la.celulas[y] : 0, cn = y < ln.num ? ln.celulas[y] : 0;
+        if (ca == cn && (ca == 0 || memcmp(la.inicio[y], ln.inicio[y], (size_t)ca) == 0)) continue;
+        diferenca->linhasAlteradas++;
+        int largura = ca > cn ? ca : cn;
+        for (int x = 0; x < largura && ok; x++) {
+            char a = celula(&la, x, y), n = celula(&ln, x, y);
+            if (a == n) continue;
+            if (ehAntena(a)) {
+                afetada[(unsigned char)a] = 1;
+                ok = acrescentarAntena(&caudaRemovidas, a, x, y);
+            }
+            if (ok && ehAntena(n)) {
+                afetada[(unsigned char)n] = 1;
+                ok = acrescentarAntena(&caudaAdicionadas, n, x, y);
+            }
+        }
+    }
+    for (int f = 0; f < 256; f++) diferenca->frequenciasAfetadas += afetada[f];
+    if (!ok || diferenca->frequenciasAfetadas == 0) {
+        libertarLinhas(&la);
+        libertarLinhas(&ln);
+        if (!ok) libertarDiferenca(diferenca);
+        return ok;
+    }
+
+    // Antenas do mapa novo agrupadas por frequência; o grupo antigo de uma frequência afetada são as
+    // antenas que já tinham essa frequência no mapa antigo, mais as removidas
+    int inicioFreq[257] = {0}, pos[256];
+    for (int y = 0; y < ln.num; y++) {
+        for (int x = 0; x < ln.celulas[y]; x++) {
+            if (ehAntena(ln.inicio[y][x])) inicioFreq[(unsigned char)ln.inicio[y][x] + 1]++;
+        }
+    }
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    int total = inicioFreq[256], numRemovidas = 0;
+    for (Antena* r = diferenca->removidas; r; r = r->prox) numRemovidas++;
+    int32_t* xs = (int32_t*)malloc((size_t)(total + 1) * sizeof(int32_t));
+    int32_t* ys = (int32_t*)malloc((size_t)(total + 1) * sizeof(int32_t));
+    int32_t* gx = (int32_t*)malloc((size_t)(total + numRemovidas + 1) * sizeof(int32_t));
+    int32_t* gy = (int32_t*)malloc((size_t)(total + numRemovidas + 1) * sizeof(int32_t));
+    uint64_t* mapas = (uint64_t*)calloc(4 * PALAVRAS_MAPA, sizeof(uint64_t));
+    if (!xs || !ys || !gx || !gy || !mapas) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        free(gx);
+        free(gy);
+        free(mapas);
+        libertarLinhas(&la);
+        libertarLinhas(&ln);
+        libertarDiferenca(diferenca);
+        return 0;
+    }
+    for (int y = 0; y < ln.num; y++) {
+        for (int x = 0; x < ln.celulas[y]; x++) {
+            char c = ln.inicio[y][x];
+            if (!ehAntena(c)) continue;
+            xs[pos[(unsigned char)c]] = x;
+            ys[pos[(unsigned char)c]++] = y;
+        }
+    }
+
+    // Efeitos das frequências afetadas antes e depois da alteração
+    uint64_t* efeitosAntigos = mapas, *efeitosNovos = mapas + PALAVRAS_MAPA;
+    uint64_t* adicionados = mapas + 2 * PALAVRAS_MAPA, *removidos = mapas + 3 * PALAVRAS_MAPA;
+    for (int f = 0; f < 256; f++) {
+        if (!afetada[f]) continue;
+        int n = inicioFreq[f + 1] - inicioFreq[f], g = 0;
+        marcarEfeitosGrupo(xs + inicioFreq[f], ys + inicioFreq[f], n, MAX_LINHAS, MAX_COLUNAS, efeitosNovos);
+        for (int i = inicioFreq[f]; i < inicioFreq[f + 1]; i++) {
+            if (celula(&la, xs[i], ys[i]) != (char)f) continue;
+            gx[g] = xs[i];
+            gy[g++] = ys[i];
+        }
+        for (Antena* r = diferenca->removidas; r; r = r->prox) {
+            if (r->frequencia != (char)f) continue;
+            gx[g] = r->x;
+            gy[g++] = r->y;
+        }
+        marcarEfeitosGrupo(gx, gy, g, MAX_LINHAS, MAX_COLUNAS, efeitosAntigos);
+    }
+
+    // Só as células que mudaram e não são efeitos de outra frequência entram na diferença
+    for (int w = 0; w < PALAVRAS_MAPA; w++) {
+        uint64_t mudou = efeitosAntigos[w] ^ efeitosNovos[w];
+        while (mudou) {
+            int b = 0;
+            while (!(mudou >> b & 1)) b++;
+            mudou &= mudou - 1;
+            int c = w * 64 + b;
+            if (efeitoInalterado(&ln, inicioFreq, xs, ys, afetada, c % MAX_COLUNAS, c / MAX_COLUNAS)) continue;
+            if (efeitosNovos[w] >> b & 1) adicionados[w] |= 1ULL << b;
+            else removidos[w] |= 1ULL << b;
+        }
+    }
+    diferenca->efeitosAdicionados = listaDeMapa(adicionados, MAX_LINHAS, MAX_COLUNAS);
+    diferenca->efeitosRemovidos = listaDeMapa(removidos, MAX_LINHAS, MAX_COLUNAS);
+
+    free(xs);
+    free(ys);
+    free(gx);
+    free(gy);
+    free(mapas);
+    libertarLinhas(&la);
+    libertarLinhas(&ln);
+    return 1;
+}
+
+/**
+ * @brief Liberta as listas das diferenças entre dois mapas
+ *
+ * @param diferenca Diferenças a libertar
+ */
+void libertarDiferenca(DiferencaMapas* diferenca) {
+    Antena* listas[2] = {diferenca->adicionadas, diferenca->removidas};
+    for (int i = 0; i < 2; i++) {
+        while (listas[i]) {
+            Antena* seguinte = listas[i]->prox;
+            free(listas[i]);
+            listas[i] = seguinte;
+        }
+    }
+    Nefasto* efeitos[2] = {diferenca->efeitosAdicionados, diferenca->efeitosRemovidos};
+    for (int i = 0; i < 2; i++) {
+        while (efeitos[i]) {
+            Nefasto* seguinte = efeitos[i]->prox;
+            free(efeitos[i]);
+            efeitos[i] = seguinte;
+        }
+    }
+    memset(diferenca, 0, sizeof(DiferencaMapas));
+}
+
+/**
+ * @brief Escreve as diferenças entre dois mapas, uma antena ou efeito nefasto por linha ('+' adicionado, '-' removido)
+ *
+ * @param diferenca Diferenças a escrever
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola
+ * @return int 1 se as diferenças foram escritas com sucesso, 0 caso contrário
+ */
+int guardarDiferenca(const DiferencaMapas* diferenca, const char* filename) {
+    Saida saida;
+    if (!abrirSaida(&saida, filename)) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return 0;
+    }
+    escreverTexto(&saida, "\nDiferencas entre Mapas:\n");
+    escreverTexto(&saida, "Linhas alteradas: ");
+    escreverInteiro(&saida, diferenca->linhasAlteradas);
+    escreverTexto(&saida, "\nFrequencias afetadas: ");
+    escreverInteiro(&saida, diferenca->frequenciasAfetadas);
+    escreverTexto(&saida, "\n------------------------\n");
+    Antena* antenas[2] = {diferenca->adicionadas, diferenca->removidas};
+    Nefasto* efeitos[2] = {diferenca->efeitosAdicionados, diferenca->efeitosRemovidos};
+    const char* sinais = "+-";
+    for (int i = 0; i < 2; i++) {
+        for (Antena* a = antenas[i]; a; a = a->prox) {
+            escreverCaracter(&saida, sinais[i]);
+            escreverBytes(&saida, " ", 1);
+            escreverCaracter(&saida, a->frequencia);
+            escreverBytes(&saida, " | (X:", 6);
+            escreverInteiro(&saida, a->x);
+            escreverBytes(&saida, ", Y:", 4);
+            escreverInteiro(&saida, a->y);
+            escreverBytes(&saida, ")\n", 2);
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (Nefasto* e = efeitos[i]; e; e = e->prox) {
+            escreverCaracter(&saida, sinais[i]);
+            escreverBytes(&saida, " # | (X:", 8);
+            escreverInteiro(&saida, e->x);
+            escreverBytes(&saida, ", Y:", 4);
+            escreverInteiro(&saida, e->y);
+            escreverBytes(&saida, ")\n", 2);
+        }
+    }
+    escreverTexto(&saida, "------------------------\n");
+    return fecharSaida(&saida);
+}
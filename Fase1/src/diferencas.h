@@ -0,0 +1,45 @@
+/**
+ * @file diferencas.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da comparação incremental de duas versões de um mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef DIFERENCAS_H
+#define DIFERENCAS_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Compara duas versões de um mapa e calcula as antenas e os efeitos nefastos que mudaram
+ *
+ * Os dois ficheiros são mapeados em memória e divididos nas mesmas linhas que carregarAntenas leria; as
+ * linhas iguais são saltadas com memcmp (vetorizado na biblioteca C) e só as diferentes são comparadas
+ * célula a célula. Os efeitos só são recalculados para as frequências com antenas adicionadas ou
+ * removidas, antes e depois da alteração; as células que mudam nessas frequências só contam quando
+ * nenhuma das outras frequências (que não mudaram) também lá tem um efeito. O resultado é igual à
+ * diferença entre os efeitos de detetarEfeitosNefastos nos dois mapas.
+ *
+ * @param antigo Nome do ficheiro com a versão antiga do mapa
+ * @param novo Nome do ficheiro com a versão nova do mapa
+ * @param diferenca Diferenças entre os mapas (saída, libertar com libertarDiferenca)
+ * @return int 1 se os mapas foram comparados com sucesso, 0 caso contrário
+ */
+int compararMapas(const char* antigo, const char* novo, DiferencaMapas* diferenca);
+/**
+ * @brief Liberta as listas das diferenças entre dois mapas
+ *
+ * @param diferenca Diferenças a libertar
+ */
+void libertarDiferenca(DiferencaMapas* diferenca);
+/**
+ * @brief Escreve as diferenças entre dois mapas, uma antena ou efeito nefasto por linha ('+' adicionado, '-' removido)
+ *
+ * @param diferenca Diferenças a escrever
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola
+ * @return int 1 se as diferenças foram escritas com sucesso, 0 caso contrário
+ */
+int guardarDiferenca(const DiferencaMapas* diferenca, const char* filename);
+
+#endif
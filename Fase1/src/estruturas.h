@@ -9,6 +9,9 @@
 #ifndef ANTENAS_H
 #define ANTENAS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 /**
  * @brief Estrutura de dados para as antenas
  * @struct Antena
@@ -37,4 +40,244 @@ typedef struct Nefasto {
     struct Nefasto *prox;
 } Nefasto;
 
+/**
+ * @brief Estrutura de dados para um balde do índice espacial
+ * @struct Balde
+ * @param antenas Apontadores para as antenas cuja posição cai no balde
+ * @param num Número de antenas no balde
+ * @param cap Capacidade do vetor de antenas
+ */
+typedef struct Balde {
+    Antena** antenas;
+    int num, cap;
+} Balde;
+
+/**
+ * @brief Estrutura de dados para o índice espacial das antenas
+ * @struct IndiceEspacial
+ * @param linhas Número de linhas da área coberta pelo índice
+ * @param colunas Número de colunas da área coberta pelo índice
+ * @param lado Lado (em células) de cada balde da grelha
+ * @param baldesX Número de baldes na horizontal
+ * @param baldesY Número de baldes na vertical
+ * @param baldes Grelha uniforme de baldes, por linhas
+ * @param tabela Tabela de dispersão (endereçamento aberto) indexada pelas coordenadas
+ * @param capTabela Capacidade da tabela de dispersão (potência de 2)
+ * @param numAntenas Número de antenas no índice
+ * @attention O índice guarda apontadores para os nós da lista, não copia as antenas
+ */
+typedef struct IndiceEspacial {
+    int linhas, colunas;
+    int lado;
+    int baldesX, baldesY;
+    Balde* baldes;
+    Antena** tabela;
+    int capTabela;
+    int numAntenas;
+} IndiceEspacial;
+
+/**
+ * @brief Estrutura de dados para o mapa de calor dos efeitos nefastos
+ * @struct MapaCalor
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param contagens Número de pares de antenas que atingem cada célula, por linhas
+ * @attention A grelha é contígua (linhas x colunas contadores), sem nós por célula
+ */
+typedef struct MapaCalor {
+    int linhas, colunas;
+    uint32_t* contagens;
+} MapaCalor;
+
+/**
+ * @brief Estrutura de dados para uma célula do mapa de calor
+ * @struct CelulaCalor
+ * @param x Coordenada x da célula
+ * @param y Coordenada y da célula
+ * @param contagem Número de pares de antenas que atingem a célula
+ */
+typedef struct CelulaCalor {
+    int x, y;
+    uint32_t contagem;
+} CelulaCalor;
+
+/**
+ * @brief Estrutura de dados para uma posição candidata a receber uma nova antena
+ * @struct Candidato
+ * @param x Coordenada x da posição
+ * @param y Coordenada y da posição
+ * @param novos Número de efeitos nefastos novos que a antena criaria
+ */
+typedef struct Candidato {
+    int x, y;
+    int novos;
+} Candidato;
+
+/**
+ * @brief Estrutura de dados para a escrita em bloco
+ * @struct Saida
+ * @param fd Descritor do ficheiro de destino
+ * @param buffer Buffer onde os registos são formatados antes de serem escritos
+ * @param usado Número de bytes ocupados no buffer
+ * @param capacidade Capacidade do buffer
+ * @param proprio Indica se o descritor foi aberto pela saída e deve ser fechado (0 ou 1)
+ * @param erro Indica se ocorreu algum erro de escrita (0 ou 1)
+ * @attention O buffer é reutilizado entre despejos, só é libertado em fecharSaida
+ */
+typedef struct Saida {
+    int fd;
+    char* buffer;
+    size_t usado, capacidade;
+    int proprio;
+    int erro;
+} Saida;
+
+/**
+ * @brief INSERIR_ANTENA Tipo da operação de lote que insere uma antena
+ */
+#define INSERIR_ANTENA 1
+/**
+ * @brief REMOVER_ANTENA Tipo da operação de lote que remove uma antena
+ */
+#define REMOVER_ANTENA 2
+
+/**
+ * @brief Estrutura de dados para uma operação de um lote de alterações à lista de antenas
+ * @struct OperacaoAntena
+ * @param tipo Tipo da operação (INSERIR_ANTENA ou REMOVER_ANTENA)
+ * @param frequencia Frequência da antena a inserir (ignorada na remoção)
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ */
+typedef struct OperacaoAntena {
+    int tipo;
+    char frequencia;
+    int x, y;
+} OperacaoAntena;
+
+/**
+ * @brief Estrutura de dados para o armazém compacto de antenas (um vetor por campo)
+ * @struct ArmazemAntenas
+ * @param frequencias Frequência de cada antena ('.' nas antenas removidas)
+ * @param x16 Coordenadas x, quando o mapa cabe em 16 bits (NULL caso contrário)
+ * @param y16 Coordenadas y, quando o mapa cabe em 16 bits (NULL caso contrário)
+ * @param x32 Coordenadas x, quando o mapa não cabe em 16 bits (NULL caso contrário)
+ * @param y32 Coordenadas y, quando o mapa não cabe em 16 bits (NULL caso contrário)
+ * @param num Número de antenas guardadas (incluindo as removidas)
+ * @param cap Capacidade dos vetores
+ * @param removidas Número de antenas removidas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @attention O índice de cada antena não muda enquanto o armazém existir (as remoções só a marcam)
+ */
+typedef struct ArmazemAntenas {
+    unsigned char* frequencias;
+    uint16_t* x16, *y16;
+    uint32_t* x32, *y32;
+    int num, cap;
+    int removidas;
+    int linhas, colunas;
+} ArmazemAntenas;
+
+/**
+ * @brief Estrutura de dados para as diferenças entre duas versões de um mapa
+ * @struct DiferencaMapas
+ * @param adicionadas Antenas que só existem no mapa novo (por y e x)
+ * @param removidas Antenas que só existem no mapa antigo (por y e x)
+ * @param efeitosAdicionados Efeitos nefastos que só existem no mapa novo (por y e x)
+ * @param efeitosRemovidos Efeitos nefastos que só existem no mapa antigo (por y e x)
+ * @param linhasAlteradas Número de linhas diferentes entre os dois mapas
+ * @param frequenciasAfetadas Número de frequências com antenas adicionadas ou removidas
+ * @attention Uma antena que muda de frequência aparece nas removidas e nas adicionadas
+ */
+typedef struct DiferencaMapas {
+    Antena* adicionadas;
+    Antena* removidas;
+    Nefasto* efeitosAdicionados;
+    Nefasto* efeitosRemovidos;
+    int linhasAlteradas;
+    int frequenciasAfetadas;
+} DiferencaMapas;
+
+/**
+ * @brief EVENTO_INSERIR Tipo do evento que insere uma antena
+ */
+#define EVENTO_INSERIR 'A'
+/**
+ * @brief EVENTO_MOVER Tipo do evento que muda uma antena de posição
+ */
+#define EVENTO_MOVER 'M'
+/**
+ * @brief EVENTO_REMOVER Tipo do evento que remove uma antena
+ */
+#define EVENTO_REMOVER 'R'
+
+/**
+ * @brief Estrutura de dados para um evento de alteração das antenas
+ * @struct EventoAntena
+ * @param tipo Tipo do evento (EVENTO_INSERIR, EVENTO_MOVER ou EVENTO_REMOVER)
+ * @param frequencia Frequência da antena a inserir
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @param nx Nova coordenada x (só em EVENTO_MOVER)
+ * @param ny Nova coordenada y (só em EVENTO_MOVER)
+ */
+typedef struct EventoAntena {
+    char tipo;
+    char frequencia;
+    int x, y;
+    int nx, ny;
+} EventoAntena;
+
+/**
+ * @brief Estrutura de dados para o estado mantido durante o processamento de eventos
+ * @struct EstadoEventos
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param frequencias Frequência da antena de cada célula (0 se a célula está livre)
+ * @param posicoes Posição da antena de cada célula no grupo da sua frequência
+ * @param xs Coordenadas x das antenas de cada frequência (um vetor por valor de char)
+ * @param ys Coordenadas y das antenas de cada frequência
+ * @param numGrupo Número de antenas de cada frequência
+ * @param capGrupo Capacidade dos vetores de cada frequência
+ * @param contagens Número de pares de antenas que atingem cada célula (contagem de referências dos efeitos)
+ * @param marcas Estado de cada célula no início do lote mais um (0 se a célula não mudou no lote)
+ * @param tocadas Células cuja contagem mudou no lote
+ * @param numTocadas Número de células cuja contagem mudou no lote
+ * @param numAntenas Número de antenas
+ * @param numEfeitos Número de células com contagem positiva
+ * @attention As grelhas são contíguas (linhas x colunas posições), como no mapa de calor
+ */
+typedef struct EstadoEventos {
+    int linhas, colunas;
+    unsigned char* frequencias;
+    int* posicoes;
+    int32_t** xs, **ys;
+    int* numGrupo, *capGrupo;
+    uint32_t* contagens;
+    unsigned char* marcas;
+    int* tocadas;
+    int numTocadas;
+    int numAntenas, numEfeitos;
+} EstadoEventos;
+
+/**
+ * @brief Estrutura de dados para as estatísticas do processamento de eventos
+ * @struct EstatisticasEventos
+ * @param eventos Número de eventos lidos
+ * @param rejeitados Número de eventos inválidos ou que não puderam ser aplicados
+ * @param lotes Número de lotes fechados
+ * @param alteracoes Número de registos de alteração dos efeitos escritos (incluindo os efeitos iniciais)
+ * @param segundos Tempo decorrido desde o primeiro evento até ao fim da entrada
+ * @param eventosPorSegundo Débito médio
+ * @param latenciaP99 Percentil 99 da latência dos eventos (da leitura à escrita do seu lote), em microssegundos
+ */
+typedef struct EstatisticasEventos {
+    long long eventos, rejeitados;
+    long long lotes, alteracoes;
+    double segundos;
+    double eventosPorSegundo;
+    double latenciaP99;
+} EstatisticasEventos;
+
 #endif
\ No newline at end of file
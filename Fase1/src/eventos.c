@@ -0,0 +1,689 @@
+/**
+ * @file eventos.c
+ * @author Hugo Baptista
+ * @brief Implementação do processamento contínuo de eventos das antenas, com saída das alterações dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "saida.h"
+#include "eventos.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <io.h>
+#define ABRIR_LEITURA(nome) _open(nome, _O_RDONLY | _O_BINARY)
+#define LER_FD(fd, buf, n) _read(fd, buf, (unsigned int)(n))
+#define FECHAR_FD(fd) _close(fd)
+#define FD_ENTRADA 0
+#else
+#include <unistd.h>
+#include <poll.h>
+#define ABRIR_LEITURA(nome) open(nome, O_RDONLY)
+#define LER_FD(fd, buf, n) read(fd, buf, n)
+#define FECHAR_FD(fd) close(fd)
+#define FD_ENTRADA STDIN_FILENO
+#endif
+
+/**
+ * @brief Tamanho do bloco lido de cada vez da entrada
+ */
+#define TAMANHO_LEITURA (64 * 1024)
+/**
+ * @brief Número de subdivisões de cada potência de 2 no histograma de latências
+ */
+#define SUBDIVISOES_LATENCIA 16
+/**
+ * @brief Número de classes do histograma de latências
+ */
+#define CLASSES_LATENCIA (64 * SUBDIVISOES_LATENCIA)
+
+/**
+ * @brief Histograma logarítmico das latências dos eventos, em microssegundos
+ * @internal
+ * @param contagens Número de eventos de cada classe
+ * @param total Número de eventos no histograma
+ */
+typedef struct HistogramaLatencia {
+    uint64_t contagens[CLASSES_LATENCIA];
+    uint64_t total;
+} HistogramaLatencia;
+
+/**
+ * @brief Grupo de eventos de um lote lidos no mesmo bloco (com a mesma hora de chegada)
+ * @internal
+ * @param chegada Hora de leitura do bloco, em segundos
+ * @param num Número de eventos aplicados ou rejeitados do bloco
+ */
+typedef struct ChegadaEventos {
+    double chegada;
+    int num;
+} ChegadaEventos;
+
+/**
+ * @brief Devolve o tempo atual em segundos
+ * @internal
+ * @return double Tempo em segundos
+ */
+static double agora(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Devolve a posição do bit a 1 mais significativo de uma palavra não nula
+ * @internal
+ * @param v Palavra (diferente de 0)
+ * @return int Posição do bit mais significativo
+ */
+static inline int bitMaisAlto(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int x = 63;
+    while (!(v >> x & 1)) x--;
+    return x;
+#endif
+}
+
+/**
+ * @brief Acrescenta eventos com a mesma latência ao histograma
+ * @internal
+ * @param histograma Histograma a atualizar
+ * @param latencia Latência em microssegundos
+ * @param num Número de eventos
+ */
+static void registarLatencia(HistogramaLatencia* histograma, uint64_t latencia, int num) {
+    int classe;
+    if (latencia < SUBDIVISOES_LATENCIA) classe = (int)latencia;
+    else {
+        int e = bitMaisAlto(latencia);
+        classe = (e - 3) * SUBDIVISOES_LATENCIA + (int)((latencia >> (e - 4)) & (SUBDIVISOES_LATENCIA - 1));
+    }
+    histograma->contagens[classe] += (uint64_t)num;
+    histograma->total += (uint64_t)num;
+}
+
+/**
+ * @brief Calcula um percentil do histograma (o limite superior da classe onde cai)
+ * @internal
+ * @param histograma Histograma
+ * @param fracao Fração dos eventos abaixo do percentil (0.99 para o p99)
+ * @return double Percentil em microssegundos (0 se o histograma está vazio)
+ */
+static double percentilLatencia(const HistogramaLatencia* histograma, double fracao) {
+    if (histograma->total == 0) return 0.0;
+    uint64_t alvo = (uint64_t)(fracao * (double)histograma->total);
+    if (alvo < 1) alvo = 1;
+    uint64_t acumulado = 0;
+    for (int classe = 0; classe < CLASSES_LATENCIA; classe++) {
+        acumulado += histograma->contagens[classe];
+        if (acumulado < alvo) continue;
+        if (classe < SUBDIVISOES_LATENCIA) return (double)classe;
+        int e = classe / SUBDIVISOES_LATENCIA + 3, sub = classe % SUBDIVISOES_LATENCIA;
+        return (double)((((uint64_t)SUBDIVISOES_LATENCIA + sub + 1) << (e - 4)) - 1);
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Cria o estado do processamento de eventos a partir de uma lista de antenas
+ *
+ * As antenas são inseridas como eventos; as que estão fora do mapa ou numa posição já ocupada são ignoradas.
+ * Os efeitos das antenas iniciais ficam pendentes e são escritos pelo primeiro fecharLoteEventos.
+ *
+ * @param lista Lista de antenas iniciais
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return EstadoEventos* Apontador para o estado criado, ou NULL em caso de erro
+ */
+EstadoEventos* criarEstadoEventos(Antena* lista, int linhas, int colunas) {
+    if (linhas < 1 || colunas < 1) return NULL;
+    EstadoEventos* estado = (EstadoEventos*)calloc(1, sizeof(EstadoEventos));
+    if (!estado) {
+        fprintf(stderr, "Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    size_t celulas = (size_t)linhas * colunas;
+    estado->linhas = linhas;
+    estado->colunas = colunas;
+    estado->frequencias = (unsigned char*)calloc(celulas, sizeof(unsigned char));
+    estado->posicoes = (int*)malloc(celulas * sizeof(int));
+    estado->contagens = (uint32_t*)calloc(celulas, sizeof(uint32_t));
+    estado->marcas = (unsigned char*)calloc(celulas, sizeof(unsigned char));
+    estado->tocadas = (int*)malloc(celulas * sizeof(int));
+    estado->xs = (int32_t**)calloc(256, sizeof(int32_t*));
+    estado->ys = (int32_t**)calloc(256, sizeof(int32_t*));
+    estado->numGrupo = (int*)calloc(256, sizeof(int));
+    estado->capGrupo = (int*)calloc(256, sizeof(int));
+    if (!estado->frequencias || !estado->posicoes || !estado->contagens || !estado->marcas || !estado->tocadas ||
+        !estado->xs || !estado->ys || !estado->numGrupo || !estado->capGrupo) {
+        fprintf(stderr, "Erro ao alocar memoria!\n");
+        libertarEstadoEventos(estado);
+        return NULL;
+    }
+    for (Antena* a = lista; a; a = a->prox) {
+        EventoAntena evento = { EVENTO_INSERIR, a->frequencia, a->x, a->y, 0, 0 };
+        aplicarEvento(estado, &evento);
+    }
+    return estado;
+}
+
+/**
+ * @brief Liberta a memória alocada para o estado do processamento de eventos
+ *
+ * @param estado Estado a libertar
+ */
+void libertarEstadoEventos(EstadoEventos* estado) {
+    if (!estado) return;
+    for (int f = 0; f < 256; f++) {
+        if (estado->xs) free(estado->xs[f]);
+        if (estado->ys) free(estado->ys[f]);
+    }
+    free(estado->xs);
+    free(estado->ys);
+    free(estado->numGrupo);
+    free(estado->capGrupo);
+    free(estado->frequencias);
+    free(estado->posicoes);
+    free(estado->contagens);
+    free(estado->marcas);
+    free(estado->tocadas);
+    free(estado);
+}
+
+/**
+ * @brief Soma (ou subtrai) 1 à contagem de uma célula, marcando-a com o estado anterior se ainda não mudou no lote
+ * @internal
+ * @param e Estado do processamento
+ * @param c Célula
+ * @param sinal 1 para somar, -1 para subtrair
+ */
+static inline void alterarCelula(EstadoEventos* e, size_t c, int sinal) {
+    uint32_t* contagem = &e->contagens[c];
+    if (!e->marcas[c]) {
+        e->marcas[c] = (unsigned char)(1 + (*contagem > 0));
+        e->tocadas[e->numTocadas++] = (int)c;
+    }
+    if (sinal > 0) {
+        if ((*contagem)++ == 0) e->numEfeitos++;
+    } else {
+        if (--(*contagem) == 0) e->numEfeitos--;
+    }
+}
+
+/**
+ * @brief Soma (ou subtrai) às contagens os efeitos dos pares de uma antena com as antenas de um grupo
+ * @internal
+ * @param e Estado do processamento
+ * @param f Frequência do grupo
+ * @param x Coordenada x da antena (fora do grupo)
+ * @param y Coordenada y da antena
+ * @param sinal 1 para somar, -1 para subtrair
+ */
+static void alterarPares(EstadoEventos* e, int f, int x, int y, int sinal) {
+    const int32_t* xs = e->xs[f];
+    const int32_t* ys = e->ys[f];
+    int n = e->numGrupo[f];
+    unsigned linhas = (unsigned)e->linhas, colunas = (unsigned)e->colunas;
+    int x2 = 2 * x, y2 = 2 * y;
+    for (int j = 0; j < n; j++) {
+        // Os dois efeitos do par: 2 * (x, y) - p_j e 2 * p_j - (x, y)
+        unsigned ax = (unsigned)(x2 - xs[j]), ay = (unsigned)(y2 - ys[j]);
+        if (ax < colunas && ay < linhas) alterarCelula(e, (size_t)ay * colunas + ax, sinal);
+        unsigned bx = (unsigned)(2 * xs[j] - x), by = (unsigned)(2 * ys[j] - y);
+        if (bx < colunas && by < linhas) alterarCelula(e, (size_t)by * colunas + bx, sinal);
+    }
+}
+
+/**
+ * @brief Coloca uma antena numa célula livre, somando os efeitos dos novos pares
+ * @internal
+ * @param e Estado do processamento
+ * @param f Frequência da antena
+ * @param x Coordenada x da antena (dentro do mapa)
+ * @param y Coordenada y da antena (dentro do mapa)
+ * @return int 1 se a antena foi colocada, 0 em caso de erro
+ */
+static int colocarAntena(EstadoEventos* e, int f, int x, int y) {
+    if (e->numGrupo[f] == e->capGrupo[f]) {
+        int cap = e->capGrupo[f] > 0 ? 2 * e->capGrupo[f] : 16;
+        int32_t* xs = (int32_t*)realloc(e->xs[f], (size_t)cap * sizeof(int32_t));
+        if (xs) e->xs[f] = xs;
+        int32_t* ys = (int32_t*)realloc(e->ys[f], (size_t)cap * sizeof(int32_t));
+        if (ys) e->ys[f] = ys;
+        if (!xs || !ys) {
+            fprintf(stderr, "Erro ao alocar memoria!\n");
+            return 0;
+        }
+        e->capGrupo[f] = cap;
+    }
+    alterarPares(e, f, x, y, 1);
+    size_t c = (size_t)y * e->colunas + x;
+    int i = e->numGrupo[f]++;
+    e->xs[f][i] = x;
+    e->ys[f][i] = y;
+    e->frequencias[c] = (unsigned char)f;
+    e->posicoes[c] = i;
+    e->numAntenas++;
+    return 1;
+}
+
+/**
+ * @brief Retira a antena de uma célula, subtraindo os efeitos dos seus pares
+ * @internal
+ * A última antena do grupo passa para o lugar da antena retirada.
+ * @param e Estado do processamento
+ * @param c Célula ocupada
+ * @return int Frequência da antena retirada
+ */
+static int retirarAntena(EstadoEventos* e, size_t c) {
+    int f = e->frequencias[c];
+    int i = e->posicoes[c];
+    int x = e->xs[f][i], y = e->ys[f][i];
+    int ultima = --e->numGrupo[f];
+    if (i != ultima) {
+        e->xs[f][i] = e->xs[f][ultima];
+        e->ys[f][i] = e->ys[f][ultima];
+        e->posicoes[(size_t)e->ys[f][i] * e->colunas + e->xs[f][i]] = i;
+    }
+    e->frequencias[c] = 0;
+    e->numAntenas--;
+    alterarPares(e, f, x, y, -1);
+    return f;
+}
+
+/**
+ * @brief Aplica um evento às antenas e às contagens dos efeitos
+ *
+ * Só os pares da antena com as antenas da mesma frequência são somados ou subtraídos, pelo que o custo é
+ * proporcional ao tamanho do grupo da frequência. Mover uma antena é retirá-la e inseri-la na nova posição.
+ *
+ * @param estado Estado a alterar
+ * @param evento Evento a aplicar
+ * @return int 1 se o evento foi aplicado, 0 se foi rejeitado (posição fora do mapa, ocupada ou livre, frequência inválida)
+ */
+int aplicarEvento(EstadoEventos* estado, const EventoAntena* evento) {
+    if ((unsigned)evento->x >= (unsigned)estado->colunas || (unsigned)evento->y >= (unsigned)estado->linhas) return 0;
+    size_t c = (size_t)evento->y * estado->colunas + evento->x;
+    if (evento->tipo == EVENTO_INSERIR) {
+        unsigned char f = (unsigned char)evento->frequencia;
+        if (f <= ' ' || f == '.' || f == '#' || estado->frequencias[c]) return 0;
+        return colocarAntena(estado, f, evento->x, evento->y);
+    }
+    if (!estado->frequencias[c]) return 0;
+    if (evento->tipo == EVENTO_REMOVER) {
+        retirarAntena(estado, c);
+        return 1;
+    }
+    if (evento->tipo != EVENTO_MOVER) return 0;
+    if ((unsigned)evento->nx >= (unsigned)estado->colunas || (unsigned)evento->ny >= (unsigned)estado->linhas) return 0;
+    size_t destino = (size_t)evento->ny * estado->colunas + evento->nx;
+    if (destino == c) return 1;
+    if (estado->frequencias[destino]) return 0;
+    // O grupo acabou de perder a antena, pelo que colocarAntena não precisa de o fazer crescer
+    colocarAntena(estado, retirarAntena(estado, c), evento->nx, evento->ny);
+    return 1;
+}
+
+/**
+ * @brief Compara duas células pelo índice (y e depois x)
+ * @internal
+ * @param a Primeira célula
+ * @param b Segunda célula
+ * @return int Negativo, zero ou positivo, como em qsort
+ */
+static int compararCelulas(const void* a, const void* b) {
+    int ca = *(const int*)a, cb = *(const int*)b;
+    return (ca > cb) - (ca < cb);
+}
+
+/**
+ * @brief Fecha o lote atual e escreve as células que passaram a ter ou deixaram de ter efeitos nefastos
+ *
+ * Só as células cuja contagem mudou no lote são comparadas com o estado no início do lote, pelo que um
+ * efeito que aparece e desaparece dentro do mesmo lote não é escrito. Os registos seguem a ordem de y e
+ * depois de x: em texto, "+ x y" ou "- x y" por linha; em binário, TAMANHO_ALTERACAO_BINARIA bytes com o
+ * sinal ('+' ou '-'), um byte a 0 e x e y em 16 bits little-endian.
+ *
+ * @param estado Estado do processamento
+ * @param saida Saída onde escrever os registos
+ * @param binario 1 para o formato binário, 0 para texto
+ * @return int Número de registos escritos, ou -1 em caso de erro
+ */
+int fecharLoteEventos(EstadoEventos* estado, Saida* saida, int binario) {
+    size_t celulas = (size_t)estado->linhas * estado->colunas;
+    // Com muitas células alteradas, percorrer as marcas pela ordem das células sai mais barato do que ordenar
+    int percorrer = (size_t)estado->numTocadas * 16 > celulas;
+    if (!percorrer) qsort(estado->tocadas, (size_t)estado->numTocadas, sizeof(int), compararCelulas);
+    size_t num = percorrer ? celulas : (size_t)estado->numTocadas;
+    int escritos = 0;
+    for (size_t i = 0; i < num; i++) {
+        int c = percorrer ? (int)i : estado->tocadas[i];
+        if (!estado->marcas[c]) continue;
+        int antes = estado->marcas[c] - 1, depois = estado->contagens[c] > 0;
+        estado->marcas[c] = 0;
+        if (antes == depois) continue;
+        int x = c % estado->colunas, y = c / estado->colunas;
+        if (binario) {
+            char registo[TAMANHO_ALTERACAO_BINARIA] = {
+                depois ? '+' : '-', 0,
+                (char)(x & 0xFF), (char)(x >> 8 & 0xFF),
+                (char)(y & 0xFF), (char)(y >> 8 & 0xFF)
+            };
+            escreverBytes(saida, registo, sizeof(registo));
+        } else {
+            escreverBytes(saida, depois ? "+ " : "- ", 2);
+            escreverInteiro(saida, x);
+            escreverCaracter(saida, ' ');
+            escreverInteiro(saida, y);
+            escreverCaracter(saida, '\n');
+        }
+        escritos++;
+    }
+    estado->numTocadas = 0;
+    return saida->erro ? -1 : escritos;
+}
+
+/**
+ * @brief Lê um inteiro não negativo de texto, saltando os espaços antes dele
+ * @internal
+ * @param p Posição atual (avança para depois do número)
+ * @param fim Fim do texto
+ * @param valor Valor lido
+ * @return int 1 se foi lido um número, 0 caso contrário
+ */
+static int lerNumero(const char** p, const char* fim, int* valor) {
+    const char* s = *p;
+    while (s < fim && (*s == ' ' || *s == '\t')) s++;
+    if (s == fim || *s < '0' || *s > '9') return 0;
+    long v = 0;
+    while (s < fim && *s >= '0' && *s <= '9') {
+        v = v * 10 + (*s++ - '0');
+        if (v > 0x7FFFFFFF) return 0;
+    }
+    *valor = (int)v;
+    *p = s;
+    return 1;
+}
+
+/**
+ * @brief Lê um evento de uma linha de texto
+ * @internal
+ * @param linha Início da linha
+ * @param fim Fim da linha (sem o '\n')
+ * @param evento Evento lido
+ * @return int 1 se a linha tem um evento, 0 se é inválida, -1 se está vazia
+ */
+static int lerEventoTexto(const char* linha, const char* fim, EventoAntena* evento) {
+    while (fim > linha && (fim[-1] == '\r' || fim[-1] == ' ' || fim[-1] == '\t')) fim--;
+    while (linha < fim && (*linha == ' ' || *linha == '\t')) linha++;
+    if (linha == fim) return -1;
+    evento->tipo = *linha++;
+    evento->frequencia = 0;
+    evento->nx = evento->ny = 0;
+    if (evento->tipo == EVENTO_INSERIR) {
+        while (linha < fim && (*linha == ' ' || *linha == '\t')) linha++;
+        if (linha == fim) return 0;
+        evento->frequencia = *linha++;
+    } else if (evento->tipo != EVENTO_MOVER && evento->tipo != EVENTO_REMOVER) return 0;
+    if (!lerNumero(&linha, fim, &evento->x) || !lerNumero(&linha, fim, &evento->y)) return 0;
+    if (evento->tipo == EVENTO_MOVER && (!lerNumero(&linha, fim, &evento->nx) || !lerNumero(&linha, fim, &evento->ny))) return 0;
+    return linha == fim;
+}
+
+/**
+ * @brief Lê um evento no formato binário
+ * @internal
+ * @param registo TAMANHO_EVENTO_BINARIO bytes do evento
+ * @param evento Evento lido
+ */
+static void lerEventoBinario(const unsigned char* registo, EventoAntena* evento) {
+    evento->tipo = (char)registo[0];
+    evento->frequencia = (char)registo[1];
+    evento->x = registo[2] | registo[3] << 8;
+    evento->y = registo[4] | registo[5] << 8;
+    evento->nx = registo[6] | registo[7] << 8;
+    evento->ny = registo[8] | registo[9] << 8;
+}
+
+/**
+ * @brief Acrescenta ao lote um bloco de eventos lidos ao mesmo tempo
+ * @internal
+ * @param chegadas Vetor dos blocos do lote (pode ser realocado)
+ * @param num Número de blocos no vetor
+ * @param cap Capacidade do vetor
+ * @param chegada Hora de leitura do bloco, em segundos
+ * @param eventos Número de eventos do bloco
+ * @return int 1 se o bloco foi acrescentado, 0 em caso de erro
+ */
+static int acrescentarChegada(ChegadaEventos** chegadas, int* num, int* cap, double chegada, int eventos) {
+    if (*num == *cap) {
+        ChegadaEventos* novas = (ChegadaEventos*)realloc(*chegadas, (size_t)*cap * 2 * sizeof(ChegadaEventos));
+        if (!novas) {
+            fprintf(stderr, "Erro ao alocar memoria!\n");
+            return 0;
+        }
+        *chegadas = novas;
+        *cap *= 2;
+    }
+    (*chegadas)[*num].chegada = chegada;
+    (*chegadas)[*num].num = eventos;
+    (*num)++;
+    return 1;
+}
+
+/**
+ * @brief Fecha o lote, despeja a saída e regista a latência dos eventos do lote
+ * @internal
+ * @param estado Estado do processamento
+ * @param saida Saída dos registos
+ * @param binario 1 para o formato binário, 0 para texto
+ * @param chegadas Blocos de eventos do lote
+ * @param numChegadas Número de blocos (passa a 0)
+ * @param histograma Histograma das latências
+ * @param estatisticas Estatísticas a atualizar
+ * @return int 1 se o lote foi escrito, 0 em caso de erro
+ */
+static int despacharLote(EstadoEventos* estado, Saida* saida, int binario, ChegadaEventos* chegadas, int* numChegadas,
+                         HistogramaLatencia* histograma, EstatisticasEventos* estatisticas) {
+    int escritos = fecharLoteEventos(estado, saida, binario);
+    if (escritos < 0 || !despejarSaida(saida)) return 0;
+    double fim = agora();
+    for (int i = 0; i < *numChegadas; i++) {
+        double latencia = (fim - chegadas[i].chegada) * 1e6;
+        registarLatencia(histograma, latencia > 0 ? (uint64_t)latencia : 0, chegadas[i].num);
+    }
+    *numChegadas = 0;
+    estatisticas->lotes++;
+    estatisticas->alteracoes += escritos;
+    return 1;
+}
+
+/**
+ * @brief Lê eventos de um ficheiro ou do stdin, aplica-os em lotes e escreve as alterações dos efeitos nefastos
+ *
+ * Em texto, cada linha tem um evento: "A f x y" insere, "M x y nx ny" move e "R x y" remove; as linhas
+ * vazias são ignoradas. Em binário, cada evento tem TAMANHO_EVENTO_BINARIO bytes: o tipo ('A', 'M' ou 'R'),
+ * a frequência e x, y, nx, ny em 16 bits little-endian, seguidos de dois bytes a 0. Um lote é fechado
+ * quando o seu primeiro evento já espera há janela microssegundos, quando não chegam mais dados dentro da
+ * janela, quando tem MAX_LOTE_EVENTOS eventos ou no fim da entrada; antes do primeiro lote são escritos os
+ * efeitos do mapa inicial. A latência de cada evento vai da leitura do bloco que o trouxe à escrita do seu
+ * lote e é acumulada num histograma logarítmico (erro inferior a 1/16), pelo que a memória não cresce com
+ * o número de eventos.
+ *
+ * @param mapa Nome do ficheiro com o mapa inicial (dimensões e antenas)
+ * @param entrada Nome do ficheiro com os eventos, ou NULL para o stdin
+ * @param saidaFicheiro Nome do ficheiro a escrever, ou NULL para a consola
+ * @param binario 1 para eventos e registos binários, 0 para texto
+ * @param janela Janela de latência de cada lote, em microssegundos
+ * @param estatisticas Estatísticas do processamento (saída, pode ser NULL)
+ * @return int 1 se a entrada foi processada até ao fim, 0 em caso de erro
+ * @attention Em Windows não há espera com poll, pelo que cada bloco lido fecha o lote
+ * @attention As mensagens de erro vão para o stderr, para não se misturarem com as alterações escritas no stdout
+ */
+int processarEventos(const char* mapa, const char* entrada, const char* saidaFicheiro, int binario, long janela, EstatisticasEventos* estatisticas) {
+    EstatisticasEventos local;
+    if (!estatisticas) estatisticas = &local;
+    memset(estatisticas, 0, sizeof(EstatisticasEventos));
+    // O stdout pode ser a saída das alterações: um mapa que não abre é assinalado aqui, no stderr,
+    // antes de contarLinhas e carregarAntenas escreverem o erro na consola
+    FILE* ficheiroMapa = fopen(mapa, "r");
+    if (!ficheiroMapa) {
+        fprintf(stderr, "Erro ao abrir o ficheiro!\n");
+        return 0;
+    }
+    fclose(ficheiroMapa);
+    int linhas = contarLinhas(mapa), colunas = contarColunas(mapa);
+    if (binario && (linhas > 65536 || colunas > 65536)) {
+        fprintf(stderr, "Mapa demasiado grande para o formato binario!\n");
+        return 0;
+    }
+    Antena* lista = carregarAntenas(mapa);
+    EstadoEventos* estado = criarEstadoEventos(lista, linhas, colunas);
+    while (lista) {
+        Antena* seguinte = lista->prox;
+        free(lista);
+        lista = seguinte;
+    }
+    if (!estado) return 0;
+
+    int fd = entrada ? ABRIR_LEITURA(entrada) : FD_ENTRADA;
+    if (fd < 0) {
+        fprintf(stderr, "Erro ao abrir o ficheiro!\n");
+        libertarEstadoEventos(estado);
+        return 0;
+    }
+    Saida saida;
+    int aberta = binario ? abrirSaidaBinaria(&saida, saidaFicheiro) : abrirSaida(&saida, saidaFicheiro);
+    char* buffer = (char*)malloc(TAMANHO_LEITURA + 1);
+    HistogramaLatencia* histograma = (HistogramaLatencia*)calloc(1, sizeof(HistogramaLatencia));
+    int capChegadas = 64, numChegadas = 0;
+    ChegadaEventos* chegadas = (ChegadaEventos*)malloc((size_t)capChegadas * sizeof(ChegadaEventos));
+    if (!aberta || !buffer || !histograma || !chegadas) {
+        if (aberta) fecharSaida(&saida);
+        else fprintf(stderr, "Erro ao abrir o ficheiro!\n");
+        if (entrada) FECHAR_FD(fd);
+        free(buffer);
+        free(histograma);
+        free(chegadas);
+        libertarEstadoEventos(estado);
+        return 0;
+    }
+
+    // Os efeitos do mapa inicial são o primeiro lote, antes de qualquer evento
+    int ok = fecharLoteEventos(estado, &saida, binario) >= 0 && despejarSaida(&saida);
+    int pendentes = 0, fimEntrada = 0;
+    size_t usados = 0;
+    double inicio = 0.0;
+    while (ok && !fimEntrada) {
+#ifndef _WIN32
+        // Com eventos pendentes, só se espera por mais dados até a janela do lote acabar
+        if (pendentes > 0) {
+            double espera = janela / 1e6 - (agora() - chegadas[0].chegada);
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            if (espera <= 0 || poll(&pfd, 1, (int)(espera * 1000 + 0.999)) == 0) {
+                ok = despacharLote(estado, &saida, binario, chegadas, &numChegadas, histograma, estatisticas);
+                pendentes = 0;
+                continue;
+            }
+        }
+#endif
+        long lidos = (long)LER_FD(fd, buffer + usados, TAMANHO_LEITURA - usados);
+        if (lidos < 0) {
+            if (errno == EINTR) continue;
+            ok = 0;
+            break;
+        }
+        double chegada = agora();
+        if (inicio == 0.0) inicio = chegada;
+        if (lidos == 0) {
+            // Uma última linha sem '\n' ainda conta como evento
+            fimEntrada = 1;
+            if (binario || usados == 0) break;
+            buffer[usados++] = '\n';
+        } else usados += (size_t)lidos;
+
+        size_t pos = 0;
+        int doBloco = 0;
+        while (ok) {
+            EventoAntena evento;
+            int lido;
+            if (binario) {
+                if (usados - pos < TAMANHO_EVENTO_BINARIO) break;
+                lerEventoBinario((const unsigned char*)buffer + pos, &evento);
+                pos += TAMANHO_EVENTO_BINARIO;
+                lido = 1;
+            } else {
+                char* fimLinha = (char*)memchr(buffer + pos, '\n', usados - pos);
+                if (!fimLinha) break;
+                lido = lerEventoTexto(buffer + pos, fimLinha, &evento);
+                pos = (size_t)(fimLinha - buffer) + 1;
+                if (lido < 0) continue;
+            }
+            estatisticas->eventos++;
+            if (!lido || !aplicarEvento(estado, &evento)) estatisticas->rejeitados++;
+            pendentes++;
+            doBloco++;
+            // Num bloco grande, a janela também é verificada a cada 256 eventos
+            if (pendentes < MAX_LOTE_EVENTOS && (pendentes % 256 != 0 ||
+                agora() - (numChegadas > 0 ? chegadas[0].chegada : chegada) < janela / 1e6)) continue;
+            ok = acrescentarChegada(&chegadas, &numChegadas, &capChegadas, chegada, doBloco) &&
+                 despacharLote(estado, &saida, binario, chegadas, &numChegadas, histograma, estatisticas);
+            pendentes = doBloco = 0;
+        }
+        if (ok && doBloco > 0) ok = acrescentarChegada(&chegadas, &numChegadas, &capChegadas, chegada, doBloco);
+        memmove(buffer, buffer + pos, usados - pos);
+        usados -= pos;
+        if (!binario && usados == TAMANHO_LEITURA) {
+            // Uma linha que não cabe no bloco não é um evento válido: é descartada
+            estatisticas->eventos++;
+            estatisticas->rejeitados++;
+            usados = 0;
+        }
+#ifdef _WIN32
+        if (ok && pendentes > 0) {
+            ok = despacharLote(estado, &saida, binario, chegadas, &numChegadas, histograma, estatisticas);
+            pendentes = 0;
+        }
+#endif
+    }
+    if (ok && pendentes > 0) ok = despacharLote(estado, &saida, binario, chegadas, &numChegadas, histograma, estatisticas);
+
+    estatisticas->segundos = inicio > 0.0 ? agora() - inicio : 0.0;
+    estatisticas->eventosPorSegundo = estatisticas->segundos > 0.0 ? estatisticas->eventos / estatisticas->segundos : 0.0;
+    estatisticas->latenciaP99 = percentilLatencia(histograma, 0.99);
+    if (!fecharSaida(&saida)) ok = 0;
+    if (entrada) FECHAR_FD(fd);
+    free(buffer);
+    free(histograma);
+    free(chegadas);
+    libertarEstadoEventos(estado);
+    return ok;
+}
+
+/**
+ * @brief Escreve as estatísticas do processamento de eventos no stderr
+ *
+ * @param estatisticas Estatísticas a escrever
+ */
+void imprimirEstatisticasEventos(const EstatisticasEventos* estatisticas) {
+    fprintf(stderr, "Eventos: %lld (rejeitados: %lld)\n", estatisticas->eventos, estatisticas->rejeitados);
+    fprintf(stderr, "Lotes: %lld, alteracoes dos efeitos: %lld\n", estatisticas->lotes, estatisticas->alteracoes);
+    fprintf(stderr, "Tempo: %.3f s, debito: %.0f eventos/s\n", estatisticas->segundos, estatisticas->eventosPorSegundo);
+    fprintf(stderr, "Latencia p99: %.0f us\n", estatisticas->latenciaP99);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file eventos.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do processamento contínuo de eventos das antenas, com saída das alterações dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include "estruturas.h"
+#include "saida.h"
+
+/**
+ * @brief Janela de latência por omissão, em microssegundos
+ */
+#define JANELA_EVENTOS 1000
+/**
+ * @brief Número máximo de eventos de um lote
+ */
+#define MAX_LOTE_EVENTOS 65536
+/**
+ * @brief Tamanho de um evento no formato binário, em bytes
+ */
+#define TAMANHO_EVENTO_BINARIO 12
+/**
+ * @brief Tamanho de um registo de alteração no formato binário, em bytes
+ */
+#define TAMANHO_ALTERACAO_BINARIA 6
+
+/**
+ * @brief Cria o estado do processamento de eventos a partir de uma lista de antenas
+ *
+ * As antenas são inseridas como eventos; as que estão fora do mapa ou numa posição já ocupada são ignoradas.
+ * Os efeitos das antenas iniciais ficam pendentes e são escritos pelo primeiro fecharLoteEventos.
+ *
+ * @param lista Lista de antenas iniciais
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return EstadoEventos* Apontador para o estado criado, ou NULL em caso de erro
+ */
+EstadoEventos* criarEstadoEventos(Antena* lista, int linhas, int colunas);
+/**
+ * @brief Liberta a memória alocada para o estado do processamento de eventos
+ *
+ * @param estado Estado a libertar
+ */
+void libertarEstadoEventos(EstadoEventos* estado);
+/**
+ * @brief Aplica um evento às antenas e às contagens dos efeitos
+ *
+ * Só os pares da antena com as antenas da mesma frequência são somados ou subtraídos, pelo que o custo é
+ * proporcional ao tamanho do grupo da frequência. Mover uma antena é retirá-la e inseri-la na nova posição.
+ *
+ * @param estado Estado a alterar
+ * @param evento Evento a aplicar
+ * @return int 1 se o evento foi aplicado, 0 se foi rejeitado (posição fora do mapa, ocupada ou livre, frequência inválida)
+ */
+int aplicarEvento(EstadoEventos* estado, const EventoAntena* evento);
+/**
+ * @brief Fecha o lote atual e escreve as células que passaram a ter ou deixaram de ter efeitos nefastos
+ *
+ * Só as células cuja contagem mudou no lote são comparadas com o estado no início do lote, pelo que um
+ * efeito que aparece e desaparece dentro do mesmo lote não é escrito. Os registos seguem a ordem de y e
+ * depois de x: em texto, "+ x y" ou "- x y" por linha; em binário, TAMANHO_ALTERACAO_BINARIA bytes com o
+ * sinal ('+' ou '-'), um byte a 0 e x e y em 16 bits little-endian.
+ *
+ * @param estado Estado do processamento
+ * @param saida Saída onde escrever os registos
+ * @param binario 1 para o formato binário, 0 para texto
+ * @return int Número de registos escritos, ou -1 em caso de erro
+ */
+int fecharLoteEventos(EstadoEventos* estado, Saida* saida, int binario);
+/**
+ * @brief Lê eventos de um ficheiro ou do stdin, aplica-os em lotes e escreve as alterações dos efeitos nefastos
+ *
+ * Em texto, cada linha tem um evento: "A f x y" insere, "M x y nx ny" move e "R x y" remove; as linhas
+ * vazias são ignoradas. Em binário, cada evento tem TAMANHO_EVENTO_BINARIO bytes: o tipo ('A', 'M' ou 'R'),
+ * a frequência e x, y, nx, ny em 16 bits little-endian, seguidos de dois bytes a 0. Um lote é fechado
+ * quando o seu primeiro evento já espera há janela microssegundos, quando não chegam mais dados dentro da
+ * janela, quando tem MAX_LOTE_EVENTOS eventos ou no fim da entrada; antes do primeiro lote são escritos os
+ * efeitos do mapa inicial. A latência de cada evento vai da leitura do bloco que o trouxe à escrita do seu
+ * lote e é acumulada num histograma logarítmico (erro inferior a 1/16), pelo que a memória não cresce com
+ * o número de eventos.
+ *
+ * @param mapa Nome do ficheiro com o mapa inicial (dimensões e antenas)
+ * @param entrada Nome do ficheiro com os eventos, ou NULL para o stdin
+ * @param saidaFicheiro Nome do ficheiro a escrever, ou NULL para a consola
+ * @param binario 1 para eventos e registos binários, 0 para texto
+ * @param janela Janela de latência de cada lote, em microssegundos
+ * @param estatisticas Estatísticas do processamento (saída, pode ser NULL)
+ * @return int 1 se a entrada foi processada até ao fim, 0 em caso de erro
+ * @attention Em Windows não há espera com poll, pelo que cada bloco lido fecha o lote
+ * @attention As mensagens de erro vão para o stderr, para não se misturarem com as alterações escritas no stdout
+ */
+int processarEventos(const char* mapa, const char* entrada, const char* saidaFicheiro, int binario, long janela, EstatisticasEventos* estatisticas);
+/**
+ * @brief Escreve as estatísticas do processamento de eventos no stderr
+ *
+ * @param estatisticas Estatísticas a escrever
+ */
+void imprimirEstatisticasEventos(const EstatisticasEventos* estatisticas);
+
+#endif
@@ -0,0 +1,464 @@
+/**
+ * @file externo.c
+ * @author Hugo Baptista
+ * @brief Implementação do cálculo dos efeitos nefastos fora de memória, para mapas muito grandes
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "saida.h"
+#include "externo.h"
+
+#ifdef _WIN32
+#define POSICIONAR(f, pos) _fseeki64(f, (long long)(pos), SEEK_SET)
+#else
+#include <sys/types.h>
+#define POSICIONAR(f, pos) fseeko(f, (off_t)(pos), SEEK_SET)
+#endif
+
+/**
+ * @brief Tamanho do buffer de leitura do mapa (1 MiB)
+ */
+#define TAMANHO_LEITURA (1 << 20)
+
+/**
+ * @brief Corrida de chaves ordenadas e sem repetições guardada num ficheiro temporário
+ * @internal
+ */
+typedef struct Corrida {
+    uint64_t inicio; /**< Posição (em chaves) do início da corrida no ficheiro. */
+    uint64_t num; /**< Número de chaves da corrida. */
+} Corrida;
+
+/**
+ * @brief Leitor de uma corrida durante a fusão
+ * @internal
+ */
+typedef struct LeitorCorrida {
+    uint64_t posicao; /**< Próxima chave a ler do ficheiro. */
+    uint64_t restantes; /**< Chaves ainda por ler do ficheiro. */
+    uint64_t* buffer; /**< Chaves lidas. */
+    size_t num; /**< Número de chaves no buffer. */
+    size_t atual; /**< Próxima chave do buffer. */
+} LeitorCorrida;
+
+/**
+ * @brief Lê o mapa em blocos, contando as antenas de cada frequência ou guardando as suas coordenadas
+ * @internal
+ * @param file Ficheiro do mapa (já aberto, no início)
+ * @param buffer Buffer de leitura com TAMANHO_LEITURA bytes
+ * @param contagens Número de antenas de cada frequência (incrementado), ou NULL
+ * @param coordenadas Coordenadas (x, y) das antenas, agrupadas por frequência, ou NULL
+ * @param posicoes Próxima posição livre de cada frequência em coordenadas (atualizada), ou NULL
+ * @param linhas Número de linhas do mapa (saída)
+ * @param colunas Comprimento da linha mais comprida (saída)
+ */
+static void percorrerMapa(FILE* file, char* buffer, uint64_t* contagens, int32_t* coordenadas, uint64_t* posicoes, int* linhas, int* colunas) {
+    int x = 0, y = 0;
+    size_t lidos;
+    *colunas = 0;
+    while ((lidos = fread(buffer, 1, TAMANHO_LEITURA, file)) > 0) {
+        for (size_t i = 0; i < lidos; i++) {
+            char c = buffer[i];
+            if (c == '\n') {
+                if (x > *colunas) *colunas = x;
+                x = 0;
+                y++;
+                continue;
+            }
+            if (c != '.' && c != '#') {
+                unsigned char f = (unsigned char)c;
+                if (contagens) contagens[f]++;
+                if (coordenadas) {
+                    uint64_t p = posicoes[f]++;
+                    coordenadas[2 * p] = x;
+                    coordenadas[2 * p + 1] = y;
+                }
+            }
+            x++;
+        }
+    }
+    if (x > *colunas) *colunas = x;
+    *linhas = y + 1; // Como em contarLinhas: um fim de linha no fim do ficheiro abre uma linha vazia
+}
+
+/**
+ * @brief Ordena um vetor de chaves (radix sort LSD com dígitos de 11 bits)
+ * @internal
+ * Os dígitos iguais em todas as chaves são saltados, pelo que as chaves de mapas pequenos só precisam de poucas passagens.
+ * @param chaves Chaves a ordenar
+ * @param aux Vetor auxiliar com espaço para num chaves
+ * @param num Número de chaves
+ */
+static void ordenarChaves(uint64_t* chaves, uint64_t* aux, size_t num) {
+    size_t contagens[6][2048] = {{0}};
+    for (size_t i = 0; i < num; i++) {
+        for (int d = 0; d < 6; d++) contagens[d][(chaves[i] >> (11 * d)) & 2047]++;
+    }
+    uint64_t* origem = chaves, *destino = aux;
+    for (int d = 0; d < 6; d++) {
+        if (num == 0 || contagens[d][(chaves[0] >> (11 * d)) & 2047] == num) continue; // Dígito constante
+        size_t soma = 0;
+        for (int b = 0; b < 2048; b++) {
+            size_t c = contagens[d][b];
+            contagens[d][b] = soma;
+            soma += c;
+        }
+        for (size_t i = 0; i < num; i++) destino[contagens[d][(origem[i] >> (11 * d)) & 2047]++] = origem[i];
+        uint64_t* t = origem;
+        origem = destino;
+        destino = t;
+    }
+    if (origem != chaves) memcpy(chaves, origem, num * sizeof(uint64_t));
+}
+
+/**
+ * @brief Ordena as chaves, retira as repetidas e escreve-as no fim do ficheiro temporário como uma corrida
+ * @internal
+ * @param temporario Ficheiro temporário
+ * @param fim Número de chaves já escritas no ficheiro (atualizado)
+ * @param chaves Chaves a escrever (o vetor é reordenado)
+ * @param aux Vetor auxiliar com espaço para num chaves
+ * @param num Número de chaves
+ * @param corrida Corrida escrita (saída)
+ * @return int 1 se a corrida foi escrita com sucesso, 0 caso contrário
+ */
+static int escreverCorrida(FILE* temporario, uint64_t* fim, uint64_t* chaves, uint64_t* aux, size_t num, Corrida* corrida) {
+    ordenarChaves(chaves, aux, num);
+    size_t unicas = 0;
+    for (size_t i = 0; i < num; i++) {
+        if (unicas == 0 || chaves[i] != chaves[unicas - 1]) chaves[unicas++] = chaves[i];
+    }
+    corrida->inicio = *fim;
+    corrida->num = unicas;
+    if (POSICIONAR(temporario, *fim * sizeof(uint64_t)) != 0) return 0;
+    if (fwrite(chaves, sizeof(uint64_t), unicas, temporario) != unicas) return 0;
+    *fim += unicas;
+    return 1;
+}
+
+/**
+ * @brief Lê as chaves seguintes de uma corrida para o buffer do leitor
+ * @internal
+ * @param temporario Ficheiro temporário
+ * @param leitor Leitor da corrida
+ * @param cap Capacidade do buffer do leitor
+ * @return int 1 se o buffer ficou com chaves, 0 se a corrida acabou, -1 em caso de erro de leitura
+ */
+static int encherLeitor(FILE* temporario, LeitorCorrida* leitor, size_t cap) {
+    leitor->atual = 0;
+    leitor->num = 0;
+    if (leitor->restantes == 0) return 0;
+    size_t pedir = leitor->restantes < cap ? (size_t)leitor->restantes : cap;
+    if (POSICIONAR(temporario, leitor->posicao * sizeof(uint64_t)) != 0) return -1;
+    leitor->num = fread(leitor->buffer, sizeof(uint64_t), pedir, temporario);
+    leitor->posicao += leitor->num;
+    leitor->restantes -= leitor->num;
+    // A corrida ainda tinha chaves: ler menos do que as pedidas é um erro, e não o fim da corrida
+    if (leitor->num < pedir || ferror(temporario)) return -1;
+    return 1;
+}
+
+/**
+ * @brief Escreve um efeito nefasto com o formato da tabela de efeitos de guardarListas
+ * @internal
+ * @param saida Saída onde escrever
+ * @param chave Chave do efeito (y nos 32 bits altos, x nos baixos)
+ */
+static void escreverChave(Saida* saida, uint64_t chave) {
+    escreverBytes(saida, "# |  (X:", 8);
+    escreverInteiro(saida, (int)(uint32_t)chave);
+    escreverBytes(saida, ", Y:", 4);
+    escreverInteiro(saida, (int)(chave >> 32));
+    escreverBytes(saida, ")\n", 2);
+}
+
+/**
+ * @brief Funde corridas do ficheiro temporário, sem repetições, numa nova corrida ou na saída de texto
+ * @internal
+ * @param temporario Ficheiro temporário com as corridas
+ * @param corridas Corridas a fundir
+ * @param num Número de corridas
+ * @param memoria Memória para os buffers dos leitores
+ * @param capMemoria Capacidade da memória (em chaves)
+ * @param destino Ficheiro onde acrescentar a corrida resultante, ou NULL para escrever na saída
+ * @param fimDestino Número de chaves já escritas em destino (atualizado)
+ * @param saida Saída de texto (usada quando destino é NULL)
+ * @param resultado Corrida resultante em destino (saída)
+ * @return long long Número de chaves escritas, ou -1 em caso de erro
+ * @attention Os erros de leitura e de escrita do ficheiro temporário são escritos aqui
+ */
+static long long fundirCorridas(FILE* temporario, const Corrida* corridas, int num, uint64_t* memoria, size_t capMemoria,
+                                FILE* destino, uint64_t* fimDestino, Saida* saida, Corrida* resultado) {
+    LeitorCorrida* leitores = (LeitorCorrida*)malloc((size_t)num * sizeof(LeitorCorrida));
+    int* heap = (int*)malloc((size_t)num * sizeof(int));
+    if (!leitores || !heap) {
+        printf("Erro ao alocar memoria!\n");
+        free(leitores);
+        free(heap);
+        return -1;
+    }
+    size_t cap = capMemoria / (size_t)num;
+    int numHeap = 0, erroLeitura = 0;
+    for (int r = 0; r < num; r++) {
+        leitores[r].posicao = corridas[r].inicio;
+        leitores[r].restantes = corridas[r].num;
+        leitores[r].buffer = memoria + (size_t)r * cap;
+        int lido = encherLeitor(temporario, &leitores[r], cap);
+        if (lido < 0) {
+            erroLeitura = 1;
+            numHeap = 0;
+            break;
+        }
+        if (!lido) continue;
+        // Insere no min-heap pela chave atual de cada leitor
+        int i = numHeap++;
+        uint64_t chave = leitores[r].buffer[0];
+        while (i > 0 && leitores[heap[(i - 1) / 2]].buffer[leitores[heap[(i - 1) / 2]].atual] > chave) {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap[i] = r;
+    }
+    int erroEscrita = 0;
+    if (destino) {
+        resultado->inicio = *fimDestino;
+        resultado->num = 0;
+        if (!erroLeitura && POSICIONAR(destino, *fimDestino * sizeof(uint64_t)) != 0) {
+            erroEscrita = 1;
+            numHeap = 0;
+        }
+    }
+
+    long long escritas = 0;
+    int temAnterior = 0;
+    uint64_t anterior = 0;
+    while (numHeap > 0) {
+        LeitorCorrida* topo = &leitores[heap[0]];
+        uint64_t chave = topo->buffer[topo->atual++];
+        if (!temAnterior || chave != anterior) {
+            if (destino) {
+                if (fwrite(&chave, sizeof(uint64_t), 1, destino) != 1) {
+                    erroEscrita = 1;
+                    break;
+                }
+            } else {
+                escreverChave(saida, chave);
+            }
+            escritas++;
+            anterior = chave;
+            temAnterior = 1;
+        }
+        int r = heap[0];
+        if (topo->atual == topo->num) {
+            int lido = encherLeitor(temporario, topo, cap);
+            if (lido < 0) {
+                erroLeitura = 1;
+                break;
+            }
+            if (!lido) {
+                if (--numHeap == 0) break;
+                r = heap[numHeap];
+            }
+        }
+        // Desce o leitor r a partir da raiz
+        uint64_t valor = leitores[r].buffer[leitores[r].atual];
+        int i = 0;
+        for (;;) {
+            int f = 2 * i + 1;
+            if (f >= numHeap) break;
+            if (f + 1 < numHeap && leitores[heap[f + 1]].buffer[leitores[heap[f + 1]].atual] < leitores[heap[f]].buffer[leitores[heap[f]].atual]) f++;
+            if (leitores[heap[f]].buffer[leitores[heap[f]].atual] >= valor) break;
+            heap[i] = heap[f];
+            i = f;
+        }
+        heap[i] = r;
+    }
+    if (erroLeitura) printf("Erro ao ler o ficheiro temporario!\n");
+    else if (erroEscrita) printf("Erro ao escrever o ficheiro temporario!\n");
+    if (erroLeitura || erroEscrita) escritas = -1;
+    if (destino && escritas >= 0) {
+        resultado->num = (uint64_t)escritas;
+        *fimDestino += (uint64_t)escritas;
+    }
+    free(leitores);
+    free(heap);
+    return escritas;
+}
+
+/**
+ * @brief Calcula os efeitos nefastos de um mapa guardado em ficheiro sem o carregar para memória
+ *
+ * O mapa é lido duas vezes em blocos: a primeira leitura conta as antenas de cada frequência e a
+ * segunda guarda só as suas coordenadas, agrupadas por frequência. Os efeitos são gerados para um
+ * buffer de chaves (y, x); sempre que o buffer enche é ordenado, sem repetições, e escrito como uma
+ * corrida num ficheiro temporário. No fim as corridas são fundidas (em várias passagens, se não
+ * couberem todas no orçamento) e os efeitos são escritos por ordem de y e depois de x, sem repetições,
+ * com o formato da tabela de efeitos de guardarListas.
+ *
+ * @param filename Nome do ficheiro do mapa
+ * @param saidaFicheiro Nome do ficheiro onde escrever os efeitos
+ * @param orcamento Memória (em bytes) para as coordenadas das antenas e para os buffers de ordenação e fusão
+ * @return long long Número de efeitos nefastos escritos, ou -1 em caso de erro
+ * @attention O mapa tem tantas linhas como em contarLinhas (fins de linha mais 1, mas sem o limite de MAX_LINHAS)
+ * e tantas colunas como a linha mais comprida do ficheiro;
+ * só são considerados os efeitos dentro do mapa, como em detetarEfeitosNefastosMapa. As linhas não são
+ * divididas aos 99 caracteres, ao contrário de carregarAntenas
+ */
+long long detetarEfeitosNefastosExterno(const char* filename, const char* saidaFicheiro, size_t orcamento) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return -1;
+    }
+    char* leitura = (char*)malloc(TAMANHO_LEITURA);
+    if (!leitura) {
+        printf("Erro ao alocar memoria!\n");
+        fclose(file);
+        return -1;
+    }
+
+    // Primeira leitura: antenas por frequência; segunda leitura: coordenadas agrupadas por frequência
+    uint64_t inicioFreq[257] = {0}, posicoes[256];
+    int linhas, colunas;
+    percorrerMapa(file, leitura, inicioFreq + 1, NULL, NULL, &linhas, &colunas);
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    uint64_t numAntenas = inicioFreq[256];
+    size_t bytesAntenas = (size_t)numAntenas * 2 * sizeof(int32_t);
+    if (orcamento < bytesAntenas || (orcamento - bytesAntenas) / (2 * sizeof(uint64_t)) < MIN_CHAVES) {
+        printf("Orcamento de memoria insuficiente!\n");
+        free(leitura);
+        fclose(file);
+        return -1;
+    }
+    size_t capMemoria = (orcamento - bytesAntenas) / sizeof(uint64_t);
+    int32_t* coordenadas = (int32_t*)malloc(bytesAntenas > 0 ? bytesAntenas : 1);
+    uint64_t* memoria = (uint64_t*)malloc(capMemoria * sizeof(uint64_t));
+    FILE* temporario = tmpfile();
+    if (!coordenadas || !memoria || !temporario) {
+        printf(temporario ? "Erro ao alocar memoria!\n" : "Erro ao abrir o ficheiro!\n");
+        free(coordenadas);
+        free(memoria);
+        if (temporario) fclose(temporario);
+        free(leitura);
+        fclose(file);
+        return -1;
+    }
+    memcpy(posicoes, inicioFreq, sizeof(posicoes));
+    rewind(file);
+    int l, c;
+    percorrerMapa(file, leitura, NULL, coordenadas, posicoes, &l, &c);
+    fclose(file);
+    free(leitura);
+
+    // Geração: metade da memória para as chaves e metade para o vetor auxiliar da ordenação
+    size_t capChaves = capMemoria / 2, numChaves = 0;
+    uint64_t* chaves = memoria, *aux = memoria + capChaves;
+    Corrida* corridas = NULL;
+    int numCorridas = 0, capCorridas = 0, erro = 0;
+    uint64_t fimTemporario = 0;
+    for (int f = 0; f < 256 && !erro; f++) {
+        for (uint64_t i = inicioFreq[f]; i < inicioFreq[f + 1] && !erro; i++) {
+            for (uint64_t j = inicioFreq[f]; j < inicioFreq[f + 1]; j++) {
+                if (i == j) continue;
+                int64_t x = 2 * (int64_t)coordenadas[2 * i] - coordenadas[2 * j];
+                int64_t y = 2 * (int64_t)coordenadas[2 * i + 1] - coordenadas[2 * j + 1];
+                if (x < 0 || y < 0 || x >= colunas || y >= linhas) continue;
+                chaves[numChaves++] = (uint64_t)y << 32 | (uint64_t)x;
+                if (numChaves < capChaves) continue;
+                if (numCorridas == capCorridas) {
+                    int cap = capCorridas ? capCorridas * 2 : 16;
+                    Corrida* novo = (Corrida*)realloc(corridas, (size_t)cap * sizeof(Corrida));
+                    if (!novo) {
+                        printf("Erro ao alocar memoria!\n");
+                        erro = 1;
+                        break;
+                    }
+                    corridas = novo;
+                    capCorridas = cap;
+                }
+                if (!escreverCorrida(temporario, &fimTemporario, chaves, aux, numChaves, &corridas[numCorridas++])) {
+                    printf("Erro ao escrever o ficheiro temporario!\n");
+                    erro = 1;
+                    break;
+                }
+                numChaves = 0;
+            }
+        }
+    }
+    free(coordenadas);
+    if (!erro && numCorridas > 0 && numChaves > 0) {
+        Corrida* novo = (Corrida*)realloc(corridas, (size_t)(numCorridas + 1) * sizeof(Corrida));
+        if (!novo) {
+            printf("Erro ao alocar memoria!\n");
+            erro = 1;
+        } else {
+            corridas = novo;
+            if (!escreverCorrida(temporario, &fimTemporario, chaves, aux, numChaves, &corridas[numCorridas++])) {
+                printf("Erro ao escrever o ficheiro temporario!\n");
+                erro = 1;
+            }
+        }
+        numChaves = 0;
+    }
+
+    // Fusão em várias passagens enquanto houver mais corridas do que leitores que cabem na memória
+    int maxLeitores = (int)(capMemoria / MIN_LEITURA < 1024 ? capMemoria / MIN_LEITURA : 1024);
+    while (!erro && numCorridas > maxLeitores) {
+        FILE* destino = tmpfile();
+        uint64_t fimDestino = 0;
+        int numNovas = 0;
+        if (!destino) {
+            printf("Erro ao abrir o ficheiro!\n");
+            erro = 1;
+            break;
+        }
+        for (int r = 0; r < numCorridas && !erro; r += maxLeitores) {
+            int num = numCorridas - r < maxLeitores ? numCorridas - r : maxLeitores;
+            Corrida resultado;
+            if (fundirCorridas(temporario, corridas + r, num, memoria, capMemoria, destino, &fimDestino, NULL, &resultado) < 0) {
+                erro = 1;
+                break;
+            }
+            corridas[numNovas++] = resultado;
+        }
+        fclose(temporario);
+        temporario = destino;
+        numCorridas = numNovas;
+    }
+
+    long long total = -1;
+    Saida saida;
+    if (!erro && !abrirSaida(&saida, saidaFicheiro)) {
+        printf("Erro ao abrir o ficheiro!\n");
+        erro = 1;
+    }
+    if (!erro) {
+        escreverTexto(&saida, "\nEfeitos Nefastos:\n");
+        escreverTexto(&saida, "Coordenadas\n");
+        escreverTexto(&saida, "------------\n");
+        if (numCorridas == 0) { // Tudo coube na memória: não há corridas no ficheiro temporário
+            ordenarChaves(chaves, aux, numChaves);
+            total = 0;
+            for (size_t i = 0; i < numChaves; i++) {
+                if (i > 0 && chaves[i] == chaves[i - 1]) continue;
+                escreverChave(&saida, chaves[i]);
+                total++;
+            }
+        } else {
+            total = fundirCorridas(temporario, corridas, numCorridas, memoria, capMemoria, NULL, NULL, &saida, NULL);
+        }
+        escreverTexto(&saida, "------------\n");
+        if (!fecharSaida(&saida)) total = -1;
+    }
+
+    free(corridas);
+    free(memoria);
+    fclose(temporario);
+    return total;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file externo.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de cálculo dos efeitos nefastos fora de memória, para mapas muito grandes
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef EXTERNO_H
+#define EXTERNO_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Número mínimo de chaves do buffer de geração (o orçamento tem de o permitir)
+ */
+#define MIN_CHAVES 1024
+/**
+ * @brief Número mínimo de chaves lidas de cada corrida de uma vez durante a fusão
+ */
+#define MIN_LEITURA 512
+
+/**
+ * @brief Calcula os efeitos nefastos de um mapa guardado em ficheiro sem o carregar para memória
+ *
+ * O mapa é lido duas vezes em blocos: a primeira leitura conta as antenas de cada frequência e a
+ * segunda guarda só as suas coordenadas, agrupadas por frequência. Os efeitos são gerados para um
+ * buffer de chaves (y, x); sempre que o buffer enche é ordenado, sem repetições, e escrito como uma
+ * corrida num ficheiro temporário. No fim as corridas são fundidas (em várias passagens, se não
+ * couberem todas no orçamento) e os efeitos são escritos por ordem de y e depois de x, sem repetições,
+ * com o formato da tabela de efeitos de guardarListas.
+ *
+ * @param filename Nome do ficheiro do mapa
+ * @param saidaFicheiro Nome do ficheiro onde escrever os efeitos
+ * @param orcamento Memória (em bytes) para as coordenadas das antenas e para os buffers de ordenação e fusão
+ * @return long long Número de efeitos nefastos escritos, ou -1 em caso de erro
+ * @attention O mapa tem tantas linhas como em contarLinhas (fins de linha mais 1, mas sem o limite de MAX_LINHAS)
+ * e tantas colunas como a linha mais comprida do ficheiro;
+ * só são considerados os efeitos dentro do mapa, como em detetarEfeitosNefastosMapa. As linhas não são
+ * divididas aos 99 caracteres, ao contrário de carregarAntenas
+ */
+long long detetarEfeitosNefastosExterno(const char* filename, const char* saidaFicheiro, size_t orcamento);
+
+#endif
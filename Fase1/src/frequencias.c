@@ -0,0 +1,284 @@
+/**
+ * @file frequencias.c
+ * @author Hugo Baptista
+ * @brief Implementação da reatribuição de frequências às antenas por recozimento simulado
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "estruturas.h"
+#include "frequencias.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Temperatura no início de cada reinício
+ */
+#define TEMPERATURA_INICIAL 3.0
+/**
+ * @brief Temperatura no fim de cada reinício
+ */
+#define TEMPERATURA_FINAL 0.05
+
+/**
+ * @brief Estado de um reinício: frequência de cada antena, grupos e contagem de efeitos por célula
+ * @internal
+ * @param grupo Índice da frequência atribuída a cada antena
+ * @param prox Antena seguinte no mesmo grupo (-1 no fim)
+ * @param ant Antena anterior no mesmo grupo (-1 no início)
+ * @param cabeca Primeira antena de cada grupo (-1 se vazio)
+ * @param contagens Número de pares que atingem cada célula do mapa
+ * @param total Número de células com contagem positiva
+ */
+typedef struct EstadoFrequencias {
+    int* grupo;
+    int* prox;
+    int* ant;
+    int* cabeca;
+    uint32_t* contagens;
+    int total;
+} EstadoFrequencias;
+
+/**
+ * @brief Gera o número pseudo-aleatório seguinte (xorshift64*)
+ * @internal
+ * @param estado Estado do gerador (diferente de 0)
+ * @return uint64_t Número gerado
+ */
+static inline uint64_t aleatorio(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Devolve o tempo atual em segundos
+ * @internal
+ * @return double Tempo em segundos
+ */
+static double agora(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Soma (ou subtrai) às contagens os efeitos dos pares da antena i com as antenas de um grupo
+ * @internal
+ * @param e Estado do reinício
+ * @param xs Coordenadas x das antenas
+ * @param ys Coordenadas y das antenas
+ * @param i Antena (não pertence ao grupo)
+ * @param g Grupo
+ * @param sinal 1 para somar, -1 para subtrair
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ */
+static void alterarPares(EstadoFrequencias* e, const int* xs, const int* ys, int i, int g, int sinal, int linhas, int colunas) {
+    for (int j = e->cabeca[g]; j >= 0; j = e->prox[j]) {
+        int ex[2] = { 2 * xs[i] - xs[j], 2 * xs[j] - xs[i] };
+        int ey[2] = { 2 * ys[i] - ys[j], 2 * ys[j] - ys[i] };
+        for (int k = 0; k < 2; k++) {
+            if ((unsigned)ex[k] >= (unsigned)colunas || (unsigned)ey[k] >= (unsigned)linhas) continue;
+            uint32_t* c = &e->contagens[(size_t)ey[k] * colunas + ex[k]];
+            if (sinal > 0) {
+                if ((*c)++ == 0) e->total++;
+            } else {
+                if (--(*c) == 0) e->total--;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Coloca a antena i no grupo g, somando os efeitos dos novos pares
+ * @internal
+ * @param e Estado do reinício
+ * @param xs Coordenadas x das antenas
+ * @param ys Coordenadas y das antenas
+ * @param i Antena (fora de qualquer grupo)
+ * @param g Grupo de destino
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ */
+static void juntarGrupo(EstadoFrequencias* e, const int* xs, const int* ys, int i, int g, int linhas, int colunas) {
+    alterarPares(e, xs, ys, i, g, 1, linhas, colunas);
+    e->grupo[i] = g;
+    e->ant[i] = -1;
+    e->prox[i] = e->cabeca[g];
+    if (e->cabeca[g] >= 0) e->ant[e->cabeca[g]] = i;
+    e->cabeca[g] = i;
+}
+
+/**
+ * @brief Muda a antena i para o grupo g; só os pares com o grupo antigo e com o novo são recalculados
+ * @internal
+ * @param e Estado do reinício
+ * @param xs Coordenadas x das antenas
+ * @param ys Coordenadas y das antenas
+ * @param i Antena
+ * @param g Grupo de destino
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ */
+static void moverAntena(EstadoFrequencias* e, const int* xs, const int* ys, int i, int g, int linhas, int colunas) {
+    int antigo = e->grupo[i];
+    if (e->ant[i] >= 0) e->prox[e->ant[i]] = e->prox[i];
+    else e->cabeca[antigo] = e->prox[i];
+    if (e->prox[i] >= 0) e->ant[e->prox[i]] = e->ant[i];
+    alterarPares(e, xs, ys, i, antigo, -1, linhas, colunas);
+    juntarGrupo(e, xs, ys, i, g, linhas, colunas);
+}
+
+/**
+ * @brief Escolhe as frequências das antenas (mantendo as posições) que minimizam o número de efeitos nefastos
+ *
+ * Usa recozimento simulado: cada movimento muda a frequência de uma antena e só mexe nos pares dessa
+ * antena com os dois grupos de frequência envolvidos, atualizando um contador por célula do mapa, em
+ * vez de repetir a deteção completa. Os reinícios correm em paralelo nas threads disponíveis e
+ * repartem o tempo dado; o primeiro reinício parte das frequências atuais e os restantes de
+ * atribuições aleatórias. No fim, a melhor atribuição encontrada é escrita na lista.
+ *
+ * @param lista Lista de antenas (as frequências são alteradas)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param permitidas String com as frequências que podem ser atribuídas
+ * @param segundos Tempo total disponível, em segundos
+ * @param reinicios Número de reinícios
+ * @param semente Semente do gerador de números aleatórios
+ * @return int Número de efeitos nefastos dentro do mapa com a melhor atribuição, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas); para o mesmo critério
+ * de detetarEfeitosNefastos use MAX_LINHAS e MAX_COLUNAS
+ */
+int otimizarFrequencias(Antena* lista, int linhas, int colunas, const char* permitidas, double segundos, int reinicios, unsigned int semente) {
+    if (linhas < 1 || colunas < 1 || !permitidas || reinicios < 1) return -1;
+
+    // Frequências permitidas, sem repetições
+    char freqs[256];
+    int numFreq = 0, indiceFreq[256];
+    for (int f = 0; f < 256; f++) indiceFreq[f] = -1;
+    for (const char* p = permitidas; *p; p++) {
+        if (indiceFreq[(unsigned char)*p] >= 0) continue;
+        indiceFreq[(unsigned char)*p] = numFreq;
+        freqs[numFreq++] = *p;
+    }
+    if (numFreq == 0) return -1;
+
+    int n = 0;
+    for (Antena* a = lista; a; a = a->prox) n++;
+    if (n == 0) return 0;
+    int* xs = (int*)malloc((size_t)n * sizeof(int));
+    int* ys = (int*)malloc((size_t)n * sizeof(int));
+    int* iniciais = (int*)malloc((size_t)n * sizeof(int));
+    int* melhor = (int*)malloc((size_t)n * sizeof(int));
+    if (!xs || !ys || !iniciais || !melhor) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        free(iniciais);
+        free(melhor);
+        return -1;
+    }
+    int i = 0;
+    for (Antena* a = lista; a; a = a->prox, i++) {
+        xs[i] = a->x;
+        ys[i] = a->y;
+        iniciais[i] = indiceFreq[(unsigned char)a->frequencia];
+    }
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    int rondas = (reinicios + numThreads - 1) / numThreads;
+    double fatia = segundos > 0 ? segundos / rondas : 0;
+    size_t celulas = (size_t)linhas * colunas;
+    int melhorTotal = -1, melhorReinicio = reinicios, erro = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int r = 0; r < reinicios; r++) {
+        EstadoFrequencias e;
+        e.grupo = (int*)malloc((size_t)n * sizeof(int));
+        e.prox = (int*)malloc((size_t)n * sizeof(int));
+        e.ant = (int*)malloc((size_t)n * sizeof(int));
+        e.cabeca = (int*)malloc((size_t)numFreq * sizeof(int));
+        e.contagens = (uint32_t*)calloc(celulas, sizeof(uint32_t));
+        e.total = 0;
+        int* melhorLocal = (int*)malloc((size_t)n * sizeof(int));
+        if (!e.grupo || !e.prox || !e.ant || !e.cabeca || !e.contagens || !melhorLocal) {
+            #pragma omp atomic write
+            erro = 1;
+        } else {
+            uint64_t gerador = ((uint64_t)semente << 32 ^ (uint64_t)r * 0x9E3779B97F4A7C15ULL) | 1;
+            for (int g = 0; g < numFreq; g++) e.cabeca[g] = -1;
+            for (int j = 0; j < n; j++) {
+                int g = r == 0 && iniciais[j] >= 0 ? iniciais[j] : (int)(aleatorio(&gerador) % (uint64_t)numFreq);
+                juntarGrupo(&e, xs, ys, j, g, linhas, colunas);
+            }
+            int totalLocal = e.total;
+            memcpy(melhorLocal, e.grupo, (size_t)n * sizeof(int));
+
+            double inicio = agora(), temperatura = TEMPERATURA_INICIAL;
+            for (long it = 0; numFreq > 1 && totalLocal > 0; it++) {
+                if ((it & 255) == 0) {
+                    double fracao = fatia > 0 ? (agora() - inicio) / fatia : 1;
+                    if (fracao >= 1) break;
+                    temperatura = TEMPERATURA_INICIAL * pow(TEMPERATURA_FINAL / TEMPERATURA_INICIAL, fracao);
+                }
+                int a = (int)(aleatorio(&gerador) % (uint64_t)n);
+                int antigo = e.grupo[a];
+                int g = (int)(aleatorio(&gerador) % (uint64_t)(numFreq - 1));
+                if (g >= antigo) g++;
+                int antes = e.total;
+                moverAntena(&e, xs, ys, a, g, linhas, colunas);
+                int delta = e.total - antes;
+                if (delta > 0 && (double)(aleatorio(&gerador) >> 11) * (1.0 / 9007199254740992.0) >= exp(-delta / temperatura)) {
+                    moverAntena(&e, xs, ys, a, antigo, linhas, colunas); // Movimento rejeitado
+                } else if (e.total < totalLocal) {
+                    totalLocal = e.total;
+                    memcpy(melhorLocal, e.grupo, (size_t)n * sizeof(int));
+                }
+            }
+
+            #pragma omp critical(melhorFrequencias)
+            {
+                if (melhorTotal < 0 || totalLocal < melhorTotal || (totalLocal == melhorTotal && r < melhorReinicio)) {
+                    melhorTotal = totalLocal;
+                    melhorReinicio = r;
+                    memcpy(melhor, melhorLocal, (size_t)n * sizeof(int));
+                }
+            }
+        }
+        free(e.grupo);
+        free(e.prox);
+        free(e.ant);
+        free(e.cabeca);
+        free(e.contagens);
+        free(melhorLocal);
+    }
+
+    if (erro || melhorTotal < 0) {
+        printf("Erro ao alocar memoria!\n");
+        melhorTotal = -1;
+    } else {
+        i = 0;
+        for (Antena* a = lista; a; a = a->prox, i++) a->frequencia = freqs[melhor[i]];
+    }
+    free(xs);
+    free(ys);
+    free(iniciais);
+    free(melhor);
+    return melhorTotal;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file frequencias.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de reatribuição de frequências às antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef FREQUENCIAS_H
+#define FREQUENCIAS_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Escolhe as frequências das antenas (mantendo as posições) que minimizam o número de efeitos nefastos
+ *
+ * Usa recozimento simulado: cada movimento muda a frequência de uma antena e só mexe nos pares dessa
+ * antena com os dois grupos de frequência envolvidos, atualizando um contador por célula do mapa, em
+ * vez de repetir a deteção completa. Os reinícios correm em paralelo nas threads disponíveis e
+ * repartem o tempo dado; o primeiro reinício parte das frequências atuais e os restantes de
+ * atribuições aleatórias. No fim, a melhor atribuição encontrada é escrita na lista.
+ *
+ * @param lista Lista de antenas (as frequências são alteradas)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param permitidas String com as frequências que podem ser atribuídas
+ * @param segundos Tempo total disponível, em segundos
+ * @param reinicios Número de reinícios
+ * @param semente Semente do gerador de números aleatórios
+ * @return int Número de efeitos nefastos dentro do mapa com a melhor atribuição, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas); para o mesmo critério
+ * de detetarEfeitosNefastos use MAX_LINHAS e MAX_COLUNAS
+ */
+int otimizarFrequencias(Antena* lista, int linhas, int colunas, const char* permitidas, double segundos, int reinicios, unsigned int semente);
+
+#endif
@@ -0,0 +1,479 @@
+/**
+ * @file harmonicos.c
+ * @author Hugo Baptista
+ * @brief Implementação do modo de harmónicos, em que os efeitos nefastos ocupam toda a reta de cada par de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "vetorial.h"
+#include "harmonicos.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Número máximo de células do retângulo de um grupo para usar a tabela de direções reduzidas
+ */
+#define MAX_CELULAS_DENSO (1 << 20)
+
+/**
+ * @brief Tabela de direções reduzidas já vistas a partir de uma antena, de uma thread
+ * @internal
+ * @param chaves Direção (sx, sy) de cada posição do hash, com sx nos 32 bits altos e sy nos baixos
+ * @param marcas Antena a que pertence cada posição do hash (as posições de outras antenas estão livres)
+ * @param mascara Número de posições do hash menos 1 (potência de 2 menos 1)
+ * @param deslocamento Deslocamento que reduz o hash ao número de posições
+ * @param vistas Antena que viu cada direção reduzida dos grupos densos, duas posições por direção (sy positivo e negativo)
+ */
+typedef struct TabelaDirecoes {
+    uint64_t* chaves;
+    uint32_t* marcas;
+    uint32_t mascara;
+    int deslocamento;
+    uint32_t* vistas;
+} TabelaDirecoes;
+
+/**
+ * @brief Retângulo e tabelas partilhadas de um grupo denso de antenas
+ * @internal
+ * @param minX Menor coordenada x do grupo
+ * @param minY Menor coordenada y do grupo
+ * @param largura Largura do retângulo do grupo
+ * @param altura Altura do retângulo do grupo
+ * @param reduzidas Direção reduzida de cada diferença (dx, |dy|), na posição dx * altura + |dy|
+ * @param ocupadas Indica se a célula (x - minX) * altura + (y - minY) tem uma antena do grupo
+ */
+typedef struct GrupoDenso {
+    int minX, minY;
+    int largura, altura;
+    int32_t* reduzidas;
+    unsigned char* ocupadas;
+} GrupoDenso;
+
+/**
+ * @brief Conta os bits a 1 de uma palavra
+ * @internal
+ * @param v Palavra
+ * @return int Número de bits a 1
+ */
+static inline int contarBits(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Calcula o máximo divisor comum de dois inteiros não negativos (algoritmo binário)
+ * @internal
+ * @param a Primeiro inteiro
+ * @param b Segundo inteiro
+ * @return int Máximo divisor comum (0 se ambos forem 0)
+ */
+static inline int mdc(int a, int b) {
+    if (!a) return b;
+    if (!b) return a;
+#if defined(__GNUC__) || defined(__clang__)
+    int comum = __builtin_ctz((unsigned int)(a | b));
+    a >>= __builtin_ctz((unsigned int)a);
+    do {
+        b >>= __builtin_ctz((unsigned int)b);
+        if (a > b) {
+            int t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    } while (b);
+    return a << comum;
+#else
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+#endif
+}
+
+/**
+ * @brief Marca uma célula no mapa de bits (de forma atómica quando há várias threads)
+ * @internal
+ * @param mapa Mapa de bits
+ * @param c Posição y * colunas + x da célula
+ */
+static inline void marcarCelula(uint64_t* mapa, size_t c) {
+    uint64_t bit = 1ULL << (c & 63), palavra;
+    // Nos grupos densos quase todas as células já estão marcadas: a leitura evita a escrita atómica
+#ifdef _OPENMP
+    #pragma omp atomic read
+#endif
+    palavra = mapa[c >> 6];
+    if (palavra & bit) return;
+#ifdef _OPENMP
+    #pragma omp atomic
+#endif
+    mapa[c >> 6] |= bit;
+}
+
+/**
+ * @brief Restringe o intervalo [tmin, tmax] aos passos t em que p + t * s fica em [0, n)
+ * @internal
+ * @param p Coordenada inicial (dentro de [0, n))
+ * @param s Passo
+ * @param n Dimensão do mapa nessa coordenada
+ * @param tmin Menor passo (entrada e saída)
+ * @param tmax Maior passo (entrada e saída)
+ */
+static inline void limitarPassos(int p, int s, int n, int* tmin, int* tmax) {
+    int menor, maior;
+    if (s > 0) {
+        menor = -(p / s);
+        maior = (n - 1 - p) / s;
+    } else if (s < 0) {
+        menor = -((n - 1 - p) / -s);
+        maior = p / -s;
+    } else {
+        return;
+    }
+    if (menor > *tmin) *tmin = menor;
+    if (maior < *tmax) *tmax = maior;
+}
+
+/**
+ * @brief Marca no mapa todas as células da reta que passa em (x, y) com passo (sx, sy)
+ *
+ * Os extremos da reta dentro do mapa são calculados por divisão, pelo que só são visitadas as suas células.
+ * @internal
+ * @param x Coordenada x de um ponto da reta (dentro do mapa)
+ * @param y Coordenada y de um ponto da reta (dentro do mapa)
+ * @param sx Passo em x (direção reduzida)
+ * @param sy Passo em y (direção reduzida)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static void desenharReta(int x, int y, int sx, int sy, int linhas, int colunas, uint64_t* mapa) {
+    int tmin = -linhas - colunas, tmax = linhas + colunas;
+    limitarPassos(x, sx, colunas, &tmin, &tmax);
+    limitarPassos(y, sy, linhas, &tmin, &tmax);
+    long long c = (long long)(y + tmin * sy) * colunas + (x + tmin * sx);
+    long long passo = (long long)sy * colunas + sx;
+    for (int t = tmin; t <= tmax; t++, c += passo) marcarCelula(mapa, (size_t)c);
+}
+
+/**
+ * @brief Insere uma direção na tabela da antena atual
+ * @internal
+ * @param tabela Tabela de direções
+ * @param chave Direção reduzida (sx nos 32 bits altos, sy nos baixos)
+ * @param marca Identificador da antena atual
+ * @return int 1 se a direção é nova para esta antena, 0 se já estava na tabela
+ */
+static inline int inserirDirecao(TabelaDirecoes* tabela, uint64_t chave, uint32_t marca) {
+    uint32_t i = (uint32_t)((chave * 0x9E3779B97F4A7C15ULL) >> tabela->deslocamento);
+    while (tabela->marcas[i] == marca) {
+        if (tabela->chaves[i] == chave) return 0;
+        i = (i + 1) & tabela->mascara;
+    }
+    tabela->marcas[i] = marca;
+    tabela->chaves[i] = chave;
+    return 1;
+}
+
+/**
+ * @brief Desenha as retas de que a antena i do grupo é a primeira antena
+ *
+ * As direções das antenas anteriores a i entram na tabela sem serem desenhadas, porque essas retas já
+ * foram desenhadas pela sua primeira antena; as das seguintes só são desenhadas se ainda não estiverem
+ * na tabela, o que salta as antenas colineares com um par anterior.
+ * @internal
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param n Número de antenas do grupo
+ * @param i Antena atual
+ * @param tabela Tabela de direções
+ * @param marca Identificador da antena atual na tabela (diferente de 0 e dos anteriores)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static void harmonicosAntena(const int32_t* xs, const int32_t* ys, int n, int i, TabelaDirecoes* tabela, uint32_t marca, int linhas, int colunas, uint64_t* mapa) {
+    int xi = xs[i], yi = ys[i];
+    for (int j = 0; j < n; j++) {
+        if (j == i) continue;
+        int dx = xs[j] - xi, dy = ys[j] - yi;
+        if (!dx && !dy) { // Duas antenas iguais na mesma posição: o efeito cai sobre elas
+            marcarCelula(mapa, (size_t)yi * colunas + xi);
+            continue;
+        }
+        // Direção canónica: sx > 0, ou sx == 0 e sy > 0, para que (dx, dy) e (-dx, -dy) sejam a mesma reta
+        if (dx < 0 || (!dx && dy < 0)) {
+            dx = -dx;
+            dy = -dy;
+        }
+        int g = mdc(dx, dy < 0 ? -dy : dy);
+        int sx = dx / g, sy = dy / g;
+        uint64_t chave = (uint64_t)(uint32_t)sx << 32 | (uint32_t)sy;
+        if (inserirDirecao(tabela, chave, marca) && j > i) desenharReta(xi, yi, sx, sy, linhas, colunas, mapa);
+    }
+}
+
+/**
+ * @brief Prepara um grupo denso: ordena as antenas por x e depois por y e preenche as tabelas do seu retângulo
+ *
+ * A posição dx * altura + dy da tabela de direções reduzidas fica com (dx / g) * altura + dy / g, com
+ * g = mdc(dx, dy). Percorrendo as posições por ordem, a primeira que ainda não está preenchida é uma
+ * direção reduzida e preenche os seus múltiplos, pelo que não é calculado nenhum mdc. As antenas são
+ * reescritas pela ordem das células ocupadas do retângulo, sem as repetidas, cuja posição é marcada no mapa.
+ * @internal
+ * @param grupo Grupo denso (com o retângulo e as tabelas já alocadas)
+ * @param xs Coordenadas x das antenas do grupo (reordenadas)
+ * @param ys Coordenadas y das antenas do grupo (reordenadas)
+ * @param n Número de antenas do grupo
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ * @return int Número de antenas do grupo sem as repetidas
+ */
+static int prepararGrupoDenso(GrupoDenso* grupo, int32_t* xs, int32_t* ys, int n, int colunas, uint64_t* mapa) {
+    int largura = grupo->largura, altura = grupo->altura;
+    size_t celulas = (size_t)largura * altura;
+    memset(grupo->reduzidas, 0xFF, celulas * sizeof(int32_t));
+    for (int sx = 0; sx < largura; sx++) {
+        for (int sy = 0; sy < altura; sy++) {
+            int32_t r = sx * altura + sy;
+            if ((!sx && !sy) || grupo->reduzidas[r] >= 0) continue;
+            for (int k = 1; k * sx < largura && k * sy < altura; k++) grupo->reduzidas[k * sx * altura + k * sy] = r;
+        }
+    }
+
+    memset(grupo->ocupadas, 0, celulas);
+    for (int i = 0; i < n; i++) {
+        unsigned char* celula = &grupo->ocupadas[(size_t)(xs[i] - grupo->minX) * altura + (ys[i] - grupo->minY)];
+        if (*celula) marcarCelula(mapa, (size_t)ys[i] * colunas + xs[i]); // Duas antenas iguais na mesma posição: o efeito cai sobre elas
+        *celula = 1;
+    }
+    int num = 0;
+    for (size_t c = 0; c < celulas; c++) {
+        if (!grupo->ocupadas[c]) continue;
+        xs[num] = grupo->minX + (int)(c / altura);
+        ys[num++] = grupo->minY + (int)(c % altura);
+    }
+    return num;
+}
+
+/**
+ * @brief Desenha as retas de que a antena i de um grupo denso é a primeira antena
+ *
+ * Com as antenas ordenadas por x e depois por y, a primeira antena de uma reta é a primeira pela ordem do
+ * grupo e só as antenas seguintes têm de ser vistas. A direção reduzida de cada par é lida da tabela do
+ * retângulo, sem mdc nem hash, e a reta só é desenhada se, recuando a partir da antena i, se sair do
+ * retângulo sem encontrar outra antena. Cada recuo para na antena anterior da reta, pelo que os recuos
+ * de todas as antenas de uma reta somam no máximo o seu comprimento.
+ * @internal
+ * @param grupo Grupo denso preparado por prepararGrupoDenso
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param n Número de antenas do grupo
+ * @param i Antena atual
+ * @param vistas Vetor com duas posições por direção da tabela (sy positivo e negativo)
+ * @param marca Identificador da antena atual no vetor (diferente de 0 e dos anteriores)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static void harmonicosAntenaDenso(const GrupoDenso* grupo, const int32_t* xs, const int32_t* ys, int n, int i, uint32_t* vistas, uint32_t marca, int linhas, int colunas, uint64_t* mapa) {
+    int xi = xs[i], yi = ys[i], altura = grupo->altura;
+    for (int j = i + 1; j < n; j++) {
+        int dx = xs[j] - xi, dy = ys[j] - yi;
+        int negativo = dy < 0;
+        int32_t d = 2 * grupo->reduzidas[dx * altura + (negativo ? -dy : dy)] + negativo;
+        if (vistas[d] == marca) continue; // Colinear com um par anterior desta antena
+        vistas[d] = marca;
+        int sx = d / 2 / altura, sy = d / 2 % altura;
+        if (negativo) sy = -sy;
+        int x = xi - grupo->minX - sx, y = yi - grupo->minY - sy;
+        while (x >= 0 && y >= 0 && y < altura && !grupo->ocupadas[(size_t)x * altura + y]) {
+            x -= sx;
+            y -= sy;
+        }
+        if (x >= 0 && y >= 0 && y < altura) continue; // Há uma antena anterior na reta, que já a desenhou
+        desenharReta(xi, yi, sx, sy, linhas, colunas, mapa);
+    }
+}
+
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos harmónicos de uma lista de antenas
+ *
+ * Cada par de antenas da mesma frequência, com diferença (dx, dy) e g = mdc(|dx|, |dy|), afeta todas as
+ * células p + k * (dx / g, dy / g) dentro do mapa, incluindo as próprias antenas. Cada reta é desenhada
+ * uma única vez, com passo (dx / g, dy / g) diretamente no mapa de bits: uma antena só desenha as retas
+ * em que é a primeira antena (pela ordem do grupo) e salta as antenas colineares com um par anterior
+ * numa tabela de direções reduzidas, pelo que o custo é O(n^2) consultas mais o comprimento das retas
+ * distintas, em vez de O(n^2 * L). Nos grupos densos (retângulo com até n^2 células) as direções
+ * reduzidas vêm de uma tabela do retângulo, sem mdc nem hash; nos restantes, de um hash. As antenas de
+ * cada grupo são repartidas entre as threads.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são consideradas as antenas dentro do mapa (linhas x colunas)
+ */
+long long calcularHarmonicos(Antena* lista, int linhas, int colunas, uint64_t* mapa) {
+    if (linhas < 1 || colunas < 1) return -1;
+    size_t palavras = ((size_t)linhas * colunas + 63) / 64;
+    memset(mapa, 0, palavras * sizeof(uint64_t));
+
+    // Agrupa as coordenadas das antenas dentro do mapa por frequência em vetores contíguos
+    int inicioFreq[257] = {0}, pos[256], num = 0;
+    int minX[256], maxX[256], minY[256], maxY[256];
+    for (int f = 0; f < 256; f++) {
+        minX[f] = colunas;
+        minY[f] = linhas;
+        maxX[f] = maxY[f] = -1;
+    }
+    for (Antena* a = lista; a; a = a->prox) {
+        if (a->x < 0 || a->x >= colunas || a->y < 0 || a->y >= linhas) continue;
+        int f = (unsigned char)a->frequencia;
+        inicioFreq[f + 1]++;
+        if (a->x < minX[f]) minX[f] = a->x;
+        if (a->x > maxX[f]) maxX[f] = a->x;
+        if (a->y < minY[f]) minY[f] = a->y;
+        if (a->y > maxY[f]) maxY[f] = a->y;
+        num++;
+    }
+    if (num < 2) return 0;
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    int32_t* xs = (int32_t*)malloc((size_t)num * sizeof(int32_t));
+    int32_t* ys = (int32_t*)malloc((size_t)num * sizeof(int32_t));
+    if (!xs || !ys) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        return -1;
+    }
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (Antena* a = lista; a; a = a->prox) {
+        if (a->x < 0 || a->x >= colunas || a->y < 0 || a->y >= linhas) continue;
+        int p = pos[(unsigned char)a->frequencia]++;
+        xs[p] = a->x;
+        ys[p] = a->y;
+    }
+
+    // Um grupo é denso quando o seu retângulo não tem mais células do que pares: usa a tabela de
+    // direções reduzidas do retângulo; os restantes usam o hash, com o dobro das posições do maior grupo
+    int denso[256], maiorGrupo = 0;
+    size_t maiorRetangulo = 0;
+    for (int f = 0; f < 256; f++) {
+        int n = inicioFreq[f + 1] - inicioFreq[f];
+        size_t celulas = n < 2 ? 0 : (size_t)(maxX[f] - minX[f] + 1) * (maxY[f] - minY[f] + 1);
+        denso[f] = n >= 2 && celulas <= MAX_CELULAS_DENSO && celulas <= (size_t)n * n;
+        if (denso[f] && celulas > maiorRetangulo) maiorRetangulo = celulas;
+        if (!denso[f] && n > maiorGrupo) maiorGrupo = n;
+    }
+    int bits = 4;
+    while ((1 << bits) < 2 * maiorGrupo) bits++;
+    uint32_t posicoes = 1U << bits;
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    int erro = 0;
+    TabelaDirecoes* tabelas = (TabelaDirecoes*)calloc((size_t)numThreads, sizeof(TabelaDirecoes));
+    GrupoDenso grupo;
+    grupo.reduzidas = maiorRetangulo ? (int32_t*)malloc(maiorRetangulo * sizeof(int32_t)) : NULL;
+    grupo.ocupadas = maiorRetangulo ? (unsigned char*)malloc(maiorRetangulo) : NULL;
+    erro = !tabelas || (maiorRetangulo && (!grupo.reduzidas || !grupo.ocupadas));
+    for (int t = 0; !erro && t < numThreads; t++) {
+        tabelas[t].mascara = posicoes - 1;
+        tabelas[t].deslocamento = 64 - bits;
+        if (maiorGrupo >= 2) {
+            tabelas[t].chaves = (uint64_t*)malloc(posicoes * sizeof(uint64_t));
+            tabelas[t].marcas = (uint32_t*)calloc(posicoes, sizeof(uint32_t));
+            erro = !tabelas[t].chaves || !tabelas[t].marcas;
+        }
+        if (!erro && maiorRetangulo) {
+            tabelas[t].vistas = (uint32_t*)calloc(2 * maiorRetangulo, sizeof(uint32_t));
+            erro = !tabelas[t].vistas;
+        }
+    }
+
+    for (int f = 0; !erro && f < 256; f++) {
+        int inicio = inicioFreq[f], n = inicioFreq[f + 1] - inicio;
+        if (n < 2) continue;
+        if (denso[f]) {
+            grupo.minX = minX[f];
+            grupo.minY = minY[f];
+            grupo.largura = maxX[f] - minX[f] + 1;
+            grupo.altura = maxY[f] - minY[f] + 1;
+            n = prepararGrupoDenso(&grupo, xs + inicio, ys + inicio, n, colunas, mapa);
+        }
+        // A marca de cada antena é a sua posição nos vetores mais 1, única entre todos os grupos
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+#endif
+        for (int i = 0; i < n; i++) {
+            TabelaDirecoes* tabela = &tabelas[0];
+#ifdef _OPENMP
+            tabela = &tabelas[omp_get_thread_num()];
+#endif
+            if (denso[f]) {
+                harmonicosAntenaDenso(&grupo, xs + inicio, ys + inicio, n, i, tabela->vistas, (uint32_t)(inicio + i) + 1, linhas, colunas, mapa);
+            } else {
+                harmonicosAntena(xs + inicio, ys + inicio, n, i, tabela, (uint32_t)(inicio + i) + 1, linhas, colunas, mapa);
+            }
+        }
+    }
+
+    for (int t = 0; tabelas && t < numThreads; t++) {
+        free(tabelas[t].chaves);
+        free(tabelas[t].marcas);
+        free(tabelas[t].vistas);
+    }
+    free(tabelas);
+    free(grupo.reduzidas);
+    free(grupo.ocupadas);
+    free(xs);
+    free(ys);
+    if (erro) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+
+    long long total = 0;
+    for (size_t p = 0; p < palavras; p++) total += contarBits(mapa[p]);
+    return total;
+}
+
+/**
+ * @brief Calcula os efeitos nefastos harmónicos das antenas
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosHarmonicos(Antena* lista, int linhas, int colunas) {
+    if (linhas < 1 || colunas < 1) return NULL;
+    uint64_t* mapa = (uint64_t*)malloc(((size_t)linhas * colunas + 63) / 64 * sizeof(uint64_t));
+    if (!mapa) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    Nefasto* efeitos = calcularHarmonicos(lista, linhas, colunas, mapa) > 0 ? listaDeMapa(mapa, linhas, colunas) : NULL;
+    free(mapa);
+    return efeitos;
+}
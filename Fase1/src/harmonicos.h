@@ -0,0 +1,45 @@
+/**
+ * @file harmonicos.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do modo de harmónicos, em que os efeitos nefastos ocupam toda a reta de cada par de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef HARMONICOS_H
+#define HARMONICOS_H
+
+#include <stdint.h>
+#include "estruturas.h"
+
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos harmónicos de uma lista de antenas
+ *
+ * Cada par de antenas da mesma frequência, com diferença (dx, dy) e g = mdc(|dx|, |dy|), afeta todas as
+ * células p + k * (dx / g, dy / g) dentro do mapa, incluindo as próprias antenas. Cada reta é desenhada
+ * uma única vez, com passo (dx / g, dy / g) diretamente no mapa de bits: uma antena só desenha as retas
+ * em que é a primeira antena (pela ordem do grupo) e salta as antenas colineares com um par anterior
+ * numa tabela de direções reduzidas, pelo que o custo é O(n^2) consultas mais o comprimento das retas
+ * distintas, em vez de O(n^2 * L). Nos grupos densos (retângulo com até n^2 células) as direções
+ * reduzidas vêm de uma tabela do retângulo, sem mdc nem hash; nos restantes, de um hash. As antenas de
+ * cada grupo são repartidas entre as threads.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são consideradas as antenas dentro do mapa (linhas x colunas)
+ */
+long long calcularHarmonicos(Antena* lista, int linhas, int colunas, uint64_t* mapa);
+/**
+ * @brief Calcula os efeitos nefastos harmónicos das antenas
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosHarmonicos(Antena* lista, int linhas, int colunas);
+
+#endif
@@ -0,0 +1,417 @@
+/**
+ * @file indice.c
+ * @author Hugo Baptista
+ * @brief Implementação do índice espacial das antenas (grelha uniforme de baldes e tabela de dispersão)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "indice.h"
+
+/**
+ * @brief Calcula a posição inicial de uma coordenada na tabela de dispersão
+ * @internal
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @param cap Capacidade da tabela (potência de 2)
+ * @return int Posição inicial na tabela
+ */
+static int dispersao(int x, int y, int cap) {
+    unsigned int h = (unsigned int)x * 0x9E3779B1u ^ (unsigned int)y * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 13;
+    return (int)(h & (unsigned int)(cap - 1));
+}
+
+/**
+ * @brief Devolve o balde onde cai uma posição (posições fora do mapa ficam no balde da margem)
+ * @internal
+ * @param indice Índice
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return Balde* Balde da posição
+ */
+static Balde* baldeDe(const IndiceEspacial* indice, int x, int y) {
+    int bx = x < 0 ? 0 : x / indice->lado;
+    int by = y < 0 ? 0 : y / indice->lado;
+    if (bx >= indice->baldesX) bx = indice->baldesX - 1;
+    if (by >= indice->baldesY) by = indice->baldesY - 1;
+    return &indice->baldes[by * indice->baldesX + bx];
+}
+
+/**
+ * @brief Insere um apontador na tabela de dispersão, sem verificar a carga
+ * @internal
+ * @param tabela Tabela de dispersão
+ * @param cap Capacidade da tabela
+ * @param antena Antena a inserir
+ */
+static void inserirNaTabela(Antena** tabela, int cap, Antena* antena) {
+    int i = dispersao(antena->x, antena->y, cap);
+    while (tabela[i]) i = (i + 1) & (cap - 1);
+    tabela[i] = antena;
+}
+
+/**
+ * @brief Duplica a capacidade da tabela de dispersão
+ * @internal
+ * @param indice Índice
+ * @return int 1 se a tabela foi aumentada com sucesso, 0 caso contrário
+ */
+static int aumentarTabela(IndiceEspacial* indice) {
+    int cap = indice->capTabela * 2;
+    Antena** nova = (Antena**)calloc((size_t)cap, sizeof(Antena*));
+    if (!nova) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    for (int i = 0; i < indice->capTabela; i++) {
+        if (indice->tabela[i]) inserirNaTabela(nova, cap, indice->tabela[i]);
+    }
+    free(indice->tabela);
+    indice->tabela = nova;
+    indice->capTabela = cap;
+    return 1;
+}
+
+/**
+ * @brief Cria um índice espacial a partir de uma lista de antenas
+ *
+ * O lado dos baldes é escolhido para que cada balde tenha, em média, cerca de duas antenas.
+ *
+ * @param lista Lista de antenas a indexar
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return IndiceEspacial* Apontador para o índice criado, ou NULL em caso de erro
+ * @attention inserirAntena e ordenarAntenas trocam os dados entre os nós, pelo que o índice deve ser recriado depois delas
+ */
+IndiceEspacial* criarIndice(Antena* lista, int linhas, int colunas) {
+    if (linhas < 1 || colunas < 1) return NULL;
+    IndiceEspacial* indice = (IndiceEspacial*)calloc(1, sizeof(IndiceEspacial));
+    if (!indice) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    int num = 0;
+    for (Antena* atual = lista; atual; atual = atual->prox) num++;
+
+    long long area = (long long)linhas * colunas;
+    int lado = 1;
+    if (num == 0) lado = linhas > colunas ? linhas : colunas;
+    else while ((long long)lado * lado * num < 2 * area) lado++;
+    indice->lado = lado;
+    indice->linhas = linhas;
+    indice->colunas = colunas;
+    indice->baldesX = (colunas + indice->lado - 1) / indice->lado;
+    indice->baldesY = (linhas + indice->lado - 1) / indice->lado;
+    indice->capTabela = 16;
+    while (indice->capTabela < 2 * num) indice->capTabela *= 2;
+    indice->baldes = (Balde*)calloc((size_t)indice->baldesX * indice->baldesY, sizeof(Balde));
+    indice->tabela = (Antena**)calloc((size_t)indice->capTabela, sizeof(Antena*));
+    if (!indice->baldes || !indice->tabela) {
+        printf("Erro ao alocar memoria!\n");
+        libertarIndice(indice);
+        return NULL;
+    }
+    for (Antena* atual = lista; atual; atual = atual->prox) {
+        if (!indiceInserir(indice, atual)) {
+            libertarIndice(indice);
+            return NULL;
+        }
+    }
+    return indice;
+}
+
+/**
+ * @brief Liberta a memória alocada para o índice (as antenas não são libertadas)
+ *
+ * @param indice Índice a libertar
+ */
+void libertarIndice(IndiceEspacial* indice) {
+    if (!indice) return;
+    if (indice->baldes) {
+        for (int i = 0; i < indice->baldesX * indice->baldesY; i++) free(indice->baldes[i].antenas);
+    }
+    free(indice->baldes);
+    free(indice->tabela);
+    free(indice);
+}
+
+/**
+ * @brief Acrescenta uma antena ao índice
+ *
+ * @param indice Índice onde acrescentar
+ * @param antena Nó da lista a acrescentar
+ * @return int 1 se a antena foi acrescentada com sucesso, 0 caso contrário
+ */
+int indiceInserir(IndiceEspacial* indice, Antena* antena) {
+    if (!indice || !antena) return 0;
+    if (2 * (indice->numAntenas + 1) > indice->capTabela && !aumentarTabela(indice)) return 0;
+    Balde* balde = baldeDe(indice, antena->x, antena->y);
+    if (balde->num == balde->cap) {
+        int cap = balde->cap ? balde->cap * 2 : 4;
+        Antena** novo = (Antena**)realloc(balde->antenas, (size_t)cap * sizeof(Antena*));
+        if (!novo) {
+            printf("Erro ao alocar memoria!\n");
+            return 0;
+        }
+        balde->antenas = novo;
+        balde->cap = cap;
+    }
+    balde->antenas[balde->num++] = antena;
+    inserirNaTabela(indice->tabela, indice->capTabela, antena);
+    indice->numAntenas++;
+    return 1;
+}
+
+/**
+ * @brief Retira uma antena do índice
+ *
+ * @param indice Índice de onde retirar
+ * @param antena Nó da lista a retirar
+ * @return int 1 se a antena foi retirada com sucesso, 0 caso contrário
+ */
+int indiceRemover(IndiceEspacial* indice, Antena* antena) {
+    if (!indice || !antena) return 0;
+    int cap = indice->capTabela;
+    int i = dispersao(antena->x, antena->y, cap);
+    while (indice->tabela[i] && indice->tabela[i] != antena) i = (i + 1) & (cap - 1);
+    if (!indice->tabela[i]) return 0;
+
+    // Remoção com recuo: puxa para trás as entradas seguintes que deixariam de ser encontradas
+    indice->tabela[i] = NULL;
+    for (int j = (i + 1) & (cap - 1); indice->tabela[j]; j = (j + 1) & (cap - 1)) {
+        int origem = dispersao(indice->tabela[j]->x, indice->tabela[j]->y, cap);
+        if (((j - origem) & (cap - 1)) >= ((j - i) & (cap - 1))) {
+            indice->tabela[i] = indice->tabela[j];
+            indice->tabela[j] = NULL;
+            i = j;
+        }
+    }
+
+    Balde* balde = baldeDe(indice, antena->x, antena->y);
+    for (int k = 0; k < balde->num; k++) {
+        if (balde->antenas[k] == antena) {
+            balde->antenas[k] = balde->antenas[--balde->num];
+            break;
+        }
+    }
+    indice->numAntenas--;
+    return 1;
+}
+
+/**
+ * @brief Procura a antena numa posição, em O(1)
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return Antena* Antena encontrada, ou NULL se a posição estiver livre
+ */
+Antena* antenaEm(const IndiceEspacial* indice, int x, int y) {
+    if (!indice) return NULL;
+    int cap = indice->capTabela;
+    for (int i = dispersao(x, y, cap); indice->tabela[i]; i = (i + 1) & (cap - 1)) {
+        if (indice->tabela[i]->x == x && indice->tabela[i]->y == y) return indice->tabela[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Conta as antenas que ocupam uma posição
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return int Número de antenas na posição
+ */
+int contarAntenasEm(const IndiceEspacial* indice, int x, int y) {
+    if (!indice) return 0;
+    int cap = indice->capTabela, num = 0;
+    for (int i = dispersao(x, y, cap); indice->tabela[i]; i = (i + 1) & (cap - 1)) {
+        if (indice->tabela[i]->x == x && indice->tabela[i]->y == y) num++;
+    }
+    return num;
+}
+
+/**
+ * @brief Procura as antenas dentro de um retângulo (limites incluídos)
+ *
+ * @param indice Índice onde procurar
+ * @param x0 Coordenada x do canto superior esquerdo
+ * @param y0 Coordenada y do canto superior esquerdo
+ * @param x1 Coordenada x do canto inferior direito
+ * @param y1 Coordenada y do canto inferior direito
+ * @param resultado Vetor onde guardar as antenas encontradas
+ * @param max Capacidade do vetor resultado
+ * @return int Número total de antenas no retângulo (só as primeiras max são guardadas)
+ */
+int antenasNoRetangulo(const IndiceEspacial* indice, int x0, int y0, int x1, int y1, Antena** resultado, int max) {
+    if (!indice || x0 > x1 || y0 > y1) return 0;
+    int bx0 = x0 < 0 ? 0 : x0 / indice->lado, bx1 = x1 < 0 ? 0 : x1 / indice->lado;
+    int by0 = y0 < 0 ? 0 : y0 / indice->lado, by1 = y1 < 0 ? 0 : y1 / indice->lado;
+    if (bx1 >= indice->baldesX) bx1 = indice->baldesX - 1;
+    if (by1 >= indice->baldesY) by1 = indice->baldesY - 1;
+    if (bx0 > bx1) bx0 = bx1;
+    if (by0 > by1) by0 = by1;
+    int num = 0;
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            const Balde* balde = &indice->baldes[by * indice->baldesX + bx];
+            for (int k = 0; k < balde->num; k++) {
+                Antena* a = balde->antenas[k];
+                if (a->x < x0 || a->x > x1 || a->y < y0 || a->y > y1) continue;
+                if (num < max) resultado[num] = a;
+                num++;
+            }
+        }
+    }
+    return num;
+}
+
+/**
+ * @brief Procura as antenas a uma distância euclidiana não superior a raio de um ponto
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x do centro
+ * @param y Coordenada y do centro
+ * @param raio Raio da procura
+ * @param resultado Vetor onde guardar as antenas encontradas
+ * @param max Capacidade do vetor resultado
+ * @return int Número total de antenas no círculo (só as primeiras max são guardadas)
+ */
+int antenasNoRaio(const IndiceEspacial* indice, int x, int y, int raio, Antena** resultado, int max) {
+    if (!indice || raio < 0) return 0;
+    long long r2 = (long long)raio * raio;
+    int bx0 = x - raio < 0 ? 0 : (x - raio) / indice->lado, bx1 = x + raio < 0 ? 0 : (x + raio) / indice->lado;
+    int by0 = y - raio < 0 ? 0 : (y - raio) / indice->lado, by1 = y + raio < 0 ? 0 : (y + raio) / indice->lado;
+    if (bx1 >= indice->baldesX) bx1 = indice->baldesX - 1;
+    if (by1 >= indice->baldesY) by1 = indice->baldesY - 1;
+    if (bx0 > bx1) bx0 = bx1;
+    if (by0 > by1) by0 = by1;
+    int num = 0;
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            const Balde* balde = &indice->baldes[by * indice->baldesX + bx];
+            for (int k = 0; k < balde->num; k++) {
+                Antena* a = balde->antenas[k];
+                long long dx = a->x - x, dy = a->y - y;
+                if (dx * dx + dy * dy > r2) continue;
+                if (num < max) resultado[num] = a;
+                num++;
+            }
+        }
+    }
+    return num;
+}
+
+/**
+ * @brief Indica se a antena a está mais longe do que b (desempate por y e depois por x)
+ * @internal
+ * @param a Primeira antena
+ * @param da Quadrado da distância de a
+ * @param b Segunda antena
+ * @param db Quadrado da distância de b
+ * @return int 1 se a está mais longe do que b, 0 caso contrário
+ */
+static int maisLonge(const Antena* a, long long da, const Antena* b, long long db) {
+    if (da != db) return da > db;
+    if (a->y != b->y) return a->y > b->y;
+    return a->x > b->x;
+}
+
+/**
+ * @brief Procura as k antenas mais próximas de um ponto
+ *
+ * Percorre os baldes em anéis à volta do ponto e pára assim que nenhum anel seguinte pode conter uma antena mais próxima.
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x do ponto
+ * @param y Coordenada y do ponto
+ * @param k Número de antenas pretendido
+ * @param freq Frequência das antenas pretendidas, ou '\0' para qualquer frequência
+ * @param resultado Vetor com espaço para k antenas, ordenado por distância crescente
+ * @return int Número de antenas encontradas (no máximo k)
+ */
+int antenasMaisProximas(const IndiceEspacial* indice, int x, int y, int k, char freq, Antena** resultado) {
+    if (!indice || k < 1) return 0;
+    long long* dist = (long long*)malloc((size_t)k * sizeof(long long));
+    if (!dist) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    const Balde* centro = baldeDe(indice, x, y);
+    int cbx = (int)((centro - indice->baldes) % indice->baldesX);
+    int cby = (int)((centro - indice->baldes) / indice->baldesX);
+    int maxAnel = indice->baldesX > indice->baldesY ? indice->baldesX : indice->baldesY;
+    int num = 0; // resultado[0..num) é um max-heap pela distância
+
+    for (int anel = 0; anel <= maxAnel; anel++) {
+        if (num == k && anel > 0) {
+            long long limite = (long long)(anel - 1) * indice->lado + 1;
+            if (limite * limite > dist[0]) break;
+        }
+        for (int by = cby - anel; by <= cby + anel; by++) {
+            if (by < 0 || by >= indice->baldesY) continue;
+            int passo = (by == cby - anel || by == cby + anel) ? 1 : 2 * anel;
+            for (int bx = cbx - anel; bx <= cbx + anel; bx += passo > 0 ? passo : 1) {
+                if (bx < 0 || bx >= indice->baldesX) continue;
+                const Balde* balde = &indice->baldes[by * indice->baldesX + bx];
+                for (int b = 0; b < balde->num; b++) {
+                    Antena* a = balde->antenas[b];
+                    if (freq && a->frequencia != freq) continue;
+                    long long dx = a->x - x, dy = a->y - y, d = dx * dx + dy * dy;
+                    int i;
+                    if (num < k) { // Sobe no heap
+                        i = num++;
+                        while (i > 0 && maisLonge(a, d, resultado[(i - 1) / 2], dist[(i - 1) / 2])) {
+                            resultado[i] = resultado[(i - 1) / 2];
+                            dist[i] = dist[(i - 1) / 2];
+                            i = (i - 1) / 2;
+                        }
+                    } else if (maisLonge(resultado[0], dist[0], a, d)) { // Substitui o mais longe e desce
+                        i = 0;
+                        for (;;) {
+                            int f = 2 * i + 1;
+                            if (f >= k) break;
+                            if (f + 1 < k && maisLonge(resultado[f + 1], dist[f + 1], resultado[f], dist[f])) f++;
+                            if (!maisLonge(resultado[f], dist[f], a, d)) break;
+                            resultado[i] = resultado[f];
+                            dist[i] = dist[f];
+                            i = f;
+                        }
+                    } else continue;
+                    resultado[i] = a;
+                    dist[i] = d;
+                }
+            }
+        }
+    }
+
+    // Ordena o heap por distância crescente
+    for (int fim = num - 1; fim > 0; fim--) {
+        Antena* a = resultado[fim];
+        long long d = dist[fim];
+        resultado[fim] = resultado[0];
+        dist[fim] = dist[0];
+        int i = 0;
+        for (;;) {
+            int f = 2 * i + 1;
+            if (f >= fim) break;
+            if (f + 1 < fim && maisLonge(resultado[f + 1], dist[f + 1], resultado[f], dist[f])) f++;
+            if (!maisLonge(resultado[f], dist[f], a, d)) break;
+            resultado[i] = resultado[f];
+            dist[i] = dist[f];
+            i = f;
+        }
+        resultado[i] = a;
+        dist[i] = d;
+    }
+    free(dist);
+    return num;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file indice.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções do índice espacial das antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Cria um índice espacial a partir de uma lista de antenas
+ *
+ * O lado dos baldes é escolhido para que cada balde tenha, em média, cerca de duas antenas.
+ *
+ * @param lista Lista de antenas a indexar
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return IndiceEspacial* Apontador para o índice criado, ou NULL em caso de erro
+ * @attention inserirAntena e ordenarAntenas trocam os dados entre os nós, pelo que o índice deve ser recriado depois delas
+ */
+IndiceEspacial* criarIndice(Antena* lista, int linhas, int colunas);
+/**
+ * @brief Liberta a memória alocada para o índice (as antenas não são libertadas)
+ *
+ * @param indice Índice a libertar
+ */
+void libertarIndice(IndiceEspacial* indice);
+/**
+ * @brief Acrescenta uma antena ao índice
+ *
+ * @param indice Índice onde acrescentar
+ * @param antena Nó da lista a acrescentar
+ * @return int 1 se a antena foi acrescentada com sucesso, 0 caso contrário
+ */
+int indiceInserir(IndiceEspacial* indice, Antena* antena);
+/**
+ * @brief Retira uma antena do índice
+ *
+ * @param indice Índice de onde retirar
+ * @param antena Nó da lista a retirar
+ * @return int 1 se a antena foi retirada com sucesso, 0 caso contrário
+ */
+int indiceRemover(IndiceEspacial* indice, Antena* antena);
+/**
+ * @brief Procura a antena numa posição, em O(1)
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return Antena* Antena encontrada, ou NULL se a posição estiver livre
+ */
+Antena* antenaEm(const IndiceEspacial* indice, int x, int y);
+/**
+ * @brief Conta as antenas que ocupam uma posição
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return int Número de antenas na posição
+ */
+int contarAntenasEm(const IndiceEspacial* indice, int x, int y);
+/**
+ * @brief Procura as antenas dentro de um retângulo (limites incluídos)
+ *
+ * @param indice Índice onde procurar
+ * @param x0 Coordenada x do canto superior esquerdo
+ * @param y0 Coordenada y do canto superior esquerdo
+ * @param x1 Coordenada x do canto inferior direito
+ * @param y1 Coordenada y do canto inferior direito
+ * @param resultado Vetor onde guardar as antenas encontradas
+ * @param max Capacidade do vetor resultado
+ * @return int Número total de antenas no retângulo (só as primeiras max são guardadas)
+ */
+int antenasNoRetangulo(const IndiceEspacial* indice, int x0, int y0, int x1, int y1, Antena** resultado, int max);
+/**
+ * @brief Procura as antenas a uma distância euclidiana não superior a raio de um ponto
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x do centro
+ * @param y Coordenada y do centro
+ * @param raio Raio da procura
+ * @param resultado Vetor onde guardar as antenas encontradas
+ * @param max Capacidade do vetor resultado
+ * @return int Número total de antenas no círculo (só as primeiras max são guardadas)
+ */
+int antenasNoRaio(const IndiceEspacial* indice, int x, int y, int raio, Antena** resultado, int max);
+/**
+ * @brief Procura as k antenas mais próximas de um ponto
+ *
+ * Percorre os baldes em anéis à volta do ponto e pára assim que nenhum anel seguinte pode conter uma antena mais próxima.
+ *
+ * @param indice Índice onde procurar
+ * @param x Coordenada x do ponto
+ * @param y Coordenada y do ponto
+ * @param k Número de antenas pretendido
+ * @param freq Frequência das antenas pretendidas, ou '\0' para qualquer frequência
+ * @param resultado Vetor com espaço para k antenas, ordenado por distância crescente
+ * @return int Número de antenas encontradas (no máximo k)
+ */
+int antenasMaisProximas(const IndiceEspacial* indice, int x, int y, int k, char freq, Antena** resultado);
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file leitor.c
+ * @author Hugo Baptista
+ * @brief Implementação da leitura paralela de ficheiros de mapas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "leitor.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Tamanho do buffer de linha usado por carregarAntenas (as linhas maiores são divididas)
+ */
+#define TAMANHO_LINHA 100
+
+/**
+ * @brief Mapeia um ficheiro inteiro em memória, só para leitura
+ *
+ * @param filename Nome do ficheiro a ler
+ * @param tamanho Número de bytes do ficheiro (saída)
+ * @return char* Conteúdo do ficheiro, ou NULL em caso de erro
+ * @attention Em Windows o ficheiro é lido em modo de texto para um buffer, como faria o fgets
+ */
+char* mapearFicheiro(const char* filename, size_t* tamanho) {
+    *tamanho = 0;
+#ifdef _WIN32
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return NULL;
+    }
+    size_t cap = TAMANHO_BLOCO, lidos;
+    char* dados = (char*)malloc(cap);
+    while (dados && (lidos = fread(dados + *tamanho, 1, cap - *tamanho, file)) > 0) {
+        *tamanho += lidos;
+        if (*tamanho == cap) {
+            char* novo = (char*)realloc(dados, cap * 2);
+            if (!novo) {
+                free(dados);
+                dados = NULL;
+                break;
+            }
+            dados = novo;
+            cap *= 2;
+        }
+    }
+    fclose(file);
+    if (!dados) printf("Erro ao alocar memoria!\n");
+    return dados;
+#else
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        printf("Erro ao abrir o ficheiro!\n");
+        if (fd >= 0) close(fd);
+        return NULL;
+    }
+    if (info.st_size == 0) { // mmap não aceita ficheiros vazios
+        close(fd);
+        char* vazio = (char*)calloc(1, 1);
+        if (!vazio) printf("Erro ao alocar memoria!\n");
+        return vazio;
+    }
+    void* dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return NULL;
+    }
+    madvise(dados, (size_t)info.st_size, MADV_SEQUENTIAL);
+    *tamanho = (size_t)info.st_size;
+    return (char*)dados;
+#endif
+}
+
+/**
+ * @brief Liberta um ficheiro mapeado com mapearFicheiro
+ *
+ * @param dados Conteúdo do ficheiro
+ * @param tamanho Número de bytes do ficheiro
+ */
+void libertarFicheiro(char* dados, size_t tamanho) {
+    if (!dados) return;
+#ifdef _WIN32
+    (void)tamanho;
+    free(dados);
+#else
+    if (tamanho == 0) free(dados);
+    else munmap(dados, tamanho);
+#endif
+}
+
+/**
+ * @brief Percorre um bloco de texto com as mesmas linhas que o fgets de carregarAntenas produziria
+ *
+ * Uma linha termina num '\n' ou ao fim de TAMANHO_LINHA - 1 caracteres; um '\0' termina a leitura
+ * da linha atual, como no ciclo de carregarAntenas. Sem lista de destino só conta as linhas.
+ *
+ * @internal
+ * @param inicio Início do bloco (início de uma linha)
+ * @param fim Fim do bloco
+ * @param y0 Número da primeira linha do bloco
+ * @param lista Lista onde colocar as antenas do bloco (por y e, em cada linha, por x decrescente), ou NULL
+ * @return int Número de linhas do bloco
+ */
+static int percorrerBloco(const char* inicio, const char* fim, int y0, Antena** lista) {
+    int linhas = 0, x = 0, aberta = 0, ativa = 0;
+    Antena* linhaAtual = NULL;
+    Antena** cauda = lista;
+    for (const char* p = inicio; p < fim; p++) {
+        if (lista && y0 + linhas >= MAX_LINHAS && !aberta) break; // As linhas seguintes já não têm antenas válidas
+        if (!aberta) {
+            aberta = ativa = 1;
+            x = 0;
+            linhas++;
+        }
+        char c = *p;
+        if (c != '\n') {
+            if (c == '\0') ativa = 0;
+            if (lista && ativa && c != '.' && c != '#') {
+                Antena* nova = criarAntena(c, x, y0 + linhas - 1);
+                if (nova) { // Em cada linha a antena mais à direita fica à frente
+                    nova->prox = linhaAtual;
+                    linhaAtual = nova;
+                }
+            }
+            x++;
+        }
+        if (c == '\n' || x == TAMANHO_LINHA - 1) {
+            aberta = 0;
+            if (lista && linhaAtual) {
+                *cauda = linhaAtual;
+                while (*cauda) cauda = &(*cauda)->prox;
+                linhaAtual = NULL;
+            }
+        }
+    }
+    if (lista && linhaAtual) {
+        *cauda = linhaAtual;
+        while (*cauda) cauda = &(*cauda)->prox;
+    }
+    return linhas;
+}
+
+/**
+ * @brief Carrega as antenas de um ficheiro para uma lista ligada, lendo blocos do ficheiro em paralelo
+ *
+ * O ficheiro é dividido em blocos que começam no início de uma linha. Cada thread conta as linhas
+ * dos seus blocos, uma soma de prefixos dá a linha inicial de cada bloco, e cada thread constrói a
+ * lista das antenas dos seus blocos; no fim as listas são juntadas pela ordem dos blocos.
+ * O resultado é igual ao de carregarAntenas, incluindo a divisão das linhas com mais de 99 caracteres.
+ *
+ * @param filename Nome do ficheiro a carregar
+ * @return Antena* Lista de antenas carregada, ordenada por y e, em cada linha, por x decrescente
+ */
+Antena* carregarAntenasParalelo(const char* filename) {
+    size_t tamanho;
+    char* dados = mapearFicheiro(filename, &tamanho);
+    if (!dados) return NULL;
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    size_t maxBlocos = tamanho / TAMANHO_BLOCO + 1;
+    int numBlocos = maxBlocos < (size_t)numThreads * 4 ? (int)maxBlocos : numThreads * 4;
+    size_t* inicios = (size_t*)malloc(((size_t)numBlocos + 1) * sizeof(size_t));
+    int* primeiraLinha = (int*)malloc(((size_t)numBlocos + 1) * sizeof(int));
+    Antena** listas = (Antena**)calloc((size_t)numBlocos, sizeof(Antena*));
+    if (!inicios || !primeiraLinha || !listas) {
+        printf("Erro ao alocar memoria!\n");
+        free(inicios);
+        free(primeiraLinha);
+        free(listas);
+        libertarFicheiro(dados, tamanho);
+        return NULL;
+    }
+
+    // Cada bloco começa depois do primeiro '\n' a partir da sua fração do ficheiro
+    inicios[0] = 0;
+    inicios[numBlocos] = tamanho;
+    for (int b = 1; b < numBlocos; b++) {
+        size_t p = tamanho / numBlocos * b;
+        if (p < inicios[b - 1]) p = inicios[b - 1];
+        const char* nl = p < tamanho ? (const char*)memchr(dados + p, '\n', tamanho - p) : NULL;
+        inicios[b] = nl ? (size_t)(nl - dados) + 1 : tamanho;
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < numBlocos; b++) {
+        primeiraLinha[b + 1] = percorrerBloco(dados + inicios[b], dados + inicios[b + 1], 0, NULL);
+    }
+    primeiraLinha[0] = 0;
+    for (int b = 0; b < numBlocos; b++) primeiraLinha[b + 1] += primeiraLinha[b];
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < numBlocos; b++) {
+        if (primeiraLinha[b] < MAX_LINHAS) percorrerBloco(dados + inicios[b], dados + inicios[b + 1], primeiraLinha[b], &listas[b]);
+    }
+
+    // Junta as listas dos blocos pela ordem do ficheiro
+    Antena* lista = NULL;
+    Antena** cauda = &lista;
+    for (int b = 0; b < numBlocos; b++) {
+        *cauda = listas[b];
+        while (*cauda) cauda = &(*cauda)->prox;
+    }
+
+    free(inicios);
+    free(primeiraLinha);
+    free(listas);
+    libertarFicheiro(dados, tamanho);
+    return lista;
+}
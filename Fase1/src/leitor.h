@@ -0,0 +1,48 @@
+/**
+ * @file leitor.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de leitura paralela de ficheiros de mapas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Tamanho mínimo de cada bloco do ficheiro lido por uma thread (1 MiB)
+ */
+#define TAMANHO_BLOCO (1 << 20)
+
+/**
+ * @brief Mapeia um ficheiro inteiro em memória, só para leitura
+ *
+ * @param filename Nome do ficheiro a ler
+ * @param tamanho Número de bytes do ficheiro (saída)
+ * @return char* Conteúdo do ficheiro, ou NULL em caso de erro
+ * @attention Em Windows o ficheiro é lido em modo de texto para um buffer, como faria o fgets
+ */
+char* mapearFicheiro(const char* filename, size_t* tamanho);
+/**
+ * @brief Liberta um ficheiro mapeado com mapearFicheiro
+ *
+ * @param dados Conteúdo do ficheiro
+ * @param tamanho Número de bytes do ficheiro
+ */
+void libertarFicheiro(char* dados, size_t tamanho);
+/**
+ * @brief Carrega as antenas de um ficheiro para uma lista ligada, lendo blocos do ficheiro em paralelo
+ *
+ * O ficheiro é dividido em blocos que começam no início de uma linha. Cada thread conta as linhas
+ * dos seus blocos, uma soma de prefixos dá a linha inicial de cada bloco, e cada thread constrói a
+ * lista das antenas dos seus blocos; no fim as listas são juntadas pela ordem dos blocos.
+ * O resultado é igual ao de carregarAntenas, incluindo a divisão das linhas com mais de 99 caracteres.
+ *
+ * @param filename Nome do ficheiro a carregar
+ * @return Antena* Lista de antenas carregada, ordenada por y e, em cada linha, por x decrescente
+ */
+Antena* carregarAntenasParalelo(const char* filename);
+
+#endif
@@ -11,6 +11,8 @@
 #include <string.h>
 #include "estruturas.h"
 #include "lista.h"
+#include "saida.h"
+#include "indice.h"
 
 
 /**
@@ -73,6 +75,7 @@ Nefasto* criarNefasto(int x, int y) {
  * @param x Coordenada x da antena a inserir
  * @param y Coordenada y da antena a inserir
  * @return int 1 se a antena foi inserida com sucesso, 0 caso contrário
+ * @attention Não atualiza o índice espacial da lista: como ordenarAntenas troca os dados entre os nós, um índice criado antes tem de ser recriado com criarIndice (indiceInserir sobre a nova antena não chega)
  */
 int inserirAntena(Antena** lista, char freq, int x, int y) {
     Antena* nova = criarAntena(freq, x, y);
@@ -108,12 +111,33 @@ int inserirNefasto(Nefasto** lista, int x, int y) {
 /**
  * @brief Remove uma antena da lista ligada e liberta a memória
  * 
+ * Com um índice espacial a antena é encontrada em O(1) e retirada copiando para o seu nó a antena seguinte,
+ * o que mantém a ordem da lista. Sem índice, ou quando a antena é a última da lista, a procura é linear.
+ * 
  * @param lista Apontador para a lista de antenas
+ * @param indice Índice espacial da lista, mantido atualizado, ou NULL
  * @param x Coordenada x da antena a remover
  * @param y Coordenada y da antena a remover
  * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ * @attention O índice só se mantém atualizado numa lista ordenada por y, como a de carregarAntenas, em que ordenarAntenas não troca nós; depois de inserirAntena tem de ser recriado
  */
-int removerAntena(Antena** lista, int x, int y) {
+int removerAntena(Antena** lista, IndiceEspacial* indice, int x, int y) {
+    if (indice) {
+        Antena* alvo = antenaEm(indice, x, y);
+        if (!alvo) return 0;
+        if (alvo->prox && contarAntenasEm(indice, x, y) == 1) {
+            Antena* seguinte = alvo->prox;
+            indiceRemover(indice, alvo);
+            indiceRemover(indice, seguinte);
+            alvo->frequencia = seguinte->frequencia;
+            alvo->x = seguinte->x;
+            alvo->y = seguinte->y;
+            alvo->prox = seguinte->prox;
+            free(seguinte);
+            indiceInserir(indice, alvo);
+            return 1;
+        }
+    }
     Antena* atual = *lista, *anterior = NULL;
     while (atual && (atual->x != x || atual->y != y)) {
         anterior = atual;
@@ -122,11 +146,119 @@ int removerAntena(Antena** lista, int x, int y) {
     if (!atual) return 0;
     if (!anterior) *lista = atual->prox;
     else anterior->prox = atual->prox;
+    indiceRemover(indice, atual);
     free(atual);
     ordenarAntenas(lista);
     return 1;
 }
 
+/**
+ * @brief Aplica um lote de inserções e remoções de antenas, pela ordem dada
+ * 
+ * Numa lista ordenada por y, como a de carregarAntenas, o resultado (incluindo os estados) é o mesmo de
+ * chamar inserirAntena e removerAntena para cada operação, mas a lista é reconstruída uma única vez:
+ * as operações são resolvidas com uma pilha por posição (uma remoção retira a antena mais recente nessa
+ * posição) e no fim as antenas são distribuídas por linha, com as novas de cada linha à frente das
+ * existentes, da mais recente para a mais antiga. O custo é linear no tamanho da lista e do lote.
+ * 
+ * @param lista Apontador para a lista de antenas
+ * @param indice Índice espacial da lista, mantido atualizado, ou NULL
+ * @param operacoes Operações a aplicar
+ * @param num Número de operações
+ * @param estados Vetor com espaço para num estados (1 se a operação foi aplicada, 0 caso contrário), ou NULL
+ * @return int Número de operações aplicadas, ou -1 em caso de erro (a lista não é alterada)
+ * @attention Numa lista que não esteja ordenada por y, as antenas de cada linha ficam pela ordem da lista, enquanto
+ * ordenarAntenas (chamada por inserirAntena e removerAntena) não mantém essa ordem
+ */
+int aplicarLoteAntenas(Antena** lista, IndiceEspacial* indice, const OperacaoAntena* operacoes, int num, int* estados) {
+    if (num < 1) return 0;
+    int numAntenas = 0;
+    for (Antena* a = *lista; a; a = a->prox) numAntenas++;
+
+    // Antenas existentes em [0, numAntenas) e novas a seguir; cada posição tem uma cadeia de existentes
+    // (pela ordem da lista) e uma pilha de novas (a mais recente no topo)
+    Antena** nos = (Antena**)malloc((size_t)(numAntenas + num) * sizeof(Antena*));
+    int* seguinte = (int*)malloc((size_t)(numAntenas + num) * sizeof(int));
+    char* removida = (char*)calloc((size_t)(numAntenas + num), sizeof(char));
+    int* existentes = (int*)malloc((size_t)MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+    int* novas = (int*)malloc((size_t)MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+    if (!nos || !seguinte || !removida || !existentes || !novas) {
+        printf("Erro ao alocar memoria!\n");
+        free(nos);
+        free(seguinte);
+        free(removida);
+        free(existentes);
+        free(novas);
+        return -1;
+    }
+    for (int c = 0; c < MAX_LINHAS * MAX_COLUNAS; c++) existentes[c] = novas[c] = -1;
+    int i = 0;
+    for (Antena* a = *lista; a; a = a->prox) nos[i++] = a;
+    for (i = numAntenas - 1; i >= 0; i--) {
+        int c = nos[i]->y * MAX_COLUNAS + nos[i]->x;
+        seguinte[i] = existentes[c];
+        existentes[c] = i;
+    }
+
+    int numNovas = 0, aplicadas = 0;
+    for (i = 0; i < num; i++) {
+        const OperacaoAntena* op = &operacoes[i];
+        int ok = 0;
+        if (op->tipo == INSERIR_ANTENA) {
+            Antena* nova = criarAntena(op->frequencia, op->x, op->y);
+            if (nova) {
+                int j = numAntenas + numNovas++, c = op->y * MAX_COLUNAS + op->x;
+                nos[j] = nova;
+                seguinte[j] = novas[c];
+                novas[c] = j;
+                ok = 1;
+            }
+        } else if (op->tipo == REMOVER_ANTENA && op->x >= 0 && op->x < MAX_COLUNAS && op->y >= 0 && op->y < MAX_LINHAS) {
+            int c = op->y * MAX_COLUNAS + op->x;
+            int* topo = novas[c] >= 0 ? &novas[c] : &existentes[c];
+            if (*topo >= 0) {
+                removida[*topo] = 1;
+                *topo = seguinte[*topo];
+                ok = 1;
+            }
+        }
+        if (estados) estados[i] = ok;
+        aplicadas += ok;
+    }
+
+    // Distribui as antenas por linha: primeiro as novas (da mais recente para a mais antiga), depois as existentes
+    Antena* cabecas[MAX_LINHAS] = {NULL};
+    Antena* caudas[MAX_LINHAS] = {NULL};
+    for (int k = 0; k < numAntenas + numNovas; k++) {
+        int j = k < numNovas ? numAntenas + numNovas - 1 - k : k - numNovas;
+        Antena* a = nos[j];
+        if (removida[j]) {
+            if (j < numAntenas) indiceRemover(indice, a);
+            free(a);
+            continue;
+        }
+        if (j >= numAntenas) indiceInserir(indice, a);
+        a->prox = NULL;
+        if (!cabecas[a->y]) cabecas[a->y] = a;
+        else caudas[a->y]->prox = a;
+        caudas[a->y] = a;
+    }
+    Antena** fim = lista;
+    for (int y = 0; y < MAX_LINHAS; y++) {
+        if (!cabecas[y]) continue;
+        *fim = cabecas[y];
+        fim = &caudas[y]->prox;
+    }
+    *fim = NULL;
+
+    free(nos);
+    free(seguinte);
+    free(removida);
+    free(existentes);
+    free(novas);
+    return aplicadas;
+}
+
 /**
  * @brief Ordena as antenas por ordem crescente de y
  * 
@@ -222,20 +354,58 @@ Nefasto* detetarEfeitosNefastos(Antena* lista) {
     return efeitos;
 }
 
+/**
+ * @brief Escreve a tabela de antenas numa saída em bloco
+ * @internal
+ * @param saida Saída onde escrever
+ * @param lista Lista de antenas
+ */
+static void escreverAntenas(Saida* saida, Antena* lista) {
+    escreverTexto(saida, "\nLista de Antenas:\n");
+    escreverTexto(saida, "Frequencia | Coordenadas\n");
+    escreverTexto(saida, "------------------------\n");
+    for (; lista; lista = lista->prox) {
+        escreverBytes(saida, "    ", 4);
+        escreverCaracter(saida, lista->frequencia);
+        escreverBytes(saida, "      | (X:", 11);
+        escreverInteiro(saida, lista->x);
+        escreverBytes(saida, ", Y:", 4);
+        escreverInteiro(saida, lista->y);
+        escreverBytes(saida, ")\n", 2);
+    }
+    escreverTexto(saida, "------------------------\n");
+}
+
+/**
+ * @brief Escreve a tabela de efeitos nefastos numa saída em bloco
+ * @internal
+ * @param saida Saída onde escrever
+ * @param lista Lista de efeitos nefastos
+ */
+static void escreverEfeitos(Saida* saida, Nefasto* lista) {
+    escreverTexto(saida, "\nEfeitos Nefastos:\n");
+    escreverTexto(saida, "Coordenadas\n");
+    escreverTexto(saida, "------------\n");
+    for (; lista; lista = lista->prox) {
+        escreverBytes(saida, "# |  (X:", 8);
+        escreverInteiro(saida, lista->x);
+        escreverBytes(saida, ", Y:", 4);
+        escreverInteiro(saida, lista->y);
+        escreverBytes(saida, ")\n", 2);
+    }
+    escreverTexto(saida, "------------\n");
+}
+
 /**
  * @brief Imprime a lista de antenas
  * 
  * @param lista Lista de antenas
  */
 void imprimirAntenas(Antena* lista) {
-    printf("\nLista de Antenas:\n");
-    printf("Frequencia | Coordenadas\n");
-    printf("------------------------\n");
-    while (lista) {
-        printf("    %c      | (X:%d, Y:%d)\n", lista->frequencia, lista->x, lista->y);
-        lista = lista->prox;
-    }
-    printf("------------------------\n");
+    Saida saida;
+    if (!abrirSaida(&saida, NULL)) return;
+    escreverAntenas(&saida, lista);
+    fecharSaida(&saida);
 }
 
 /**
@@ -244,14 +414,10 @@ void imprimirAntenas(Antena* lista) {
  * @param lista Lista de efeitos nefastos
  */
 void imprimirEfeitosNefastos(Nefasto* lista) {
-    printf("\nEfeitos Nefastos:\n");
-    printf("Coordenadas\n");
-    printf("------------\n");
-    while (lista) {
-        printf("# |  (X:%d, Y:%d)\n", lista->x, lista->y);
-        lista = lista->prox;
-    }
-    printf("------------\n");
+    Saida saida;
+    if (!abrirSaida(&saida, NULL)) return;
+    escreverEfeitos(&saida, lista);
+    fecharSaida(&saida);
 }
 
 /**
@@ -418,12 +584,13 @@ int contarColunas(const char* filename) {
  * @param linhas Número de linhas da matriz
  */
 void imprimirMatriz(char** matriz, int linhas) {
-    printf("\n   MATRIZ\n");
-    printf(" ----------\n\n");
-    for (int i = 0; i < linhas; i++) {
-        printf("%s\n", matriz[i]);
-    }
-    printf("\n------------\n");
+    Saida saida;
+    if (!abrirSaida(&saida, NULL)) return;
+    escreverTexto(&saida, "\n   MATRIZ\n");
+    escreverTexto(&saida, " ----------\n\n");
+    escreverLinhas(&saida, matriz, linhas);
+    escreverTexto(&saida, "\n------------\n");
+    fecharSaida(&saida);
 }
 
 /**
@@ -435,32 +602,18 @@ void imprimirMatriz(char** matriz, int linhas) {
  * @return int 1 se as listas foram guardadas com sucesso, 0 caso contrário
  */
 int guardarListas(Antena* antenas, Nefasto* efeitos, const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
+    Saida saida;
+    if (!abrirSaida(&saida, filename)) {
         printf("Erro ao abrir o ficheiro!\n");
         return 0;
     }
     if (!antenas || !efeitos) {
-        fprintf(file, "Nada a guardar!\n");
-        fclose(file);
-        return 1;
-    }
-    fprintf(file, "\nLista de Antenas:\n");
-    fprintf(file, "Frequencia | Coordenadas\n");
-    fprintf(file, "------------------------\n");
-    for (Antena* atual = antenas; atual; atual = atual->prox) {
-        fprintf(file, "    %c      | (X:%d, Y:%d)\n", atual->frequencia, atual->x, atual->y);
-    }
-    fprintf(file, "------------------------\n");
-    fprintf(file, "\nEfeitos Nefastos:\n");
-    fprintf(file, "Coordenadas\n");
-    fprintf(file,"------------\n");
-    for (Nefasto* atual = efeitos; atual; atual = atual->prox) {
-        fprintf(file, "# |  (X:%d, Y:%d)\n", atual->x, atual->y);
+        escreverTexto(&saida, "Nada a guardar!\n");
+        return fecharSaida(&saida);
     }
-    fprintf(file, "------------\n");
-    fclose(file);
-    return 1;
+    escreverAntenas(&saida, antenas);
+    escreverEfeitos(&saida, efeitos);
+    return fecharSaida(&saida);
 }
 
 /**
@@ -472,19 +625,15 @@ int guardarListas(Antena* antenas, Nefasto* efeitos, const char* filename) {
  * @return int 1 se a matriz foi guardada com sucesso, 0 caso contrário
  */
 int guardarMatriz(char** matriz, int linhas, const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
+    Saida saida;
+    if (!abrirSaida(&saida, filename)) {
         printf("Erro ao abrir o ficheiro!\n");
         return 0;
     }
     if (!matriz) {
-        fprintf(file, "Nada a guardar!\n");
-        fclose(file);
-        return 1;
-    }
-    for (int i = 0; i < linhas; i++) {
-        fprintf(file, "%s\n", matriz[i]);
+        escreverTexto(&saida, "Nada a guardar!\n");
+        return fecharSaida(&saida);
     }
-    fclose(file);
-    return 1;
+    escreverLinhas(&saida, matriz, linhas);
+    return fecharSaida(&saida);
 }
\ No newline at end of file
@@ -41,6 +41,7 @@ Nefasto* criarNefasto(int x, int y);
  * @param x Coordenada x da antena a inserir
  * @param y Coordenada y da antena a inserir
  * @return int 1 se a antena foi inserida com sucesso, 0 caso contrário
+ * @attention Não atualiza o índice espacial da lista: como ordenarAntenas troca os dados entre os nós, um índice criado antes tem de ser recriado com criarIndice (indiceInserir sobre a nova antena não chega)
  */
 int inserirAntena(Antena** lista, char freq, int x, int y);
 /**
@@ -55,12 +56,36 @@ int inserirNefasto(Nefasto** lista, int x, int y);
 /**
  * @brief Remove uma antena da lista ligada e liberta a memória
  * 
+ * Com um índice espacial a antena é encontrada em O(1) e retirada copiando para o seu nó a antena seguinte,
+ * o que mantém a ordem da lista. Sem índice, ou quando a antena é a última da lista, a procura é linear.
+ * 
  * @param lista Apontador para a lista de antenas
+ * @param indice Índice espacial da lista, mantido atualizado, ou NULL
  * @param x Coordenada x da antena a remover
  * @param y Coordenada y da antena a remover
  * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ * @attention O índice só se mantém atualizado numa lista ordenada por y, como a de carregarAntenas, em que ordenarAntenas não troca nós; depois de inserirAntena tem de ser recriado
  */
-int removerAntena(Antena** lista, int x, int y);
+int removerAntena(Antena** lista, IndiceEspacial* indice, int x, int y);
+/**
+ * @brief Aplica um lote de inserções e remoções de antenas, pela ordem dada
+ * 
+ * Numa lista ordenada por y, como a de carregarAntenas, o resultado (incluindo os estados) é o mesmo de
+ * chamar inserirAntena e removerAntena para cada operação, mas a lista é reconstruída uma única vez:
+ * as operações são resolvidas com uma pilha por posição (uma remoção retira a antena mais recente nessa
+ * posição) e no fim as antenas são distribuídas por linha, com as novas de cada linha à frente das
+ * existentes, da mais recente para a mais antiga. O custo é linear no tamanho da lista e do lote.
+ * 
+ * @param lista Apontador para a lista de antenas
+ * @param indice Índice espacial da lista, mantido atualizado, ou NULL
+ * @param operacoes Operações a aplicar
+ * @param num Número de operações
+ * @param estados Vetor com espaço para num estados (1 se a operação foi aplicada, 0 caso contrário), ou NULL
+ * @return int Número de operações aplicadas, ou -1 em caso de erro (a lista não é alterada)
+ * @attention Numa lista que não esteja ordenada por y, as antenas de cada linha ficam pela ordem da lista, enquanto
+ * ordenarAntenas (chamada por inserirAntena e removerAntena) não mantém essa ordem
+ */
+int aplicarLoteAntenas(Antena** lista, IndiceEspacial* indice, const OperacaoAntena* operacoes, int num, int* estados);
 /**
  * @brief Ordena as antenas por ordem crescente de y
  * 
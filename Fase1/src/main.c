@@ -8,13 +8,78 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include "estruturas.h"
 #include "lista.h"
+#include "indice.h"
+#include "eventos.h"
+#include "harmonicos.h"
+#include "vetorial.h"
+#include "diferencas.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     char ficheiroIN[] = "antenas.txt";
     char ficheiro_listasOUT[] = "listasOUT.txt";
     char ficheiro_matrizOUT[] = "matrizOUT.txt";
+
+    // Modo de eventos: main --eventos [-b] [-j microssegundos] [ficheiro de eventos]
+    if (argc > 1 && strcmp(argv[1], "--eventos") == 0) {
+        int binario = 0;
+        long janela = JANELA_EVENTOS;
+        const char* entrada = NULL;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "-b") == 0) binario = 1;
+            else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) janela = atol(argv[++i]);
+            else entrada = argv[i];
+        }
+        EstatisticasEventos estatisticas;
+        int ok = processarEventos(ficheiroIN, entrada, NULL, binario, janela, &estatisticas);
+        imprimirEstatisticasEventos(&estatisticas);
+        return ok ? 0 : 1;
+    }
+
+    // Modo de diferenças: main --diferencas <mapa antigo> <mapa novo> [ficheiro de saída]
+    if (argc > 1 && strcmp(argv[1], "--diferencas") == 0) {
+        if (argc < 4) {
+            printf("Uso: %s --diferencas <mapa antigo> <mapa novo> [ficheiro de saida]\n", argv[0]);
+            return 1;
+        }
+        DiferencaMapas diferenca;
+        if (!compararMapas(argv[2], argv[3], &diferenca)) return 1;
+        int ok = guardarDiferenca(&diferenca, argc > 4 ? argv[4] : NULL);
+        libertarDiferenca(&diferenca);
+        return ok ? 0 : 1;
+    }
+
+    // Modo de harmónicos: main --harmonicos
+    if (argc > 1 && strcmp(argv[1], "--harmonicos") == 0) {
+        Antena* lista = carregarAntenas(ficheiroIN);
+        if (!lista) return 1;
+        int linhas = contarLinhas(ficheiroIN), colunas = contarColunas(ficheiroIN);
+        // O mapa de bits é calculado aqui para distinguir um erro (-1) de um mapa sem efeitos (0):
+        // detetarEfeitosHarmonicos devolve NULL nos dois casos
+        uint64_t* mapa = (uint64_t*)malloc(((size_t)linhas * colunas + 63) / 64 * sizeof(uint64_t));
+        long long num = -1;
+        if (mapa) num = calcularHarmonicos(lista, linhas, colunas, mapa);
+        else printf("Erro ao alocar memoria!\n");
+        Nefasto* efeitos = num > 0 ? listaDeMapa(mapa, linhas, colunas) : NULL;
+        int ok = num >= 0;
+        if (ok) imprimirEfeitosNefastos(efeitos);
+        free(mapa);
+        while (efeitos) {
+            Nefasto* seguinte = efeitos->prox;
+            free(efeitos);
+            efeitos = seguinte;
+        }
+        while (lista) {
+            Antena* seguinte = lista->prox;
+            free(lista);
+            lista = seguinte;
+        }
+        return ok ? 0 : 1;
+    }
+
     Antena* lista = carregarAntenas(ficheiroIN);
     if (!lista) return 1;
     imprimirAntenas(lista);
@@ -39,9 +104,11 @@ int main() {
     printf("\nApos Atualizacao:\n");
     imprimirMatriz(matriz, linhas);
     
-    // Teste de remoção
-    removerAntena(&lista, 5, 5);
-    removerAntena(&lista, 6, 5);
+    // Teste de remoção (com o índice espacial)
+    IndiceEspacial* indice = criarIndice(lista, linhas, colunas);
+    removerAntena(&lista, indice, 5, 5);
+    removerAntena(&lista, indice, 6, 5);
+    libertarIndice(indice);
     printf("\nApos Remocao:\n");
     imprimirAntenas(lista);
     efeitos = detetarEfeitosNefastos(lista);
@@ -0,0 +1,219 @@
+/**
+ * @file morton.c
+ * @author Hugo Baptista
+ * @brief Implementação da ordenação das listas pela curva de Morton (ordem Z)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "morton.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define COM_BMI2
+#endif
+
+/**
+ * @brief Par (código de Morton, nó) ordenado pelo radix sort
+ * @internal
+ */
+typedef struct ParMorton {
+    uint64_t chave; /**< Posição empacotada (x nos 32 bits altos) e, depois de codificada, código de Morton */
+    void* no;       /**< Nó da lista */
+} ParMorton;
+
+/**
+ * @brief Espalha os 32 bits de v pelas posições pares de uma palavra de 64 bits
+ * @internal
+ * @param v Valor a espalhar
+ * @return uint64_t Valor com o bit i de v no bit 2i
+ */
+static inline uint64_t espalharBits(uint32_t v) {
+    uint64_t r = v;
+    r = (r | (r << 16)) & 0x0000FFFF0000FFFFULL;
+    r = (r | (r << 8)) & 0x00FF00FF00FF00FFULL;
+    r = (r | (r << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    r = (r | (r << 2)) & 0x3333333333333333ULL;
+    r = (r | (r << 1)) & 0x5555555555555555ULL;
+    return r;
+}
+
+/**
+ * @brief Calcula o código de Morton de uma posição
+ *
+ * Os bits de x ficam nas posições pares e os de y nas ímpares, pelo que posições próximas no mapa
+ * ficam, na maior parte dos casos, com códigos próximos. As coordenadas são deslocadas de 2^31 para
+ * que as negativas fiquem antes das positivas.
+ *
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return uint64_t Código de Morton da posição
+ */
+uint64_t codigoMorton(int x, int y) {
+    return espalharBits((uint32_t)x ^ 0x80000000u) | (espalharBits((uint32_t)y ^ 0x80000000u) << 1);
+}
+
+/**
+ * @brief Converte as posições empacotadas dos pares em códigos de Morton
+ * @internal
+ * @param pares Pares a converter
+ * @param num Número de pares
+ */
+static void codificarEscalar(ParMorton* pares, size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        uint64_t k = pares[i].chave;
+        pares[i].chave = espalharBits((uint32_t)(k >> 32)) | (espalharBits((uint32_t)k) << 1);
+    }
+}
+
+#ifdef COM_BMI2
+/**
+ * @brief Converte as posições empacotadas dos pares em códigos de Morton com PDEP (BMI2)
+ * @internal
+ * @param pares Pares a converter
+ * @param num Número de pares
+ */
+__attribute__((target("bmi2")))
+static void codificarBMI2(ParMorton* pares, size_t num) {
+    for (size_t i = 0; i < num; i++) {
+        uint64_t k = pares[i].chave;
+        pares[i].chave = _pdep_u64(k >> 32, 0x5555555555555555ULL) | _pdep_u64(k & 0xFFFFFFFFULL, 0xAAAAAAAAAAAAAAAAULL);
+    }
+}
+#endif
+
+/**
+ * @brief Ordena os pares pela chave (radix sort LSD estável com dígitos de 11 bits)
+ * @internal
+ * Os dígitos iguais em todas as chaves são saltados; como os bits altos dos códigos vêm do deslocamento
+ * das coordenadas, os mapas pequenos só precisam de duas ou três passagens.
+ * @param pares Pares a ordenar
+ * @param aux Vetor auxiliar com espaço para num pares
+ * @param num Número de pares
+ */
+static void ordenarPares(ParMorton* pares, ParMorton* aux, size_t num) {
+    size_t contagens[6][2048] = {{0}};
+    for (size_t i = 0; i < num; i++) {
+        for (int d = 0; d < 6; d++) contagens[d][(pares[i].chave >> (11 * d)) & 2047]++;
+    }
+    ParMorton* origem = pares, *destino = aux;
+    for (int d = 0; d < 6; d++) {
+        if (num == 0 || contagens[d][(pares[0].chave >> (11 * d)) & 2047] == num) continue; // Dígito constante
+        size_t soma = 0;
+        for (int b = 0; b < 2048; b++) {
+            size_t c = contagens[d][b];
+            contagens[d][b] = soma;
+            soma += c;
+        }
+        for (size_t i = 0; i < num; i++) destino[contagens[d][(origem[i].chave >> (11 * d)) & 2047]++] = origem[i];
+        ParMorton* t = origem;
+        origem = destino;
+        destino = t;
+    }
+    if (origem != pares) memcpy(pares, origem, num * sizeof(ParMorton));
+}
+
+/**
+ * @brief Codifica e ordena os pares, escolhendo a codificação suportada pelo processador
+ * @internal
+ * @param pares Pares com as posições empacotadas
+ * @param num Número de pares
+ * @return int 1 se os pares foram ordenados com sucesso, 0 caso contrário
+ */
+static int ordenarPorMorton(ParMorton* pares, size_t num) {
+    ParMorton* aux = (ParMorton*)malloc(num * sizeof(ParMorton));
+    if (!aux) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    void (*codificar)(ParMorton*, size_t) = codificarEscalar;
+#ifdef COM_BMI2
+    if (__builtin_cpu_supports("bmi2")) codificar = codificarBMI2;
+#endif
+    codificar(pares, num);
+    ordenarPares(pares, aux, num);
+    free(aux);
+    return 1;
+}
+
+/**
+ * @brief Empacota uma posição na chave inicial de um par
+ * @internal
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return uint64_t Posição deslocada de 2^31, com x nos 32 bits altos e y nos baixos
+ */
+static inline uint64_t empacotar(int x, int y) {
+    return ((uint64_t)((uint32_t)x ^ 0x80000000u) << 32) | ((uint32_t)y ^ 0x80000000u);
+}
+
+/**
+ * @brief Ordena as antenas pelo código de Morton da sua posição (ordem Z)
+ *
+ * Os nós são religados pela nova ordem sem trocar os seus dados, pelo que o índice espacial da lista
+ * continua válido. Os códigos são calculados com PDEP quando o processador tem BMI2 e ordenados com um
+ * radix sort estável, em tempo linear no tamanho da lista.
+ *
+ * @param lista Apontador para a lista de antenas
+ * @return int 1 se as antenas foram ordenadas com sucesso, 0 caso contrário
+ */
+int ordenarAntenasMorton(Antena** lista) {
+    size_t num = 0;
+    for (Antena* a = *lista; a; a = a->prox) num++;
+    if (num < 2) return 1;
+    ParMorton* pares = (ParMorton*)malloc(num * sizeof(ParMorton));
+    if (!pares) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    size_t i = 0;
+    for (Antena* a = *lista; a; a = a->prox, i++) {
+        pares[i].chave = empacotar(a->x, a->y);
+        pares[i].no = a;
+    }
+    if (!ordenarPorMorton(pares, num)) {
+        free(pares);
+        return 0;
+    }
+    for (i = 0; i + 1 < num; i++) ((Antena*)pares[i].no)->prox = (Antena*)pares[i + 1].no;
+    ((Antena*)pares[num - 1].no)->prox = NULL;
+    *lista = (Antena*)pares[0].no;
+    free(pares);
+    return 1;
+}
+
+/**
+ * @brief Ordena os efeitos nefastos pelo código de Morton da sua posição (ordem Z)
+ *
+ * @param lista Apontador para a lista de efeitos nefastos
+ * @return int 1 se os efeitos nefastos foram ordenados com sucesso, 0 caso contrário
+ */
+int ordenarEfeitosMorton(Nefasto** lista) {
+    size_t num = 0;
+    for (Nefasto* e = *lista; e; e = e->prox) num++;
+    if (num < 2) return 1;
+    ParMorton* pares = (ParMorton*)malloc(num * sizeof(ParMorton));
+    if (!pares) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    size_t i = 0;
+    for (Nefasto* e = *lista; e; e = e->prox, i++) {
+        pares[i].chave = empacotar(e->x, e->y);
+        pares[i].no = e;
+    }
+    if (!ordenarPorMorton(pares, num)) {
+        free(pares);
+        return 0;
+    }
+    for (i = 0; i + 1 < num; i++) ((Nefasto*)pares[i].no)->prox = (Nefasto*)pares[i + 1].no;
+    ((Nefasto*)pares[num - 1].no)->prox = NULL;
+    *lista = (Nefasto*)pares[0].no;
+    free(pares);
+    return 1;
+}
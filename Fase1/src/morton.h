@@ -0,0 +1,46 @@
+/**
+ * @file morton.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da ordenação das listas pela curva de Morton (ordem Z)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef MORTON_H
+#define MORTON_H
+
+#include <stdint.h>
+#include "estruturas.h"
+
+/**
+ * @brief Calcula o código de Morton de uma posição
+ *
+ * Os bits de x ficam nas posições pares e os de y nas ímpares, pelo que posições próximas no mapa
+ * ficam, na maior parte dos casos, com códigos próximos. As coordenadas são deslocadas de 2^31 para
+ * que as negativas fiquem antes das positivas.
+ *
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return uint64_t Código de Morton da posição
+ */
+uint64_t codigoMorton(int x, int y);
+/**
+ * @brief Ordena as antenas pelo código de Morton da sua posição (ordem Z)
+ *
+ * Os nós são religados pela nova ordem sem trocar os seus dados, pelo que o índice espacial da lista
+ * continua válido. Os códigos são calculados com PDEP quando o processador tem BMI2 e ordenados com um
+ * radix sort estável, em tempo linear no tamanho da lista.
+ *
+ * @param lista Apontador para a lista de antenas
+ * @return int 1 se as antenas foram ordenadas com sucesso, 0 caso contrário
+ */
+int ordenarAntenasMorton(Antena** lista);
+/**
+ * @brief Ordena os efeitos nefastos pelo código de Morton da sua posição (ordem Z)
+ *
+ * @param lista Apontador para a lista de efeitos nefastos
+ * @return int 1 se os efeitos nefastos foram ordenados com sucesso, 0 caso contrário
+ */
+int ordenarEfeitosMorton(Nefasto** lista);
+
+#endif
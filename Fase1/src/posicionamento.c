@@ -0,0 +1,220 @@
+/**
+ * @file posicionamento.c
+ * @author Hugo Baptista
+ * @brief Implementação da escolha da posição de uma nova antena
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "posicionamento.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Indica se o candidato a é pior do que b (mais efeitos novos; empate pela maior posição)
+ * @internal
+ * @param a Primeiro candidato
+ * @param b Segundo candidato
+ * @return int 1 se a é pior do que b, 0 caso contrário
+ */
+static int pior(const Candidato* a, const Candidato* b) {
+    if (a->novos != b->novos) return a->novos > b->novos;
+    if (a->y != b->y) return a->y > b->y;
+    return a->x > b->x;
+}
+
+/**
+ * @brief Compara dois candidatos para qsort (melhor primeiro)
+ * @internal
+ * @param a Primeiro candidato
+ * @param b Segundo candidato
+ * @return int Negativo, zero ou positivo, como em qsort
+ */
+static int compararCandidatos(const void* a, const void* b) {
+    return pior((const Candidato*)a, (const Candidato*)b) - pior((const Candidato*)b, (const Candidato*)a);
+}
+
+/**
+ * @brief Acrescenta um candidato a um max-heap de tamanho k (a raiz é o pior)
+ * @internal
+ * @param heap Heap de candidatos
+ * @param num Número de candidatos no heap (atualizado)
+ * @param k Capacidade do heap
+ * @param c Candidato a acrescentar
+ */
+static void guardarCandidato(Candidato* heap, int* num, int k, Candidato c) {
+    int i;
+    if (*num < k) {
+        i = (*num)++;
+        while (i > 0 && pior(&c, &heap[(i - 1) / 2])) {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        if (!pior(&heap[0], &c)) return;
+        i = 0;
+        for (;;) {
+            int f = 2 * i + 1;
+            if (f >= k) break;
+            if (f + 1 < k && pior(&heap[f + 1], &heap[f])) f++;
+            if (!pior(&heap[f], &c)) break;
+            heap[i] = heap[f];
+            i = f;
+        }
+    }
+    heap[i] = c;
+}
+
+/**
+ * @brief Avalia todas as posições livres do mapa para uma nova antena e devolve as k melhores
+ *
+ * Para cada posição livre c conta os efeitos nefastos novos que uma antena da frequência freq criaria:
+ * as células 2c - p e 2p - c, para cada antena p dessa frequência, que fiquem dentro do mapa e que
+ * ainda não sejam efeitos nefastos. Cada posição custa O(n) (n antenas da frequência), em vez de
+ * repetir a deteção completa. As linhas do mapa são repartidas entre as threads e uma posição deixa de
+ * ser avaliada assim que ultrapassa a pior das k melhores dessa thread.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param freq Frequência da nova antena
+ * @param k Número de posições pretendido
+ * @param resultado Vetor com espaço para k candidatos, do que cria menos efeitos novos para o que cria mais (empates por y e x)
+ * @return int Número de candidatos devolvidos, ou -1 em caso de erro
+ */
+int melhoresPosicoes(Antena* lista, int linhas, int colunas, char freq, int k, Candidato* resultado) {
+    if (linhas < 1 || colunas < 1 || k < 1) return -1;
+    size_t celulas = (size_t)linhas * colunas, palavras = (celulas + 63) / 64;
+
+    // Agrupa as antenas por frequência para marcar os efeitos já existentes e as posições ocupadas
+    int inicioFreq[257] = {0}, num = 0;
+    for (Antena* a = lista; a; a = a->prox, num++) inicioFreq[(unsigned char)a->frequencia + 1]++;
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    int* xs = (int*)malloc((size_t)(num > 0 ? num : 1) * sizeof(int));
+    int* ys = (int*)malloc((size_t)(num > 0 ? num : 1) * sizeof(int));
+    uint64_t* efeitos = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+    uint64_t* ocupadas = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+    if (!xs || !ys || !efeitos || !ocupadas) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        free(efeitos);
+        free(ocupadas);
+        return -1;
+    }
+    int pos[256];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (Antena* a = lista; a; a = a->prox) {
+        int p = pos[(unsigned char)a->frequencia]++;
+        xs[p] = a->x;
+        ys[p] = a->y;
+        if ((unsigned)a->x < (unsigned)colunas && (unsigned)a->y < (unsigned)linhas) {
+            size_t c = (size_t)a->y * colunas + a->x;
+            ocupadas[c / 64] |= 1ULL << (c % 64);
+        }
+    }
+    for (int f = 0; f < 256; f++) {
+        for (int i = inicioFreq[f]; i < inicioFreq[f + 1]; i++) {
+            for (int j = inicioFreq[f]; j < inicioFreq[f + 1]; j++) {
+                int x = 2 * xs[i] - xs[j], y = 2 * ys[i] - ys[j];
+                if (i == j || (unsigned)x >= (unsigned)colunas || (unsigned)y >= (unsigned)linhas) continue;
+                size_t c = (size_t)y * colunas + x;
+                efeitos[c / 64] |= 1ULL << (c % 64);
+            }
+        }
+    }
+
+    const int* px = xs + inicioFreq[(unsigned char)freq];
+    const int* py = ys + inicioFreq[(unsigned char)freq];
+    int n = inicioFreq[(unsigned char)freq + 1] - inicioFreq[(unsigned char)freq];
+    int capVistos = 16;
+    while (capVistos < 4 * n) capVistos *= 2;
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    Candidato* heaps = (Candidato*)malloc((size_t)numThreads * k * sizeof(Candidato));
+    int* numHeaps = (int*)calloc((size_t)numThreads, sizeof(int));
+    // Conjunto das células já contadas para o candidato atual, um por thread (marcadas com a geração do
+    // candidato); é alocado antes da região paralela para todas as threads chegarem ao omp for
+    size_t* todosVistos = (size_t*)malloc((size_t)numThreads * capVistos * sizeof(size_t));
+    unsigned int* todasGeracoes = (unsigned int*)calloc((size_t)numThreads * capVistos, sizeof(unsigned int));
+    int erro = !heaps || !numHeaps || !todosVistos || !todasGeracoes;
+
+    if (!erro) {
+        #pragma omp parallel num_threads(numThreads)
+        {
+            int t = 0;
+#ifdef _OPENMP
+            t = omp_get_thread_num();
+#endif
+            Candidato* heap = heaps + (size_t)t * k;
+            size_t* vistos = todosVistos + (size_t)t * capVistos;
+            unsigned int* geracao = todasGeracoes + (size_t)t * capVistos;
+            unsigned int atual = 0;
+            #pragma omp for schedule(dynamic, 1)
+            for (int y = 0; y < linhas; y++) {
+                for (int x = 0; x < colunas; x++) {
+                    size_t c = (size_t)y * colunas + x;
+                    if (ocupadas[c / 64] >> (c % 64) & 1) continue;
+                    int limite = numHeaps[t] == k ? heap[0].novos : n * 2 + 1;
+                    int novos = 0;
+                    if (++atual == 0) { // Volta completa do contador de gerações
+                        memset(geracao, 0, (size_t)capVistos * sizeof(unsigned int));
+                        atual = 1;
+                    }
+                    for (int p = 0; p < n && novos <= limite; p++) {
+                        int ex[2] = { 2 * x - px[p], 2 * px[p] - x };
+                        int ey[2] = { 2 * y - py[p], 2 * py[p] - y };
+                        for (int e = 0; e < 2; e++) {
+                            if ((unsigned)ex[e] >= (unsigned)colunas || (unsigned)ey[e] >= (unsigned)linhas) continue;
+                            size_t ce = (size_t)ey[e] * colunas + ex[e];
+                            if (efeitos[ce / 64] >> (ce % 64) & 1) continue;
+                            size_t h = (ce * 0x9E3779B97F4A7C15ULL >> 20) & (size_t)(capVistos - 1);
+                            while (geracao[h] == atual && vistos[h] != ce) h = (h + 1) & (size_t)(capVistos - 1);
+                            if (geracao[h] == atual) continue; // Já contada (3c = p1 + 2*p2)
+                            geracao[h] = atual;
+                            vistos[h] = ce;
+                            novos++;
+                        }
+                    }
+                    if (novos > limite) continue;
+                    Candidato cand = { x, y, novos };
+                    guardarCandidato(heap, &numHeaps[t], k, cand);
+                }
+            }
+        }
+    }
+    free(todosVistos);
+    free(todasGeracoes);
+
+    int total = -1;
+    if (!erro) {
+        // Junta os heaps das threads e fica com os k melhores
+        total = 0;
+        for (int t = 0; t < numThreads; t++) {
+            memmove(heaps + total, heaps + (size_t)t * k, (size_t)numHeaps[t] * sizeof(Candidato));
+            total += numHeaps[t];
+        }
+        qsort(heaps, (size_t)total, sizeof(Candidato), compararCandidatos);
+        if (total > k) total = k;
+        memcpy(resultado, heaps, (size_t)total * sizeof(Candidato));
+    } else {
+        printf("Erro ao alocar memoria!\n");
+    }
+
+    free(heaps);
+    free(numHeaps);
+    free(xs);
+    free(ys);
+    free(efeitos);
+    free(ocupadas);
+    return total;
+}
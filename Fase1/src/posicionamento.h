@@ -0,0 +1,33 @@
+/**
+ * @file posicionamento.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de escolha da posição de uma nova antena
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef POSICIONAMENTO_H
+#define POSICIONAMENTO_H
+
+#include "estruturas.h"
+
+/**
+ * @brief Avalia todas as posições livres do mapa para uma nova antena e devolve as k melhores
+ *
+ * Para cada posição livre c conta os efeitos nefastos novos que uma antena da frequência freq criaria:
+ * as células 2c - p e 2p - c, para cada antena p dessa frequência, que fiquem dentro do mapa e que
+ * ainda não sejam efeitos nefastos. Cada posição custa O(n) (n antenas da frequência), em vez de
+ * repetir a deteção completa. As linhas do mapa são repartidas entre as threads e uma posição deixa de
+ * ser avaliada assim que ultrapassa a pior das k melhores dessa thread.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param freq Frequência da nova antena
+ * @param k Número de posições pretendido
+ * @param resultado Vetor com espaço para k candidatos, do que cria menos efeitos novos para o que cria mais (empates por y e x)
+ * @return int Número de candidatos devolvidos, ou -1 em caso de erro
+ */
+int melhoresPosicoes(Antena* lista, int linhas, int colunas, char freq, int k, Candidato* resultado);
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file saida.c
+ * @author Hugo Baptista
+ * @brief Implementação das funções de escrita em bloco para ficheiros e para a consola
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include "estruturas.h"
+#include "saida.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#define ABRIR_FICHEIRO(nome, modo) _open(nome, _O_WRONLY | _O_CREAT | _O_TRUNC | (modo), _S_IREAD | _S_IWRITE)
+#define MODO_TEXTO _O_TEXT
+#define MODO_BINARIO _O_BINARY
+#define ESCREVER_FD(fd, buf, n) _write(fd, buf, (unsigned int)(n))
+#define FECHAR_FD(fd) _close(fd)
+#define FD_CONSOLA 1
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#define ABRIR_FICHEIRO(nome, modo) open(nome, O_WRONLY | O_CREAT | O_TRUNC | (modo), 0644)
+#define MODO_TEXTO 0
+#define MODO_BINARIO 0
+#define ESCREVER_FD(fd, buf, n) write(fd, buf, n)
+#define FECHAR_FD(fd) close(fd)
+#define FD_CONSOLA STDOUT_FILENO
+/**
+ * @brief Número máximo de vetores por chamada a writev.
+ */
+#define MAX_VETORES 1024
+#endif
+
+/**
+ * @brief Pares de dígitos "00" a "99" usados na formatação dos inteiros.
+ */
+static const char DIGITOS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * @brief Escreve um bloco inteiro no descritor, repetindo as escritas parciais
+ * @internal
+ * @param fd Descritor de destino
+ * @param dados Bytes a escrever
+ * @param tamanho Número de bytes a escrever
+ * @return int 1 se todos os bytes foram escritos, 0 caso contrário
+ */
+static int escreverTudo(int fd, const char* dados, size_t tamanho) {
+    while (tamanho > 0) {
+        long escritos = (long)ESCREVER_FD(fd, dados, tamanho);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        dados += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Inicializa uma saída em bloco com o modo de abertura indicado
+ * @internal
+ * @param saida Saída a inicializar
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola
+ * @param modo Modo de abertura do ficheiro (MODO_TEXTO ou MODO_BINARIO)
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ */
+static int iniciarSaida(Saida* saida, const char* filename, int modo) {
+    saida->buffer = (char*)malloc(TAMANHO_SAIDA);
+    if (!saida->buffer) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    if (filename) {
+        saida->fd = ABRIR_FICHEIRO(filename, modo);
+        if (saida->fd < 0) {
+            free(saida->buffer);
+            saida->buffer = NULL;
+            return 0;
+        }
+        saida->proprio = 1;
+    } else {
+        fflush(stdout);
+        saida->fd = FD_CONSOLA;
+        saida->proprio = 0;
+    }
+    saida->usado = 0;
+    saida->capacidade = TAMANHO_SAIDA;
+    saida->erro = 0;
+    return 1;
+}
+
+/**
+ * @brief Abre uma saída em bloco
+ *
+ * @param saida Saída a inicializar
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ * @attention Quando a saída é a consola, o buffer do stdio é despejado antes para manter a ordem do texto
+ */
+int abrirSaida(Saida* saida, const char* filename) {
+    return iniciarSaida(saida, filename, MODO_TEXTO);
+}
+
+/**
+ * @brief Abre uma saída em bloco para dados binários (sem conversão de fins de linha em Windows)
+ *
+ * @param saida Saída a inicializar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ */
+int abrirSaidaBinaria(Saida* saida, const char* filename) {
+    return iniciarSaida(saida, filename, MODO_BINARIO);
+}
+
+/**
+ * @brief Escreve todo o conteúdo do buffer no destino
+ *
+ * @param saida Saída a despejar
+ * @return int 1 se o buffer foi escrito com sucesso, 0 caso contrário
+ */
+int despejarSaida(Saida* saida) {
+    if (saida->usado > 0 && !escreverTudo(saida->fd, saida->buffer, saida->usado)) saida->erro = 1;
+    saida->usado = 0;
+    return !saida->erro;
+}
+
+/**
+ * @brief Despeja o buffer, fecha o destino e liberta a memória da saída
+ *
+ * @param saida Saída a fechar
+ * @return int 1 se todas as escritas tiveram sucesso, 0 caso contrário
+ */
+int fecharSaida(Saida* saida) {
+    despejarSaida(saida);
+    if (saida->proprio && FECHAR_FD(saida->fd) != 0) saida->erro = 1;
+    free(saida->buffer);
+    saida->buffer = NULL;
+    saida->capacidade = 0;
+    return !saida->erro;
+}
+
+/**
+ * @brief Escreve um bloco de bytes na saída
+ *
+ * @param saida Saída onde escrever
+ * @param texto Bytes a escrever
+ * @param tamanho Número de bytes a escrever
+ * @return int 1 se os bytes foram escritos com sucesso, 0 caso contrário
+ */
+int escreverBytes(Saida* saida, const char* texto, size_t tamanho) {
+    if (saida->usado + tamanho > saida->capacidade) {
+        despejarSaida(saida);
+        if (tamanho > saida->capacidade) { // Blocos maiores que o buffer seguem diretamente
+            if (!escreverTudo(saida->fd, texto, tamanho)) saida->erro = 1;
+            return !saida->erro;
+        }
+    }
+    memcpy(saida->buffer + saida->usado, texto, tamanho);
+    saida->usado += tamanho;
+    return !saida->erro;
+}
+
+/**
+ * @brief Escreve uma string terminada em '\0' na saída
+ *
+ * @param saida Saída onde escrever
+ * @param texto String a escrever
+ * @return int 1 se a string foi escrita com sucesso, 0 caso contrário
+ */
+int escreverTexto(Saida* saida, const char* texto) {
+    return escreverBytes(saida, texto, strlen(texto));
+}
+
+/**
+ * @brief Escreve um caracter na saída
+ *
+ * @param saida Saída onde escrever
+ * @param c Caracter a escrever
+ * @return int 1 se o caracter foi escrito com sucesso, 0 caso contrário
+ */
+int escreverCaracter(Saida* saida, char c) {
+    if (saida->usado == saida->capacidade) despejarSaida(saida);
+    saida->buffer[saida->usado++] = c;
+    return !saida->erro;
+}
+
+/**
+ * @brief Escreve um inteiro em base 10 na saída, sem passar pelo printf
+ *
+ * @param saida Saída onde escrever
+ * @param valor Inteiro a escrever
+ * @return int 1 se o inteiro foi escrito com sucesso, 0 caso contrário
+ */
+int escreverInteiro(Saida* saida, int valor) {
+    char tmp[12];
+    char* fim = tmp + sizeof(tmp);
+    char* p = fim;
+    unsigned int v = valor < 0 ? 0u - (unsigned int)valor : (unsigned int)valor;
+    while (v >= 100) { // Dois dígitos de cada vez
+        unsigned int par = (v % 100) * 2;
+        v /= 100;
+        *--p = DIGITOS[par + 1];
+        *--p = DIGITOS[par];
+    }
+    if (v >= 10) {
+        *--p = DIGITOS[v * 2 + 1];
+        *--p = DIGITOS[v * 2];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    if (valor < 0) *--p = '-';
+    size_t tamanho = (size_t)(fim - p);
+    if (saida->usado + tamanho > saida->capacidade) despejarSaida(saida);
+    memcpy(saida->buffer + saida->usado, p, tamanho);
+    saida->usado += tamanho;
+    return !saida->erro;
+}
+
+/**
+ * @brief Escreve várias linhas seguidas de '\n' na saída
+ *
+ * As linhas são enviadas diretamente com writev, sem serem copiadas para o buffer.
+ *
+ * @param saida Saída onde escrever
+ * @param linhas Linhas a escrever
+ * @param num Número de linhas
+ * @return int 1 se as linhas foram escritas com sucesso, 0 caso contrário
+ */
+int escreverLinhas(Saida* saida, char** linhas, int num) {
+#ifdef _WIN32
+    for (int i = 0; i < num; i++) {
+        escreverTexto(saida, linhas[i]);
+        escreverCaracter(saida, '\n');
+    }
+    return !saida->erro;
+#else
+    static char fimLinha[] = "\n";
+    struct iovec vetores[MAX_VETORES];
+    long limite = sysconf(_SC_IOV_MAX);
+    int maxVetores = limite > 1 && limite < MAX_VETORES ? (int)limite : MAX_VETORES;
+    despejarSaida(saida);
+    for (int i = 0; i < num && !saida->erro; ) {
+        int n = 0;
+        size_t total = 0;
+        for (; i < num && n + 2 <= maxVetores; i++) {
+            vetores[n].iov_base = linhas[i];
+            vetores[n].iov_len = strlen(linhas[i]);
+            total += vetores[n++].iov_len;
+            vetores[n].iov_base = fimLinha;
+            vetores[n++].iov_len = 1;
+            total++;
+        }
+        struct iovec* atual = vetores;
+        while (total > 0) {
+            ssize_t escritos = writev(saida->fd, atual, n);
+            if (escritos < 0) {
+                if (errno == EINTR) continue;
+                saida->erro = 1;
+                break;
+            }
+            total -= (size_t)escritos;
+            while (n > 0 && (size_t)escritos >= atual->iov_len) { // Avança sobre os vetores já escritos
+                escritos -= (ssize_t)atual->iov_len;
+                atual++;
+                n--;
+            }
+            if (n > 0) {
+                atual->iov_base = (char*)atual->iov_base + escritos;
+                atual->iov_len -= (size_t)escritos;
+            }
+        }
+    }
+    return !saida->erro;
+#endif
+}
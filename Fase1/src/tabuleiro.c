@@ -0,0 +1,216 @@
+/**
+ * @file tabuleiro.c
+ * @author Hugo Baptista
+ * @brief Implementação do motor de efeitos nefastos por bitboards, para mapas até 64 colunas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "vetorial.h"
+#include "tabuleiro.h"
+
+/**
+ * @brief Número de palavras por frequência e linha que cabem nos vetores da pilha.
+ */
+#define TAMANHO_PILHA 512
+
+/**
+ * @brief Conta os bits a 1 de uma palavra
+ * @internal
+ * @param v Palavra
+ * @return int Número de bits a 1
+ */
+static inline int contarBits(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Devolve a posição do bit a 1 mais significativo de uma palavra não nula
+ * @internal
+ * @param v Palavra (diferente de 0)
+ * @return int Posição do bit mais significativo
+ */
+static inline int bitMaisAlto(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int x = 63;
+    while (!(v >> x & 1)) x--;
+    return x;
+#endif
+}
+
+/**
+ * @brief Inverte a ordem dos bits de uma palavra (o bit x passa a 63 - x)
+ * @internal
+ * @param v Palavra
+ * @return uint64_t Palavra invertida
+ */
+static inline uint64_t inverterBits(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    v = ((v >> 8) & 0x00FF00FF00FF00FFULL) | ((v & 0x00FF00FF00FF00FFULL) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFULL) | ((v & 0x0000FFFF0000FFFFULL) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+/**
+ * @brief Calcula o bitboard dos efeitos nefastos de um mapa com até 64 colunas
+ *
+ * Para cada frequência constrói uma máscara por linha com as suas antenas (e a máscara invertida).
+ * Os efeitos de uma antena (xa, ya) com todas as antenas da linha yb ficam na linha 2*ya - yb,
+ * nas colunas 2*xa - xb, que se obtêm deslocando a máscara invertida da linha yb de 2*xa - 63 bits.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa (no máximo 64)
+ * @param tabuleiro Vetor com uma palavra por linha, onde o bit x da linha y indica um efeito nefasto em (x, y)
+ * @return int Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas)
+ */
+int calcularTabuleiroNefastos(Antena* lista, int linhas, int colunas, uint64_t* tabuleiro) {
+    if (linhas < 1 || colunas < 1 || colunas > MAX_COLUNAS_TABULEIRO) return -1;
+    memset(tabuleiro, 0, (size_t)linhas * sizeof(uint64_t));
+    uint64_t largura = colunas == 64 ? ~0ULL : (1ULL << colunas) - 1;
+
+    // Atribui uma posição a cada frequência presente no mapa
+    int slot[256], numFreq = 0;
+    for (int f = 0; f < 256; f++) slot[f] = -1;
+    for (Antena* a = lista; a; a = a->prox) {
+        int f = (unsigned char)a->frequencia;
+        if (slot[f] < 0) slot[f] = numFreq++;
+    }
+    if (numFreq == 0) return 0;
+
+    // Os mapas pequenos (o caso habitual) usam a pilha, evitando alocações por mapa
+    uint64_t pilhaMascaras[TAMANHO_PILHA], pilhaInvertidas[TAMANHO_PILHA];
+    int pilhaOcupadas[TAMANHO_PILHA], pilhaNum[256];
+    size_t tamanho = (size_t)numFreq * linhas;
+    int naPilha = tamanho <= TAMANHO_PILHA;
+    uint64_t* mascaras = naPilha ? pilhaMascaras : (uint64_t*)malloc(tamanho * sizeof(uint64_t));
+    uint64_t* invertidas = naPilha ? pilhaInvertidas : (uint64_t*)malloc(tamanho * sizeof(uint64_t));
+    int* linhasOcupadas = naPilha ? pilhaOcupadas : (int*)malloc(tamanho * sizeof(int));
+    int* numOcupadas = pilhaNum;
+    if (!mascaras || !invertidas || !linhasOcupadas) {
+        printf("Erro ao alocar memoria!\n");
+        free(mascaras);
+        free(invertidas);
+        free(linhasOcupadas);
+        return -1;
+    }
+    memset(mascaras, 0, tamanho * sizeof(uint64_t));
+    memset(numOcupadas, 0, (size_t)numFreq * sizeof(int));
+
+    for (Antena* a = lista; a; a = a->prox) {
+        if (a->x < 0 || a->x >= colunas || a->y < 0 || a->y >= linhas) continue;
+        int s = slot[(unsigned char)a->frequencia];
+        uint64_t* linha = &mascaras[(size_t)s * linhas + a->y];
+        uint64_t bit = 1ULL << a->x;
+        if (*linha & bit) tabuleiro[a->y] |= bit; // Duas antenas iguais na mesma posição: o efeito cai sobre elas
+        if (!*linha) linhasOcupadas[(size_t)s * linhas + numOcupadas[s]++] = a->y;
+        *linha |= bit;
+    }
+    for (int s = 0; s < numFreq; s++) {
+        for (int k = 0; k < numOcupadas[s]; k++) {
+            size_t i = (size_t)s * linhas + linhasOcupadas[(size_t)s * linhas + k];
+            invertidas[i] = inverterBits(mascaras[i]);
+        }
+    }
+
+    for (Antena* a = lista; a; a = a->prox) {
+        if (a->x < 0 || a->x >= colunas || a->y < 0 || a->y >= linhas) continue;
+        int s = slot[(unsigned char)a->frequencia];
+        const uint64_t* inv = &invertidas[(size_t)s * linhas];
+        const int* ocupadas = &linhasOcupadas[(size_t)s * linhas];
+        int desloc = 2 * a->x - 63;
+        for (int k = 0; k < numOcupadas[s]; k++) {
+            int yb = ocupadas[k];
+            int alvo = 2 * a->y - yb;
+            if (alvo < 0 || alvo >= linhas) continue;
+            uint64_t m = inv[yb];
+            if (yb == a->y) m &= ~(1ULL << (63 - a->x)); // A antena não forma par consigo própria
+            tabuleiro[alvo] |= (desloc >= 0 ? m << desloc : m >> -desloc) & largura;
+        }
+    }
+
+    int total = 0;
+    for (int y = 0; y < linhas; y++) total += contarBits(tabuleiro[y]);
+
+    if (!naPilha) {
+        free(mascaras);
+        free(invertidas);
+        free(linhasOcupadas);
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula os efeitos nefastos das antenas com o motor de bitboards
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa (no máximo 64)
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosNefastosTabuleiro(Antena* lista, int linhas, int colunas) {
+    if (linhas < 1) return NULL;
+    uint64_t* tabuleiro = (uint64_t*)malloc((size_t)linhas * sizeof(uint64_t));
+    if (!tabuleiro) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    Nefasto* efeitos = NULL;
+    if (calcularTabuleiroNefastos(lista, linhas, colunas, tabuleiro) > 0) {
+        // Percorre o tabuleiro do fim para o início, inserindo à cabeça, para a lista ficar ordenada
+        for (int y = linhas - 1; y >= 0; y--) {
+            for (uint64_t m = tabuleiro[y]; m; ) {
+                int x = bitMaisAlto(m);
+                m &= ~(1ULL << x);
+                Nefasto* novo = criarNefasto(x, y);
+                if (!novo) continue;
+                novo->prox = efeitos;
+                efeitos = novo;
+            }
+        }
+    }
+    free(tabuleiro);
+    return efeitos;
+}
+
+/**
+ * @brief Calcula os efeitos nefastos dentro do mapa, escolhendo o motor pela largura do mapa
+ *
+ * Mapas com até 64 colunas usam o motor de bitboards; os restantes usam o núcleo vetorial de
+ * calcularEfeitosVetorial, que marca os efeitos dentro do mapa num mapa de bits.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosNefastosMapa(Antena* lista, int linhas, int colunas) {
+    if (colunas <= MAX_COLUNAS_TABULEIRO) return detetarEfeitosNefastosTabuleiro(lista, linhas, colunas);
+    if (linhas < 1) return NULL;
+    uint64_t* mapa = (uint64_t*)malloc(((size_t)linhas * colunas + 63) / 64 * sizeof(uint64_t));
+    if (!mapa) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    Nefasto* efeitos = calcularEfeitosVetorial(lista, linhas, colunas, mapa) > 0 ? listaDeMapa(mapa, linhas, colunas) : NULL;
+    free(mapa);
+    return efeitos;
+}
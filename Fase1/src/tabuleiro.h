@@ -0,0 +1,57 @@
+/**
+ * @file tabuleiro.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do motor de efeitos nefastos por bitboards, para mapas até 64 colunas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef TABULEIRO_H
+#define TABULEIRO_H
+
+#include <stdint.h>
+#include "estruturas.h"
+
+/**
+ * @brief MAX_COLUNAS_TABULEIRO Número máximo de colunas que cabem numa linha do bitboard (uint64_t)
+ */
+#define MAX_COLUNAS_TABULEIRO 64
+
+/**
+ * @brief Calcula o bitboard dos efeitos nefastos de um mapa com até 64 colunas
+ *
+ * Para cada frequência constrói uma máscara por linha com as suas antenas (e a máscara invertida).
+ * Os efeitos de uma antena (xa, ya) com todas as antenas da linha yb ficam na linha 2*ya - yb,
+ * nas colunas 2*xa - xb, que se obtêm deslocando a máscara invertida da linha yb de 2*xa - 63 bits.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa (no máximo 64)
+ * @param tabuleiro Vetor com uma palavra por linha, onde o bit x da linha y indica um efeito nefasto em (x, y)
+ * @return int Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas)
+ */
+int calcularTabuleiroNefastos(Antena* lista, int linhas, int colunas, uint64_t* tabuleiro);
+/**
+ * @brief Calcula os efeitos nefastos das antenas com o motor de bitboards
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa (no máximo 64)
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosNefastosTabuleiro(Antena* lista, int linhas, int colunas);
+/**
+ * @brief Calcula os efeitos nefastos dentro do mapa, escolhendo o motor pela largura do mapa
+ *
+ * Mapas com até 64 colunas usam o motor de bitboards; os restantes usam o núcleo vetorial de
+ * calcularEfeitosVetorial, que marca os efeitos dentro do mapa num mapa de bits.
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos dentro do mapa, ordenada por y e depois por x
+ */
+Nefasto* detetarEfeitosNefastosMapa(Antena* lista, int linhas, int colunas);
+
+#endif
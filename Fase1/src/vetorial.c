@@ -0,0 +1,281 @@
+/**
+ * @file vetorial.c
+ * @author Hugo Baptista
+ * @brief Implementação do núcleo vetorial (AVX2/SSE2) de geração dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "vetorial.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define COM_AVX2
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Conta os bits a 1 de uma palavra
+ * @internal
+ * @param v Palavra
+ * @return int Número de bits a 1
+ */
+static inline int contarBits(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Devolve a posição do bit a 1 menos significativo de uma palavra não nula
+ * @internal
+ * @param v Palavra (diferente de 0)
+ * @return int Posição do bit menos significativo
+ */
+static inline int bitMaisBaixo(unsigned int v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(v);
+#else
+    int x = 0;
+    while (!(v >> x & 1)) x++;
+    return x;
+#endif
+}
+
+/**
+ * @brief Devolve a posição do bit a 1 mais significativo de uma palavra não nula
+ * @internal
+ * @param v Palavra (diferente de 0)
+ * @return int Posição do bit mais significativo
+ */
+static inline int bitMaisAlto(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int x = 63;
+    while (!(v >> x & 1)) x--;
+    return x;
+#endif
+}
+
+/**
+ * @brief Marca no mapa os efeitos 2 * (xi, yi) - p_j de um intervalo de antenas (versão escalar)
+ * @internal
+ * @param xi Dobro da coordenada x da antena i
+ * @param yi Dobro da coordenada y da antena i
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param j0 Início do intervalo
+ * @param j1 Fim (exclusivo) do intervalo
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static void marcarEscalar(int32_t xi, int32_t yi, const int32_t* xs, const int32_t* ys, int j0, int j1, int linhas, int colunas, uint64_t* mapa) {
+    for (int j = j0; j < j1; j++) {
+        int32_t x = xi - xs[j], y = yi - ys[j];
+        if ((unsigned)x >= (unsigned)colunas || (unsigned)y >= (unsigned)linhas) continue;
+        size_t c = (size_t)y * colunas + (unsigned)x;
+        mapa[c / 64] |= 1ULL << (c % 64);
+    }
+}
+
+/**
+ * @brief Escreve no mapa os efeitos das faixas selecionadas por uma máscara
+ * @internal
+ * @param mascara Máscara das faixas dentro do mapa
+ * @param bx Coordenadas x das faixas
+ * @param by Coordenadas y das faixas
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static inline void escreverFaixas(unsigned int mascara, const int32_t* bx, const int32_t* by, int colunas, uint64_t* mapa) {
+    while (mascara) {
+        int b = bitMaisBaixo(mascara);
+        mascara &= mascara - 1;
+        size_t c = (size_t)by[b] * colunas + (unsigned)bx[b];
+        mapa[c / 64] |= 1ULL << (c % 64);
+    }
+}
+
+#ifdef COM_AVX2
+/**
+ * @brief Marca no mapa os efeitos de um intervalo de antenas, 8 de cada vez (AVX2)
+ * @internal
+ * @param xi Dobro da coordenada x da antena i
+ * @param yi Dobro da coordenada y da antena i
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param j0 Início do intervalo
+ * @param j1 Fim (exclusivo) do intervalo
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+__attribute__((target("avx2")))
+static void marcarAVX2(int32_t xi, int32_t yi, const int32_t* xs, const int32_t* ys, int j0, int j1, int linhas, int colunas, uint64_t* mapa) {
+    const __m256i vx = _mm256_set1_epi32(xi), vy = _mm256_set1_epi32(yi);
+    const __m256i limX = _mm256_set1_epi32(colunas), limY = _mm256_set1_epi32(linhas), menosUm = _mm256_set1_epi32(-1);
+    int32_t bx[8], by[8];
+    int j = j0;
+    for (; j + 8 <= j1; j += 8) {
+        __m256i x = _mm256_sub_epi32(vx, _mm256_loadu_si256((const __m256i*)(xs + j)));
+        __m256i y = _mm256_sub_epi32(vy, _mm256_loadu_si256((const __m256i*)(ys + j)));
+        __m256i dentro = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(x, menosUm), _mm256_cmpgt_epi32(limX, x)),
+                                          _mm256_and_si256(_mm256_cmpgt_epi32(y, menosUm), _mm256_cmpgt_epi32(limY, y)));
+        unsigned int mascara = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(dentro));
+        if (!mascara) continue;
+        _mm256_storeu_si256((__m256i*)bx, x);
+        _mm256_storeu_si256((__m256i*)by, y);
+        escreverFaixas(mascara, bx, by, colunas, mapa);
+    }
+    marcarEscalar(xi, yi, xs, ys, j, j1, linhas, colunas, mapa);
+}
+#endif
+
+#ifdef __SSE2__
+/**
+ * @brief Marca no mapa os efeitos de um intervalo de antenas, 4 de cada vez (SSE2)
+ * @internal
+ * @param xi Dobro da coordenada x da antena i
+ * @param yi Dobro da coordenada y da antena i
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param j0 Início do intervalo
+ * @param j1 Fim (exclusivo) do intervalo
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits
+ */
+static void marcarSSE2(int32_t xi, int32_t yi, const int32_t* xs, const int32_t* ys, int j0, int j1, int linhas, int colunas, uint64_t* mapa) {
+    const __m128i vx = _mm_set1_epi32(xi), vy = _mm_set1_epi32(yi);
+    const __m128i limX = _mm_set1_epi32(colunas), limY = _mm_set1_epi32(linhas), menosUm = _mm_set1_epi32(-1);
+    int32_t bx[4], by[4];
+    int j = j0;
+    for (; j + 4 <= j1; j += 4) {
+        __m128i x = _mm_sub_epi32(vx, _mm_loadu_si128((const __m128i*)(xs + j)));
+        __m128i y = _mm_sub_epi32(vy, _mm_loadu_si128((const __m128i*)(ys + j)));
+        __m128i dentro = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(x, menosUm), _mm_cmpgt_epi32(limX, x)),
+                                       _mm_and_si128(_mm_cmpgt_epi32(y, menosUm), _mm_cmpgt_epi32(limY, y)));
+        unsigned int mascara = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(dentro));
+        if (!mascara) continue;
+        _mm_storeu_si128((__m128i*)bx, x);
+        _mm_storeu_si128((__m128i*)by, y);
+        escreverFaixas(mascara, bx, by, colunas, mapa);
+    }
+    marcarEscalar(xi, yi, xs, ys, j, j1, linhas, colunas, mapa);
+}
+#endif
+
+/**
+ * @brief Marca num mapa de bits os efeitos nefastos de um grupo de antenas da mesma frequência
+ *
+ * Para cada antena i os efeitos com todas as antenas j do grupo são 2 * p_i - p_j; são calculados
+ * 8 de cada vez com AVX2 (quando o processador o suporta) ou 4 de cada vez com SSE2, juntamente com
+ * a máscara dos que ficam dentro do mapa, e só os bits da máscara são escritos no mapa.
+ *
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param n Número de antenas do grupo
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits onde o bit y * colunas + x indica um efeito em (x, y)
+ */
+void marcarEfeitosGrupo(const int32_t* xs, const int32_t* ys, int n, int linhas, int colunas, uint64_t* mapa) {
+    void (*marcar)(int32_t, int32_t, const int32_t*, const int32_t*, int, int, int, int, uint64_t*) = marcarEscalar;
+#ifdef __SSE2__
+    marcar = marcarSSE2;
+#endif
+#ifdef COM_AVX2
+    if (__builtin_cpu_supports("avx2")) marcar = marcarAVX2;
+#endif
+    for (int i = 0; i < n; i++) {
+        // A antena não forma par consigo própria: o intervalo é dividido em [0, i) e (i, n)
+        marcar(2 * xs[i], 2 * ys[i], xs, ys, 0, i, linhas, colunas, mapa);
+        marcar(2 * xs[i], 2 * ys[i], xs, ys, i + 1, n, linhas, colunas, mapa);
+    }
+}
+
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos de uma lista de antenas com o núcleo vetorial
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas)
+ */
+long long calcularEfeitosVetorial(Antena* lista, int linhas, int colunas, uint64_t* mapa) {
+    if (linhas < 1 || colunas < 1) return -1;
+    size_t palavras = ((size_t)linhas * colunas + 63) / 64;
+    memset(mapa, 0, palavras * sizeof(uint64_t));
+
+    // Agrupa as coordenadas por frequência em vetores contíguos
+    int inicioFreq[257] = {0}, pos[256], num = 0;
+    for (Antena* a = lista; a; a = a->prox, num++) inicioFreq[(unsigned char)a->frequencia + 1]++;
+    for (int f = 0; f < 256; f++) inicioFreq[f + 1] += inicioFreq[f];
+    int32_t* xs = (int32_t*)malloc((size_t)(num > 0 ? num : 1) * sizeof(int32_t));
+    int32_t* ys = (int32_t*)malloc((size_t)(num > 0 ? num : 1) * sizeof(int32_t));
+    if (!xs || !ys) {
+        printf("Erro ao alocar memoria!\n");
+        free(xs);
+        free(ys);
+        return -1;
+    }
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (Antena* a = lista; a; a = a->prox) {
+        int p = pos[(unsigned char)a->frequencia]++;
+        xs[p] = a->x;
+        ys[p] = a->y;
+    }
+    for (int f = 0; f < 256; f++) {
+        marcarEfeitosGrupo(xs + inicioFreq[f], ys + inicioFreq[f], inicioFreq[f + 1] - inicioFreq[f], linhas, colunas, mapa);
+    }
+    free(xs);
+    free(ys);
+
+    long long total = 0;
+    for (size_t p = 0; p < palavras; p++) total += contarBits(mapa[p]);
+    return total;
+}
+
+/**
+ * @brief Converte um mapa de bits de efeitos nefastos numa lista
+ *
+ * @param mapa Mapa de bits onde o bit y * colunas + x indica um efeito em (x, y)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos, ordenada por y e depois por x
+ * @attention Tal como em criarNefasto, os efeitos fora de MAX_LINHAS x MAX_COLUNAS não entram na lista
+ */
+Nefasto* listaDeMapa(const uint64_t* mapa, int linhas, int colunas) {
+    Nefasto* efeitos = NULL;
+    size_t celulas = (size_t)linhas * colunas;
+    // Percorre o mapa do fim para o início, inserindo à cabeça, para a lista ficar ordenada
+    for (size_t p = (celulas + 63) / 64; p-- > 0; ) {
+        for (uint64_t m = mapa[p]; m; ) {
+            int b = bitMaisAlto(m);
+            m &= ~(1ULL << b);
+            size_t c = p * 64 + (size_t)b;
+            Nefasto* novo = criarNefasto((int)(c % colunas), (int)(c / colunas));
+            if (!novo) continue;
+            novo->prox = efeitos;
+            efeitos = novo;
+        }
+    }
+    return efeitos;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file vetorial.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do núcleo vetorial (AVX2/SSE2) de geração dos efeitos nefastos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef VETORIAL_H
+#define VETORIAL_H
+
+#include <stdint.h>
+#include "estruturas.h"
+
+/**
+ * @brief Marca num mapa de bits os efeitos nefastos de um grupo de antenas da mesma frequência
+ *
+ * Para cada antena i os efeitos com todas as antenas j do grupo são 2 * p_i - p_j; são calculados
+ * 8 de cada vez com AVX2 (quando o processador o suporta) ou 4 de cada vez com SSE2, juntamente com
+ * a máscara dos que ficam dentro do mapa, e só os bits da máscara são escritos no mapa.
+ *
+ * @param xs Coordenadas x das antenas do grupo
+ * @param ys Coordenadas y das antenas do grupo
+ * @param n Número de antenas do grupo
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits onde o bit y * colunas + x indica um efeito em (x, y)
+ */
+void marcarEfeitosGrupo(const int32_t* xs, const int32_t* ys, int n, int linhas, int colunas, uint64_t* mapa);
+/**
+ * @brief Calcula o mapa de bits dos efeitos nefastos de uma lista de antenas com o núcleo vetorial
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Vetor com (linhas x colunas + 63) / 64 palavras, onde o bit y * colunas + x indica um efeito em (x, y)
+ * @return long long Número de efeitos nefastos no mapa, ou -1 em caso de erro
+ * @attention Só são considerados os efeitos dentro do mapa (linhas x colunas)
+ */
+long long calcularEfeitosVetorial(Antena* lista, int linhas, int colunas, uint64_t* mapa);
+/**
+ * @brief Converte um mapa de bits de efeitos nefastos numa lista
+ *
+ * @param mapa Mapa de bits onde o bit y * colunas + x indica um efeito em (x, y)
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @return Nefasto* Lista de efeitos nefastos, ordenada por y e depois por x
+ * @attention Tal como em criarNefasto, os efeitos fora de MAX_LINHAS x MAX_COLUNAS não entram na lista
+ */
+Nefasto* listaDeMapa(const uint64_t* mapa, int linhas, int colunas);
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file teste.h
+ * @author Hugo Baptista
+ * @brief Utilitários partilhados pelos testes: contagem de falhas, gerador reprodutível, libertação de listas e
+ * verificação do índice espacial
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "estruturas.h"
+#include "indice.h"
+
+/**
+ * @brief Número de verificações que falharam (cada teste é um programa com um só ficheiro)
+ */
+static int falhas = 0;
+
+/**
+ * @brief Verifica uma condição e escreve a linha de cada verificação que falha
+ */
+#define VERIFICAR(condicao) do { if (!(condicao)) { printf("FALHOU %s:%d: %s\n", __FILE__, __LINE__, #condicao); falhas++; } } while (0)
+
+/**
+ * @brief Gerador pseudo-aleatório (xorshift), para os testes serem reprodutíveis
+ *
+ * @param estado Estado do gerador (diferente de 0)
+ * @return unsigned int Próximo número
+ */
+static inline unsigned int aleatorio(unsigned int* estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+/**
+ * @brief Liberta uma lista de antenas
+ *
+ * @param lista Lista a libertar
+ */
+static inline void libertarAntenas(Antena* lista) {
+    while (lista) {
+        Antena* prox = lista->prox;
+        free(lista);
+        lista = prox;
+    }
+}
+
+/**
+ * @brief Liberta uma lista de efeitos
+ *
+ * @param lista Lista a libertar
+ */
+static inline void libertarEfeitos(Nefasto* lista) {
+    while (lista) {
+        Nefasto* prox = lista->prox;
+        free(lista);
+        lista = prox;
+    }
+}
+
+/**
+ * @brief Indica se duas listas têm as mesmas antenas pela mesma ordem
+ *
+ * @param a Primeira lista
+ * @param b Segunda lista
+ * @return int 1 se as listas são iguais, 0 caso contrário
+ */
+static inline int listasIguais(const Antena* a, const Antena* b) {
+    for (; a && b; a = a->prox, b = b->prox) {
+        if (a->frequencia != b->frequencia || a->x != b->x || a->y != b->y) return 0;
+    }
+    return !a && !b;
+}
+
+/**
+ * @brief Indica se o índice tem exatamente os nós da lista, cada um na sua posição
+ *
+ * Em cada posição de [0, colunas) x [0, linhas), contarAntenasEm tem de dar o número de antenas da lista
+ * nessa posição e antenaEm um nó da lista nessa posição; um retângulo que cobre todas as posições tem de
+ * devolver cada nó da lista uma só vez (um nó já libertado que ficou no índice não está na lista).
+ *
+ * @param indice Índice a verificar
+ * @param lista Lista de antenas (todas dentro de [0, colunas) x [0, linhas))
+ * @param linhas Número de linhas a verificar
+ * @param colunas Número de colunas a verificar
+ * @return int 1 se o índice está de acordo com a lista, 0 caso contrário
+ */
+static inline int indiceConsistente(const IndiceEspacial* indice, const Antena* lista, int linhas, int colunas) {
+    int numLista = 0;
+    for (const Antena* a = lista; a; a = a->prox) numLista++;
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            int num = 0;
+            for (const Antena* a = lista; a; a = a->prox) num += a->x == x && a->y == y;
+            if (contarAntenasEm(indice, x, y) != num) return 0;
+            Antena* encontrada = antenaEm(indice, x, y);
+            if (num == 0 ? encontrada != NULL : !encontrada || encontrada->x != x || encontrada->y != y) return 0;
+            const Antena* a = lista;
+            while (a && a != encontrada) a = a->prox;
+            if (encontrada && !a) return 0;
+        }
+    }
+    Antena** todas = (Antena**)malloc((size_t)(numLista > 0 ? numLista : 1) * sizeof(Antena*));
+    if (!todas) return 0;
+    int ok = antenasNoRetangulo(indice, 0, 0, colunas - 1, linhas - 1, todas, numLista) == numLista;
+    for (const Antena* a = lista; a && ok; a = a->prox) {
+        int vezes = 0;
+        for (int i = 0; i < numLista; i++) vezes += todas[i] == a;
+        ok = vezes == 1;
+    }
+    free(todas);
+    return ok;
+}
+
+/**
+ * @brief Escreve o resultado de um teste
+ *
+ * @param nome Nome do teste
+ * @return int Código de saída do teste: 0 se nenhuma verificação falhou, 1 caso contrário
+ */
+static inline int terminarTeste(const char* nome) {
+    printf("%s: %s\n", nome, falhas ? "FALHOU" : "OK");
+    return falhas ? 1 : 0;
+}
+
+#endif
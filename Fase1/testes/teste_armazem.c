@@ -0,0 +1,121 @@
+/**
+ * @file teste_armazem.c
+ * @author Hugo Baptista
+ * @brief Testes do armazém de antenas (um vetor por campo), comparado com a lista e o motor em memória
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "tabuleiro.h"
+#include "armazem.h"
+#include "teste.h"
+
+/**
+ * @brief Ficheiro temporário com o mapa
+ */
+#define FICHEIRO_MAPA "teste_armazem_mapa.tmp"
+
+/**
+ * @brief Indica se duas listas de efeitos têm os mesmos efeitos pela mesma ordem
+ *
+ * @param a Primeira lista
+ * @param b Segunda lista
+ * @return int 1 se são iguais, 0 caso contrário
+ */
+static int mesmosEfeitos(const Nefasto* a, const Nefasto* b) {
+    for (; a && b; a = a->prox, b = b->prox) {
+        if (a->x != b->x || a->y != b->y) return 0;
+    }
+    return !a && !b;
+}
+
+/**
+ * @brief Compara o armazém carregado de FICHEIRO_MAPA com a lista e o motor em memória
+ *
+ * @param descricao Descrição do caso, para as mensagens de falha
+ */
+static void compararComLista(const char* descricao) {
+    int linhas = contarLinhas(FICHEIRO_MAPA), colunas = contarColunas(FICHEIRO_MAPA);
+    ArmazemAntenas* armazem = carregarArmazem(FICHEIRO_MAPA);
+    VERIFICAR(armazem != NULL);
+    if (!armazem) return;
+    Antena* lista = carregarAntenas(FICHEIRO_MAPA);
+    Nefasto* esperados = detetarEfeitosNefastosMapa(lista, linhas, colunas);
+    Nefasto* obtidos = detetarEfeitosNefastosArmazem(armazem);
+    if (armazem->linhas != linhas || armazem->colunas != colunas || !mesmosEfeitos(esperados, obtidos)) {
+        printf("FALHOU %s: armazem %dx%d, mapa %dx%d\n", descricao, armazem->colunas, armazem->linhas, colunas, linhas);
+        falhas++;
+    }
+    // As antenas do armazém são as da lista, pela ordem de leitura (y crescente e x crescente)
+    int num = 0;
+    for (Antena* a = lista; a; a = a->prox) num++;
+    VERIFICAR(armazem->num == num);
+    for (int i = 0; i < armazem->num; i++) {
+        int encontrada = 0;
+        for (Antena* a = lista; a && !encontrada; a = a->prox) {
+            encontrada = a->x == armazemX(armazem, i) && a->y == armazemY(armazem, i) && a->frequencia == (char)armazem->frequencias[i];
+        }
+        VERIFICAR(encontrada);
+        if (i > 0) VERIFICAR(armazemY(armazem, i - 1) < armazemY(armazem, i) ||
+                             (armazemY(armazem, i - 1) == armazemY(armazem, i) && armazemX(armazem, i - 1) < armazemX(armazem, i)));
+    }
+    libertarEfeitos(esperados);
+    libertarEfeitos(obtidos);
+    libertarAntenas(lista);
+    libertarArmazem(armazem);
+}
+
+/**
+ * @brief Um fim de linha no fim do ficheiro abre uma linha vazia, e o efeito nessa linha conta
+ */
+static void testarFimDeLinha(void) {
+    FILE* file = fopen(FICHEIRO_MAPA, "w");
+    fputs("....\n.a..\n..a.\n", file);
+    fclose(file);
+    ArmazemAntenas* armazem = carregarArmazem(FICHEIRO_MAPA);
+    VERIFICAR(armazem && armazem->linhas == 4 && armazem->colunas == 4);
+    if (armazem) {
+        Nefasto* efeitos = detetarEfeitosNefastosArmazem(armazem);
+        int num = 0;
+        for (Nefasto* n = efeitos; n; n = n->prox) num++;
+        VERIFICAR(num == 2);
+        libertarEfeitos(efeitos);
+        libertarArmazem(armazem);
+    }
+    compararComLista("mapa com fim de linha");
+}
+
+/**
+ * @brief O armazém dá as mesmas dimensões, antenas e efeitos que a lista em mapas aleatórios
+ */
+static void testarIgualLista(void) {
+    unsigned int semente = 4036;
+    for (int caso = 0; caso < 60; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 60), colunas = 1 + (int)(aleatorio(&semente) % 99);
+        int fimDeLinha = caso % 2, percentagem = 2 + (int)(aleatorio(&semente) % 15);
+        FILE* file = fopen(FICHEIRO_MAPA, "w");
+        for (int y = 0; y < linhas; y++) {
+            for (int x = 0; x < colunas; x++) {
+                unsigned int r = aleatorio(&semente) % 100;
+                fputc(r < (unsigned)percentagem ? "aAb0"[aleatorio(&semente) % 4] : r == 99 ? '#' : '.', file);
+            }
+            if (y + 1 < linhas || fimDeLinha) fputc('\n', file);
+        }
+        fclose(file);
+        char descricao[64];
+        snprintf(descricao, sizeof(descricao), "caso %d (%dx%d, fim de linha %d)", caso, colunas, linhas, fimDeLinha);
+        compararComLista(descricao);
+    }
+}
+
+int main(void) {
+    testarFimDeLinha();
+    testarIgualLista();
+    remove(FICHEIRO_MAPA);
+    return terminarTeste("teste_armazem");
+}
@@ -0,0 +1,142 @@
+/**
+ * @file teste_diferencas.c
+ * @author Hugo Baptista
+ * @brief Testes da comparação de duas versões de um mapa, comparada com a deteção completa nos dois mapas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "diferencas.h"
+#include "teste.h"
+
+/**
+ * @brief Ficheiro temporário com a versão antiga do mapa
+ */
+#define FICHEIRO_ANTIGO "teste_diferencas_antigo.tmp"
+/**
+ * @brief Ficheiro temporário com a versão nova do mapa
+ */
+#define FICHEIRO_NOVO "teste_diferencas_novo.tmp"
+
+/**
+ * @brief Escreve um mapa num ficheiro, linha a linha
+ *
+ * @param filename Nome do ficheiro a escrever
+ * @param celulas Células do mapa, linha a linha
+ * @param linhas Número de linhas
+ * @param colunas Número de colunas
+ */
+static void escreverMapa(const char* filename, const char* celulas, int linhas, int colunas) {
+    FILE* file = fopen(filename, "w");
+    for (int y = 0; y < linhas; y++) {
+        fwrite(celulas + (size_t)y * colunas, 1, (size_t)colunas, file);
+        if (y + 1 < linhas) fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Marca numa grelha MAX_COLUNAS x MAX_LINHAS as posições de uma lista de efeitos
+ *
+ * @param efeitos Lista de efeitos
+ * @param grelha Grelha a marcar com o valor indicado
+ * @param valor Valor a somar a cada posição
+ */
+static void marcarEfeitos(const Nefasto* efeitos, int* grelha, int valor) {
+    for (; efeitos; efeitos = efeitos->prox) {
+        VERIFICAR(efeitos->x >= 0 && efeitos->x < MAX_COLUNAS && efeitos->y >= 0 && efeitos->y < MAX_LINHAS);
+        grelha[efeitos->y * MAX_COLUNAS + efeitos->x] += valor;
+    }
+}
+
+/**
+ * @brief Marca numa grelha MAX_COLUNAS x MAX_LINHAS as antenas de uma lista, com a frequência
+ *
+ * @param lista Lista de antenas
+ * @param grelha Grelha a marcar
+ */
+static void marcarAntenas(const Antena* lista, char* grelha) {
+    for (; lista; lista = lista->prox) {
+        if (lista->x >= 0 && lista->x < MAX_COLUNAS && lista->y >= 0 && lista->y < MAX_LINHAS) {
+            grelha[lista->y * MAX_COLUNAS + lista->x] = lista->frequencia;
+        }
+    }
+}
+
+/**
+ * @brief compararMapas devolve as mesmas antenas e efeitos que a diferença entre as deteções completas
+ */
+static void testarIgualDetecao(void) {
+    unsigned int semente = 4045;
+    int* esperado = (int*)malloc(MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+    int* obtido = (int*)malloc(MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+    char* antes = (char*)malloc(MAX_LINHAS * MAX_COLUNAS);
+    char* depois = (char*)malloc(MAX_LINHAS * MAX_COLUNAS);
+    for (int caso = 0; caso < 60; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 30), colunas = 1 + (int)(aleatorio(&semente) % 30);
+        size_t celulas = (size_t)linhas * colunas;
+        char* antigo = (char*)malloc(celulas);
+        char* novo = (char*)malloc(celulas);
+        for (size_t c = 0; c < celulas; c++) antigo[c] = aleatorio(&semente) % 5 == 0 ? "aAb0"[aleatorio(&semente) % 4] : '.';
+        memcpy(novo, antigo, celulas);
+        // Algumas alterações, em poucas linhas, incluindo mudanças de frequência
+        int alteracoes = (int)(aleatorio(&semente) % 6);
+        for (int i = 0; i < alteracoes; i++) novo[aleatorio(&semente) % celulas] = "..aAb"[aleatorio(&semente) % 5];
+        escreverMapa(FICHEIRO_ANTIGO, antigo, linhas, colunas);
+        escreverMapa(FICHEIRO_NOVO, novo, linhas, colunas);
+
+        DiferencaMapas diferenca;
+        VERIFICAR(compararMapas(FICHEIRO_ANTIGO, FICHEIRO_NOVO, &diferenca));
+
+        Antena* listaAntiga = carregarAntenas(FICHEIRO_ANTIGO);
+        Antena* listaNova = carregarAntenas(FICHEIRO_NOVO);
+        Nefasto* efeitosAntigos = detetarEfeitosNefastos(listaAntiga);
+        Nefasto* efeitosNovos = detetarEfeitosNefastos(listaNova);
+
+        // Efeitos: novo - antigo (1 adicionado, -1 removido) tem de bater com as listas da diferença
+        memset(esperado, 0, MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+        memset(obtido, 0, MAX_LINHAS * MAX_COLUNAS * sizeof(int));
+        marcarEfeitos(efeitosNovos, esperado, 1);
+        marcarEfeitos(efeitosAntigos, esperado, -1);
+        marcarEfeitos(diferenca.efeitosAdicionados, obtido, 1);
+        marcarEfeitos(diferenca.efeitosRemovidos, obtido, -1);
+        VERIFICAR(memcmp(esperado, obtido, MAX_LINHAS * MAX_COLUNAS * sizeof(int)) == 0);
+
+        // Antenas: aplicar a diferença ao mapa antigo dá o mapa novo
+        memset(antes, 0, MAX_LINHAS * MAX_COLUNAS);
+        memset(depois, 0, MAX_LINHAS * MAX_COLUNAS);
+        marcarAntenas(listaAntiga, antes);
+        marcarAntenas(listaNova, depois);
+        for (Antena* a = diferenca.removidas; a; a = a->prox) {
+            VERIFICAR(antes[a->y * MAX_COLUNAS + a->x] == a->frequencia);
+            antes[a->y * MAX_COLUNAS + a->x] = 0;
+        }
+        marcarAntenas(diferenca.adicionadas, antes);
+        VERIFICAR(memcmp(antes, depois, MAX_LINHAS * MAX_COLUNAS) == 0);
+        if (alteracoes == 0) VERIFICAR(diferenca.linhasAlteradas == 0 && !diferenca.adicionadas && !diferenca.removidas);
+
+        libertarDiferenca(&diferenca);
+        libertarEfeitos(efeitosAntigos);
+        libertarEfeitos(efeitosNovos);
+        libertarAntenas(listaAntiga);
+        libertarAntenas(listaNova);
+        free(antigo);
+        free(novo);
+    }
+    remove(FICHEIRO_ANTIGO);
+    remove(FICHEIRO_NOVO);
+    free(esperado);
+    free(obtido);
+    free(antes);
+    free(depois);
+}
+
+int main(void) {
+    testarIgualDetecao();
+    return terminarTeste("teste_diferencas");
+}
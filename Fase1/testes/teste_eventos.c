@@ -0,0 +1,260 @@
+/**
+ * @file teste_eventos.c
+ * @author Hugo Baptista
+ * @brief Testes das alterações dos efeitos nefastos escritas por lote, comparadas com a deteção completa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "saida.h"
+#include "vetorial.h"
+#include "eventos.h"
+#include "teste.h"
+
+/**
+ * @brief Ficheiro temporário com o mapa inicial
+ */
+#define FICHEIRO_MAPA "teste_eventos_mapa.tmp"
+/**
+ * @brief Ficheiro temporário com os eventos
+ */
+#define FICHEIRO_EVENTOS "teste_eventos_entrada.tmp"
+/**
+ * @brief Ficheiro temporário com as alterações escritas
+ */
+#define FICHEIRO_SAIDA "teste_eventos_saida.tmp"
+
+/**
+ * @brief Modelo do mapa mantido pelo teste, com a frequência de cada célula ('.' se está livre)
+ */
+typedef struct Modelo {
+    int linhas, colunas;
+    char* celulas;
+} Modelo;
+
+/**
+ * @brief Aplica um evento ao modelo com as regras de aplicarEvento
+ *
+ * @param m Modelo a alterar
+ * @param e Evento a aplicar
+ * @return int 1 se o evento foi aplicado, 0 se foi rejeitado
+ */
+static int aplicarModelo(Modelo* m, const EventoAntena* e) {
+    if (e->x < 0 || e->x >= m->colunas || e->y < 0 || e->y >= m->linhas) return 0;
+    char* c = &m->celulas[e->y * m->colunas + e->x];
+    if (e->tipo == EVENTO_INSERIR) {
+        if (*c != '.' || (unsigned char)e->frequencia <= ' ' || e->frequencia == '.' || e->frequencia == '#') return 0;
+        *c = e->frequencia;
+        return 1;
+    }
+    if (*c == '.') return 0;
+    if (e->tipo == EVENTO_REMOVER) {
+        *c = '.';
+        return 1;
+    }
+    if (e->nx < 0 || e->nx >= m->colunas || e->ny < 0 || e->ny >= m->linhas) return 0;
+    char* d = &m->celulas[e->ny * m->colunas + e->nx];
+    if (d == c) return 1;
+    if (*d != '.') return 0;
+    *d = *c;
+    *c = '.';
+    return 1;
+}
+
+/**
+ * @brief Calcula os efeitos das antenas do modelo com a deteção completa
+ *
+ * @param m Modelo
+ * @param mapa Mapa de bits a preencher
+ */
+static void recalcular(const Modelo* m, uint64_t* mapa) {
+    size_t celulas = (size_t)m->linhas * m->colunas;
+    Antena* antenas = (Antena*)calloc(celulas, sizeof(Antena));
+    Antena* lista = NULL;
+    for (size_t c = 0; c < celulas; c++) {
+        if (m->celulas[c] == '.') continue;
+        antenas[c].frequencia = m->celulas[c];
+        antenas[c].x = (int)(c % (size_t)m->colunas);
+        antenas[c].y = (int)(c / (size_t)m->colunas);
+        antenas[c].prox = lista;
+        lista = &antenas[c];
+    }
+    calcularEfeitosVetorial(lista, m->linhas, m->colunas, mapa);
+    free(antenas);
+}
+
+/**
+ * @brief Gera um evento aleatório, com alguns fora do mapa, em células livres ou com frequências inválidas
+ *
+ * @param m Modelo (só para as dimensões)
+ * @param semente Estado do gerador
+ * @return EventoAntena Evento gerado
+ */
+static EventoAntena gerarEvento(const Modelo* m, unsigned int* semente) {
+    EventoAntena e;
+    int tipo = (int)(aleatorio(semente) % 10);
+    e.tipo = tipo < 5 ? EVENTO_INSERIR : tipo < 8 ? EVENTO_MOVER : EVENTO_REMOVER;
+    e.frequencia = "aAb0#"[aleatorio(semente) % 5];
+    e.x = (int)(aleatorio(semente) % (unsigned)(m->colunas + 1));
+    e.y = (int)(aleatorio(semente) % (unsigned)(m->linhas + 1));
+    e.nx = (int)(aleatorio(semente) % (unsigned)(m->colunas + 1));
+    e.ny = (int)(aleatorio(semente) % (unsigned)(m->linhas + 1));
+    return e;
+}
+
+/**
+ * @brief Aplica as alterações de texto de um ficheiro ("+ x y" / "- x y") a um mapa de bits
+ *
+ * Um "+" numa célula que já tem efeito, ou um "-" numa que não tem, conta como falha.
+ *
+ * @param filename Nome do ficheiro com as alterações
+ * @param mapa Mapa de bits a alterar
+ * @param colunas Número de colunas do mapa
+ * @return int Número de alterações lidas
+ */
+static int aplicarAlteracoes(const char* filename, uint64_t* mapa, int colunas) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        falhas++;
+        return 0;
+    }
+    char sinal;
+    int x, y, num = 0;
+    while (fscanf(file, " %c %d %d", &sinal, &x, &y) == 3) {
+        size_t c = (size_t)y * colunas + x;
+        int tinha = (int)(mapa[c / 64] >> (c % 64) & 1);
+        VERIFICAR(sinal == '+' ? !tinha : sinal == '-' && tinha);
+        mapa[c / 64] ^= 1ULL << (c % 64);
+        num++;
+    }
+    fclose(file);
+    return num;
+}
+
+/**
+ * @brief Cada lote de fecharLoteEventos leva os efeitos acumulados ao resultado da deteção completa
+ */
+static void testarLotes(void) {
+    unsigned int semente = 4049;
+    for (int caso = 0; caso < 30; caso++) {
+        Modelo m;
+        m.linhas = 1 + (int)(aleatorio(&semente) % 24);
+        m.colunas = 1 + (int)(aleatorio(&semente) % 24);
+        size_t celulas = (size_t)m.linhas * m.colunas, palavras = (celulas + 63) / 64;
+        m.celulas = (char*)malloc(celulas);
+        memset(m.celulas, '.', celulas);
+        uint64_t* acumulado = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+        uint64_t* esperado = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+
+        // Mapa inicial, com antenas repetidas na mesma posição (as seguintes, pela ordem da lista, são ignoradas)
+        int numIniciais = (int)(aleatorio(&semente) % (unsigned)(celulas / 4 + 1));
+        Antena* iniciais = (Antena*)calloc((size_t)numIniciais + 1, sizeof(Antena));
+        Antena* lista = numIniciais > 0 ? iniciais : NULL;
+        for (int i = 0; i < numIniciais; i++) {
+            EventoAntena e = { EVENTO_INSERIR, "aAb"[aleatorio(&semente) % 3], 0, 0, 0, 0 };
+            e.x = (int)(aleatorio(&semente) % (unsigned)m.colunas);
+            e.y = (int)(aleatorio(&semente) % (unsigned)m.linhas);
+            aplicarModelo(&m, &e);
+            iniciais[i].frequencia = e.frequencia;
+            iniciais[i].x = e.x;
+            iniciais[i].y = e.y;
+            iniciais[i].prox = i + 1 < numIniciais ? &iniciais[i + 1] : NULL;
+        }
+        EstadoEventos* estado = criarEstadoEventos(lista, m.linhas, m.colunas);
+        free(iniciais);
+        VERIFICAR(estado != NULL);
+        if (!estado) {
+            free(m.celulas);
+            free(acumulado);
+            free(esperado);
+            continue;
+        }
+
+        for (int lote = 0; lote < 40; lote++) {
+            // O primeiro lote só tem os efeitos do mapa inicial
+            int numEventos = lote == 0 ? 0 : 1 + (int)(aleatorio(&semente) % 12);
+            for (int i = 0; i < numEventos; i++) {
+                EventoAntena e = gerarEvento(&m, &semente);
+                int esperadoAplicado = aplicarModelo(&m, &e);
+                VERIFICAR(aplicarEvento(estado, &e) == esperadoAplicado);
+            }
+            Saida saida;
+            VERIFICAR(abrirSaida(&saida, FICHEIRO_SAIDA));
+            int escritos = fecharLoteEventos(estado, &saida, 0);
+            VERIFICAR(fecharSaida(&saida));
+            VERIFICAR(aplicarAlteracoes(FICHEIRO_SAIDA, acumulado, m.colunas) == escritos);
+            recalcular(&m, esperado);
+            if (memcmp(acumulado, esperado, palavras * sizeof(uint64_t)) != 0) {
+                printf("FALHOU caso %d, lote %d: efeitos diferentes da detecao completa\n", caso, lote);
+                falhas++;
+                memcpy(acumulado, esperado, palavras * sizeof(uint64_t));
+            }
+        }
+        libertarEstadoEventos(estado);
+        free(m.celulas);
+        free(acumulado);
+        free(esperado);
+    }
+    remove(FICHEIRO_SAIDA);
+}
+
+/**
+ * @brief processarEventos lê o mapa e os eventos de ficheiros e escreve as mesmas alterações que a deteção completa
+ */
+static void testarProcessarEventos(void) {
+    unsigned int semente = 91;
+    Modelo m;
+    m.linhas = 12;
+    m.colunas = 15;
+    size_t celulas = (size_t)m.linhas * m.colunas, palavras = (celulas + 63) / 64;
+    m.celulas = (char*)malloc(celulas);
+    for (size_t c = 0; c < celulas; c++) m.celulas[c] = aleatorio(&semente) % 6 == 0 ? "aAb"[aleatorio(&semente) % 3] : '.';
+
+    FILE* file = fopen(FICHEIRO_MAPA, "w");
+    for (int y = 0; y < m.linhas; y++) {
+        fwrite(m.celulas + (size_t)y * m.colunas, 1, (size_t)m.colunas, file);
+        if (y + 1 < m.linhas) fputc('\n', file);
+    }
+    fclose(file);
+
+    file = fopen(FICHEIRO_EVENTOS, "w");
+    for (int i = 0; i < 500; i++) {
+        EventoAntena e = gerarEvento(&m, &semente);
+        if (e.tipo == EVENTO_INSERIR) fprintf(file, "A %c %d %d\n", e.frequencia, e.x, e.y);
+        else if (e.tipo == EVENTO_MOVER) fprintf(file, "M %d %d %d %d\n", e.x, e.y, e.nx, e.ny);
+        else fprintf(file, "R %d %d\n", e.x, e.y);
+        aplicarModelo(&m, &e);
+        if (i % 50 == 0) fprintf(file, "\nlinha invalida\n");
+    }
+    fclose(file);
+
+    EstatisticasEventos estatisticas;
+    VERIFICAR(processarEventos(FICHEIRO_MAPA, FICHEIRO_EVENTOS, FICHEIRO_SAIDA, 0, JANELA_EVENTOS, &estatisticas));
+    VERIFICAR(estatisticas.eventos == 510);
+    uint64_t* acumulado = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+    uint64_t* esperado = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+    aplicarAlteracoes(FICHEIRO_SAIDA, acumulado, m.colunas);
+    recalcular(&m, esperado);
+    VERIFICAR(memcmp(acumulado, esperado, palavras * sizeof(uint64_t)) == 0);
+
+    // Um mapa que não existe é um erro, sem nada escrito
+    VERIFICAR(!processarEventos("teste_eventos_inexistente.tmp", FICHEIRO_EVENTOS, FICHEIRO_SAIDA, 0, JANELA_EVENTOS, NULL));
+
+    remove(FICHEIRO_MAPA);
+    remove(FICHEIRO_EVENTOS);
+    remove(FICHEIRO_SAIDA);
+    free(m.celulas);
+    free(acumulado);
+    free(esperado);
+}
+
+int main(void) {
+    testarLotes();
+    testarProcessarEventos();
+    return terminarTeste("teste_eventos");
+}
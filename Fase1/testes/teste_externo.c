@@ -0,0 +1,90 @@
+/**
+ * @file teste_externo.c
+ * @author Hugo Baptista
+ * @brief Testes do motor de efeitos nefastos fora da memória, comparado com o motor em memória
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "tabuleiro.h"
+#include "externo.h"
+#include "teste.h"
+
+/**
+ * @brief Escreve um mapa aleatório num ficheiro
+ *
+ * @param filename Nome do ficheiro
+ * @param linhas Número de linhas
+ * @param colunas Número de colunas
+ * @param percentagem Percentagem de células com antena
+ * @param fimDeLinha 1 para terminar o ficheiro com um fim de linha
+ * @param semente Semente do gerador
+ */
+static void escreverMapa(const char* filename, int linhas, int colunas, int percentagem, int fimDeLinha, unsigned int semente) {
+    FILE* file = fopen(filename, "w");
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            int antena = (int)(aleatorio(&semente) % 100) < percentagem;
+            fputc(antena ? "aAb0"[aleatorio(&semente) % 4] : '.', file);
+        }
+        if (y + 1 < linhas || fimDeLinha) fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Compara a tabela de efeitos escrita pelo motor fora da memória com uma lista de efeitos
+ *
+ * @param filename Ficheiro escrito por detetarEfeitosNefastosExterno
+ * @param efeitos Lista esperada, ordenada por y e depois por x
+ * @return int 1 se as duas têm os mesmos efeitos pela mesma ordem, 0 caso contrário
+ */
+static int mesmosEfeitos(const char* filename, Nefasto* efeitos) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return 0;
+    char linha[128];
+    int iguais = 1, x, y;
+    while (fgets(linha, sizeof(linha), file)) {
+        if (sscanf(linha, "# |  (X:%d, Y:%d)", &x, &y) != 2) continue;
+        if (!efeitos || efeitos->x != x || efeitos->y != y) iguais = 0;
+        if (efeitos) efeitos = efeitos->prox;
+    }
+    fclose(file);
+    return iguais && !efeitos;
+}
+
+/**
+ * @brief O motor fora da memória dá os mesmos efeitos que o motor em memória, com e sem fim de linha no
+ * fim do ficheiro e com orçamentos que obrigam a várias corridas
+ */
+static void testarIgualAoMapa(void) {
+    const char* mapa = "teste_externo_mapa.txt";
+    const char* saida = "teste_externo_saida.txt";
+    for (int caso = 0; caso < 40; caso++) {
+        int linhas = 2 + caso % 37, colunas = 2 + (caso * 7) % 61;
+        escreverMapa(mapa, linhas, colunas, 4 + caso % 20, caso % 2, 1234u + (unsigned int)caso);
+        Antena* antenas = carregarAntenas(mapa);
+        Nefasto* esperados = detetarEfeitosNefastosMapa(antenas, contarLinhas(mapa), contarColunas(mapa));
+        size_t orcamento = caso % 3 ? 64 * 1024 : 1 << 20;
+        long long total = detetarEfeitosNefastosExterno(mapa, saida, orcamento);
+        VERIFICAR(total >= 0);
+        if (!mesmosEfeitos(saida, esperados)) {
+            printf("FALHOU caso %d (%dx%d, fim de linha %d)\n", caso, linhas, colunas, caso % 2);
+            falhas++;
+        }
+        libertarEfeitos(esperados);
+        libertarAntenas(antenas);
+    }
+    remove(mapa);
+    remove(saida);
+}
+
+int main(void) {
+    testarIgualAoMapa();
+    return terminarTeste("teste_externo");
+}
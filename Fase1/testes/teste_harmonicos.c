@@ -0,0 +1,149 @@
+/**
+ * @file teste_harmonicos.c
+ * @author Hugo Baptista
+ * @brief Testes do modo de harmónicos, comparado com o desenho de todas as retas de cada par
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "harmonicos.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Máximo divisor comum de dois inteiros não negativos
+ *
+ * @param a Primeiro inteiro
+ * @param b Segundo inteiro
+ * @return int mdc(a, b)
+ */
+static int mdc(int a, int b) {
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Desenha, par a par, a reta inteira de cada par de antenas da mesma frequência dentro do mapa
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param mapa Mapa de bits a preencher
+ * @return long long Número de efeitos
+ */
+static long long forcaBruta(Antena* lista, int linhas, int colunas, uint64_t* mapa) {
+    size_t palavras = ((size_t)linhas * colunas + 63) / 64;
+    memset(mapa, 0, palavras * sizeof(uint64_t));
+    for (Antena* a = lista; a; a = a->prox) {
+        if (a->x < 0 || a->x >= colunas || a->y < 0 || a->y >= linhas) continue;
+        for (Antena* b = lista; b; b = b->prox) {
+            if (b == a || b->frequencia != a->frequencia) continue;
+            if (b->x < 0 || b->x >= colunas || b->y < 0 || b->y >= linhas) continue;
+            int dx = b->x - a->x, dy = b->y - a->y;
+            int g = mdc(abs(dx), abs(dy));
+            if (g == 0) continue;
+            dx /= g;
+            dy /= g;
+            for (int s = -1; s <= 1; s += 2) {
+                for (int x = a->x, y = a->y; x >= 0 && x < colunas && y >= 0 && y < linhas; x += s * dx, y += s * dy) {
+                    size_t c = (size_t)y * colunas + x;
+                    mapa[c / 64] |= 1ULL << (c % 64);
+                }
+            }
+        }
+    }
+    long long num = 0;
+    for (size_t p = 0; p < palavras; p++) num += __builtin_popcountll(mapa[p]);
+    return num;
+}
+
+/**
+ * @brief calcularHarmonicos marca as mesmas células que a força bruta, em grupos esparsos e densos, com 1 a 4 threads
+ */
+static void testarIgualForcaBruta(void) {
+    unsigned int semente = 4050;
+    for (int caso = 0; caso < 80; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 40), colunas = 1 + (int)(aleatorio(&semente) % 40);
+        size_t celulas = (size_t)linhas * colunas, palavras = (celulas + 63) / 64;
+        // Metade dos casos tem um grupo denso num retângulo pequeno, para usar a tabela de direções do retângulo
+        int denso = caso % 2;
+        int numAntenas = denso ? 20 + (int)(aleatorio(&semente) % 40) : (int)(aleatorio(&semente) % 30);
+        int larguraDensa = 1 + colunas / 4, alturaDensa = 1 + linhas / 4;
+        Antena* antenas = (Antena*)calloc((size_t)numAntenas + 1, sizeof(Antena));
+        Antena* lista = NULL;
+        for (int i = 0; i < numAntenas; i++) {
+            if (denso && i % 3 != 0) {
+                antenas[i].frequencia = 'a';
+                antenas[i].x = (int)(aleatorio(&semente) % (unsigned)larguraDensa);
+                antenas[i].y = (int)(aleatorio(&semente) % (unsigned)alturaDensa);
+            } else {
+                antenas[i].frequencia = denso ? "Ab0"[aleatorio(&semente) % 3] : "aAb0"[aleatorio(&semente) % 4];
+                // Algumas antenas ficam fora do mapa, e não contam
+                antenas[i].x = (int)(aleatorio(&semente) % (unsigned)(colunas + 2)) - 1;
+                antenas[i].y = (int)(aleatorio(&semente) % (unsigned)(linhas + 2)) - 1;
+            }
+            antenas[i].prox = lista;
+            lista = &antenas[i];
+        }
+        uint64_t* esperado = (uint64_t*)malloc(palavras * sizeof(uint64_t));
+        uint64_t* obtido = (uint64_t*)malloc(palavras * sizeof(uint64_t));
+        long long numEsperado = forcaBruta(lista, linhas, colunas, esperado);
+        for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            long long num = calcularHarmonicos(lista, linhas, colunas, obtido);
+            if (num != numEsperado || memcmp(obtido, esperado, palavras * sizeof(uint64_t)) != 0) {
+                printf("FALHOU caso %d, %d threads: %lld efeitos, esperados %lld\n", caso, threads, num, numEsperado);
+                falhas++;
+            }
+        }
+        free(esperado);
+        free(obtido);
+        free(antenas);
+    }
+}
+
+/**
+ * @brief detetarEfeitosHarmonicos devolve a lista ordenada das células da força bruta
+ */
+static void testarLista(void) {
+    Antena c = { 'a', 4, 2, NULL };
+    Antena b = { 'a', 2, 1, &c };
+    Antena a = { 'a', 0, 0, &b };
+    int linhas = 5, colunas = 9;
+    uint64_t esperado[1];
+    forcaBruta(&a, linhas, colunas, esperado);
+    Nefasto* efeitos = detetarEfeitosHarmonicos(&a, linhas, colunas);
+    int anterior = -1, num = 0;
+    for (Nefasto* n = efeitos; n; n = n->prox, num++) {
+        int celula = n->y * colunas + n->x;
+        VERIFICAR(celula > anterior);
+        VERIFICAR(esperado[0] >> celula & 1);
+        anterior = celula;
+    }
+    VERIFICAR(num == __builtin_popcountll(esperado[0]));
+    libertarEfeitos(efeitos);
+    // Sem pares não há efeitos, nem erro
+    Antena sozinha = { 'a', 1, 1, NULL };
+    uint64_t mapa[1];
+    VERIFICAR(calcularHarmonicos(&sozinha, linhas, colunas, mapa) == 0);
+    VERIFICAR(calcularHarmonicos(&sozinha, 0, colunas, mapa) == -1);
+}
+
+int main(void) {
+    testarIgualForcaBruta();
+    testarLista();
+    return terminarTeste("teste_harmonicos");
+}
@@ -0,0 +1,255 @@
+/**
+ * @file teste_indice.c
+ * @author Hugo Baptista
+ * @brief Testes do índice espacial (consultas e remoção indexada), comparado com a procura linear na lista
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "indice.h"
+#include "teste.h"
+
+/**
+ * @brief Número máximo de antenas de cada ensaio
+ */
+#define MAX_ANTENAS 150
+
+/**
+ * @brief Antena e quadrado da sua distância a um ponto, para a procura linear dos mais próximos
+ */
+typedef struct Vizinho {
+    Antena* antena;
+    long long distancia;
+} Vizinho;
+
+/**
+ * @brief Compara dois vizinhos pela distância, depois por y e depois por x (a ordem de antenasMaisProximas)
+ *
+ * @param a Primeiro vizinho
+ * @param b Segundo vizinho
+ * @return int Negativo, zero ou positivo, como em qsort
+ */
+static int compararVizinhos(const void* a, const void* b) {
+    const Vizinho* va = (const Vizinho*)a, *vb = (const Vizinho*)b;
+    if (va->distancia != vb->distancia) return va->distancia < vb->distancia ? -1 : 1;
+    if (va->antena->y != vb->antena->y) return va->antena->y - vb->antena->y;
+    return va->antena->x - vb->antena->x;
+}
+
+/**
+ * @brief Indica se um nó pertence à lista
+ *
+ * @param lista Lista de antenas
+ * @param antena Nó a procurar
+ * @return int 1 se o nó está na lista, 0 caso contrário
+ */
+static int naLista(const Antena* lista, const Antena* antena) {
+    for (; lista; lista = lista->prox) {
+        if (lista == antena) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Indica se um resultado tem nós distintos da lista
+ *
+ * @param lista Lista de antenas
+ * @param resultado Nós devolvidos por uma consulta
+ * @param num Número de nós
+ * @return int 1 se todos os nós são da lista e nenhum se repete, 0 caso contrário
+ */
+static int nosDistintos(const Antena* lista, Antena* const* resultado, int num) {
+    for (int i = 0; i < num; i++) {
+        if (!naLista(lista, resultado[i])) return 0;
+        for (int j = 0; j < i; j++) {
+            if (resultado[j] == resultado[i]) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Cria uma lista pseudo-aleatória, com antenas repetidas na mesma posição e algumas fora do mapa do índice
+ *
+ * @param linhas Número de linhas do mapa do índice
+ * @param colunas Número de colunas do mapa do índice
+ * @param ordenada 1 para a lista ficar ordenada por y, como a de carregarAntenas
+ * @param semente Estado do gerador
+ * @return Antena* A lista criada
+ */
+static Antena* criarLista(int linhas, int colunas, int ordenada, unsigned int* semente) {
+    int num = (int)(aleatorio(semente) % (MAX_ANTENAS + 1));
+    Antena* lista = NULL;
+    for (int i = 0; i < num; i++) {
+        Antena* a = criarAntena("aAb0"[aleatorio(semente) % 4], (int)(aleatorio(semente) % (unsigned)(colunas + 4)),
+                                (int)(aleatorio(semente) % (unsigned)(linhas + 4)));
+        a->prox = lista;
+        lista = a;
+    }
+    if (ordenada) {
+        // Ordenação estável por y (inserção), sem trocar os dados entre os nós
+        Antena* ordenadas = NULL;
+        while (lista) {
+            Antena* a = lista;
+            lista = lista->prox;
+            Antena** ligacao = &ordenadas;
+            while (*ligacao && (*ligacao)->y <= a->y) ligacao = &(*ligacao)->prox;
+            a->prox = *ligacao;
+            *ligacao = a;
+        }
+        lista = ordenadas;
+    }
+    return lista;
+}
+
+/**
+ * @brief antenasNoRetangulo, antenasNoRaio e antenasMaisProximas (com e sem filtro de frequência) dão o resultado
+ * da procura linear, em 300 mapas e com pontos dentro e fora do mapa
+ */
+static void testarConsultas(void) {
+    unsigned int semente = 2727;
+    Antena* resultado[MAX_ANTENAS];
+    Vizinho vizinhos[MAX_ANTENAS];
+    for (int caso = 0; caso < 300; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 60), colunas = 1 + (int)(aleatorio(&semente) % 60);
+        Antena* lista = criarLista(linhas, colunas, 0, &semente);
+        IndiceEspacial* indice = criarIndice(lista, linhas, colunas);
+        VERIFICAR(indice != NULL);
+        for (int consulta = 0; indice && consulta < 20; consulta++) {
+            int x = (int)(aleatorio(&semente) % (unsigned)(colunas + 10)) - 5;
+            int y = (int)(aleatorio(&semente) % (unsigned)(linhas + 10)) - 5;
+            int ok = 1;
+
+            // Retângulo (às vezes invertido, e então vazio)
+            int x1 = x + (int)(aleatorio(&semente) % 30) - 5, y1 = y + (int)(aleatorio(&semente) % 30) - 5;
+            int esperado = 0;
+            for (Antena* a = lista; a; a = a->prox) esperado += a->x >= x && a->x <= x1 && a->y >= y && a->y <= y1;
+            int num = antenasNoRetangulo(indice, x, y, x1, y1, resultado, MAX_ANTENAS);
+            ok = ok && num == esperado && nosDistintos(lista, resultado, num);
+            for (int i = 0; ok && i < num; i++) {
+                ok = resultado[i]->x >= x && resultado[i]->x <= x1 && resultado[i]->y >= y && resultado[i]->y <= y1;
+            }
+            // Com pouco espaço, o total continua a ser devolvido
+            ok = ok && antenasNoRetangulo(indice, x, y, x1, y1, resultado, 2) == esperado;
+
+            // Raio
+            int raio = (int)(aleatorio(&semente) % 16);
+            esperado = 0;
+            for (Antena* a = lista; a; a = a->prox) {
+                esperado += (long long)(a->x - x) * (a->x - x) + (long long)(a->y - y) * (a->y - y) <= (long long)raio * raio;
+            }
+            num = antenasNoRaio(indice, x, y, raio, resultado, MAX_ANTENAS);
+            ok = ok && num == esperado && nosDistintos(lista, resultado, num);
+            for (int i = 0; ok && i < num; i++) {
+                long long dx = resultado[i]->x - x, dy = resultado[i]->y - y;
+                ok = dx * dx + dy * dy <= (long long)raio * raio;
+            }
+            ok = ok && antenasNoRaio(indice, x, y, -1, resultado, MAX_ANTENAS) == 0;
+
+            // k mais próximas, com e sem filtro
+            int k = 1 + (int)(aleatorio(&semente) % 10);
+            char freq = consulta % 2 ? 'a' : '\0';
+            int numVizinhos = 0;
+            for (Antena* a = lista; a; a = a->prox) {
+                if (freq && a->frequencia != freq) continue;
+                long long dx = a->x - x, dy = a->y - y;
+                vizinhos[numVizinhos].antena = a;
+                vizinhos[numVizinhos++].distancia = dx * dx + dy * dy;
+            }
+            qsort(vizinhos, (size_t)numVizinhos, sizeof(Vizinho), compararVizinhos);
+            num = antenasMaisProximas(indice, x, y, k, freq, resultado);
+            ok = ok && num == (numVizinhos < k ? numVizinhos : k) && nosDistintos(lista, resultado, num);
+            // Antenas na mesma posição empatam: compara-se a distância e a posição de cada lugar, e não o nó
+            for (int i = 0; ok && i < num; i++) {
+                long long dx = resultado[i]->x - x, dy = resultado[i]->y - y;
+                ok = dx * dx + dy * dy == vizinhos[i].distancia && resultado[i]->x == vizinhos[i].antena->x &&
+                     resultado[i]->y == vizinhos[i].antena->y && (!freq || resultado[i]->frequencia == freq);
+            }
+
+            if (!ok) {
+                printf("FALHOU caso %d, consulta %d em (%d, %d)\n", caso, consulta, x, y);
+                falhas++;
+            }
+        }
+        libertarIndice(indice);
+        libertarAntenas(lista);
+    }
+}
+
+/**
+ * @brief removerAntena com índice remove o mesmo que a procura linear (a última antena, antenas repetidas e posições
+ * livres) e o índice continua de acordo com a lista depois de cada remoção
+ */
+static void testarRemocao(void) {
+    unsigned int semente = 2828;
+    for (int caso = 0; caso < 100; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 20), colunas = 1 + (int)(aleatorio(&semente) % 20);
+        Antena* lista = criarLista(linhas, colunas, 1, &semente);
+        Antena* linear = NULL, **fim = &linear;
+        for (Antena* a = lista; a; a = a->prox) {
+            *fim = criarAntena(a->frequencia, a->x, a->y);
+            fim = &(*fim)->prox;
+        }
+        IndiceEspacial* indice = criarIndice(lista, linhas, colunas);
+        VERIFICAR(indice != NULL);
+        int ok = indice != NULL;
+        for (int passo = 0; ok && lista; passo++) {
+            int x, y;
+            Antena* ultima = lista;
+            while (ultima->prox) ultima = ultima->prox;
+            if (passo % 4 == 0) { // A última antena da lista
+                x = ultima->x;
+                y = ultima->y;
+            } else if (passo % 4 == 1) { // Uma posição com várias antenas, se houver
+                x = lista->x;
+                y = lista->y;
+                for (Antena* a = lista; a; a = a->prox) {
+                    if (contarAntenasEm(indice, a->x, a->y) > 1) {
+                        x = a->x;
+                        y = a->y;
+                        break;
+                    }
+                }
+            } else { // Uma posição qualquer, muitas vezes livre
+                x = (int)(aleatorio(&semente) % (unsigned)(colunas + 4));
+                y = (int)(aleatorio(&semente) % (unsigned)(linhas + 4));
+            }
+            int removida = removerAntena(&lista, indice, x, y);
+            ok = removida == removerAntena(&linear, NULL, x, y) && listasIguais(lista, linear) &&
+                 indiceConsistente(indice, lista, linhas + 4, colunas + 4);
+            if (!ok) {
+                printf("FALHOU caso %d, passo %d: remocao em (%d, %d)\n", caso, passo, x, y);
+                falhas++;
+            }
+        }
+        libertarIndice(indice);
+        libertarAntenas(lista);
+        libertarAntenas(linear);
+    }
+
+    // A última antena, sozinha na sua posição, e uma antena repetida no fim da lista
+    Antena* lista = NULL;
+    inserirAntena(&lista, 'a', 1, 1);
+    inserirAntena(&lista, 'a', 2, 2);
+    inserirAntena(&lista, 'b', 2, 2);
+    inserirAntena(&lista, 'a', 3, 0);
+    IndiceEspacial* indice = criarIndice(lista, 4, 4);
+    VERIFICAR(removerAntena(&lista, indice, 2, 2) && contarAntenasEm(indice, 2, 2) == 1);
+    VERIFICAR(indiceConsistente(indice, lista, 4, 4));
+    VERIFICAR(removerAntena(&lista, indice, 2, 2) && !antenaEm(indice, 2, 2));
+    VERIFICAR(indiceConsistente(indice, lista, 4, 4));
+    VERIFICAR(!removerAntena(&lista, indice, 2, 2));
+    VERIFICAR(removerAntena(&lista, indice, 3, 0) && removerAntena(&lista, indice, 1, 1) && !lista);
+    VERIFICAR(indiceConsistente(indice, lista, 4, 4));
+    libertarIndice(indice);
+}
+
+int main(void) {
+    testarConsultas();
+    testarRemocao();
+    return terminarTeste("teste_indice");
+}
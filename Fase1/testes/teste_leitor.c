@@ -0,0 +1,94 @@
+/**
+ * @file teste_leitor.c
+ * @author Hugo Baptista
+ * @brief Testes da leitura paralela do mapa, comparada com a leitura sequencial
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "leitor.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Ficheiro temporário com o mapa
+ */
+#define FICHEIRO_MAPA "teste_leitor_mapa.tmp"
+
+/**
+ * @brief Escreve um mapa aleatório com linhas de comprimento variável, algumas com mais de 99 caracteres
+ *
+ * @param filename Nome do ficheiro a escrever
+ * @param tamanho Número aproximado de bytes do mapa
+ * @param fimLinha 1 para acabar o ficheiro com '\n'
+ * @param semente Estado do gerador
+ */
+static void escreverMapa(const char* filename, size_t tamanho, int fimLinha, unsigned int* semente) {
+    FILE* file = fopen(filename, "w");
+    size_t escritos = 0;
+    while (escritos < tamanho) {
+        int comprimento = (int)(aleatorio(semente) % 260);
+        for (int x = 0; x < comprimento; x++) {
+            unsigned int r = aleatorio(semente) % 200;
+            fputc(r == 0 ? '#' : r < 4 ? "aAbZ09"[aleatorio(semente) % 6] : '.', file);
+        }
+        escritos += (size_t)comprimento + 1;
+        if (escritos < tamanho || fimLinha) fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Compara a leitura paralela com a sequencial do mesmo ficheiro, com 1 a 4 threads
+ *
+ * @param descricao Descrição do caso, para as mensagens de falha
+ */
+static void compararLeituras(const char* descricao) {
+    Antena* sequencial = carregarAntenas(FICHEIRO_MAPA);
+    for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        Antena* paralela = carregarAntenasParalelo(FICHEIRO_MAPA);
+        Antena* a = sequencial, *b = paralela;
+        long long i = 0;
+        for (; a && b; a = a->prox, b = b->prox, i++) {
+            if (a->frequencia != b->frequencia || a->x != b->x || a->y != b->y) break;
+        }
+        if (a || b) {
+            printf("FALHOU %s, %d threads: listas diferentes na antena %lld\n", descricao, threads, i);
+            falhas++;
+        }
+        libertarAntenas(paralela);
+    }
+    libertarAntenas(sequencial);
+}
+
+/**
+ * @brief carregarAntenasParalelo devolve a mesma lista que carregarAntenas, em ficheiros de um e de vários blocos
+ */
+static void testarIgualSequencial(void) {
+    unsigned int semente = 4034;
+    size_t tamanhos[] = { 0, 1, 150, 5000, 3 * (size_t)TAMANHO_BLOCO + 12345 };
+    for (size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        for (int fimLinha = 0; fimLinha <= 1; fimLinha++) {
+            char descricao[64];
+            snprintf(descricao, sizeof(descricao), "%zu bytes, fim de linha %d", tamanhos[t], fimLinha);
+            escreverMapa(FICHEIRO_MAPA, tamanhos[t], fimLinha, &semente);
+            compararLeituras(descricao);
+        }
+    }
+    remove(FICHEIRO_MAPA);
+}
+
+int main(void) {
+    testarIgualSequencial();
+    return terminarTeste("teste_leitor");
+}
@@ -0,0 +1,94 @@
+/**
+ * @file teste_lote.c
+ * @author Hugo Baptista
+ * @brief Testes do lote de inserções e remoções de antenas, comparado com inserirAntena e removerAntena
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "estruturas.h"
+#include "lista.h"
+#include "indice.h"
+#include "teste.h"
+
+/**
+ * @brief Lado do mapa dos testes (pequeno, para haver antenas repetidas na mesma posição)
+ */
+#define LADO 12
+
+/**
+ * @brief Número máximo de operações de um lote
+ */
+#define MAX_OPERACOES 40
+
+/**
+ * @brief Cria duas listas iguais, ordenadas por y como as de carregarAntenas
+ *
+ * @param a Primeira lista (saída)
+ * @param b Segunda lista (saída)
+ * @param semente Estado do gerador
+ */
+static void criarListas(Antena** a, Antena** b, unsigned int* semente) {
+    Antena** fimA = a, **fimB = b;
+    for (int y = 0; y < LADO; y++) {
+        int num = (int)(aleatorio(semente) % 3);
+        for (int i = 0; i < num; i++) {
+            Antena* na = criarAntena("aAb"[aleatorio(semente) % 3], (int)(aleatorio(semente) % LADO), y);
+            Antena* nb = criarAntena(na->frequencia, na->x, na->y);
+            *fimA = na;
+            *fimB = nb;
+            fimA = &na->prox;
+            fimB = &nb->prox;
+        }
+    }
+}
+
+/**
+ * @brief aplicarLoteAntenas dá as mesmas listas, estados e contagens que inserirAntena e removerAntena, em 2000 ensaios
+ *
+ * Metade dos ensaios aplica o lote com um índice, que tem de ficar de acordo com a lista.
+ */
+static void testarIgualSequencial(void) {
+    unsigned int semente = 1690;
+    for (int ensaio = 0; ensaio < 2000; ensaio++) {
+        Antena* lote = NULL, *sequencial = NULL;
+        criarListas(&lote, &sequencial, &semente);
+        IndiceEspacial* indice = ensaio % 2 ? criarIndice(lote, LADO + 1, LADO + 1) : NULL;
+
+        OperacaoAntena operacoes[MAX_OPERACOES];
+        int estadosLote[MAX_OPERACOES], estadosSequencial[MAX_OPERACOES];
+        int num = 1 + (int)(aleatorio(&semente) % MAX_OPERACOES);
+        for (int i = 0; i < num; i++) {
+            operacoes[i].tipo = aleatorio(&semente) % 2 ? INSERIR_ANTENA : REMOVER_ANTENA;
+            // Frequências e posições inválidas de vez em quando, que falham nas duas versões
+            operacoes[i].frequencia = "aAb."[aleatorio(&semente) % 4];
+            operacoes[i].x = (int)(aleatorio(&semente) % (LADO + 2)) - 1;
+            operacoes[i].y = (int)(aleatorio(&semente) % (LADO + 2)) - 1;
+        }
+        int aplicadas = aplicarLoteAntenas(&lote, indice, operacoes, num, estadosLote);
+        int aplicadasSequencial = 0;
+        for (int i = 0; i < num; i++) {
+            const OperacaoAntena* op = &operacoes[i];
+            if (op->tipo == INSERIR_ANTENA) estadosSequencial[i] = inserirAntena(&sequencial, op->frequencia, op->x, op->y);
+            else estadosSequencial[i] = removerAntena(&sequencial, NULL, op->x, op->y);
+            aplicadasSequencial += estadosSequencial[i];
+        }
+
+        int iguais = aplicadas == aplicadasSequencial && listasIguais(lote, sequencial);
+        for (int i = 0; i < num && iguais; i++) iguais = estadosLote[i] == estadosSequencial[i];
+        if (!iguais || (indice && !indiceConsistente(indice, lote, LADO + 1, LADO + 1))) {
+            printf("FALHOU ensaio %d%s\n", ensaio, indice ? " (com indice)" : "");
+            falhas++;
+        }
+        libertarIndice(indice);
+        libertarAntenas(lote);
+        libertarAntenas(sequencial);
+    }
+}
+
+int main(void) {
+    testarIgualSequencial();
+    return terminarTeste("teste_lote");
+}
@@ -0,0 +1,116 @@
+/**
+ * @file teste_posicionamento.c
+ * @author Hugo Baptista
+ * @brief Testes da escolha da posição de uma nova antena, comparada com a deteção completa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturas.h"
+#include "vetorial.h"
+#include "posicionamento.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Compara dois candidatos por efeitos novos, y e x
+ *
+ * @param a Primeiro candidato
+ * @param b Segundo candidato
+ * @return int Negativo, zero ou positivo, como em qsort
+ */
+static int compararCandidatos(const void* a, const void* b) {
+    const Candidato* ca = (const Candidato*)a;
+    const Candidato* cb = (const Candidato*)b;
+    if (ca->novos != cb->novos) return ca->novos - cb->novos;
+    if (ca->y != cb->y) return ca->y - cb->y;
+    return ca->x - cb->x;
+}
+
+/**
+ * @brief Avalia todas as posições livres repetindo a deteção completa com a nova antena
+ *
+ * @param lista Lista de antenas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param freq Frequência da nova antena
+ * @param candidatos Vetor com espaço para linhas x colunas candidatos, ordenado no fim
+ * @return int Número de posições livres
+ */
+static int avaliarTodas(Antena* lista, int linhas, int colunas, char freq, Candidato* candidatos) {
+    size_t palavras = ((size_t)linhas * colunas + 63) / 64;
+    uint64_t* antes = (uint64_t*)malloc(palavras * sizeof(uint64_t));
+    uint64_t* depois = (uint64_t*)malloc(palavras * sizeof(uint64_t));
+    calcularEfeitosVetorial(lista, linhas, colunas, antes);
+    int num = 0;
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            int ocupada = 0;
+            for (Antena* a = lista; a; a = a->prox) ocupada |= a->x == x && a->y == y;
+            if (ocupada) continue;
+            Antena nova = { freq, x, y, lista };
+            calcularEfeitosVetorial(&nova, linhas, colunas, depois);
+            int novos = 0;
+            for (size_t p = 0; p < palavras; p++) novos += __builtin_popcountll(depois[p] & ~antes[p]);
+            Candidato c = { x, y, novos };
+            candidatos[num++] = c;
+        }
+    }
+    qsort(candidatos, (size_t)num, sizeof(Candidato), compararCandidatos);
+    free(antes);
+    free(depois);
+    return num;
+}
+
+/**
+ * @brief melhoresPosicoes devolve as mesmas k posições que a deteção completa, com 1 a 4 threads
+ */
+static void testarIgualDetecao(void) {
+    unsigned int semente = 2024;
+    for (int caso = 0; caso < 60; caso++) {
+        int linhas = 3 + (int)(aleatorio(&semente) % 18), colunas = 3 + (int)(aleatorio(&semente) % 18);
+        int numAntenas = (int)(aleatorio(&semente) % (unsigned)(linhas * colunas / 3 + 1));
+        Antena* antenas = (Antena*)calloc((size_t)numAntenas + 1, sizeof(Antena));
+        Antena* lista = NULL;
+        for (int i = 0; i < numAntenas; i++) {
+            antenas[i].frequencia = "aAb"[aleatorio(&semente) % 3];
+            antenas[i].x = (int)(aleatorio(&semente) % (unsigned)colunas);
+            antenas[i].y = (int)(aleatorio(&semente) % (unsigned)linhas);
+            antenas[i].prox = lista;
+            lista = &antenas[i];
+        }
+        char freq = "aAb"[caso % 3];
+        int k = 1 + caso % 7;
+        Candidato* todos = (Candidato*)malloc((size_t)linhas * colunas * sizeof(Candidato));
+        int livres = avaliarTodas(lista, linhas, colunas, freq, todos);
+        int esperados = livres < k ? livres : k;
+        for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            Candidato resultado[8];
+            int num = melhoresPosicoes(lista, linhas, colunas, freq, k, resultado);
+            VERIFICAR(num == esperados);
+            for (int i = 0; i < num && i < esperados; i++) {
+                if (compararCandidatos(&resultado[i], &todos[i]) != 0) {
+                    printf("FALHOU caso %d, %d threads, posicao %d\n", caso, threads, i);
+                    falhas++;
+                    break;
+                }
+            }
+        }
+        free(todos);
+        free(antenas);
+    }
+}
+
+int main(void) {
+    testarIgualDetecao();
+    return terminarTeste("teste_posicionamento");
+}
@@ -0,0 +1,404 @@
+/**
+ * @file alcance.c
+ * @author Hugo Baptista
+ * @brief Implementação do fecho transitivo pré-calculado (alcance entre todos os pares de vértices)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "compacto.h"
+#include "alcance.h"
+
+/**
+ * @brief Calcula as componentes fortemente conexas de um grafo compacto (algoritmo de Tarjan iterativo).
+ * @internal
+ * As componentes são numeradas pela ordem em que ficam completas, pelo que uma aresta entre duas componentes
+ * diferentes vai sempre de uma componente para outra com número menor.
+ * @param compacto O grafo compacto.
+ * @param componente Vetor com espaço para numVertices posições, preenchido com a componente de cada índice.
+ * @return int Retorna o número de componentes, ou -1 em caso de erro.
+ */
+static int componentesFortes(const GrafoCompacto* compacto, int* componente) {
+    int n = compacto->numVertices;
+    size_t tam = (size_t)(n > 0 ? n : 1) * sizeof(int);
+    int* ordem = (int*)malloc(tam);
+    int* baixo = (int*)malloc(tam);
+    int* pilha = (int*)malloc(tam);
+    int* chamadas = (int*)malloc(tam);
+    int* posicao = (int*)malloc(tam);
+    if (!ordem || !baixo || !pilha || !chamadas || !posicao) {
+        printf("Erro ao alocar memoria!\n");
+        free(ordem);
+        free(baixo);
+        free(pilha);
+        free(chamadas);
+        free(posicao);
+        return -1;
+    }
+    memset(ordem, -1, tam);
+    memset(componente, -1, (size_t)n * sizeof(int));
+    int contador = 0, topoPilha = 0, numComponentes = 0;
+    for (int s = 0; s < n; s++) {
+        if (ordem[s] >= 0) continue;
+        int topo = 0;
+        chamadas[topo++] = s;
+        ordem[s] = baixo[s] = contador++;
+        posicao[s] = compacto->inicio[s];
+        pilha[topoPilha++] = s;
+        while (topo > 0) {
+            int v = chamadas[topo - 1];
+            if (posicao[v] < compacto->inicio[v + 1]) {
+                int w = compacto->destinos[posicao[v]++];
+                if (ordem[w] < 0) {
+                    ordem[w] = baixo[w] = contador++;
+                    posicao[w] = compacto->inicio[w];
+                    pilha[topoPilha++] = w;
+                    chamadas[topo++] = w;
+                } else if (componente[w] < 0 && ordem[w] < baixo[v]) {
+                    baixo[v] = ordem[w]; // w ainda está na pilha
+                }
+                continue;
+            }
+            topo--;
+            if (baixo[v] == ordem[v]) {
+                int w;
+                do {
+                    w = pilha[--topoPilha];
+                    componente[w] = numComponentes;
+                } while (w != v);
+                numComponentes++;
+            }
+            if (topo > 0 && baixo[v] < baixo[chamadas[topo - 1]]) baixo[chamadas[topo - 1]] = baixo[v];
+        }
+    }
+    free(ordem);
+    free(baixo);
+    free(pilha);
+    free(chamadas);
+    free(posicao);
+    return numComponentes;
+}
+
+/**
+ * @brief Calcula a memória, em bytes, de um fecho com um dado número de componentes.
+ * @internal
+ * @param compacto O grafo compacto.
+ * @param numComponentes Número de componentes fortemente conexas.
+ * @return size_t Retorna o número de bytes.
+ */
+static size_t memoriaFecho(const GrafoCompacto* compacto, int numComponentes) {
+    size_t palavras = ((size_t)numComponentes + 63) / 64;
+    return (size_t)numComponentes * palavras * sizeof(uint64_t) +
+           ((size_t)compacto->numVertices * 3 + (size_t)numComponentes + 1 + (size_t)compacto->maxCodigo + 1) * sizeof(int);
+}
+
+/**
+ * @brief Calcula a memória, em bytes, que o fecho transitivo de um grafo compacto ocuparia.
+ *
+ * As componentes fortemente conexas são calculadas (em tempo linear) para saber o número de linhas de bits;
+ * o valor inclui as linhas e os vetores auxiliares do fecho.
+ *
+ * @param compacto O grafo compacto.
+ * @return size_t Retorna o número de bytes, ou 0 em caso de erro.
+ */
+size_t estimarMemoriaAlcance(const GrafoCompacto* compacto) {
+    int* componente = (int*)malloc((size_t)(compacto->numVertices > 0 ? compacto->numVertices : 1) * sizeof(int));
+    if (!componente) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    int numComponentes = componentesFortes(compacto, componente);
+    free(componente);
+    return numComponentes < 0 ? 0 : memoriaFecho(compacto, numComponentes);
+}
+
+/**
+ * @brief Liberta a memória de um fecho transitivo.
+ *
+ * @param fecho O fecho a libertar (pode ser NULL).
+ */
+void libertarFechoAlcance(FechoAlcance* fecho) {
+    if (!fecho) return;
+    free(fecho->componente);
+    free(fecho->inicioComponente);
+    free(fecho->membros);
+    free(fecho->codigos);
+    free(fecho->indices);
+    free(fecho->linhas);
+    free(fecho);
+}
+
+/**
+ * @brief Cria o grafo condensado (uma aresta entre cada par de componentes ligadas) e divide-o em níveis.
+ * @internal
+ * O nível de uma componente é a maior distância a uma componente sem sucessores; as componentes são devolvidas
+ * agrupadas por nível, do nível 0 para cima.
+ * @param compacto O grafo compacto.
+ * @param fecho O fecho, com as componentes e os seus membros já calculados.
+ * @param inicioSucessores Posição em sucessores dos sucessores de cada componente (saída, numComponentes + 1 posições).
+ * @param sucessores Componentes sucessoras (saída).
+ * @param inicioNivel Posição em porNivel da primeira componente de cada nível (saída, numComponentes + 1 posições).
+ * @param porNivel Componentes agrupadas por nível (saída, numComponentes posições).
+ * @return int Retorna o número de níveis, ou -1 em caso de erro.
+ */
+static int condensarGrafo(const GrafoCompacto* compacto, const FechoAlcance* fecho, int** inicioSucessores, int** sucessores, int** inicioNivel, int** porNivel) {
+    int k = fecho->numComponentes;
+    size_t tam = (size_t)(k + 1) * sizeof(int);
+    int* ultimo = (int*)malloc(tam);
+    int* nivel = (int*)calloc((size_t)k + 1, sizeof(int));
+    *inicioSucessores = (int*)calloc((size_t)k + 1, sizeof(int));
+    *inicioNivel = (int*)calloc((size_t)k + 2, sizeof(int));
+    *porNivel = (int*)malloc(tam);
+    *sucessores = NULL;
+    if (!ultimo || !nivel || !*inicioSucessores || !*inicioNivel || !*porNivel) {
+        printf("Erro ao alocar memoria!\n");
+        free(ultimo);
+        free(nivel);
+        return -1;
+    }
+
+    // Primeira passagem conta os sucessores distintos, a segunda preenche-os e calcula os níveis
+    for (int passagem = 0; passagem < 2; passagem++) {
+        memset(ultimo, -1, tam);
+        int p = 0;
+        for (int c = 0; c < k; c++) {
+            if (passagem == 1) p = (*inicioSucessores)[c];
+            for (int m = fecho->inicioComponente[c]; m < fecho->inicioComponente[c + 1]; m++) {
+                int v = fecho->membros[m];
+                for (int e = compacto->inicio[v]; e < compacto->inicio[v + 1]; e++) {
+                    int d = fecho->componente[compacto->destinos[e]];
+                    if (d == c || ultimo[d] == c) continue;
+                    ultimo[d] = c;
+                    if (passagem == 0) (*inicioSucessores)[c + 1]++;
+                    else {
+                        (*sucessores)[p++] = d;
+                        if (nivel[d] + 1 > nivel[c]) nivel[c] = nivel[d] + 1; // d < c, o nível de d já é conhecido
+                    }
+                }
+            }
+        }
+        if (passagem == 0) {
+            for (int c = 0; c < k; c++) (*inicioSucessores)[c + 1] += (*inicioSucessores)[c];
+            *sucessores = (int*)malloc((size_t)((*inicioSucessores)[k] > 0 ? (*inicioSucessores)[k] : 1) * sizeof(int));
+            if (!*sucessores) {
+                printf("Erro ao alocar memoria!\n");
+                free(ultimo);
+                free(nivel);
+                return -1;
+            }
+        }
+    }
+
+    int numNiveis = 0;
+    for (int c = 0; c < k; c++) {
+        (*inicioNivel)[nivel[c] + 1]++;
+        if (nivel[c] + 1 > numNiveis) numNiveis = nivel[c] + 1;
+    }
+    for (int l = 0; l < numNiveis; l++) (*inicioNivel)[l + 1] += (*inicioNivel)[l];
+    memcpy(ultimo, *inicioNivel, (size_t)numNiveis * sizeof(int));
+    for (int c = 0; c < k; c++) (*porNivel)[ultimo[nivel[c]]++] = c;
+    free(ultimo);
+    free(nivel);
+    return numNiveis;
+}
+
+/**
+ * @brief Cria o fecho transitivo de um grafo compacto, se couber no orçamento de memória.
+ *
+ * Os vértices são agrupados nas suas componentes fortemente conexas (algoritmo de Tarjan iterativo), que
+ * alcançam todas o mesmo conjunto, pelo que há uma linha de bits por componente. As componentes do grafo
+ * condensado (acíclico) são divididas em níveis pela maior distância a uma componente sem sucessores; as
+ * linhas de um nível só dependem das dos níveis anteriores e são calculadas em paralelo, cada uma com o OR,
+ * palavra a palavra, das linhas das componentes sucessoras.
+ *
+ * @param compacto O grafo compacto.
+ * @param orcamento Número máximo de bytes que o fecho pode ocupar.
+ * @return FechoAlcance* Retorna o fecho, ou NULL se exceder o orçamento ou em caso de erro.
+ */
+FechoAlcance* criarFechoAlcance(const GrafoCompacto* compacto, size_t orcamento) {
+    FechoAlcance* fecho = (FechoAlcance*)calloc(1, sizeof(FechoAlcance));
+    int n = compacto->numVertices;
+    size_t tam = (size_t)(n > 0 ? n : 1) * sizeof(int);
+    if (fecho) fecho->componente = (int*)malloc(tam);
+    if (!fecho || !fecho->componente) {
+        printf("Erro ao alocar memoria!\n");
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    fecho->numVertices = n;
+    fecho->maxCodigo = compacto->maxCodigo;
+    int k = componentesFortes(compacto, fecho->componente);
+    if (k < 0) {
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    if (memoriaFecho(compacto, k) > orcamento) {
+        printf("Orcamento de memoria excedido!\n");
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    fecho->numComponentes = k;
+    fecho->palavras = ((size_t)k + 63) / 64;
+    fecho->inicioComponente = (int*)calloc((size_t)k + 1, sizeof(int));
+    fecho->membros = (int*)malloc(tam);
+    fecho->codigos = (int*)malloc(tam);
+    fecho->indices = (int*)malloc((size_t)(compacto->maxCodigo + 1) * sizeof(int));
+    fecho->linhas = (uint64_t*)calloc((size_t)(k > 0 ? k : 1) * fecho->palavras + 1, sizeof(uint64_t));
+    if (!fecho->inicioComponente || !fecho->membros || !fecho->codigos || !fecho->indices || !fecho->linhas) {
+        printf("Erro ao alocar memoria!\n");
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    memcpy(fecho->codigos, compacto->codigos, (size_t)n * sizeof(int));
+    memcpy(fecho->indices, compacto->indices, (size_t)(compacto->maxCodigo + 1) * sizeof(int));
+
+    // Membros de cada componente, por ordem crescente de índice
+    for (int v = 0; v < n; v++) fecho->inicioComponente[fecho->componente[v] + 1]++;
+    for (int c = 0; c < k; c++) fecho->inicioComponente[c + 1] += fecho->inicioComponente[c];
+    int* pos = (int*)malloc((size_t)(k + 1) * sizeof(int));
+    if (!pos) {
+        printf("Erro ao alocar memoria!\n");
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    memcpy(pos, fecho->inicioComponente, (size_t)(k + 1) * sizeof(int));
+    for (int v = 0; v < n; v++) fecho->membros[pos[fecho->componente[v]]++] = v;
+    free(pos);
+
+    int* inicioSucessores, *sucessores, *inicioNivel, *porNivel;
+    int numNiveis = condensarGrafo(compacto, fecho, &inicioSucessores, &sucessores, &inicioNivel, &porNivel);
+    if (numNiveis >= 0) {
+        uint64_t* linhas = fecho->linhas;
+        size_t palavras = fecho->palavras;
+        #pragma omp parallel
+        {
+            for (int l = 0; l < numNiveis; l++) {
+                // As linhas do nível l só leem as dos níveis anteriores; o fim do for sincroniza as threads
+                #pragma omp for schedule(dynamic, 16)
+                for (int i = inicioNivel[l]; i < inicioNivel[l + 1]; i++) {
+                    int c = porNivel[i];
+                    uint64_t* linha = linhas + (size_t)c * palavras;
+                    linha[c / 64] |= 1ULL << (c % 64);
+                    for (int s = inicioSucessores[c]; s < inicioSucessores[c + 1]; s++) {
+                        const uint64_t* outra = linhas + (size_t)sucessores[s] * palavras;
+                        #pragma omp simd
+                        for (size_t w = 0; w < palavras; w++) linha[w] |= outra[w];
+                    }
+                }
+            }
+        }
+    }
+    free(inicioSucessores);
+    free(sucessores);
+    free(inicioNivel);
+    free(porNivel);
+    if (numNiveis < 0) {
+        libertarFechoAlcance(fecho);
+        return NULL;
+    }
+    return fecho;
+}
+
+/**
+ * @brief Devolve o índice de um código no fecho.
+ * @internal
+ * @param fecho O fecho transitivo.
+ * @param codigo O código do vértice.
+ * @return int Retorna o índice do vértice, ou -1 se não existir.
+ */
+static inline int indiceFecho(const FechoAlcance* fecho, int codigo) {
+    if (codigo < 0 || codigo > fecho->maxCodigo) return -1;
+    return fecho->indices[codigo];
+}
+
+/**
+ * @brief Indica se um vértice é alcançável a partir de outro, em tempo constante.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origem O código do vértice de origem.
+ * @param destino O código do vértice de destino.
+ * @return int Retorna 1 se existe um caminho (cada vértice alcança-se a si próprio), 0 se não existe, ou -1 se um dos vértices não existir.
+ */
+int alcancavel(const FechoAlcance* fecho, int origem, int destino) {
+    int o = indiceFecho(fecho, origem), d = indiceFecho(fecho, destino);
+    if (o < 0 || d < 0) return -1;
+    int co = fecho->componente[o], cd = fecho->componente[d];
+    return (int)(fecho->linhas[(size_t)co * fecho->palavras + cd / 64] >> (cd % 64) & 1);
+}
+
+/**
+ * @brief Escreve os códigos dos vértices cujas componentes estão num conjunto de bits.
+ * @internal
+ * @param fecho O fecho transitivo.
+ * @param conjunto Conjunto de bits de componentes.
+ * @param destinos Vetor a preencher, por ordem de índice.
+ * @return int Retorna o número de vértices escritos.
+ */
+static int listarVertices(const FechoAlcance* fecho, const uint64_t* conjunto, int* destinos) {
+    int num = 0;
+    for (int v = 0; v < fecho->numVertices; v++) {
+        int c = fecho->componente[v];
+        if (conjunto[c / 64] >> (c % 64) & 1) destinos[num++] = fecho->codigos[v];
+    }
+    return num;
+}
+
+/**
+ * @brief Lista os vértices alcançáveis a partir de um vértice.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origem O código do vértice de origem.
+ * @param destinos Vetor com espaço para numVertices códigos, preenchido por ordem de índice (incluindo a origem).
+ * @return int Retorna o número de vértices alcançáveis, ou -1 se o vértice não existir.
+ */
+int alcancaveisDe(const FechoAlcance* fecho, int origem, int* destinos) {
+    int o = indiceFecho(fecho, origem);
+    if (o < 0) return -1;
+    return listarVertices(fecho, fecho->linhas + (size_t)fecho->componente[o] * fecho->palavras, destinos);
+}
+
+/**
+ * @brief Lista os vértices alcançáveis a partir de algum (ou de todos) os vértices de um conjunto.
+ *
+ * As linhas das origens são combinadas palavra a palavra (OR para algum, AND para todos), num ciclo que o
+ * compilador vetoriza; só depois os vértices do resultado são listados.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origens Os códigos dos vértices de origem.
+ * @param num Número de origens.
+ * @param todos 1 para os vértices alcançáveis a partir de todas as origens, 0 para os alcançáveis a partir de alguma.
+ * @param destinos Vetor com espaço para numVertices códigos, preenchido por ordem de índice.
+ * @return int Retorna o número de vértices do resultado, ou -1 se uma das origens não existir ou em caso de erro.
+ */
+int alcanceConjunto(const FechoAlcance* fecho, const int* origens, int num, int todos, int* destinos) {
+    for (int i = 0; i < num; i++) {
+        if (indiceFecho(fecho, origens[i]) < 0) return -1;
+    }
+    if (num <= 0) return 0;
+    size_t palavras = fecho->palavras;
+    uint64_t* conjunto = (uint64_t*)malloc((palavras > 0 ? palavras : 1) * sizeof(uint64_t));
+    if (!conjunto) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+    const uint64_t* primeira = fecho->linhas + (size_t)fecho->componente[indiceFecho(fecho, origens[0])] * palavras;
+    memcpy(conjunto, primeira, palavras * sizeof(uint64_t));
+    for (int i = 1; i < num; i++) {
+        const uint64_t* linha = fecho->linhas + (size_t)fecho->componente[indiceFecho(fecho, origens[i])] * palavras;
+        if (todos) {
+            #pragma omp simd
+            for (size_t w = 0; w < palavras; w++) conjunto[w] &= linha[w];
+        } else {
+            #pragma omp simd
+            for (size_t w = 0; w < palavras; w++) conjunto[w] |= linha[w];
+        }
+    }
+    int total = listarVertices(fecho, conjunto, destinos);
+    free(conjunto);
+    return total;
+}
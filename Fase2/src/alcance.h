@@ -0,0 +1,83 @@
+/**
+ * @file alcance.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do fecho transitivo pré-calculado (alcance entre todos os pares de vértices)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef ALCANCE_H
+#define ALCANCE_H
+
+#include <stddef.h>
+#include "estruturasDados.h"
+
+/**
+ * @brief Orçamento de memória por omissão, em bytes, para o fecho transitivo.
+ */
+#define ORCAMENTO_ALCANCE ((size_t)512 * 1024 * 1024)
+
+/**
+ * @brief Calcula a memória, em bytes, que o fecho transitivo de um grafo compacto ocuparia.
+ *
+ * As componentes fortemente conexas são calculadas (em tempo linear) para saber o número de linhas de bits;
+ * o valor inclui as linhas e os vetores auxiliares do fecho.
+ *
+ * @param compacto O grafo compacto.
+ * @return size_t Retorna o número de bytes, ou 0 em caso de erro.
+ */
+size_t estimarMemoriaAlcance(const GrafoCompacto* compacto);
+/**
+ * @brief Cria o fecho transitivo de um grafo compacto, se couber no orçamento de memória.
+ *
+ * Os vértices são agrupados nas suas componentes fortemente conexas (algoritmo de Tarjan iterativo), que
+ * alcançam todas o mesmo conjunto, pelo que há uma linha de bits por componente. As componentes do grafo
+ * condensado (acíclico) são divididas em níveis pela maior distância a uma componente sem sucessores; as
+ * linhas de um nível só dependem das dos níveis anteriores e são calculadas em paralelo, cada uma com o OR,
+ * palavra a palavra, das linhas das componentes sucessoras.
+ *
+ * @param compacto O grafo compacto.
+ * @param orcamento Número máximo de bytes que o fecho pode ocupar.
+ * @return FechoAlcance* Retorna o fecho, ou NULL se exceder o orçamento ou em caso de erro.
+ */
+FechoAlcance* criarFechoAlcance(const GrafoCompacto* compacto, size_t orcamento);
+/**
+ * @brief Liberta a memória de um fecho transitivo.
+ *
+ * @param fecho O fecho a libertar (pode ser NULL).
+ */
+void libertarFechoAlcance(FechoAlcance* fecho);
+/**
+ * @brief Indica se um vértice é alcançável a partir de outro, em tempo constante.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origem O código do vértice de origem.
+ * @param destino O código do vértice de destino.
+ * @return int Retorna 1 se existe um caminho (cada vértice alcança-se a si próprio), 0 se não existe, ou -1 se um dos vértices não existir.
+ */
+int alcancavel(const FechoAlcance* fecho, int origem, int destino);
+/**
+ * @brief Lista os vértices alcançáveis a partir de um vértice.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origem O código do vértice de origem.
+ * @param destinos Vetor com espaço para numVertices códigos, preenchido por ordem de índice (incluindo a origem).
+ * @return int Retorna o número de vértices alcançáveis, ou -1 se o vértice não existir.
+ */
+int alcancaveisDe(const FechoAlcance* fecho, int origem, int* destinos);
+/**
+ * @brief Lista os vértices alcançáveis a partir de algum (ou de todos) os vértices de um conjunto.
+ *
+ * As linhas das origens são combinadas palavra a palavra (OR para algum, AND para todos), num ciclo que o
+ * compilador vetoriza; só depois os vértices do resultado são listados.
+ *
+ * @param fecho O fecho transitivo.
+ * @param origens Os códigos dos vértices de origem.
+ * @param num Número de origens.
+ * @param todos 1 para os vértices alcançáveis a partir de todas as origens, 0 para os alcançáveis a partir de alguma.
+ * @param destinos Vetor com espaço para numVertices códigos, preenchido por ordem de índice.
+ * @return int Retorna o número de vértices do resultado, ou -1 se uma das origens não existir ou em caso de erro.
+ */
+int alcanceConjunto(const FechoAlcance* fecho, const int* origens, int num, int todos, int* destinos);
+
+#endif
@@ -0,0 +1,291 @@
+/**
+ * @file armazem.c
+ * @author Hugo Baptista
+ * @brief Implementação do armazém compacto de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "leitor.h"
+#include "armazem.h"
+
+/**
+ * @brief Maior dimensão do mapa cujas coordenadas cabem em 16 bits
+ */
+#define MAX_DIMENSAO_16 65536
+
+/**
+ * @brief Aumenta a capacidade dos vetores do armazém
+ * @internal
+ * @param armazem Armazém de antenas
+ * @param cap Nova capacidade
+ * @return int 1 se a capacidade foi aumentada com sucesso, 0 caso contrário
+ */
+static int aumentarArmazem(ArmazemAntenas* armazem, int cap) {
+    unsigned char* f = (unsigned char*)realloc(armazem->frequencias, (size_t)cap);
+    if (!f) return 0;
+    armazem->frequencias = f;
+    if (armazem->x16) {
+        uint16_t* x = (uint16_t*)realloc(armazem->x16, (size_t)cap * sizeof(uint16_t));
+        if (!x) return 0;
+        armazem->x16 = x;
+        uint16_t* y = (uint16_t*)realloc(armazem->y16, (size_t)cap * sizeof(uint16_t));
+        if (!y) return 0;
+        armazem->y16 = y;
+    } else {
+        uint32_t* x = (uint32_t*)realloc(armazem->x32, (size_t)cap * sizeof(uint32_t));
+        if (!x) return 0;
+        armazem->x32 = x;
+        uint32_t* y = (uint32_t*)realloc(armazem->y32, (size_t)cap * sizeof(uint32_t));
+        if (!y) return 0;
+        armazem->y32 = y;
+    }
+    armazem->cap = cap;
+    return 1;
+}
+
+/**
+ * @brief Cria um armazém de antenas vazio
+ *
+ * As coordenadas são guardadas em 16 bits quando o mapa tem no máximo 65536 linhas e colunas, e em 32 bits caso contrário.
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param cap Capacidade inicial (número de antenas)
+ * @return ArmazemAntenas* Apontador para o armazém criado, ou NULL em caso de erro
+ */
+ArmazemAntenas* criarArmazem(int linhas, int colunas, int cap) {
+    if (linhas < 0 || colunas < 0) return NULL;
+    ArmazemAntenas* armazem = (ArmazemAntenas*)calloc(1, sizeof(ArmazemAntenas));
+    if (!armazem) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    armazem->linhas = linhas;
+    armazem->colunas = colunas;
+    int estreito = linhas <= MAX_DIMENSAO_16 && colunas <= MAX_DIMENSAO_16;
+    if (cap < 16) cap = 16;
+    armazem->frequencias = (unsigned char*)malloc((size_t)cap);
+    if (estreito) {
+        armazem->x16 = (uint16_t*)malloc((size_t)cap * sizeof(uint16_t));
+        armazem->y16 = (uint16_t*)malloc((size_t)cap * sizeof(uint16_t));
+    } else {
+        armazem->x32 = (uint32_t*)malloc((size_t)cap * sizeof(uint32_t));
+        armazem->y32 = (uint32_t*)malloc((size_t)cap * sizeof(uint32_t));
+    }
+    if (!armazem->frequencias || (estreito ? !armazem->x16 || !armazem->y16 : !armazem->x32 || !armazem->y32)) {
+        printf("Erro ao alocar memoria!\n");
+        libertarArmazem(armazem);
+        return NULL;
+    }
+    armazem->cap = cap;
+    return armazem;
+}
+
+/**
+ * @brief Liberta a memória alocada para o armazém
+ *
+ * @param armazem Armazém a libertar
+ */
+void libertarArmazem(ArmazemAntenas* armazem) {
+    if (!armazem) return;
+    free(armazem->frequencias);
+    free(armazem->x16);
+    free(armazem->y16);
+    free(armazem->x32);
+    free(armazem->y32);
+    free(armazem);
+}
+
+/**
+ * @brief Acrescenta uma antena ao armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param freq Frequência da antena
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @return int Índice da antena, ou -1 se a antena for inválida ou em caso de erro
+ */
+int armazemInserir(ArmazemAntenas* armazem, char freq, int x, int y) {
+    if (!armazem || freq == '.' || freq == '#') return -1;
+    if (x < 0 || y < 0 || x >= armazem->colunas || y >= armazem->linhas) return -1;
+    if (armazem->num == armazem->cap && !aumentarArmazem(armazem, armazem->cap * 2)) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+    int i = armazem->num++;
+    armazem->frequencias[i] = (unsigned char)freq;
+    if (armazem->x16) {
+        armazem->x16[i] = (uint16_t)x;
+        armazem->y16[i] = (uint16_t)y;
+    } else {
+        armazem->x32[i] = (uint32_t)x;
+        armazem->y32[i] = (uint32_t)y;
+    }
+    return i;
+}
+
+/**
+ * @brief Remove uma antena do armazém, mantendo os índices das restantes
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena a remover
+ * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ */
+int armazemRemover(ArmazemAntenas* armazem, int indice) {
+    if (!armazem || indice < 0 || indice >= armazem->num) return 0;
+    if (armazem->frequencias[indice] == FREQUENCIA_REMOVIDA) return 0;
+    armazem->frequencias[indice] = FREQUENCIA_REMOVIDA;
+    armazem->removidas++;
+    return 1;
+}
+
+/**
+ * @brief Devolve a coordenada x de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada x
+ */
+int armazemX(const ArmazemAntenas* armazem, int indice) {
+    return armazem->x16 ? armazem->x16[indice] : (int)armazem->x32[indice];
+}
+
+/**
+ * @brief Devolve a coordenada y de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada y
+ */
+int armazemY(const ArmazemAntenas* armazem, int indice) {
+    return armazem->y16 ? armazem->y16[indice] : (int)armazem->y32[indice];
+}
+
+/**
+ * @brief Cria um armazém com as antenas dos vértices de um grafo, pela ordem da lista de vértices.
+ * 
+ * @param grafo O grafo.
+ * @param linhas Número de linhas do mapa.
+ * @param colunas Número de colunas do mapa.
+ * @return ArmazemAntenas* Retorna o armazém criado (o índice de cada antena é a posição do vértice na lista), ou NULL em caso de erro.
+ */
+ArmazemAntenas* armazemDeGrafo(Grafo grafo, int linhas, int colunas) {
+    ArmazemAntenas* armazem = criarArmazem(linhas, colunas, grafo.numVertices);
+    if (!armazem) return NULL;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) {
+        if (armazemInserir(armazem, v->antena.frequencia, v->antena.x, v->antena.y) < 0) {
+            libertarArmazem(armazem);
+            return NULL;
+        }
+    }
+    return armazem;
+}
+
+/**
+ * @brief Lê as antenas de um ficheiro diretamente para um armazém, sem criar vértices.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @return ArmazemAntenas* Retorna o armazém com as antenas por ordem de leitura (y e depois x), ou NULL em caso de erro.
+ * @attention O mapa tem tantas linhas como fins de linha mais 1 (um fim de linha no fim do ficheiro abre uma
+ * linha vazia) e tantas colunas como a linha mais comprida; as linhas não são divididas aos 99 caracteres,
+ * ao contrário de lerGrafo.
+ */
+ArmazemAntenas* lerArmazem(const char* nomeFicheiro) {
+    size_t tamanho;
+    char* dados = mapearFicheiro(nomeFicheiro, &tamanho);
+    if (!dados) return NULL;
+
+    // Primeira passagem: dimensões do mapa e número de antenas, para escolher a largura das coordenadas
+    int linhas = 0, colunas = 0, x = 0, num = 0;
+    for (size_t i = 0; i < tamanho; i++) {
+        if (dados[i] == '\n') {
+            if (x > colunas) colunas = x;
+            x = 0;
+            linhas++;
+            continue;
+        }
+        if (dados[i] != '.' && dados[i] != '#') num++;
+        x++;
+    }
+    if (x > colunas) colunas = x;
+    linhas++; // Fins de linha mais 1: um fim de linha no fim do ficheiro abre uma linha vazia
+
+    ArmazemAntenas* armazem = criarArmazem(linhas, colunas, num);
+    if (armazem) {
+        int y = 0;
+        x = 0;
+        for (size_t i = 0; i < tamanho; i++) {
+            if (dados[i] == '\n') {
+                x = 0;
+                y++;
+                continue;
+            }
+            if (dados[i] != '.' && dados[i] != '#') armazemInserir(armazem, dados[i], x, y);
+            x++;
+        }
+    }
+    libertarFicheiro(dados, tamanho);
+    return armazem;
+}
+
+/**
+ * @brief Cria o grafo das antenas do armazém, ligando todas as antenas da mesma frequência.
+ * 
+ * Os vértices são criados pela ordem dos índices (as antenas removidas são saltadas) e cada vértice fica
+ * adjacente a todos os outros da sua frequência, por ordem de código, tal como em lerGrafo.
+ * As antenas são agrupadas por frequência com uma contagem sobre o vetor de frequências, sem comparar pares de vértices.
+ * 
+ * @param armazem O armazém de antenas.
+ * @return Grafo Retorna o grafo criado.
+ */
+Grafo grafoDeArmazem(const ArmazemAntenas* armazem) {
+    Grafo grafo = criarGrafo();
+    int vivas = armazem->num - armazem->removidas;
+    Vertice** vetor = (Vertice**)malloc((size_t)(vivas > 0 ? vivas : 1) * sizeof(Vertice*));
+    int* membros = (int*)malloc((size_t)(vivas > 0 ? vivas : 1) * sizeof(int));
+    if (!vetor || !membros) {
+        printf("Erro ao alocar memoria!\n");
+        free(vetor);
+        free(membros);
+        return grafo;
+    }
+
+    // Vértices pela ordem dos índices, ligados com um apontador para o fim da lista
+    int num = 0, inicioFreq[NUM_FREQUENCIAS + 1] = {0}, pos[NUM_FREQUENCIAS];
+    Vertice** tail = &grafo.vertices;
+    for (int i = 0; i < armazem->num; i++) {
+        if (armazem->frequencias[i] == FREQUENCIA_REMOVIDA) continue;
+        Vertice* novo = criarVertice(grafo.proximoCodigo++, armazemX(armazem, i), armazemY(armazem, i), (char)armazem->frequencias[i]);
+        if (!novo) continue;
+        *tail = novo;
+        tail = &novo->prox;
+        vetor[num++] = novo;
+        inicioFreq[armazem->frequencias[i] + 1]++;
+    }
+    grafo.numVertices = num;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFreq[f + 1] += inicioFreq[f];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (int i = 0; i < num; i++) membros[pos[(unsigned char)vetor[i]->antena.frequencia]++] = i;
+
+    for (int i = 0; i < num; i++) {
+        int f = (unsigned char)vetor[i]->antena.frequencia;
+        Adjacente** cauda = &vetor[i]->adjacentes;
+        for (int m = inicioFreq[f]; m < inicioFreq[f + 1]; m++) {
+            if (membros[m] == i) continue;
+            Adjacente* novo = criarAdjacente(vetor[membros[m]]->codigo);
+            if (!novo) break;
+            *cauda = novo;
+            cauda = &novo->prox;
+        }
+    }
+    free(vetor);
+    free(membros);
+    return grafo;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file armazem.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções do armazém compacto de antenas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef ARMAZEM_H
+#define ARMAZEM_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Frequência que marca uma antena removida do armazém
+ */
+#define FREQUENCIA_REMOVIDA '.'
+
+/**
+ * @brief Cria um armazém de antenas vazio
+ *
+ * As coordenadas são guardadas em 16 bits quando o mapa tem no máximo 65536 linhas e colunas, e em 32 bits caso contrário.
+ *
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @param cap Capacidade inicial (número de antenas)
+ * @return ArmazemAntenas* Apontador para o armazém criado, ou NULL em caso de erro
+ */
+ArmazemAntenas* criarArmazem(int linhas, int colunas, int cap);
+/**
+ * @brief Liberta a memória alocada para o armazém
+ *
+ * @param armazem Armazém a libertar
+ */
+void libertarArmazem(ArmazemAntenas* armazem);
+/**
+ * @brief Acrescenta uma antena ao armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param freq Frequência da antena
+ * @param x Coordenada x da antena
+ * @param y Coordenada y da antena
+ * @return int Índice da antena, ou -1 se a antena for inválida ou em caso de erro
+ */
+int armazemInserir(ArmazemAntenas* armazem, char freq, int x, int y);
+/**
+ * @brief Remove uma antena do armazém, mantendo os índices das restantes
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena a remover
+ * @return int 1 se a antena foi removida com sucesso, 0 caso contrário
+ */
+int armazemRemover(ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Devolve a coordenada x de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada x
+ */
+int armazemX(const ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Devolve a coordenada y de uma antena do armazém
+ *
+ * @param armazem Armazém de antenas
+ * @param indice Índice da antena
+ * @return int Coordenada y
+ */
+int armazemY(const ArmazemAntenas* armazem, int indice);
+/**
+ * @brief Cria um armazém com as antenas dos vértices de um grafo, pela ordem da lista de vértices.
+ * 
+ * @param grafo O grafo.
+ * @param linhas Número de linhas do mapa.
+ * @param colunas Número de colunas do mapa.
+ * @return ArmazemAntenas* Retorna o armazém criado (o índice de cada antena é a posição do vértice na lista), ou NULL em caso de erro.
+ */
+ArmazemAntenas* armazemDeGrafo(Grafo grafo, int linhas, int colunas);
+/**
+ * @brief Lê as antenas de um ficheiro diretamente para um armazém, sem criar vértices.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @return ArmazemAntenas* Retorna o armazém com as antenas por ordem de leitura (y e depois x), ou NULL em caso de erro.
+ * @attention O mapa tem tantas linhas como fins de linha mais 1 (um fim de linha no fim do ficheiro abre uma
+ * linha vazia) e tantas colunas como a linha mais comprida; as linhas não são divididas aos 99 caracteres,
+ * ao contrário de lerGrafo.
+ */
+ArmazemAntenas* lerArmazem(const char* nomeFicheiro);
+/**
+ * @brief Cria o grafo das antenas do armazém, ligando todas as antenas da mesma frequência.
+ * 
+ * Os vértices são criados pela ordem dos índices (as antenas removidas são saltadas) e cada vértice fica
+ * adjacente a todos os outros da sua frequência, por ordem de código, tal como em lerGrafo.
+ * As antenas são agrupadas por frequência com uma contagem sobre o vetor de frequências, sem comparar pares de vértices.
+ * 
+ * @param armazem O armazém de antenas.
+ * @return Grafo Retorna o grafo criado.
+ */
+Grafo grafoDeArmazem(const ArmazemAntenas* armazem);
+
+#endif
@@ -0,0 +1,452 @@
+/**
+ * @file cache.c
+ * @author Hugo Baptista
+ * @brief Implementação da cache persistente de resultados, indexada pelo hash do conteúdo do mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "leitor.h"
+#include "saida.h"
+#include "cache.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+/**
+ * @brief Tamanho máximo do caminho de um ficheiro da cache.
+ */
+#define TAMANHO_CAMINHO 512
+/**
+ * @brief Número mágico no início dos ficheiros da cache ("EDAC").
+ */
+#define MAGIA_CACHE 0x43414445u
+/**
+ * @brief Versão do formato dos grafos da Fase 2, também usada como semente do hash.
+ */
+#define VERSAO_GRAFO 0x4632000000000001ULL
+
+/**
+ * @brief Cabeçalho de um ficheiro da cache.
+ * @internal
+ */
+typedef struct CabecalhoCache {
+    uint32_t magia;       /**< MAGIA_CACHE. */
+    uint32_t reservado;   /**< Zero. */
+    uint64_t versao;      /**< Versão do formato do resultado. */
+    uint64_t hash;        /**< Hash do conteúdo do mapa. */
+    uint64_t tamanho;     /**< Número de bytes do mapa. */
+    uint64_t verificacao; /**< Hash do resto do ficheiro, para detetar ficheiros corrompidos. */
+    uint64_t numA;        /**< Número de vértices. */
+    uint64_t numB;        /**< Número total de adjacências. */
+    uint64_t proximo;     /**< Código do próximo vértice a criar. */
+} CabecalhoCache;
+
+/**
+ * @brief Primos do xxHash de 64 bits.
+ */
+#define PRIMO64_1 0x9E3779B185EBCA87ULL
+#define PRIMO64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIMO64_3 0x165667B19E3779F9ULL
+#define PRIMO64_4 0x85EBCA77C2B2AE63ULL
+#define PRIMO64_5 0x27D4EB2F165667C5ULL
+
+/**
+ * @brief Roda os bits de uma palavra para a esquerda.
+ * @internal
+ * @param v Palavra a rodar.
+ * @param r Número de bits (1 a 63).
+ * @return uint64_t Retorna a palavra rodada.
+ */
+static inline uint64_t rodar(uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+/**
+ * @brief Lê 8 bytes em little-endian de um endereço possivelmente desalinhado.
+ * @internal
+ * @param p Endereço a ler.
+ * @return uint64_t Retorna a palavra lida.
+ */
+static inline uint64_t ler64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Lê 4 bytes em little-endian de um endereço possivelmente desalinhado.
+ * @internal
+ * @param p Endereço a ler.
+ * @return uint32_t Retorna a palavra lida.
+ */
+static inline uint32_t ler32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/**
+ * @brief Acumula uma palavra num acumulador do xxHash.
+ * @internal
+ * @param acc Acumulador.
+ * @param v Palavra.
+ * @return uint64_t Retorna o novo valor do acumulador.
+ */
+static inline uint64_t rondaXXH64(uint64_t acc, uint64_t v) {
+    acc += v * PRIMO64_2;
+    acc = rodar(acc, 31);
+    return acc * PRIMO64_1;
+}
+
+/**
+ * @brief Junta um acumulador ao hash.
+ * @internal
+ * @param h Hash.
+ * @param acc Acumulador.
+ * @return uint64_t Retorna o novo valor do hash.
+ */
+static inline uint64_t juntarXXH64(uint64_t h, uint64_t acc) {
+    h ^= rondaXXH64(0, acc);
+    return h * PRIMO64_1 + PRIMO64_4;
+}
+
+/**
+ * @brief Calcula o hash XXH64 de um bloco de memória.
+ *
+ * Implementação do algoritmo xxHash de 64 bits (não criptográfico): o bloco é consumido em faixas de
+ * 32 bytes por quatro acumuladores independentes, pelo que o custo é próximo do de ler o bloco.
+ *
+ * @param dados Bloco a resumir.
+ * @param tamanho Número de bytes do bloco.
+ * @param semente Semente do hash.
+ * @return uint64_t Retorna o hash do bloco.
+ */
+uint64_t hashXXH64(const void* dados, size_t tamanho, uint64_t semente) {
+    const unsigned char* p = (const unsigned char*)dados;
+    const unsigned char* fim = p + tamanho;
+    uint64_t h;
+    if (tamanho >= 32) {
+        uint64_t v1 = semente + PRIMO64_1 + PRIMO64_2, v2 = semente + PRIMO64_2;
+        uint64_t v3 = semente, v4 = semente - PRIMO64_1;
+        const unsigned char* limite = fim - 32;
+        do {
+            v1 = rondaXXH64(v1, ler64(p));
+            v2 = rondaXXH64(v2, ler64(p + 8));
+            v3 = rondaXXH64(v3, ler64(p + 16));
+            v4 = rondaXXH64(v4, ler64(p + 24));
+            p += 32;
+        } while (p <= limite);
+        h = rodar(v1, 1) + rodar(v2, 7) + rodar(v3, 12) + rodar(v4, 18);
+        h = juntarXXH64(h, v1);
+        h = juntarXXH64(h, v2);
+        h = juntarXXH64(h, v3);
+        h = juntarXXH64(h, v4);
+    } else {
+        h = semente + PRIMO64_5;
+    }
+    h += (uint64_t)tamanho;
+    for (; p + 8 <= fim; p += 8) {
+        h ^= rondaXXH64(0, ler64(p));
+        h = rodar(h, 27) * PRIMO64_1 + PRIMO64_4;
+    }
+    if (p + 4 <= fim) {
+        h ^= (uint64_t)ler32(p) * PRIMO64_1;
+        h = rodar(h, 23) * PRIMO64_2 + PRIMO64_3;
+        p += 4;
+    }
+    for (; p < fim; p++) {
+        h ^= (*p) * PRIMO64_5;
+        h = rodar(h, 11) * PRIMO64_1;
+    }
+    h ^= h >> 33;
+    h *= PRIMO64_2;
+    h ^= h >> 29;
+    h *= PRIMO64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Entrada da cache considerada por limitarCache.
+ * @internal
+ */
+typedef struct EntradaCache {
+    char caminho[TAMANHO_CAMINHO]; /**< Caminho do ficheiro. */
+    time_t modificado;             /**< Data da última modificação (ou reaproveitamento). */
+    unsigned long long tamanho;    /**< Número de bytes do ficheiro. */
+} EntradaCache;
+
+/**
+ * @brief Compara duas entradas da cache pela data de modificação (mais antiga primeiro).
+ * @internal
+ * @param a Primeira entrada.
+ * @param b Segunda entrada.
+ * @return int Retorna um valor negativo, zero ou positivo, como no qsort.
+ */
+static int compararEntradas(const void* a, const void* b) {
+    time_t ta = ((const EntradaCache*)a)->modificado, tb = ((const EntradaCache*)b)->modificado;
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite.
+ *
+ * Os ficheiros são removidos do mais antigo para o mais recente, pela data de modificação, que é
+ * atualizada sempre que um ficheiro é reaproveitado.
+ *
+ * @param diretorio Diretório da cache.
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache.
+ * @return int Retorna o número de ficheiros removidos, ou -1 se o diretório não puder ser lido.
+ */
+int limitarCache(const char* diretorio, size_t limite) {
+    DIR* dir = opendir(diretorio);
+    if (!dir) return -1;
+    EntradaCache* entradas = NULL;
+    int num = 0, cap = 0;
+    unsigned long long total = 0;
+    size_t tamExtensao = strlen(EXTENSAO_CACHE);
+    struct dirent* e;
+    while ((e = readdir(dir))) {
+        size_t tam = strlen(e->d_name);
+        if (tam <= tamExtensao || strcmp(e->d_name + tam - tamExtensao, EXTENSAO_CACHE) != 0) continue;
+        if (num == cap) {
+            int novaCap = cap ? cap * 2 : 16;
+            EntradaCache* novas = (EntradaCache*)realloc(entradas, (size_t)novaCap * sizeof(EntradaCache));
+            if (!novas) {
+                printf("Erro ao alocar memoria!\n");
+                break;
+            }
+            entradas = novas;
+            cap = novaCap;
+        }
+        struct stat info;
+        EntradaCache* entrada = &entradas[num];
+        if (snprintf(entrada->caminho, TAMANHO_CAMINHO, "%s/%s", diretorio, e->d_name) >= TAMANHO_CAMINHO) continue;
+        if (stat(entrada->caminho, &info) != 0 || !S_ISREG(info.st_mode)) continue;
+        entrada->modificado = info.st_mtime;
+        entrada->tamanho = (unsigned long long)info.st_size;
+        total += entrada->tamanho;
+        num++;
+    }
+    closedir(dir);
+    if (total > limite) qsort(entradas, (size_t)num, sizeof(EntradaCache), compararEntradas);
+    int removidos = 0;
+    for (int i = 0; i < num && total > limite; i++) {
+        if (remove(entradas[i].caminho) == 0) removidos++;
+        total -= entradas[i].tamanho;
+    }
+    free(entradas);
+    return removidos;
+}
+
+/**
+ * @brief Reconstrói o grafo a partir de um ficheiro da cache, se for válido para o mapa.
+ * @internal
+ * @param caminho Caminho do ficheiro da cache.
+ * @param hash Hash do conteúdo do mapa.
+ * @param tamanho Número de bytes do mapa.
+ * @param grafo Grafo reconstruído (saída).
+ * @return int Retorna 1 se o grafo foi reconstruído, 0 caso contrário.
+ */
+static int lerGrafoDeCache(const char* caminho, uint64_t hash, size_t tamanho, Grafo* grafo) {
+    struct stat info;
+    if (stat(caminho, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoCache)) return 0;
+    size_t tamCache;
+    char* dados = mapearFicheiro(caminho, &tamCache);
+    if (!dados) return 0;
+    CabecalhoCache cab;
+    memcpy(&cab, dados, sizeof(cab));
+    int valido = tamCache >= sizeof(cab) && cab.magia == MAGIA_CACHE && cab.versao == VERSAO_GRAFO &&
+                 cab.hash == hash && cab.tamanho == (uint64_t)tamanho &&
+                 cab.numA <= tamCache && cab.numB <= tamCache && cab.proximo <= INT32_MAX &&
+                 tamCache == sizeof(cab) + (cab.numA * 5 + cab.numB) * sizeof(int32_t) &&
+                 hashXXH64(dados + sizeof(cab), tamCache - sizeof(cab), 0) == cab.verificacao;
+    Grafo novo = criarGrafo();
+    Vertice* fim = NULL;
+    const char* p = dados + sizeof(cab);
+    uint64_t adjacencias = 0;
+    for (uint64_t i = 0; valido && i < cab.numA; i++) {
+        int32_t r[5];
+        memcpy(r, p, sizeof(r));
+        p += sizeof(r);
+        adjacencias += (uint32_t)r[4];
+        if (r[4] < 0 || adjacencias > cab.numB) {
+            valido = 0;
+            break;
+        }
+        Vertice* v = criarVertice(r[0], r[2], r[3], (char)r[1]);
+        if (!v) {
+            valido = 0;
+            break;
+        }
+        if (fim) fim->prox = v;
+        else novo.vertices = v;
+        fim = v;
+        novo.numVertices++;
+        Adjacente* fimAdj = NULL;
+        for (int32_t j = 0; j < r[4]; j++, p += sizeof(int32_t)) {
+            int32_t codigo;
+            memcpy(&codigo, p, sizeof(codigo));
+            Adjacente* adj = criarAdjacente(codigo);
+            if (!adj) {
+                valido = 0;
+                break;
+            }
+            if (fimAdj) fimAdj->prox = adj;
+            else v->adjacentes = adj;
+            fimAdj = adj;
+        }
+    }
+    libertarFicheiro(dados, tamCache);
+    if (!valido || adjacencias != cab.numB) {
+        libertarGrafo(&novo);
+        return 0;
+    }
+    novo.proximoCodigo = (int)cab.proximo;
+    utime(caminho, NULL); // Marca o ficheiro como usado, para limitarCache
+    *grafo = novo;
+    return 1;
+}
+
+/**
+ * @brief Escreve o grafo num ficheiro da cache.
+ * @internal
+ * O ficheiro é escrito com um nome temporário e depois renomeado, pelo que outro processo nunca lê um
+ * resultado incompleto.
+ * @param caminho Caminho do ficheiro da cache.
+ * @param hash Hash do conteúdo do mapa.
+ * @param tamanho Número de bytes do mapa.
+ * @param grafo Grafo a guardar.
+ * @return int Retorna 1 se o ficheiro foi escrito com sucesso, 0 caso contrário.
+ */
+static int escreverGrafoCache(const char* caminho, uint64_t hash, size_t tamanho, Grafo grafo) {
+    char temporario[TAMANHO_CAMINHO + 32];
+    snprintf(temporario, sizeof(temporario), "%s.%ld.tmp", caminho, (long)getpid());
+    CabecalhoCache cab;
+    memset(&cab, 0, sizeof(cab));
+    cab.magia = MAGIA_CACHE;
+    cab.versao = VERSAO_GRAFO;
+    cab.hash = hash;
+    cab.tamanho = (uint64_t)tamanho;
+    cab.proximo = (uint64_t)grafo.proximoCodigo;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) {
+        cab.numA++;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) cab.numB++;
+    }
+    size_t numInteiros = (size_t)(cab.numA * 5 + cab.numB);
+    int32_t* corpo = (int32_t*)malloc((numInteiros > 0 ? numInteiros : 1) * sizeof(int32_t));
+    if (!corpo) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    size_t k = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) {
+        size_t registo = k;
+        corpo[k++] = v->codigo;
+        corpo[k++] = v->antena.frequencia;
+        corpo[k++] = v->antena.x;
+        corpo[k++] = v->antena.y;
+        k++;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) corpo[k++] = adj->codigo;
+        corpo[registo + 4] = (int32_t)(k - registo - 5); // Número de adjacências do vértice
+    }
+    cab.verificacao = hashXXH64(corpo, numInteiros * sizeof(int32_t), 0);
+    Saida saida;
+    int aberta = abrirSaidaBinaria(&saida, temporario);
+    if (aberta) {
+        escreverBytes(&saida, (const char*)&cab, sizeof(cab));
+        escreverBytes(&saida, (const char*)corpo, numInteiros * sizeof(int32_t));
+    }
+    free(corpo);
+    if (!aberta) return 0;
+    if (!fecharSaida(&saida) || rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+#else
+
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite.
+ *
+ * @param diretorio Diretório da cache.
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache.
+ * @return int Retorna -1, porque a cache não é usada em Windows.
+ */
+int limitarCache(const char* diretorio, size_t limite) {
+    (void)diretorio;
+    (void)limite;
+    return -1;
+}
+
+#endif
+
+/**
+ * @brief Lê o grafo de um ficheiro, reaproveitando a cache.
+ *
+ * O conteúdo do ficheiro é resumido com hashXXH64; se o diretório da cache tiver um grafo íntegro com esse hash
+ * e esse tamanho, o grafo é reconstruído a partir dele, com os mesmos códigos e as adjacências pela mesma
+ * ordem, sem voltar a ler o mapa nem a ligar as antenas. Caso contrário é lido com lerGrafoParalelo e
+ * guardado na cache, que é depois limitada com limitarCache.
+ *
+ * @param nomeFicheiro O nome do ficheiro com o mapa.
+ * @param diretorio Diretório da cache (criado se não existir), ou NULL para não usar a cache.
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache.
+ * @param reaproveitado Fica a 1 se o grafo veio da cache e a 0 caso contrário (pode ser NULL).
+ * @return Grafo Retorna o grafo lido, vazio em caso de erro.
+ * @attention A cache também é ignorada quando a variável de ambiente VARIAVEL_SEM_CACHE está definida, e em Windows.
+ */
+Grafo lerGrafoCache(const char* nomeFicheiro, const char* diretorio, size_t limite, int* reaproveitado) {
+    if (reaproveitado) *reaproveitado = 0;
+    Grafo grafo = criarGrafo();
+#ifndef _WIN32
+    int usarCache = diretorio && !getenv(VARIAVEL_SEM_CACHE);
+    char caminho[TAMANHO_CAMINHO];
+    uint64_t hash = 0;
+    size_t tamanho = 0;
+    if (usarCache) {
+        char* dados = mapearFicheiro(nomeFicheiro, &tamanho);
+        if (!dados) return grafo;
+        hash = hashXXH64(dados, tamanho, VERSAO_GRAFO);
+        libertarFicheiro(dados, tamanho);
+        usarCache = snprintf(caminho, sizeof(caminho), "%s/%016llx%s", diretorio, (unsigned long long)hash, EXTENSAO_CACHE) < (int)sizeof(caminho);
+        if (usarCache && lerGrafoDeCache(caminho, hash, tamanho, &grafo)) {
+            if (reaproveitado) *reaproveitado = 1;
+            return grafo;
+        }
+    }
+#else
+    (void)diretorio;
+    (void)limite;
+#endif
+    grafo = lerGrafoParalelo(nomeFicheiro);
+#ifndef _WIN32
+    if (usarCache) {
+        mkdir(diretorio, 0777);
+        if (escreverGrafoCache(caminho, hash, tamanho, grafo)) limitarCache(diretorio, limite);
+    }
+#endif
+    return grafo;
+}
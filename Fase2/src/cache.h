@@ -0,0 +1,69 @@
+/**
+ * @file cache.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da cache persistente de resultados, indexada pelo hash do conteúdo do mapa
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+
+/**
+ * @brief Extensão dos ficheiros da cache (os outros ficheiros do diretório são ignorados).
+ */
+#define EXTENSAO_CACHE ".cache"
+/**
+ * @brief Variável de ambiente que, quando definida, faz ignorar a cache.
+ */
+#define VARIAVEL_SEM_CACHE "EDA_SEM_CACHE"
+/**
+ * @brief Tamanho máximo por omissão, em bytes, dos ficheiros da cache de um diretório.
+ */
+#define LIMITE_CACHE (64 * 1024 * 1024)
+
+/**
+ * @brief Calcula o hash XXH64 de um bloco de memória.
+ *
+ * Implementação do algoritmo xxHash de 64 bits (não criptográfico): o bloco é consumido em faixas de
+ * 32 bytes por quatro acumuladores independentes, pelo que o custo é próximo do de ler o bloco.
+ *
+ * @param dados Bloco a resumir.
+ * @param tamanho Número de bytes do bloco.
+ * @param semente Semente do hash.
+ * @return uint64_t Retorna o hash do bloco.
+ */
+uint64_t hashXXH64(const void* dados, size_t tamanho, uint64_t semente);
+/**
+ * @brief Remove os ficheiros menos usados da cache até o diretório não passar do limite.
+ *
+ * Os ficheiros são removidos do mais antigo para o mais recente, pela data de modificação, que é
+ * atualizada sempre que um ficheiro é reaproveitado.
+ *
+ * @param diretorio Diretório da cache.
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache.
+ * @return int Retorna o número de ficheiros removidos, ou -1 se o diretório não puder ser lido.
+ */
+int limitarCache(const char* diretorio, size_t limite);
+/**
+ * @brief Lê o grafo de um ficheiro, reaproveitando a cache.
+ *
+ * O conteúdo do ficheiro é resumido com hashXXH64; se o diretório da cache tiver um grafo íntegro com esse hash
+ * e esse tamanho, o grafo é reconstruído a partir dele, com os mesmos códigos e as adjacências pela mesma
+ * ordem, sem voltar a ler o mapa nem a ligar as antenas. Caso contrário é lido com lerGrafoParalelo e
+ * guardado na cache, que é depois limitada com limitarCache.
+ *
+ * @param nomeFicheiro O nome do ficheiro com o mapa.
+ * @param diretorio Diretório da cache (criado se não existir), ou NULL para não usar a cache.
+ * @param limite Tamanho máximo, em bytes, dos ficheiros da cache.
+ * @param reaproveitado Fica a 1 se o grafo veio da cache e a 0 caso contrário (pode ser NULL).
+ * @return Grafo Retorna o grafo lido, vazio em caso de erro.
+ * @attention A cache também é ignorada quando a variável de ambiente VARIAVEL_SEM_CACHE está definida, e em Windows.
+ */
+Grafo lerGrafoCache(const char* nomeFicheiro, const char* diretorio, size_t limite, int* reaproveitado);
+
+#endif
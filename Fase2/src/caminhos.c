@@ -0,0 +1,327 @@
+/**
+ * @file caminhos.c
+ * @author Hugo Baptista
+ * @brief Implementação da enumeração paralela dos caminhos simples entre dois vértices
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "compacto.h"
+#include "saida.h"
+#include "caminhos.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Estado partilhado por todas as tarefas de uma enumeração.
+ * @internal
+ */
+typedef struct EnumeracaoCaminhos {
+    const GrafoCompacto* compacto; /**< Grafo compacto. */
+    int destino; /**< Índice do vértice final. */
+    Saida* saida; /**< Saída partilhada, ou NULL para só contar. */
+    int** pilhas; /**< Caminho de trabalho de cada thread (numVertices índices). */
+    int** posicoes; /**< Próxima adjacência a seguir em cada nível da pilha de cada thread. */
+    uint64_t** visitados; /**< Conjunto de bits dos vértices no caminho, de cada thread. */
+    char** buffers; /**< Linhas ainda por escrever de cada thread. */
+    size_t* usados; /**< Bytes ocupados em cada buffer. */
+    size_t* capacidades; /**< Capacidade de cada buffer. */
+    long long total; /**< Número de caminhos encontrados. */
+    int erro; /**< Indica se faltou memória para um buffer (0 ou 1). */
+} EnumeracaoCaminhos;
+
+/**
+ * @brief Devolve o número da thread atual (0 sem OpenMP).
+ * @internal
+ * @return int Retorna o número da thread.
+ */
+static int threadAtual(void) {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Escreve na saída partilhada as linhas juntas no buffer de uma thread.
+ * @internal
+ * @param enumeracao O estado da enumeração.
+ * @param t O número da thread.
+ */
+static void despejarCaminhos(EnumeracaoCaminhos* enumeracao, int t) {
+    if (enumeracao->usados[t] == 0) return;
+    #pragma omp critical(saidaCaminhos)
+    escreverBytes(enumeracao->saida, enumeracao->buffers[t], enumeracao->usados[t]);
+    enumeracao->usados[t] = 0;
+}
+
+/**
+ * @brief Junta um caminho (no formato de listarTodosCaminhos) ao buffer da thread atual.
+ * @internal
+ * Cada linha é formatada inteira no buffer, que cresce se for preciso, para nunca ser dividida entre escritas.
+ *
+ * @param enumeracao O estado da enumeração.
+ * @param caminho Os índices dos vértices do caminho.
+ * @param tamanho O número de vértices do caminho.
+ */
+static void guardarCaminho(EnumeracaoCaminhos* enumeracao, const int* caminho, int tamanho) {
+    if (!enumeracao->saida) return;
+    int t = threadAtual();
+    size_t maximo = 10 + (size_t)tamanho * 16; // "Caminho: " e até 11 dígitos mais " -> " por vértice
+    if (enumeracao->usados[t] + maximo > enumeracao->capacidades[t]) {
+        despejarCaminhos(enumeracao, t);
+        if (maximo > enumeracao->capacidades[t]) {
+            char* novo = (char*)realloc(enumeracao->buffers[t], maximo);
+            if (!novo) {
+                #pragma omp atomic write
+                enumeracao->erro = 1;
+                return;
+            }
+            enumeracao->buffers[t] = novo;
+            enumeracao->capacidades[t] = maximo;
+        }
+    }
+    char* p = enumeracao->buffers[t] + enumeracao->usados[t];
+    memcpy(p, "Caminho: ", 9);
+    p += 9;
+    for (int i = 0; i < tamanho; i++) {
+        char tmp[12];
+        int n = 0;
+        unsigned int v = (unsigned int)enumeracao->compacto->codigos[caminho[i]];
+        do {
+            tmp[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while (v);
+        if (enumeracao->compacto->codigos[caminho[i]] < 0) tmp[n++] = '-';
+        while (n > 0) *p++ = tmp[--n];
+        if (i < tamanho - 1) {
+            memcpy(p, " -> ", 4);
+            p += 4;
+        }
+    }
+    *p++ = '\n';
+    enumeracao->usados[t] = (size_t)(p - enumeracao->buffers[t]);
+    if (enumeracao->usados[t] >= LIMIAR_CAMINHOS) despejarCaminhos(enumeracao, t);
+}
+
+/**
+ * @brief Continua a busca em profundidade a partir de um prefixo, com a pilha e os bits da thread atual.
+ * @internal
+ * Não cria tarefas, pelo que a tarefa não é suspensa e os vetores da thread não são partilhados.
+ *
+ * @param enumeracao O estado da enumeração.
+ * @param prefixo Os índices dos vértices do prefixo (o último é o vértice onde a busca continua).
+ * @param tamanho O número de vértices do prefixo.
+ * @return long long Retorna o número de caminhos encontrados.
+ */
+static long long explorarSequencial(EnumeracaoCaminhos* enumeracao, const int* prefixo, int tamanho) {
+    const GrafoCompacto* g = enumeracao->compacto;
+    int t = threadAtual();
+    int* pilha = enumeracao->pilhas[t];
+    int* posicao = enumeracao->posicoes[t];
+    uint64_t* visitados = enumeracao->visitados[t];
+    unsigned destino = (unsigned)enumeracao->destino;
+    for (int i = 0; i < tamanho; i++) {
+        pilha[i] = prefixo[i];
+        visitados[prefixo[i] / 64] |= 1ULL << (prefixo[i] % 64);
+    }
+    long long total = 0;
+    int topo = tamanho;
+    posicao[topo - 1] = g->inicio[pilha[topo - 1]];
+    while (topo >= tamanho) {
+        unsigned v = (unsigned)pilha[topo - 1];
+        int p = posicao[topo - 1];
+        if (p == g->inicio[v + 1]) {
+            if (topo > tamanho) visitados[v / 64] &= ~(1ULL << (v % 64)); // Backtrack
+            topo--;
+            continue;
+        }
+        posicao[topo - 1] = p + 1;
+        unsigned d = (unsigned)g->destinos[p];
+        if (visitados[d / 64] >> (d % 64) & 1) continue;
+        if (d == destino) {
+            pilha[topo] = (int)d;
+            if (enumeracao->saida) guardarCaminho(enumeracao, pilha, topo + 1);
+            total++;
+            continue;
+        }
+        visitados[d / 64] |= 1ULL << (d % 64);
+        pilha[topo] = (int)d;
+        posicao[topo++] = g->inicio[d];
+    }
+    for (int i = 0; i < tamanho; i++) visitados[prefixo[i] / 64] &= ~(1ULL << (prefixo[i] % 64));
+    return total;
+}
+
+/**
+ * @brief Expande um prefixo: cria uma tarefa por adjacente nos primeiros níveis e continua sequencialmente nos restantes.
+ * @internal
+ * @param enumeracao O estado da enumeração.
+ * @param prefixo Os índices dos vértices do prefixo (é libertado pela tarefa).
+ * @param tamanho O número de vértices do prefixo.
+ */
+static void explorarTarefa(EnumeracaoCaminhos* enumeracao, int* prefixo, int tamanho) {
+    long long encontrados = 0;
+    if (tamanho >= PROFUNDIDADE_TAREFAS) {
+        encontrados = explorarSequencial(enumeracao, prefixo, tamanho);
+    } else {
+        const GrafoCompacto* g = enumeracao->compacto;
+        int v = prefixo[tamanho - 1];
+        for (int p = g->inicio[v]; p < g->inicio[v + 1]; p++) {
+            int d = g->destinos[p];
+            int repetido = 0;
+            for (int i = 0; i < tamanho && !repetido; i++) repetido = prefixo[i] == d;
+            if (repetido) continue;
+            int* filho = (int*)malloc((size_t)(tamanho + 1) * sizeof(int));
+            if (!filho) {
+                #pragma omp atomic write
+                enumeracao->erro = 1;
+                break;
+            }
+            memcpy(filho, prefixo, (size_t)tamanho * sizeof(int));
+            filho[tamanho] = d;
+            if (d == enumeracao->destino) {
+                guardarCaminho(enumeracao, filho, tamanho + 1);
+                encontrados++;
+                free(filho);
+                continue;
+            }
+            #pragma omp task firstprivate(filho)
+            explorarTarefa(enumeracao, filho, tamanho + 1);
+        }
+    }
+    #pragma omp atomic
+    enumeracao->total += encontrados;
+    free(prefixo);
+}
+
+/**
+ * @brief Enumera os caminhos entre dois vértices, escrevendo-os numa saída ou só contando-os.
+ * @internal
+ * @param compacto O grafo compacto.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param saida A saída onde escrever, ou NULL para só contar.
+ * @return long long Retorna o número de caminhos, ou -1 em caso de erro.
+ */
+static long long enumerarCaminhos(const GrafoCompacto* compacto, int inicial, int final, Saida* saida) {
+    int origem = indiceCompacto(compacto, inicial), destino = indiceCompacto(compacto, final);
+    if (origem < 0 || destino < 0) {
+        printf("Um dos vertices nao existe no grafo.\n");
+        return -1;
+    }
+    if (compacto->antenas[origem].frequencia != compacto->antenas[destino].frequencia) {
+        printf("As antenas nao tem a mesma frequencia.\n");
+        return -1;
+    }
+    if (origem == destino) {
+        if (saida) {
+            escreverTexto(saida, "Caminho: ");
+            escreverInteiro(saida, inicial);
+            escreverCaracter(saida, '\n');
+        }
+        return 1;
+    }
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    int n = compacto->numVertices;
+    size_t palavras = ((size_t)n + 63) / 64;
+    EnumeracaoCaminhos enumeracao = { compacto, destino, saida, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0 };
+    enumeracao.pilhas = (int**)calloc((size_t)numThreads, sizeof(int*));
+    enumeracao.posicoes = (int**)calloc((size_t)numThreads, sizeof(int*));
+    enumeracao.visitados = (uint64_t**)calloc((size_t)numThreads, sizeof(uint64_t*));
+    enumeracao.buffers = (char**)calloc((size_t)numThreads, sizeof(char*));
+    enumeracao.usados = (size_t*)calloc((size_t)numThreads, sizeof(size_t));
+    enumeracao.capacidades = (size_t*)calloc((size_t)numThreads, sizeof(size_t));
+    int* prefixo = (int*)malloc(sizeof(int));
+    int erro = !enumeracao.pilhas || !enumeracao.posicoes || !enumeracao.visitados || !enumeracao.buffers || !enumeracao.usados || !enumeracao.capacidades || !prefixo;
+    for (int t = 0; t < numThreads && !erro; t++) {
+        enumeracao.pilhas[t] = (int*)malloc((size_t)n * sizeof(int));
+        enumeracao.posicoes[t] = (int*)malloc((size_t)n * sizeof(int));
+        enumeracao.visitados[t] = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+        if (saida) {
+            enumeracao.buffers[t] = (char*)malloc(LIMIAR_CAMINHOS);
+            enumeracao.capacidades[t] = LIMIAR_CAMINHOS;
+        }
+        if (!enumeracao.pilhas[t] || !enumeracao.posicoes[t] || !enumeracao.visitados[t] || (saida && !enumeracao.buffers[t])) erro = 1;
+    }
+
+    if (!erro) {
+        prefixo[0] = origem;
+        #pragma omp parallel num_threads(numThreads)
+        #pragma omp single
+        explorarTarefa(&enumeracao, prefixo, 1);
+        if (saida) {
+            for (int t = 0; t < numThreads; t++) despejarCaminhos(&enumeracao, t);
+        }
+        erro = enumeracao.erro;
+    } else {
+        printf("Erro ao alocar memoria!\n");
+        free(prefixo);
+    }
+
+    for (int t = 0; t < numThreads; t++) {
+        if (enumeracao.pilhas) free(enumeracao.pilhas[t]);
+        if (enumeracao.posicoes) free(enumeracao.posicoes[t]);
+        if (enumeracao.visitados) free(enumeracao.visitados[t]);
+        if (enumeracao.buffers) free(enumeracao.buffers[t]);
+    }
+    free(enumeracao.pilhas);
+    free(enumeracao.posicoes);
+    free(enumeracao.visitados);
+    free(enumeracao.buffers);
+    free(enumeracao.usados);
+    free(enumeracao.capacidades);
+    return erro ? -1 : enumeracao.total;
+}
+
+/**
+ * @brief Escreve todos os caminhos simples entre dois vértices, repartindo a árvore de busca pelas threads.
+ *
+ * Os primeiros níveis da árvore de busca são divididos em tarefas OpenMP (uma por prefixo com menos de
+ * PROFUNDIDADE_TAREFAS vértices), que as threads livres vão buscando ao conjunto de tarefas; cada tarefa
+ * leva o seu prefixo e continua a busca em profundidade com a pilha e o conjunto de bits de visitados da
+ * thread que a executa. Cada thread junta as linhas num buffer próprio, escrito na saída de uma só vez,
+ * pelo que as linhas nunca se misturam. As linhas têm o formato de listarTodosCaminhos, mas a ordem
+ * entre caminhos depende das threads.
+ *
+ * @param compacto O grafo compacto.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola.
+ * @return long long Retorna o número de caminhos escritos, ou -1 se um dos vértices não existir, se as antenas tiverem frequências diferentes ou em caso de erro.
+ */
+long long listarTodosCaminhosParalelo(const GrafoCompacto* compacto, int inicial, int final, const char* filename) {
+    Saida saida;
+    if (!abrirSaida(&saida, filename)) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return -1;
+    }
+    long long total = enumerarCaminhos(compacto, inicial, final, &saida);
+    if (!fecharSaida(&saida)) return -1;
+    return total;
+}
+
+/**
+ * @brief Conta todos os caminhos simples entre dois vértices, repartindo a árvore de busca pelas threads.
+ *
+ * A busca é a mesma de listarTodosCaminhosParalelo, sem escrever os caminhos.
+ *
+ * @param compacto O grafo compacto.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @return long long Retorna o número de caminhos, ou -1 se um dos vértices não existir, se as antenas tiverem frequências diferentes ou em caso de erro.
+ */
+long long contarCaminhosParalelo(const GrafoCompacto* compacto, int inicial, int final) {
+    return enumerarCaminhos(compacto, inicial, final, NULL);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file caminhos.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da enumeração paralela dos caminhos simples entre dois vértices
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef CAMINHOS_H
+#define CAMINHOS_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Número de vértices do prefixo a partir do qual cada tarefa continua a busca sem criar novas tarefas.
+ */
+#define PROFUNDIDADE_TAREFAS 3
+/**
+ * @brief Número de bytes que cada thread junta antes de escrever os seus caminhos na saída.
+ */
+#define LIMIAR_CAMINHOS (64 * 1024)
+
+/**
+ * @brief Escreve todos os caminhos simples entre dois vértices, repartindo a árvore de busca pelas threads.
+ *
+ * Os primeiros níveis da árvore de busca são divididos em tarefas OpenMP (uma por prefixo com menos de
+ * PROFUNDIDADE_TAREFAS vértices), que as threads livres vão buscando ao conjunto de tarefas; cada tarefa
+ * leva o seu prefixo e continua a busca em profundidade com a pilha e o conjunto de bits de visitados da
+ * thread que a executa. Cada thread junta as linhas num buffer próprio, escrito na saída de uma só vez,
+ * pelo que as linhas nunca se misturam. As linhas têm o formato de listarTodosCaminhos, mas a ordem
+ * entre caminhos depende das threads.
+ *
+ * @param compacto O grafo compacto.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola.
+ * @return long long Retorna o número de caminhos escritos, ou -1 se um dos vértices não existir, se as antenas tiverem frequências diferentes ou em caso de erro.
+ */
+long long listarTodosCaminhosParalelo(const GrafoCompacto* compacto, int inicial, int final, const char* filename);
+/**
+ * @brief Conta todos os caminhos simples entre dois vértices, repartindo a árvore de busca pelas threads.
+ *
+ * A busca é a mesma de listarTodosCaminhosParalelo, sem escrever os caminhos.
+ *
+ * @param compacto O grafo compacto.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @return long long Retorna o número de caminhos, ou -1 se um dos vértices não existir, se as antenas tiverem frequências diferentes ou em caso de erro.
+ */
+long long contarCaminhosParalelo(const GrafoCompacto* compacto, int inicial, int final);
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * @file compacto.c
+ * @author Hugo Baptista
+ * @brief Implementação do grafo compacto (CSR) e das consultas sobre ele
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "compacto.h"
+
+/**
+ * @brief Cria o grafo compacto de um vetor de vértices.
+ *
+ * Os vértices ficam com índices 0..num-1 pela ordem do vetor e as adjacências de cada vértice ficam
+ * seguidas no vetor de destinos, pela ordem da sua lista. As adjacências para códigos que não estão no
+ * vetor são descartadas. Os vértices não são alterados.
+ *
+ * @param vertices Os vértices a compactar.
+ * @param num O número de vértices.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+GrafoCompacto* compactarVertices(Vertice* const* vertices, int num) {
+    GrafoCompacto* compacto = (GrafoCompacto*)calloc(1, sizeof(GrafoCompacto));
+    if (!compacto) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    int n = num, maxCodigo = 0;
+    for (int i = 0; i < n; i++) {
+        if (vertices[i]->codigo > maxCodigo) maxCodigo = vertices[i]->codigo;
+    }
+    compacto->numVertices = n;
+    compacto->maxCodigo = maxCodigo;
+    compacto->codigos = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    compacto->antenas = (Antena*)malloc((size_t)(n > 0 ? n : 1) * sizeof(Antena));
+    compacto->inicio = (int*)malloc((size_t)(n + 1) * sizeof(int));
+    compacto->indices = (int*)malloc((size_t)(maxCodigo + 1) * sizeof(int));
+    if (!compacto->codigos || !compacto->antenas || !compacto->inicio || !compacto->indices) {
+        printf("Erro ao alocar memoria!\n");
+        libertarGrafoCompacto(compacto);
+        return NULL;
+    }
+    memset(compacto->indices, -1, (size_t)(maxCodigo + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        compacto->codigos[i] = vertices[i]->codigo;
+        compacto->antenas[i] = vertices[i]->antena;
+        if (vertices[i]->codigo >= 0) compacto->indices[vertices[i]->codigo] = i;
+    }
+
+    // Primeira passagem conta as adjacências válidas, a segunda preenche os destinos
+    int numArestas = 0;
+    for (int i = 0; i < n; i++) {
+        compacto->inicio[i] = numArestas;
+        for (Adjacente* adj = vertices[i]->adjacentes; adj; adj = adj->prox) {
+            if (indiceCompacto(compacto, adj->codigo) >= 0) numArestas++;
+        }
+    }
+    compacto->inicio[n] = numArestas;
+    compacto->numArestas = numArestas;
+    compacto->destinos = (int*)malloc((size_t)(numArestas > 0 ? numArestas : 1) * sizeof(int));
+    if (!compacto->destinos) {
+        printf("Erro ao alocar memoria!\n");
+        libertarGrafoCompacto(compacto);
+        return NULL;
+    }
+    int p = 0;
+    for (int i = 0; i < n; i++) {
+        for (Adjacente* adj = vertices[i]->adjacentes; adj; adj = adj->prox) {
+            int d = indiceCompacto(compacto, adj->codigo);
+            if (d >= 0) compacto->destinos[p++] = d;
+        }
+    }
+    return compacto;
+}
+
+/**
+ * @brief Cria o grafo compacto de um grafo.
+ *
+ * Os vértices ficam com índices 0..numVertices-1 pela ordem da lista de vértices e as adjacências de cada
+ * vértice ficam seguidas no vetor de destinos, pela ordem da sua lista. As adjacências para códigos que
+ * não existem no grafo são descartadas.
+ *
+ * @param grafo O grafo a compactar.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+GrafoCompacto* compactarGrafo(Grafo grafo) {
+    int n = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) n++;
+    Vertice** vertices = (Vertice**)malloc((size_t)(n > 0 ? n : 1) * sizeof(Vertice*));
+    if (!vertices) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    int i = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) vertices[i++] = v;
+    GrafoCompacto* compacto = compactarVertices(vertices, n);
+    free(vertices);
+    return compacto;
+}
+
+/**
+ * @brief Cria o grafo compacto transposto (com todas as arestas invertidas).
+ *
+ * Os vértices mantêm os índices e os códigos; as adjacências de cada vértice no transposto são as
+ * origens das arestas que chegam a ele, por ordem crescente de índice.
+ *
+ * @param compacto O grafo compacto.
+ * @return GrafoCompacto* Retorna o grafo transposto, ou NULL em caso de erro.
+ */
+GrafoCompacto* transporGrafoCompacto(const GrafoCompacto* compacto) {
+    int n = compacto->numVertices, m = compacto->numArestas;
+    GrafoCompacto* transposto = (GrafoCompacto*)calloc(1, sizeof(GrafoCompacto));
+    if (!transposto) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    transposto->numVertices = n;
+    transposto->numArestas = m;
+    transposto->maxCodigo = compacto->maxCodigo;
+    transposto->codigos = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    transposto->antenas = (Antena*)malloc((size_t)(n > 0 ? n : 1) * sizeof(Antena));
+    transposto->inicio = (int*)calloc((size_t)n + 1, sizeof(int));
+    transposto->destinos = (int*)malloc((size_t)(m > 0 ? m : 1) * sizeof(int));
+    transposto->indices = (int*)malloc((size_t)(compacto->maxCodigo + 1) * sizeof(int));
+    int* pos = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    if (!transposto->codigos || !transposto->antenas || !transposto->inicio || !transposto->destinos || !transposto->indices || !pos) {
+        printf("Erro ao alocar memoria!\n");
+        free(pos);
+        libertarGrafoCompacto(transposto);
+        return NULL;
+    }
+    memcpy(transposto->codigos, compacto->codigos, (size_t)n * sizeof(int));
+    memcpy(transposto->antenas, compacto->antenas, (size_t)n * sizeof(Antena));
+    memcpy(transposto->indices, compacto->indices, (size_t)(compacto->maxCodigo + 1) * sizeof(int));
+
+    // Contagem dos graus de entrada; percorrer as origens por ordem deixa cada lista ordenada
+    for (int p = 0; p < m; p++) transposto->inicio[compacto->destinos[p] + 1]++;
+    for (int v = 0; v < n; v++) transposto->inicio[v + 1] += transposto->inicio[v];
+    memcpy(pos, transposto->inicio, (size_t)n * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        for (int p = compacto->inicio[v]; p < compacto->inicio[v + 1]; p++) {
+            transposto->destinos[pos[compacto->destinos[p]]++] = v;
+        }
+    }
+    free(pos);
+    return transposto;
+}
+
+/**
+ * @brief Liberta a memória alocada para o grafo compacto.
+ *
+ * @param compacto O grafo compacto a libertar.
+ */
+void libertarGrafoCompacto(GrafoCompacto* compacto) {
+    if (!compacto) return;
+    free(compacto->codigos);
+    free(compacto->antenas);
+    free(compacto->inicio);
+    free(compacto->destinos);
+    free(compacto->indices);
+    free(compacto);
+}
+
+/**
+ * @brief Devolve o índice de um vértice no grafo compacto.
+ *
+ * @param compacto O grafo compacto.
+ * @param codigo O código do vértice.
+ * @return int Retorna o índice do vértice, ou -1 se o código não existir.
+ */
+int indiceCompacto(const GrafoCompacto* compacto, int codigo) {
+    if (codigo < 0 || codigo > compacto->maxCodigo) return -1;
+    return compacto->indices[codigo];
+}
+
+/**
+ * @brief Percorre o grafo compacto em largura a partir de um vértice.
+ *
+ * A ordem é a mesma de BFS: os adjacentes de cada vértice entram na fila pela ordem da sua lista.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param ordem Vetor com espaço para numVertices índices, onde fica a ordem da visita.
+ * @return int Retorna o número de vértices visitados, ou -1 em caso de erro.
+ */
+int percursoLargura(const GrafoCompacto* compacto, int origem, int* ordem) {
+    if (origem < 0 || origem >= compacto->numVertices) return -1;
+    char* visitado = (char*)calloc((size_t)compacto->numVertices, 1);
+    if (!visitado) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+    // A própria ordem serve de fila: cada vértice entra uma única vez
+    int frente = 0, fim = 0;
+    ordem[fim++] = origem;
+    visitado[origem] = 1;
+    while (frente < fim) {
+        int v = ordem[frente++];
+        for (int p = compacto->inicio[v]; p < compacto->inicio[v + 1]; p++) {
+            int d = compacto->destinos[p];
+            if (!visitado[d]) {
+                visitado[d] = 1;
+                ordem[fim++] = d;
+            }
+        }
+    }
+    free(visitado);
+    return fim;
+}
+
+/**
+ * @brief Percorre o grafo compacto em profundidade a partir de um vértice.
+ *
+ * A ordem é a mesma de DFS, mas a pilha é explícita, pelo que a profundidade não está limitada pela pilha de chamadas.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param ordem Vetor com espaço para numVertices índices, onde fica a ordem da visita.
+ * @return int Retorna o número de vértices visitados, ou -1 em caso de erro.
+ */
+int percursoProfundidade(const GrafoCompacto* compacto, int origem, int* ordem) {
+    if (origem < 0 || origem >= compacto->numVertices) return -1;
+    int n = compacto->numVertices;
+    char* visitado = (char*)calloc((size_t)n, 1);
+    int* pilha = (int*)malloc((size_t)n * sizeof(int));
+    int* posicao = (int*)malloc((size_t)n * sizeof(int));
+    if (!visitado || !pilha || !posicao) {
+        printf("Erro ao alocar memoria!\n");
+        free(visitado);
+        free(pilha);
+        free(posicao);
+        return -1;
+    }
+    int topo = 0, num = 0;
+    pilha[topo] = origem;
+    posicao[topo++] = compacto->inicio[origem];
+    visitado[origem] = 1;
+    ordem[num++] = origem;
+    while (topo > 0) {
+        int v = pilha[topo - 1];
+        int p = posicao[topo - 1];
+        while (p < compacto->inicio[v + 1] && visitado[compacto->destinos[p]]) p++;
+        if (p == compacto->inicio[v + 1]) {
+            topo--;
+            continue;
+        }
+        posicao[topo - 1] = p + 1; // Continua no adjacente seguinte quando voltar a este vértice
+        int d = compacto->destinos[p];
+        visitado[d] = 1;
+        ordem[num++] = d;
+        pilha[topo] = d;
+        posicao[topo++] = compacto->inicio[d];
+    }
+    free(visitado);
+    free(pilha);
+    free(posicao);
+    return num;
+}
+
+/**
+ * @brief Procura um caminho com o menor número de arestas entre dois vértices.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param destino O índice do vértice final.
+ * @param caminho Vetor com espaço para numVertices índices, onde fica o caminho (da origem ao destino).
+ * @return int Retorna o número de vértices do caminho, 0 se não existir caminho, ou -1 em caso de erro.
+ */
+int caminhoMaisCurto(const GrafoCompacto* compacto, int origem, int destino, int* caminho) {
+    int n = compacto->numVertices;
+    if (origem < 0 || origem >= n || destino < 0 || destino >= n) return -1;
+    int* pai = (int*)malloc((size_t)n * sizeof(int));
+    int* fila = (int*)malloc((size_t)n * sizeof(int));
+    if (!pai || !fila) {
+        printf("Erro ao alocar memoria!\n");
+        free(pai);
+        free(fila);
+        return -1;
+    }
+    memset(pai, -1, (size_t)n * sizeof(int));
+    int frente = 0, fim = 0;
+    fila[fim++] = origem;
+    pai[origem] = origem;
+    while (frente < fim && pai[destino] < 0) {
+        int v = fila[frente++];
+        for (int p = compacto->inicio[v]; p < compacto->inicio[v + 1]; p++) {
+            int d = compacto->destinos[p];
+            if (pai[d] < 0) {
+                pai[d] = v;
+                fila[fim++] = d;
+            }
+        }
+    }
+    int tamanho = 0;
+    if (pai[destino] >= 0) {
+        // Reconstrói o caminho do destino para a origem e inverte-o
+        for (int v = destino; ; v = pai[v]) {
+            caminho[tamanho++] = v;
+            if (v == origem) break;
+        }
+        for (int i = 0, j = tamanho - 1; i < j; i++, j--) {
+            int t = caminho[i];
+            caminho[i] = caminho[j];
+            caminho[j] = t;
+        }
+    }
+    free(pai);
+    free(fila);
+    return tamanho;
+}
+
+/**
+ * @brief Conta os caminhos simples entre dois vértices (os que listarTodosCaminhos escreveria).
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param destino O índice do vértice final.
+ * @return long long Retorna o número de caminhos, ou -1 em caso de erro.
+ * @attention O número de caminhos cresce de forma exponencial com o tamanho das componentes do grafo.
+ */
+long long contarCaminhos(const GrafoCompacto* compacto, int origem, int destino) {
+    int n = compacto->numVertices;
+    if (origem < 0 || origem >= n || destino < 0 || destino >= n) return -1;
+    if (origem == destino) return 1;
+    char* noCaminho = (char*)calloc((size_t)n, 1);
+    int* pilha = (int*)malloc((size_t)n * sizeof(int));
+    int* posicao = (int*)malloc((size_t)n * sizeof(int));
+    if (!noCaminho || !pilha || !posicao) {
+        printf("Erro ao alocar memoria!\n");
+        free(noCaminho);
+        free(pilha);
+        free(posicao);
+        return -1;
+    }
+    long long total = 0;
+    int topo = 0;
+    pilha[topo] = origem;
+    posicao[topo++] = compacto->inicio[origem];
+    noCaminho[origem] = 1;
+    while (topo > 0) {
+        int v = pilha[topo - 1];
+        int p = posicao[topo - 1];
+        if (p == compacto->inicio[v + 1]) {
+            noCaminho[v] = 0; // Backtrack
+            topo--;
+            continue;
+        }
+        posicao[topo - 1] = p + 1;
+        int d = compacto->destinos[p];
+        if (noCaminho[d]) continue;
+        if (d == destino) {
+            total++;
+            continue;
+        }
+        noCaminho[d] = 1;
+        pilha[topo] = d;
+        posicao[topo++] = compacto->inicio[d];
+    }
+    free(noCaminho);
+    free(pilha);
+    free(posicao);
+    return total;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file compacto.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções do grafo compacto (CSR) e das consultas sobre ele
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef COMPACTO_H
+#define COMPACTO_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Cria o grafo compacto de um vetor de vértices.
+ *
+ * Os vértices ficam com índices 0..num-1 pela ordem do vetor e as adjacências de cada vértice ficam
+ * seguidas no vetor de destinos, pela ordem da sua lista. As adjacências para códigos que não estão no
+ * vetor são descartadas. Os vértices não são alterados.
+ *
+ * @param vertices Os vértices a compactar.
+ * @param num O número de vértices.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+GrafoCompacto* compactarVertices(Vertice* const* vertices, int num);
+/**
+ * @brief Cria o grafo compacto de um grafo.
+ *
+ * Os vértices ficam com índices 0..numVertices-1 pela ordem da lista de vértices e as adjacências de cada
+ * vértice ficam seguidas no vetor de destinos, pela ordem da sua lista. As adjacências para códigos que
+ * não existem no grafo são descartadas.
+ *
+ * @param grafo O grafo a compactar.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+GrafoCompacto* compactarGrafo(Grafo grafo);
+/**
+ * @brief Cria o grafo compacto transposto (com todas as arestas invertidas).
+ *
+ * Os vértices mantêm os índices e os códigos; as adjacências de cada vértice no transposto são as
+ * origens das arestas que chegam a ele, por ordem crescente de índice.
+ *
+ * @param compacto O grafo compacto.
+ * @return GrafoCompacto* Retorna o grafo transposto, ou NULL em caso de erro.
+ */
+GrafoCompacto* transporGrafoCompacto(const GrafoCompacto* compacto);
+/**
+ * @brief Liberta a memória alocada para o grafo compacto.
+ *
+ * @param compacto O grafo compacto a libertar.
+ */
+void libertarGrafoCompacto(GrafoCompacto* compacto);
+/**
+ * @brief Devolve o índice de um vértice no grafo compacto.
+ *
+ * @param compacto O grafo compacto.
+ * @param codigo O código do vértice.
+ * @return int Retorna o índice do vértice, ou -1 se o código não existir.
+ */
+int indiceCompacto(const GrafoCompacto* compacto, int codigo);
+/**
+ * @brief Percorre o grafo compacto em largura a partir de um vértice.
+ *
+ * A ordem é a mesma de BFS: os adjacentes de cada vértice entram na fila pela ordem da sua lista.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param ordem Vetor com espaço para numVertices índices, onde fica a ordem da visita.
+ * @return int Retorna o número de vértices visitados, ou -1 em caso de erro.
+ */
+int percursoLargura(const GrafoCompacto* compacto, int origem, int* ordem);
+/**
+ * @brief Percorre o grafo compacto em profundidade a partir de um vértice.
+ *
+ * A ordem é a mesma de DFS, mas a pilha é explícita, pelo que a profundidade não está limitada pela pilha de chamadas.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param ordem Vetor com espaço para numVertices índices, onde fica a ordem da visita.
+ * @return int Retorna o número de vértices visitados, ou -1 em caso de erro.
+ */
+int percursoProfundidade(const GrafoCompacto* compacto, int origem, int* ordem);
+/**
+ * @brief Procura um caminho com o menor número de arestas entre dois vértices.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param destino O índice do vértice final.
+ * @param caminho Vetor com espaço para numVertices índices, onde fica o caminho (da origem ao destino).
+ * @return int Retorna o número de vértices do caminho, 0 se não existir caminho, ou -1 em caso de erro.
+ */
+int caminhoMaisCurto(const GrafoCompacto* compacto, int origem, int destino, int* caminho);
+/**
+ * @brief Conta os caminhos simples entre dois vértices (os que listarTodosCaminhos escreveria).
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param destino O índice do vértice final.
+ * @return long long Retorna o número de caminhos, ou -1 em caso de erro.
+ * @attention O número de caminhos cresce de forma exponencial com o tamanho das componentes do grafo.
+ */
+long long contarCaminhos(const GrafoCompacto* compacto, int origem, int destino);
+
+#endif
@@ -9,6 +9,14 @@
 #ifndef ANTENAS_H
 #define ANTENAS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Número de frequências distintas (uma entrada por valor de char).
+ */
+#define NUM_FREQUENCIAS 256
+
 /**
  * @brief Estrutura de dados para as antenas
  * @struct Antena
@@ -71,12 +79,156 @@ typedef struct Vertice {
  * @struct Grafo
  * @param vertices Lista de vértices do grafo
  * @param numVertices Número de vértices no grafo
+ * @param proximoCodigo Código do próximo vértice a ser adicionado ao grafo
+ * @param indice Índice dos vértices e das arestas, usado nas inserções e remoções (NULL até à primeira; definido em grafo.c)
  * @attention vertices é um apontador para a lista de vértices
  * @attention numVertices é um inteiro
+ * @attention Cada grafo atribui os seus próprios códigos, pelo que grafos diferentes podem ser criados em threads diferentes
+ * @attention Quem altera as listas diretamente tem de chamar invalidarIndiceGrafo antes
+ * @attention Uma cópia por valor partilha o índice com o original: só serve para consultas e deixa de ser válida depois de qualquer inserção, remoção ou invalidação feita no original
  */
 typedef struct Grafo {
     Vertice* vertices;
     int numVertices;
+    int proximoCodigo;
+    struct IndiceGrafo* indice;
 } Grafo;
 
+/**
+ * @brief Estrutura de dados para uma aresta entre dois vértices
+ * @struct Aresta
+ * @param origem Vértice de origem
+ * @param destino Vértice de destino
+ */
+typedef struct Aresta {
+    int origem, destino;
+} Aresta;
+
+/**
+ * @brief INSERIR_VERTICE Tipo da operação de lote que insere um vértice
+ */
+#define INSERIR_VERTICE 1
+/**
+ * @brief REMOVER_VERTICE Tipo da operação de lote que remove um vértice e as suas arestas
+ */
+#define REMOVER_VERTICE 2
+/**
+ * @brief INSERIR_ARESTA Tipo da operação de lote que insere uma aresta
+ */
+#define INSERIR_ARESTA 3
+/**
+ * @brief REMOVER_ARESTA Tipo da operação de lote que remove uma aresta
+ */
+#define REMOVER_ARESTA 4
+
+/**
+ * @brief Estrutura de dados para uma operação de um lote de alterações ao grafo
+ * @struct OperacaoGrafo
+ * @param tipo Tipo da operação (INSERIR_VERTICE, REMOVER_VERTICE, INSERIR_ARESTA ou REMOVER_ARESTA)
+ * @param origem Código do vértice a remover, ou do vértice de origem da aresta
+ * @param destino Código do vértice de destino da aresta
+ * @param x Coordenada x da antena do vértice a inserir
+ * @param y Coordenada y da antena do vértice a inserir
+ * @param frequencia Frequência da antena do vértice a inserir
+ */
+typedef struct OperacaoGrafo {
+    int tipo;
+    int origem, destino;
+    int x, y;
+    char frequencia;
+} OperacaoGrafo;
+
+/**
+ * @brief Estrutura de dados para o armazém compacto de antenas (um vetor por campo)
+ * @struct ArmazemAntenas
+ * @param frequencias Frequência de cada antena ('.' nas antenas removidas)
+ * @param x16 Coordenadas x, quando o mapa cabe em 16 bits (NULL caso contrário)
+ * @param y16 Coordenadas y, quando o mapa cabe em 16 bits (NULL caso contrário)
+ * @param x32 Coordenadas x, quando o mapa não cabe em 16 bits (NULL caso contrário)
+ * @param y32 Coordenadas y, quando o mapa não cabe em 16 bits (NULL caso contrário)
+ * @param num Número de antenas guardadas (incluindo as removidas)
+ * @param cap Capacidade dos vetores
+ * @param removidas Número de antenas removidas
+ * @param linhas Número de linhas do mapa
+ * @param colunas Número de colunas do mapa
+ * @attention O índice de cada antena não muda enquanto o armazém existir (as remoções só a marcam)
+ */
+typedef struct ArmazemAntenas {
+    unsigned char* frequencias;
+    uint16_t* x16, *y16;
+    uint32_t* x32, *y32;
+    int num, cap;
+    int removidas;
+    int linhas, colunas;
+} ArmazemAntenas;
+
+/**
+ * @brief Estrutura de dados para o grafo compacto (adjacências em vetores contíguos, formato CSR)
+ * @struct GrafoCompacto
+ * @param numVertices Número de vértices
+ * @param numArestas Número de arestas
+ * @param codigos Código do vértice de cada índice
+ * @param antenas Antena do vértice de cada índice
+ * @param inicio Posição em destinos da primeira adjacência de cada índice (numVertices + 1 posições)
+ * @param destinos Índices dos vértices adjacentes, pela ordem das listas de adjacências
+ * @param indices Índice de cada código (-1 se o código não existe), de 0 a maxCodigo
+ * @param maxCodigo Maior código de um vértice
+ * @attention Os índices seguem a ordem da lista de vértices do grafo; o grafo compacto não acompanha as alterações ao grafo
+ */
+typedef struct GrafoCompacto {
+    int numVertices, numArestas;
+    int* codigos;
+    Antena* antenas;
+    int* inicio;
+    int* destinos;
+    int* indices;
+    int maxCodigo;
+} GrafoCompacto;
+
+/**
+ * @brief Estrutura de dados para o fecho transitivo de um grafo compacto (uma linha de bits por componente fortemente conexa)
+ * @struct FechoAlcance
+ * @param numVertices Número de vértices
+ * @param numComponentes Número de componentes fortemente conexas
+ * @param componente Componente de cada índice de vértice
+ * @param inicioComponente Posição em membros do primeiro vértice de cada componente (numComponentes + 1 posições)
+ * @param membros Índices dos vértices de cada componente, por ordem crescente
+ * @param codigos Código do vértice de cada índice
+ * @param indices Índice de cada código (-1 se o código não existe), de 0 a maxCodigo
+ * @param maxCodigo Maior código de um vértice
+ * @param palavras Número de palavras de 64 bits de cada linha
+ * @param linhas Linhas de bits: o bit d da linha c indica que a componente d é alcançável a partir da componente c
+ * @attention Tal como o grafo compacto, o fecho não acompanha as alterações ao grafo
+ */
+typedef struct FechoAlcance {
+    int numVertices, numComponentes;
+    int* componente;
+    int* inicioComponente;
+    int* membros;
+    int* codigos;
+    int* indices;
+    int maxCodigo;
+    size_t palavras;
+    uint64_t* linhas;
+} FechoAlcance;
+
+/**
+ * @brief Estrutura de dados para a escrita em bloco
+ * @struct Saida
+ * @param fd Descritor do ficheiro de destino
+ * @param buffer Buffer onde os registos são formatados antes de serem escritos
+ * @param usado Número de bytes ocupados no buffer
+ * @param capacidade Capacidade do buffer
+ * @param proprio Indica se o descritor foi aberto pela saída e deve ser fechado (0 ou 1)
+ * @param erro Indica se ocorreu algum erro de escrita (0 ou 1)
+ * @attention O buffer é reutilizado entre despejos, só é libertado em fecharSaida
+ */
+typedef struct Saida {
+    int fd;
+    char* buffer;
+    size_t usado, capacidade;
+    int proprio;
+    int erro;
+} Saida;
+
 #endif
\ No newline at end of file
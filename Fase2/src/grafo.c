@@ -9,14 +9,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "estruturasDados.h"
 #include "grafo.h"
-
-
-/**
- * @brief Código do próximo vértice a ser adicionado ao grafo.
- */
-int nextCod = 1;
+#include "saida.h"
 
 #pragma region Criação de Estruturas
 /**
@@ -40,7 +36,7 @@ Antena criarAntena (char freq, int x, int y) {
 /**
  * @brief Cria um novo grafo.
  * 
- * Esta função inicializa um grafo vazio, com 0 vértices.
+ * Esta função inicializa um grafo vazio, com 0 vértices. Os códigos dos vértices de cada grafo começam em 1.
  * 
  * @return Grafo Retorna o grafo criado.
  */
@@ -48,6 +44,8 @@ Grafo criarGrafo() {
     Grafo novo;
     novo.vertices = NULL;
     novo.numVertices = 0;
+    novo.proximoCodigo = 1;
+    novo.indice = NULL;
     return novo;
 }
 
@@ -100,12 +98,366 @@ Adjacente* criarAdjacente(int codigo) {
 
 
 
+#pragma region Índice do Grafo
+
+/**
+ * @brief Ligação do índice: uma aresta, o seu nó na lista de adjacências e as suas vizinhas nas listas de saída e de entrada.
+ * @internal
+ */
+typedef struct Ligacao {
+    int origem, destino; /**< Códigos dos vértices da aresta. */
+    Adjacente* no; /**< Nó da aresta na lista de adjacências da origem. */
+    int anterior, seguinte; /**< Ligações vizinhas na lista de saída da origem (-1 nas pontas); seguinte encadeia também as ligações livres. */
+    int anteriorEntrada, seguinteEntrada; /**< Ligações vizinhas na lista de entrada do destino (-1 nas pontas). */
+} Ligacao;
+
+/**
+ * @brief Índice de um grafo, que permite inserir e remover vértices e arestas sem percorrer as listas.
+ * @internal
+ * Cada aresta ocupa uma ligação, encontrada pela tabela de dispersão (endereçamento aberto, remoção por
+ * recuo das entradas seguintes) e encadeada nas arestas que saem da origem, pela ordem da lista de
+ * adjacências, e nas que chegam ao destino. As ligações, os vértices e as adjacências retirados ficam em
+ * listas de livres e são reaproveitados nas inserções seguintes.
+ */
+typedef struct IndiceGrafo {
+    Vertice** porCodigo; /**< Vértice de cada código (NULL se o código não existe). */
+    Vertice** anteriores; /**< Vértice anterior a cada código na lista de vértices (NULL no primeiro). */
+    int* primeiraSaida, *ultimaSaida; /**< Primeira e última ligação das arestas que saem de cada código (-1 se não há). */
+    int* primeiraEntrada; /**< Primeira ligação das arestas que chegam a cada código (-1 se não há). */
+    int capCodigos; /**< Número de posições dos vetores por código. */
+    Vertice* cauda; /**< Último vértice da lista. */
+    Ligacao* ligacoes; /**< Vetor das ligações, incluindo as livres. */
+    int numLigacoes, capLigacoes; /**< Ligações já usadas e capacidade do vetor. */
+    int livre; /**< Primeira ligação livre (-1 se não há). */
+    int* tabela; /**< Ligação de cada posição da tabela de dispersão (-1 = vazio). */
+    int capTabela, numArestas; /**< Capacidade da tabela (potência de 2) e número de arestas. */
+    Vertice* verticesLivres; /**< Vértices retirados, encadeados por prox. */
+    Adjacente* adjacentesLivres; /**< Adjacências retiradas, encadeadas por prox. */
+} IndiceGrafo;
+
+/**
+ * @brief Calcula a posição inicial de uma aresta na tabela do índice.
+ * @internal
+ * @param origem Código do vértice de origem.
+ * @param destino Código do vértice de destino.
+ * @param cap Capacidade da tabela (potência de 2).
+ * @return int Retorna a posição inicial na tabela.
+ */
+static int posicaoAresta(int origem, int destino, int cap) {
+    unsigned long long chave = ((unsigned long long)(unsigned)origem << 32) | (unsigned)destino;
+    chave ^= chave >> 33;
+    chave *= 0xFF51AFD7ED558CCDULL;
+    chave ^= chave >> 33;
+    return (int)(chave & (unsigned long long)(cap - 1));
+}
+
+/**
+ * @brief Coloca uma ligação na primeira posição livre da tabela, a partir da posição da sua aresta.
+ * @internal
+ * @param indice O índice.
+ * @param l A ligação.
+ */
+static void colocarNaTabela(IndiceGrafo* indice, int l) {
+    int mascara = indice->capTabela - 1;
+    int p = posicaoAresta(indice->ligacoes[l].origem, indice->ligacoes[l].destino, indice->capTabela);
+    while (indice->tabela[p] >= 0) p = (p + 1) & mascara;
+    indice->tabela[p] = l;
+}
+
+/**
+ * @brief Substitui a tabela do índice por uma de outra capacidade, voltando a colocar todas as ligações.
+ * @internal
+ * @param indice O índice.
+ * @param cap A nova capacidade (potência de 2).
+ * @return int Retorna 1 se a tabela foi substituída, 0 em caso de erro (a tabela antiga mantém-se).
+ */
+static int redimensionarTabela(IndiceGrafo* indice, int cap) {
+    int* nova = (int*)malloc((size_t)cap * sizeof(int));
+    if (!nova) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    for (int p = 0; p < cap; p++) nova[p] = -1;
+    int* antiga = indice->tabela;
+    int capAntiga = indice->capTabela;
+    indice->tabela = nova;
+    indice->capTabela = cap;
+    for (int p = 0; p < capAntiga; p++) {
+        if (antiga[p] >= 0) colocarNaTabela(indice, antiga[p]);
+    }
+    free(antiga);
+    return 1;
+}
+
+/**
+ * @brief Retira uma ligação da tabela, recuando as entradas seguintes que deixariam de ser encontradas.
+ * @internal
+ * @param indice O índice.
+ * @param l A ligação a retirar.
+ */
+static void retirarDaTabela(IndiceGrafo* indice, int l) {
+    int mascara = indice->capTabela - 1;
+    int vazio = posicaoAresta(indice->ligacoes[l].origem, indice->ligacoes[l].destino, indice->capTabela);
+    while (indice->tabela[vazio] != l) vazio = (vazio + 1) & mascara;
+    for (int q = (vazio + 1) & mascara; indice->tabela[q] >= 0; q = (q + 1) & mascara) {
+        const Ligacao* lig = &indice->ligacoes[indice->tabela[q]];
+        int inicial = posicaoAresta(lig->origem, lig->destino, indice->capTabela);
+        // A entrada pode ocupar o buraco se este fica entre a sua posição inicial e a atual
+        if (((q - inicial) & mascara) >= ((q - vazio) & mascara)) {
+            indice->tabela[vazio] = indice->tabela[q];
+            vazio = q;
+        }
+    }
+    indice->tabela[vazio] = -1;
+}
+
+/**
+ * @brief Procura a ligação de uma aresta.
+ * @internal
+ * @param indice O índice.
+ * @param origem Código do vértice de origem.
+ * @param destino Código do vértice de destino.
+ * @return int Retorna a ligação da aresta, ou -1 se a aresta não existir.
+ */
+static int procurarLigacao(const IndiceGrafo* indice, int origem, int destino) {
+    int mascara = indice->capTabela - 1;
+    for (int p = posicaoAresta(origem, destino, indice->capTabela); indice->tabela[p] >= 0; p = (p + 1) & mascara) {
+        const Ligacao* lig = &indice->ligacoes[indice->tabela[p]];
+        if (lig->origem == origem && lig->destino == destino) return indice->tabela[p];
+    }
+    return -1;
+}
+
+/**
+ * @brief Garante que os vetores por código do índice têm uma posição para um código.
+ * @internal
+ * @param indice O índice.
+ * @param codigo O código (não negativo).
+ * @return int Retorna 1 se o código tem posição, 0 em caso de erro.
+ */
+static int garantirCodigo(IndiceGrafo* indice, int codigo) {
+    if (codigo < indice->capCodigos) return 1;
+    size_t cap = indice->capCodigos > 0 ? (size_t)indice->capCodigos : 16;
+    while (cap <= (size_t)codigo) cap *= 2;
+    if (cap > INT_MAX) cap = INT_MAX;
+    if ((size_t)codigo >= cap) return 0;
+
+    // Cada vetor fica no índice logo que cresce, para nenhum se perder se outro falhar
+    Vertice** porCodigo = (Vertice**)realloc(indice->porCodigo, cap * sizeof(Vertice*));
+    if (porCodigo) indice->porCodigo = porCodigo;
+    Vertice** anteriores = (Vertice**)realloc(indice->anteriores, cap * sizeof(Vertice*));
+    if (anteriores) indice->anteriores = anteriores;
+    int* primeiraSaida = (int*)realloc(indice->primeiraSaida, cap * sizeof(int));
+    if (primeiraSaida) indice->primeiraSaida = primeiraSaida;
+    int* ultimaSaida = (int*)realloc(indice->ultimaSaida, cap * sizeof(int));
+    if (ultimaSaida) indice->ultimaSaida = ultimaSaida;
+    int* primeiraEntrada = (int*)realloc(indice->primeiraEntrada, cap * sizeof(int));
+    if (primeiraEntrada) indice->primeiraEntrada = primeiraEntrada;
+    if (!porCodigo || !anteriores || !primeiraSaida || !ultimaSaida || !primeiraEntrada) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    for (size_t c = (size_t)indice->capCodigos; c < cap; c++) {
+        porCodigo[c] = NULL;
+        anteriores[c] = NULL;
+        primeiraSaida[c] = ultimaSaida[c] = primeiraEntrada[c] = -1;
+    }
+    indice->capCodigos = (int)cap;
+    return 1;
+}
+
+/**
+ * @brief Garante espaço no índice para mais uma aresta, de modo a que registarAresta não possa falhar.
+ * @internal
+ * @param indice O índice.
+ * @param destino Código do vértice de destino da aresta (não negativo).
+ * @return int Retorna 1 se há espaço, 0 em caso de erro.
+ */
+static int prepararAresta(IndiceGrafo* indice, int destino) {
+    if (!garantirCodigo(indice, destino)) return 0;
+    if (2 * (indice->numArestas + 1) > indice->capTabela && !redimensionarTabela(indice, 2 * indice->capTabela)) return 0;
+    if (indice->livre < 0 && indice->numLigacoes == indice->capLigacoes) {
+        int cap = indice->capLigacoes > 0 ? 2 * indice->capLigacoes : 16;
+        Ligacao* ligacoes = (Ligacao*)realloc(indice->ligacoes, (size_t)cap * sizeof(Ligacao));
+        if (!ligacoes) {
+            printf("Erro ao alocar memoria!\n");
+            return 0;
+        }
+        indice->ligacoes = ligacoes;
+        indice->capLigacoes = cap;
+    }
+    return 1;
+}
+
+/**
+ * @brief Regista no índice uma aresta cujo nó já está no fim da lista de adjacências da origem.
+ * @internal
+ * Tem de ser precedida por prepararAresta.
+ * @param indice O índice.
+ * @param origem Código do vértice de origem.
+ * @param destino Código do vértice de destino.
+ * @param no O nó da aresta.
+ */
+static void registarAresta(IndiceGrafo* indice, int origem, int destino, Adjacente* no) {
+    int l = indice->livre;
+    if (l >= 0) indice->livre = indice->ligacoes[l].seguinte;
+    else l = indice->numLigacoes++;
+    Ligacao* lig = &indice->ligacoes[l];
+    lig->origem = origem;
+    lig->destino = destino;
+    lig->no = no;
+    lig->anterior = indice->ultimaSaida[origem];
+    lig->seguinte = -1;
+    if (lig->anterior >= 0) indice->ligacoes[lig->anterior].seguinte = l;
+    else indice->primeiraSaida[origem] = l;
+    indice->ultimaSaida[origem] = l;
+    lig->anteriorEntrada = -1;
+    lig->seguinteEntrada = indice->primeiraEntrada[destino];
+    if (lig->seguinteEntrada >= 0) indice->ligacoes[lig->seguinteEntrada].anteriorEntrada = l;
+    indice->primeiraEntrada[destino] = l;
+    colocarNaTabela(indice, l);
+    indice->numArestas++;
+}
+
+/**
+ * @brief Retira uma aresta do grafo e do índice, guardando o nó e a ligação para reaproveitar.
+ * @internal
+ * @param indice O índice.
+ * @param l A ligação da aresta.
+ */
+static void retirarAresta(IndiceGrafo* indice, int l) {
+    retirarDaTabela(indice, l);
+    Ligacao* lig = &indice->ligacoes[l];
+
+    // Lista de adjacências e lista de saída da origem
+    if (lig->anterior >= 0) {
+        indice->ligacoes[lig->anterior].no->prox = lig->no->prox;
+        indice->ligacoes[lig->anterior].seguinte = lig->seguinte;
+    } else {
+        indice->porCodigo[lig->origem]->adjacentes = lig->no->prox;
+        indice->primeiraSaida[lig->origem] = lig->seguinte;
+    }
+    if (lig->seguinte >= 0) indice->ligacoes[lig->seguinte].anterior = lig->anterior;
+    else indice->ultimaSaida[lig->origem] = lig->anterior;
+
+    // Lista de entrada do destino
+    if (lig->anteriorEntrada >= 0) indice->ligacoes[lig->anteriorEntrada].seguinteEntrada = lig->seguinteEntrada;
+    else indice->primeiraEntrada[lig->destino] = lig->seguinteEntrada;
+    if (lig->seguinteEntrada >= 0) indice->ligacoes[lig->seguinteEntrada].anteriorEntrada = lig->anteriorEntrada;
+
+    lig->no->prox = indice->adjacentesLivres;
+    indice->adjacentesLivres = lig->no;
+    lig->no = NULL;
+    lig->seguinte = indice->livre;
+    indice->livre = l;
+    indice->numArestas--;
+}
+
+/**
+ * @brief Liberta a memória de um índice, incluindo os vértices e as adjacências guardados para reaproveitar.
+ * @internal
+ * @param indice O índice (pode ser NULL).
+ */
+static void libertarIndice(IndiceGrafo* indice) {
+    if (!indice) return;
+    while (indice->verticesLivres) {
+        Vertice* v = indice->verticesLivres;
+        indice->verticesLivres = v->prox;
+        free(v);
+    }
+    while (indice->adjacentesLivres) {
+        Adjacente* adj = indice->adjacentesLivres;
+        indice->adjacentesLivres = adj->prox;
+        free(adj);
+    }
+    free(indice->porCodigo);
+    free(indice->anteriores);
+    free(indice->primeiraSaida);
+    free(indice->ultimaSaida);
+    free(indice->primeiraEntrada);
+    free(indice->ligacoes);
+    free(indice->tabela);
+    free(indice);
+}
+
+/**
+ * @brief Devolve o índice do grafo, criando-o na primeira utilização.
+ * @internal
+ * A criação percorre o grafo uma vez; a partir daí, o índice acompanha as inserções e remoções.
+ * @param grafo O grafo.
+ * @return IndiceGrafo* Retorna o índice, ou NULL se o grafo tiver códigos negativos ou repetidos ou em caso de erro.
+ */
+static IndiceGrafo* obterIndice(Grafo* grafo) {
+    if (grafo->indice) return grafo->indice;
+    int maxCod = grafo->proximoCodigo > 0 ? grafo->proximoCodigo : 0, numArestas = 0;
+    for (Vertice* v = grafo->vertices; v; v = v->prox) {
+        if (v->codigo < 0) return NULL;
+        if (v->codigo > maxCod) maxCod = v->codigo;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) {
+            if (adj->codigo < 0) return NULL;
+            numArestas++;
+        }
+    }
+
+    IndiceGrafo* indice = (IndiceGrafo*)calloc(1, sizeof(IndiceGrafo));
+    if (!indice) {
+        printf("Erro ao alocar memoria!\n");
+        return NULL;
+    }
+    indice->livre = -1;
+    int cap = 16;
+    while (cap < 2 * numArestas + 2) cap *= 2;
+    indice->ligacoes = (Ligacao*)malloc((size_t)(numArestas > 0 ? numArestas : 1) * sizeof(Ligacao));
+    indice->capLigacoes = numArestas > 0 ? numArestas : 1;
+    if (!indice->ligacoes || !redimensionarTabela(indice, cap) || !garantirCodigo(indice, maxCod)) {
+        if (!indice->ligacoes) printf("Erro ao alocar memoria!\n");
+        libertarIndice(indice);
+        return NULL;
+    }
+    for (Vertice* v = grafo->vertices; v; v = v->prox) {
+        if (indice->porCodigo[v->codigo]) {
+            libertarIndice(indice);
+            return NULL;
+        }
+        indice->porCodigo[v->codigo] = v;
+        indice->anteriores[v->codigo] = indice->cauda;
+        indice->cauda = v;
+    }
+    for (Vertice* v = grafo->vertices; v; v = v->prox) {
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) {
+            if (!prepararAresta(indice, adj->codigo)) {
+                libertarIndice(indice);
+                return NULL;
+            }
+            registarAresta(indice, v->codigo, adj->codigo, adj);
+        }
+    }
+    grafo->indice = indice;
+    return indice;
+}
+
+/**
+ * @brief Descarta o índice do grafo, que volta a ser criado na próxima inserção ou remoção.
+ * 
+ * Tem de ser chamada antes de qualquer alteração feita diretamente às listas de vértices ou de adjacências.
+ * 
+ * @param grafo O grafo.
+ */
+void invalidarIndiceGrafo(Grafo* grafo) {
+    libertarIndice(grafo->indice);
+    grafo->indice = NULL;
+}
+#pragma endregion
+
+
+
 #pragma region Funções de Manipulação do Grafo
 
 /**
  * @brief Adiciona um vértice ao grafo.
  * 
- * Esta função cria um novo vértice e o adiciona ao grafo. Se o grafo estiver vazio, o novo vértice se torna o primeiro.
+ * Esta função cria um novo vértice e o adiciona ao fim da lista de vértices. Se o grafo estiver vazio, o novo vértice se torna o primeiro.
+ * Com o índice do grafo, o fim da lista é conhecido e o vértice reaproveita a memória de um vértice removido, se houver.
  * 
  * @param grafo O grafo onde adicionar o vértice.
  * @param x Coordenada x da antena.
@@ -114,10 +466,30 @@ Adjacente* criarAdjacente(int codigo) {
  * @return int Retorna 1 se a operação foi realizada com sucesso, 0 caso contrário.
  */
 int adicionarVertice(Grafo* grafo, int x, int y, char freq) {
-    Vertice* novo = criarVertice(nextCod++, x, y, freq);
-    if (!novo) return 0;
+    IndiceGrafo* indice = obterIndice(grafo);
+    if (indice && !garantirCodigo(indice, grafo->proximoCodigo)) return 0;
+
+    Vertice* novo;
+    if (indice && indice->verticesLivres) {
+        novo = indice->verticesLivres;
+        indice->verticesLivres = novo->prox;
+        novo->codigo = grafo->proximoCodigo++;
+        novo->antena = criarAntena(freq, x, y);
+        novo->visitado = 0;
+        novo->prox = NULL;
+        novo->adjacentes = NULL;
+    } else {
+        novo = criarVertice(grafo->proximoCodigo++, x, y, freq);
+        if (!novo) return 0;
+    }
 
-    if (!grafo->vertices) {grafo->vertices = novo;}
+    if (indice) {
+        if (!indice->cauda) grafo->vertices = novo;
+        else indice->cauda->prox = novo;
+        indice->porCodigo[novo->codigo] = novo;
+        indice->anteriores[novo->codigo] = indice->cauda;
+        indice->cauda = novo;
+    } else if (!grafo->vertices) {grafo->vertices = novo;}
     else {
         Vertice* tail = grafo->vertices;
         while (tail->prox) {tail = tail->prox;}
@@ -131,7 +503,9 @@ int adicionarVertice(Grafo* grafo, int x, int y, char freq) {
 /**
  * @brief Adiciona um vértice adjacente a um vértice existente no grafo.
  * 
- * Esta função percorre todos os vértices do grafo e adiciona o vértice adjacente ao vértice especificado.
+ * Esta função adiciona o vértice adjacente ao fim da lista de adjacências do vértice especificado, se ainda lá não estiver.
+ * Com o índice do grafo, o vértice, a aresta repetida e o fim da lista são encontrados em tempo constante (esperado);
+ * sem ele, percorre os vértices do grafo e a lista de adjacências.
  * 
  * @param grafo O grafo onde adicionar o adjacente.
  * @param vertice O código do vértice onde adicionar o adjacente.
@@ -143,6 +517,27 @@ int adicionarAdjacente(Grafo* grafo, int vertice, int adjacente) {
     if (!grafo->vertices) return 0;
     if (!grafo->vertices->prox) return 0;
 
+    IndiceGrafo* indice = obterIndice(grafo);
+    if (indice) {
+        if (vertice < 0 || vertice >= indice->capCodigos || !indice->porCodigo[vertice] || adjacente < 0) return 0;
+        if (procurarLigacao(indice, vertice, adjacente) >= 0) return 0;
+        if (!prepararAresta(indice, adjacente)) return 0;
+        Adjacente* novoAdjacente = indice->adjacentesLivres;
+        if (novoAdjacente) {
+            indice->adjacentesLivres = novoAdjacente->prox;
+            novoAdjacente->codigo = adjacente;
+            novoAdjacente->prox = NULL;
+        } else {
+            novoAdjacente = criarAdjacente(adjacente);
+            if (!novoAdjacente) return 0;
+        }
+        int ultima = indice->ultimaSaida[vertice];
+        if (ultima < 0) indice->porCodigo[vertice]->adjacentes = novoAdjacente;
+        else indice->ligacoes[ultima].no->prox = novoAdjacente;
+        registarAresta(indice, vertice, adjacente, novoAdjacente);
+        return 1;
+    }
+
     for (Vertice* atual = grafo->vertices; atual; atual = atual->prox) {
         if (atual->codigo == vertice) {
             for (Adjacente* temp = atual->adjacentes; temp; temp = temp->prox) { if (temp->codigo == adjacente) return 0;}
@@ -162,6 +557,60 @@ int adicionarAdjacente(Grafo* grafo, int vertice, int adjacente) {
     return 0;
 }
 
+/**
+ * @brief Remove um vértice adjacente de um vértice do grafo.
+ * 
+ * A aresta é encontrada pelo índice do grafo e retirada da lista de adjacências em tempo constante (esperado).
+ * O nó da adjacência fica guardado no índice para a próxima inserção.
+ * 
+ * @param grafo O grafo onde remover o adjacente.
+ * @param vertice O código do vértice de onde remover o adjacente.
+ * @param adjacente O código do vértice adjacente a ser removido.
+ * @return int Retorna 1 se a aresta existia e foi removida, 0 caso contrário.
+ */
+int removerAdjacente(Grafo* grafo, int vertice, int adjacente) {
+    IndiceGrafo* indice = obterIndice(grafo);
+    if (!indice) return 0;
+    int l = procurarLigacao(indice, vertice, adjacente);
+    if (l < 0) return 0;
+    retirarAresta(indice, l);
+    return 1;
+}
+
+/**
+ * @brief Remove um vértice do grafo, com as arestas que saem dele e que chegam a ele.
+ * 
+ * O índice do grafo guarda, para cada vértice, o vértice anterior na lista e as arestas que chegam a ele,
+ * pelo que o custo é proporcional ao número de arestas do vértice. Os códigos dos restantes vértices não mudam
+ * e o código removido não volta a ser atribuído; a memória do vértice e das adjacências é reaproveitada nas
+ * inserções seguintes.
+ * 
+ * @param grafo O grafo onde remover o vértice.
+ * @param codigo O código do vértice a ser removido.
+ * @return int Retorna 1 se o vértice existia e foi removido, 0 caso contrário.
+ */
+int removerVertice(Grafo* grafo, int codigo) {
+    IndiceGrafo* indice = obterIndice(grafo);
+    if (!indice) return 0;
+    if (codigo < 0 || codigo >= indice->capCodigos || !indice->porCodigo[codigo]) return 0;
+    Vertice* v = indice->porCodigo[codigo];
+    while (indice->primeiraSaida[codigo] >= 0) retirarAresta(indice, indice->primeiraSaida[codigo]);
+    while (indice->primeiraEntrada[codigo] >= 0) retirarAresta(indice, indice->primeiraEntrada[codigo]);
+
+    Vertice* anterior = indice->anteriores[codigo];
+    if (anterior) anterior->prox = v->prox;
+    else grafo->vertices = v->prox;
+    if (v->prox) indice->anteriores[v->prox->codigo] = anterior;
+    else indice->cauda = anterior;
+    indice->porCodigo[codigo] = NULL;
+    indice->anteriores[codigo] = NULL;
+    v->adjacentes = NULL;
+    v->prox = indice->verticesLivres;
+    indice->verticesLivres = v;
+    grafo->numVertices--;
+    return 1;
+}
+
 /**
  * @brief Escreve o grafo na consola.
  * 
@@ -174,17 +623,30 @@ void escreverGrafo(Grafo grafo) {
         printf("Grafo vazio!\n");
         return;
     }
+    Saida saida;
+    if (!abrirSaida(&saida, NULL)) return;
     for (Vertice* atual = grafo.vertices; atual; atual = atual->prox) {
-        printf("Vertice %d: (X: %d, Y: %d) - FREQ: %c\n", atual->codigo, atual->antena.x, atual->antena.y, atual->antena.frequencia);
+        escreverBytes(&saida, "Vertice ", 8);
+        escreverInteiro(&saida, atual->codigo);
+        escreverBytes(&saida, ": (X: ", 6);
+        escreverInteiro(&saida, atual->antena.x);
+        escreverBytes(&saida, ", Y: ", 5);
+        escreverInteiro(&saida, atual->antena.y);
+        escreverBytes(&saida, ") - FREQ: ", 10);
+        escreverCaracter(&saida, atual->antena.frequencia);
+        escreverCaracter(&saida, '\n');
         if (atual->adjacentes == NULL) {
-            printf("->  Sem adjacentes\n\n");
+            escreverTexto(&saida, "->  Sem adjacentes\n\n");
             continue;
         }
         for (Adjacente* adj = atual->adjacentes; adj; adj = adj->prox) {
-            printf("->  Adjacente: %d\n", adj->codigo);
+            escreverBytes(&saida, "->  Adjacente: ", 15);
+            escreverInteiro(&saida, adj->codigo);
+            escreverCaracter(&saida, '\n');
         }
-        printf("\n");
+        escreverCaracter(&saida, '\n');
     }
+    fecharSaida(&saida);
 }
 
 
@@ -197,12 +659,17 @@ void escreverGrafo(Grafo grafo) {
  * @return int Retorna 1 se a operação foi realizada com sucesso.
  */
 int libertarGrafo(Grafo* grafo) {
-    for (Vertice* atual = grafo->vertices; atual; atual = atual->prox) {
+    invalidarIndiceGrafo(grafo);
+    Vertice* atual = grafo->vertices;
+    while (atual) {
         Vertice* temp = atual;
-        for (Adjacente* adjAtual = atual->adjacentes; adjAtual; adjAtual = adjAtual->prox) {
+        Adjacente* adjAtual = atual->adjacentes;
+        while (adjAtual) {
             Adjacente* adjTemp = adjAtual;
+            adjAtual = adjAtual->prox;
             free(adjTemp);
         }
+        atual = atual->prox;
         free(temp);
     }
     grafo->vertices = NULL;
@@ -253,19 +720,820 @@ Grafo lerGrafo(const char* nomeFicheiro) {
 
 
 
+#pragma region Construção por Proximidade
+
+/**
+ * @brief Lê as antenas de um ficheiro e acrescenta-as ao grafo como vértices, sem adjacências.
+ * @internal
+ * Ao contrário de adicionarVertice, mantém o último vértice da lista, pelo que a leitura é linear.
+ * Esta função é usada internamente pelas construções por proximidade e não deve ser chamada diretamente.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param grafo O grafo onde acrescentar os vértices.
+ * @return Vertice** Retorna um vetor com os vértices por ordem de leitura, ou NULL em caso de erro.
+ */
+static Vertice** lerVertices(const char* nomeFicheiro, Grafo* grafo) {
+    FILE* file = fopen(nomeFicheiro, "r");
+    if (!file) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return NULL;
+    }
+    int cap = 64;
+    Vertice** vetor = (Vertice**)malloc(cap * sizeof(Vertice*));
+    if (!vetor) {
+        printf("Erro ao alocar memoria!\n");
+        fclose(file);
+        return NULL;
+    }
+    Vertice* tail = grafo->vertices;
+    while (tail && tail->prox) tail = tail->prox;
+
+    int x = 0, y = 0, c;
+    while ((c = fgetc(file)) != EOF) {
+        if (c == '\n') {
+            x = 0;
+            y++;
+            continue;
+        }
+        if (c != '.' && c != '#') {
+            if (grafo->numVertices == cap) {
+                cap *= 2;
+                Vertice** novo = (Vertice**)realloc(vetor, cap * sizeof(Vertice*));
+                if (!novo) {
+                    printf("Erro ao alocar memoria!\n");
+                    free(vetor);
+                    fclose(file);
+                    return NULL;
+                }
+                vetor = novo;
+            }
+            Vertice* novo = criarVertice(grafo->proximoCodigo++, x, y, (char)c);
+            if (!novo) {
+                free(vetor);
+                fclose(file);
+                return NULL;
+            }
+            if (!tail) grafo->vertices = novo;
+            else tail->prox = novo;
+            tail = novo;
+            vetor[grafo->numVertices++] = novo;
+        }
+        x++;
+    }
+    fclose(file);
+    return vetor;
+}
+
+/**
+ * @brief Compara duas arestas pela origem e depois pelo destino.
+ * @internal
+ * @param a Primeira aresta.
+ * @param b Segunda aresta.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int compararArestas(const void* a, const void* b) {
+    const Aresta* ea = (const Aresta*)a;
+    const Aresta* eb = (const Aresta*)b;
+    if (ea->origem != eb->origem) return ea->origem < eb->origem ? -1 : 1;
+    return (ea->destino > eb->destino) - (ea->destino < eb->destino);
+}
+
+/**
+ * @brief Cria as listas de adjacências a partir de um vetor de arestas entre índices de vértices.
+ * @internal
+ * As arestas são ordenadas e as repetidas ignoradas, pelo que cada lista fica por ordem crescente de índice,
+ * tal como na construção por cliques de lerGrafo.
+ * 
+ * @param vetor Vértices indexados pelos índices usados nas arestas.
+ * @param arestas Arestas a criar (o vetor é reordenado).
+ * @param num Número de arestas.
+ * @return int Retorna 1 se as adjacências foram criadas com sucesso, 0 caso contrário.
+ */
+static int ligarArestas(Vertice** vetor, Aresta* arestas, int num) {
+    if (num > 0) qsort(arestas, num, sizeof(Aresta), compararArestas);
+    Adjacente* tail = NULL;
+    for (int i = 0; i < num; i++) {
+        if (i > 0 && compararArestas(&arestas[i], &arestas[i - 1]) == 0) continue;
+        Vertice* origem = vetor[arestas[i].origem];
+        if (i == 0 || arestas[i].origem != arestas[i - 1].origem) {
+            tail = origem->adjacentes;
+            while (tail && tail->prox) tail = tail->prox;
+        }
+        Adjacente* novo = criarAdjacente(vetor[arestas[i].destino]->codigo);
+        if (!novo) return 0;
+        if (!tail) origem->adjacentes = novo;
+        else tail->prox = novo;
+        tail = novo;
+    }
+    return 1;
+}
+
+/**
+ * @brief Calcula a chave da célula de uma posição (frequência, coluna e linha da célula).
+ * @internal
+ * @param freq Frequência da antena.
+ * @param cx Coluna da célula.
+ * @param cy Linha da célula.
+ * @return unsigned long long A chave da célula.
+ */
+static unsigned long long chaveCelula(char freq, int cx, int cy) {
+    return ((unsigned long long)(unsigned char)freq << 56) |
+           ((unsigned long long)(cx & 0xFFFFFFF) << 28) |
+           (unsigned long long)(cy & 0xFFFFFFF);
+}
+
+/**
+ * @brief Calcula a posição inicial de uma chave na tabela de células.
+ * @internal
+ * @param chave A chave da célula.
+ * @param cap A capacidade da tabela (potência de 2).
+ * @return int A posição inicial na tabela.
+ */
+static int dispersaoCelula(unsigned long long chave, int cap) {
+    chave ^= chave >> 33;
+    chave *= 0xFF51AFD7ED558CCDULL;
+    chave ^= chave >> 33;
+    return (int)(chave & (unsigned long long)(cap - 1));
+}
+
+/**
+ * @brief Compara dois vértices pela chave da célula e depois pelo índice.
+ * @internal
+ * @param a Primeiro par chave/índice.
+ * @param b Segundo par chave/índice.
+ * @return int Negativo, zero ou positivo, como em qsort.
+ */
+static int compararCelulas(const void* a, const void* b) {
+    const unsigned long long* ca = (const unsigned long long*)a;
+    const unsigned long long* cb = (const unsigned long long*)b;
+    if (ca[0] != cb[0]) return ca[0] < cb[0] ? -1 : 1;
+    return (ca[1] > cb[1]) - (ca[1] < cb[1]);
+}
+
+/**
+ * @brief Lista de células: os vértices ordenados por célula e uma tabela de dispersão de cada célula para a sua fatia.
+ * @internal
+ */
+typedef struct ListaCelulas {
+    unsigned long long* ordem; /**< Pares (chave, índice) ordenados por chave. */
+    unsigned long long* chaves; /**< Chaves da tabela de dispersão (0 = vazio, guardadas com +1). */
+    int* inicio; /**< Início da fatia de cada célula em ordem. */
+    int* fim; /**< Fim (exclusivo) da fatia de cada célula em ordem. */
+    int cap; /**< Capacidade da tabela de dispersão. */
+} ListaCelulas;
+
+/**
+ * @brief Agrupa os vértices por célula, com o lado de célula de cada frequência.
+ * @internal
+ * @param vetor Vértices do grafo.
+ * @param num Número de vértices.
+ * @param lado Lado da célula para cada frequência.
+ * @param porFrequencia 1 para separar as células por frequência, 0 para juntar todas as frequências (chave com frequência 0).
+ * @param celulas Lista de células a preencher.
+ * @return int Retorna 1 se a lista foi criada com sucesso, 0 caso contrário.
+ */
+static int criarListaCelulas(Vertice** vetor, int num, const int* lado, int porFrequencia, ListaCelulas* celulas) {
+    celulas->cap = 16;
+    while (celulas->cap < 2 * num) celulas->cap *= 2;
+    celulas->ordem = (unsigned long long*)malloc(2 * (size_t)(num > 0 ? num : 1) * sizeof(unsigned long long));
+    celulas->chaves = (unsigned long long*)calloc(celulas->cap, sizeof(unsigned long long));
+    celulas->inicio = (int*)malloc(celulas->cap * sizeof(int));
+    celulas->fim = (int*)malloc(celulas->cap * sizeof(int));
+    if (!celulas->ordem || !celulas->chaves || !celulas->inicio || !celulas->fim) {
+        printf("Erro ao alocar memoria!\n");
+        return 0;
+    }
+    for (int i = 0; i < num; i++) {
+        Antena a = vetor[i]->antena;
+        int l = lado[(unsigned char)a.frequencia];
+        celulas->ordem[2 * i] = chaveCelula(porFrequencia ? a.frequencia : 0, a.x / l, a.y / l);
+        celulas->ordem[2 * i + 1] = (unsigned long long)i;
+    }
+    qsort(celulas->ordem, num, 2 * sizeof(unsigned long long), compararCelulas);
+    for (int i = 0; i < num; ) {
+        unsigned long long chave = celulas->ordem[2 * i];
+        int j = i;
+        while (j < num && celulas->ordem[2 * j] == chave) j++;
+        int p = dispersaoCelula(chave, celulas->cap);
+        while (celulas->chaves[p]) p = (p + 1) & (celulas->cap - 1);
+        celulas->chaves[p] = chave + 1;
+        celulas->inicio[p] = i;
+        celulas->fim[p] = j;
+        i = j;
+    }
+    return 1;
+}
+
+/**
+ * @brief Liberta a memória de uma lista de células.
+ * @internal
+ * @param celulas Lista de células a libertar.
+ */
+static void libertarListaCelulas(ListaCelulas* celulas) {
+    free(celulas->ordem);
+    free(celulas->chaves);
+    free(celulas->inicio);
+    free(celulas->fim);
+}
+
+/**
+ * @brief Procura a fatia de vértices de uma célula.
+ * @internal
+ * @param celulas Lista de células.
+ * @param chave A chave da célula.
+ * @param inicio Início da fatia (saída).
+ * @param fim Fim exclusivo da fatia (saída).
+ * @return int Retorna 1 se a célula tem vértices, 0 caso contrário.
+ */
+static int procurarCelula(const ListaCelulas* celulas, unsigned long long chave, int* inicio, int* fim) {
+    for (int p = dispersaoCelula(chave, celulas->cap); celulas->chaves[p]; p = (p + 1) & (celulas->cap - 1)) {
+        if (celulas->chaves[p] == chave + 1) {
+            *inicio = celulas->inicio[p];
+            *fim = celulas->fim[p];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Acrescenta uma aresta a um vetor dinâmico de arestas.
+ * @internal
+ * @param arestas Vetor de arestas.
+ * @param num Número de arestas no vetor.
+ * @param cap Capacidade do vetor.
+ * @param origem Índice do vértice de origem.
+ * @param destino Índice do vértice de destino.
+ * @return int Retorna 1 se a aresta foi acrescentada com sucesso, 0 caso contrário.
+ */
+static int acrescentarAresta(Aresta** arestas, int* num, int* cap, int origem, int destino) {
+    if (*num == *cap) {
+        int novaCap = *cap ? *cap * 2 : 256;
+        Aresta* novo = (Aresta*)realloc(*arestas, novaCap * sizeof(Aresta));
+        if (!novo) {
+            printf("Erro ao alocar memoria!\n");
+            return 0;
+        }
+        *arestas = novo;
+        *cap = novaCap;
+    }
+    (*arestas)[*num].origem = origem;
+    (*arestas)[(*num)++].destino = destino;
+    return 1;
+}
+
+/**
+ * @brief Liberta um grafo construído só em parte e devolve um grafo vazio, como lerGrafo quando o ficheiro não abre.
+ * @internal
+ * @param grafo O grafo a descartar.
+ * @return Grafo Retorna um grafo vazio.
+ */
+static Grafo descartarGrafo(Grafo* grafo) {
+    libertarGrafo(grafo);
+    return criarGrafo();
+}
+
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando as antenas da mesma frequência a uma distância não superior a raio.
+ * 
+ * As antenas são agrupadas em células de lado raio, pelo que cada antena só é comparada com as das 9 células vizinhas.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param raio A distância euclidiana máxima entre antenas ligadas.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ */
+Grafo lerGrafoRaio(const char* nomeFicheiro, int raio) {
+    Grafo grafo = criarGrafo();
+    if (raio < 1) return grafo;
+    Vertice** vetor = lerVertices(nomeFicheiro, &grafo);
+    if (!vetor) return descartarGrafo(&grafo);
+
+    int lado[NUM_FREQUENCIAS];
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) lado[f] = raio;
+    ListaCelulas celulas;
+    Aresta* arestas = NULL;
+    int numArestas = 0, capArestas = 0, ok = criarListaCelulas(vetor, grafo.numVertices, lado, 1, &celulas);
+    long long r2 = (long long)raio * raio;
+
+    for (int i = 0; ok && i < grafo.numVertices; i++) {
+        Antena a = vetor[i]->antena;
+        int cx = a.x / raio, cy = a.y / raio;
+        for (int dy = -1; ok && dy <= 1; dy++) {
+            for (int dx = -1; ok && dx <= 1; dx++) {
+                int inicio, fim;
+                if (cx + dx < 0 || cy + dy < 0) continue;
+                if (!procurarCelula(&celulas, chaveCelula(a.frequencia, cx + dx, cy + dy), &inicio, &fim)) continue;
+                for (int p = inicio; ok && p < fim; p++) {
+                    int j = (int)celulas.ordem[2 * p + 1];
+                    if (j <= i) continue;
+                    long long ddx = a.x - vetor[j]->antena.x, ddy = a.y - vetor[j]->antena.y;
+                    if (ddx * ddx + ddy * ddy > r2) continue;
+                    ok = acrescentarAresta(&arestas, &numArestas, &capArestas, i, j) &&
+                         acrescentarAresta(&arestas, &numArestas, &capArestas, j, i);
+                }
+            }
+        }
+    }
+    // Um erro a meio deixaria o grafo sem arestas ou com as listas de adjacências só em parte
+    if (!ok || !ligarArestas(vetor, arestas, numArestas)) grafo = descartarGrafo(&grafo);
+
+    free(arestas);
+    libertarListaCelulas(&celulas);
+    free(vetor);
+    return grafo;
+}
+
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando cada antena às k antenas mais próximas da mesma frequência.
+ * 
+ * As ligações são simétricas: se B é um dos k vizinhos de A, A fica também adjacente a B.
+ * O lado das células é escolhido por frequência para que cada célula tenha cerca de k antenas,
+ * e a procura percorre anéis de células até nenhum anel seguinte poder ter uma antena mais próxima.
+ * Os empates na distância são resolvidos a favor do vértice lido primeiro.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param k O número de vizinhos de cada antena.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ */
+Grafo lerGrafoVizinhos(const char* nomeFicheiro, int k) {
+    Grafo grafo = criarGrafo();
+    if (k < 1) return grafo;
+    Vertice** vetor = lerVertices(nomeFicheiro, &grafo);
+    if (!vetor) return descartarGrafo(&grafo);
+
+    // Caixa envolvente e número de antenas de cada frequência
+    int minX[NUM_FREQUENCIAS], minY[NUM_FREQUENCIAS], maxX[NUM_FREQUENCIAS], maxY[NUM_FREQUENCIAS];
+    int num[NUM_FREQUENCIAS] = {0}, lado[NUM_FREQUENCIAS];
+    for (int i = 0; i < grafo.numVertices; i++) {
+        Antena a = vetor[i]->antena;
+        int f = (unsigned char)a.frequencia;
+        if (num[f]++ == 0) {
+            minX[f] = maxX[f] = a.x;
+            minY[f] = maxY[f] = a.y;
+        }
+        if (a.x < minX[f]) minX[f] = a.x;
+        if (a.x > maxX[f]) maxX[f] = a.x;
+        if (a.y < minY[f]) minY[f] = a.y;
+        if (a.y > maxY[f]) maxY[f] = a.y;
+    }
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        lado[f] = 1;
+        if (!num[f]) continue;
+        long long area = (long long)(maxX[f] - minX[f] + 1) * (maxY[f] - minY[f] + 1);
+        while ((long long)lado[f] * lado[f] * num[f] < area * k) lado[f]++;
+    }
+
+    ListaCelulas celulas;
+    Aresta* arestas = NULL;
+    int numArestas = 0, capArestas = 0, ok = criarListaCelulas(vetor, grafo.numVertices, lado, 1, &celulas);
+    int* melhor = (int*)malloc(k * sizeof(int));
+    long long* dist = (long long*)malloc(k * sizeof(long long));
+    if (!melhor || !dist) ok = 0;
+
+    for (int i = 0; ok && i < grafo.numVertices; i++) {
+        Antena a = vetor[i]->antena;
+        int f = (unsigned char)a.frequencia, l = lado[f];
+        int cx = a.x / l, cy = a.y / l;
+        int maxAnel = (maxX[f] / l - minX[f] / l) + (maxY[f] / l - minY[f] / l) + 1;
+        int n = 0; // melhor[0..n) é um max-heap por (distância, índice)
+        for (int anel = 0; anel <= maxAnel; anel++) {
+            if (n == k && anel > 0) {
+                long long limite = (long long)(anel - 1) * l + 1;
+                if (limite * limite > dist[0]) break;
+            }
+            for (int by = cy - anel; by <= cy + anel; by++) {
+                int passo = (by == cy - anel || by == cy + anel || anel == 0) ? 1 : 2 * anel;
+                for (int bx = cx - anel; bx <= cx + anel; bx += passo) {
+                    int inicio, fim;
+                    if (bx < 0 || by < 0) continue;
+                    if (!procurarCelula(&celulas, chaveCelula(a.frequencia, bx, by), &inicio, &fim)) continue;
+                    for (int p = inicio; p < fim; p++) {
+                        int j = (int)celulas.ordem[2 * p + 1];
+                        if (j == i) continue;
+                        long long ddx = a.x - vetor[j]->antena.x, ddy = a.y - vetor[j]->antena.y;
+                        long long d = ddx * ddx + ddy * ddy;
+                        int pos;
+                        if (n < k) {
+                            pos = n++;
+                            while (pos > 0 && (d > dist[(pos - 1) / 2] || (d == dist[(pos - 1) / 2] && j > melhor[(pos - 1) / 2]))) {
+                                melhor[pos] = melhor[(pos - 1) / 2];
+                                dist[pos] = dist[(pos - 1) / 2];
+                                pos = (pos - 1) / 2;
+                            }
+                        } else if (d < dist[0] || (d == dist[0] && j < melhor[0])) {
+                            pos = 0;
+                            for (;;) {
+                                int c = 2 * pos + 1;
+                                if (c >= k) break;
+                                if (c + 1 < k && (dist[c + 1] > dist[c] || (dist[c + 1] == dist[c] && melhor[c + 1] > melhor[c]))) c++;
+                                if (dist[c] < d || (dist[c] == d && melhor[c] < j)) break;
+                                melhor[pos] = melhor[c];
+                                dist[pos] = dist[c];
+                                pos = c;
+                            }
+                        } else continue;
+                        melhor[pos] = j;
+                        dist[pos] = d;
+                    }
+                }
+            }
+        }
+        for (int v = 0; ok && v < n; v++) {
+            ok = acrescentarAresta(&arestas, &numArestas, &capArestas, i, melhor[v]) &&
+                 acrescentarAresta(&arestas, &numArestas, &capArestas, melhor[v], i);
+        }
+    }
+    // Um erro a meio deixaria o grafo sem arestas ou com as listas de adjacências só em parte
+    if (!ok || !ligarArestas(vetor, arestas, numArestas)) grafo = descartarGrafo(&grafo);
+
+    free(melhor);
+    free(dist);
+    free(arestas);
+    libertarListaCelulas(&celulas);
+    free(vetor);
+    return grafo;
+}
+
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando também cada antena às antenas de outras frequências perto dos seus efeitos nefastos.
+ * 
+ * As antenas da mesma frequência ficam ligadas como em lerGrafo. Para cada par (A, B) da mesma frequência, o efeito
+ * nefasto 2A - B (o do lado de A) interfere com as antenas de outras frequências a uma distância euclidiana não
+ * superior a raio (0 para só as que estão em cima do efeito), e A fica adjacente a cada uma delas. A junção é feita
+ * com uma tabela de dispersão de células de lado raio com as antenas de todas as frequências, pelo que cada efeito
+ * só é comparado com as antenas das 9 células à sua volta.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param raio A distância euclidiana máxima entre um efeito nefasto e as antenas com que interfere.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ * @attention As arestas de interferência só vão da antena que causa o efeito para as antenas afetadas.
+ */
+Grafo lerGrafoInterferencia(const char* nomeFicheiro, int raio) {
+    Grafo grafo = criarGrafo();
+    if (raio < 0) return grafo;
+    Vertice** vetor = lerVertices(nomeFicheiro, &grafo);
+    if (!vetor) return descartarGrafo(&grafo);
+
+    // Vértices agrupados por frequência, pela ordem de leitura
+    int inicioFreq[NUM_FREQUENCIAS + 1] = {0}, pos[NUM_FREQUENCIAS];
+    for (int i = 0; i < grafo.numVertices; i++) inicioFreq[(unsigned char)vetor[i]->antena.frequencia + 1]++;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFreq[f + 1] += inicioFreq[f];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    int* grupos = (int*)malloc((size_t)(grafo.numVertices > 0 ? grafo.numVertices : 1) * sizeof(int));
+
+    int lado[NUM_FREQUENCIAS], l = raio > 0 ? raio : 1;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) lado[f] = l;
+    ListaCelulas celulas;
+    Aresta* arestas = NULL;
+    int numArestas = 0, capArestas = 0, ok = criarListaCelulas(vetor, grafo.numVertices, lado, 0, &celulas);
+    if (!grupos) {
+        printf("Erro ao alocar memoria!\n");
+        ok = 0;
+    }
+    for (int i = 0; ok && i < grafo.numVertices; i++) grupos[pos[(unsigned char)vetor[i]->antena.frequencia]++] = i;
+    long long r2 = (long long)raio * raio;
+
+    for (int f = 0; ok && f < NUM_FREQUENCIAS; f++) {
+        for (int gi = inicioFreq[f]; ok && gi < inicioFreq[f + 1]; gi++) {
+            int i = grupos[gi];
+            Antena a = vetor[i]->antena;
+            for (int gj = inicioFreq[f]; ok && gj < inicioFreq[f + 1]; gj++) {
+                if (gj == gi) continue;
+                Antena b = vetor[grupos[gj]]->antena;
+                // Clique da mesma frequência, como em lerGrafo
+                ok = acrescentarAresta(&arestas, &numArestas, &capArestas, i, grupos[gj]);
+
+                // Antenas de outras frequências perto do efeito 2A - B
+                long long ex = 2LL * a.x - b.x, ey = 2LL * a.y - b.y;
+                if (ex < -raio || ey < -raio || ex > INT_MAX - l || ey > INT_MAX - l) continue;
+                int cx = (int)(ex / l), cy = (int)(ey / l);
+                for (int dy = -1; ok && dy <= 1; dy++) {
+                    for (int dx = -1; ok && dx <= 1; dx++) {
+                        int inicio, fim;
+                        if (cx + dx < 0 || cy + dy < 0) continue;
+                        if (!procurarCelula(&celulas, chaveCelula(0, cx + dx, cy + dy), &inicio, &fim)) continue;
+                        for (int p = inicio; ok && p < fim; p++) {
+                            int k = (int)celulas.ordem[2 * p + 1];
+                            Antena c = vetor[k]->antena;
+                            if (c.frequencia == a.frequencia) continue;
+                            long long ddx = ex - c.x, ddy = ey - c.y;
+                            if (ddx * ddx + ddy * ddy > r2) continue;
+                            ok = acrescentarAresta(&arestas, &numArestas, &capArestas, i, k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // Um erro a meio deixaria o grafo sem arestas ou com as listas de adjacências só em parte
+    if (!ok || !ligarArestas(vetor, arestas, numArestas)) grafo = descartarGrafo(&grafo);
+
+    free(grupos);
+    free(arestas);
+    libertarListaCelulas(&celulas);
+    free(vetor);
+    return grafo;
+}
+
+#pragma endregion
+
+
+
+#pragma region Operações em Lote
+
+/**
+ * @brief Estado de uma aresta durante um lote: existia antes do lote e mantém-se.
+ */
+#define ARESTA_ORIGINAL 1
+/**
+ * @brief Estado de uma aresta durante um lote: foi removida.
+ */
+#define ARESTA_REMOVIDA 2
+/**
+ * @brief Estado de uma aresta durante um lote: foi inserida (ou reinserida) no lote.
+ */
+#define ARESTA_NOVA 3
+
+/**
+ * @brief Tabela de dispersão das arestas de um grafo, usada durante um lote de operações.
+ * @internal
+ */
+typedef struct TabelaArestas {
+    unsigned long long* chaves; /**< Chaves das arestas (0 = vazio, guardadas com +1). */
+    char* estados; /**< Estado de cada aresta (ARESTA_ORIGINAL, ARESTA_REMOVIDA ou ARESTA_NOVA). */
+    int* ultima; /**< Índice da última operação que inseriu a aresta. */
+    int cap; /**< Capacidade da tabela. */
+} TabelaArestas;
+
+/**
+ * @brief Calcula a chave de uma aresta.
+ * @internal
+ * @param origem Código do vértice de origem.
+ * @param destino Código do vértice de destino.
+ * @return unsigned long long A chave da aresta.
+ */
+static unsigned long long chaveAresta(int origem, int destino) {
+    return ((unsigned long long)(unsigned)origem << 32) | (unsigned)destino;
+}
+
+/**
+ * @brief Procura uma aresta na tabela, criando a entrada se pedido.
+ * @internal
+ * @param tabela Tabela de arestas.
+ * @param origem Código do vértice de origem.
+ * @param destino Código do vértice de destino.
+ * @param criar 1 para criar a entrada (com estado 0) se a aresta não existir.
+ * @return int Retorna a posição da aresta na tabela, ou -1 se não existir e não for criada.
+ */
+static int procurarAresta(TabelaArestas* tabela, int origem, int destino, int criar) {
+    unsigned long long chave = chaveAresta(origem, destino);
+    int p = dispersaoCelula(chave, tabela->cap);
+    for (; tabela->chaves[p]; p = (p + 1) & (tabela->cap - 1)) {
+        if (tabela->chaves[p] == chave + 1) return p;
+    }
+    if (!criar) return -1;
+    tabela->chaves[p] = chave + 1;
+    tabela->estados[p] = 0;
+    return p;
+}
+
+/**
+ * @brief Indica se uma aresta da tabela existe, tendo em conta as remoções de vértices feitas no lote.
+ * @internal
+ * Como em removerVertice, a aresta deixa de existir quando o destino é removido depois da sua última inserção.
+ * @param tabela Tabela de arestas.
+ * @param p Posição da aresta na tabela.
+ * @param destino Código do vértice de destino (não negativo).
+ * @param estadoVertice Estado de cada código (1 = existe, 2 = removido no lote).
+ * @param removidoEm Índice da operação que removeu cada código.
+ * @param maxCod Maior código com estado.
+ * @return int Retorna 1 se a aresta existe, 0 caso contrário.
+ */
+static int arestaExiste(const TabelaArestas* tabela, int p, int destino, const char* estadoVertice, const int* removidoEm, int maxCod) {
+    if (tabela->estados[p] != ARESTA_ORIGINAL && tabela->estados[p] != ARESTA_NOVA) return 0;
+    return destino > maxCod || estadoVertice[destino] != 2 || removidoEm[destino] < tabela->ultima[p];
+}
+
+/**
+ * @brief Aplica as operações de um lote uma a uma, com as funções de inserção e remoção individuais.
+ * @internal
+ * @param grafo O grafo a alterar.
+ * @param operacoes As operações a aplicar.
+ * @param num O número de operações.
+ * @param estados Vetor com espaço para num estados, ou NULL.
+ * @return int Retorna o número de operações aplicadas.
+ */
+static int aplicarUmaAUma(Grafo* grafo, const OperacaoGrafo* operacoes, int num, int* estados) {
+    int aplicadas = 0;
+    for (int i = 0; i < num; i++) {
+        const OperacaoGrafo* op = &operacoes[i];
+        int ok = 0;
+        if (op->tipo == INSERIR_VERTICE) {
+            int codigo = grafo->proximoCodigo;
+            if (adicionarVertice(grafo, op->x, op->y, op->frequencia)) ok = codigo;
+        } else if (op->tipo == REMOVER_VERTICE) {
+            ok = removerVertice(grafo, op->origem);
+        } else if (op->tipo == INSERIR_ARESTA) {
+            ok = adicionarAdjacente(grafo, op->origem, op->destino);
+        } else if (op->tipo == REMOVER_ARESTA) {
+            ok = removerAdjacente(grafo, op->origem, op->destino);
+        }
+        if (estados) estados[i] = ok;
+        aplicadas += ok != 0;
+    }
+    return aplicadas;
+}
+
+/**
+ * @brief Aplica um lote de operações ao grafo, pela ordem dada.
+ * 
+ * O resultado, incluindo os estados, é o mesmo de aplicar as operações uma a uma com adicionarVertice,
+ * removerVertice, adicionarAdjacente e removerAdjacente, mas cada lista só é percorrida uma vez:
+ * as arestas ficam numa tabela de dispersão durante o lote e, no fim, os vértices removidos são
+ * libertados, as adjacências removidas são retiradas e as novas são acrescentadas no fim de cada
+ * lista, pela ordem em que foram inseridas. O custo é linear no tamanho do grafo e do lote.
+ * Como em adicionarAdjacente, uma aresta só é inserida num grafo com pelo menos dois vértices, a partir
+ * de um vértice existente, e o destino pode ser qualquer código não negativo, mesmo sem vértice.
+ * Remover um vértice remove também as arestas que saem dele e que chegam a ele. Num grafo com códigos
+ * negativos ou repetidos, que não admite índice, as operações são mesmo aplicadas uma a uma.
+ * O índice do grafo é descartado e volta a ser criado na próxima inserção ou remoção individual.
+ * 
+ * @param grafo O grafo a alterar.
+ * @param operacoes As operações a aplicar.
+ * @param num O número de operações.
+ * @param estados Vetor com espaço para num estados, ou NULL: 0 se a operação falhou; o código do novo vértice numa inserção de vértice; 1 nas restantes.
+ * @return int Retorna o número de operações aplicadas, ou -1 em caso de erro (o grafo não é alterado).
+ */
+int aplicarLoteGrafo(Grafo* grafo, const OperacaoGrafo* operacoes, int num, int* estados) {
+    if (num < 1) return 0;
+    int maxCod = grafo->proximoCodigo - 1, numArestas = 0, semIndice = 0;
+    Vertice* cauda = NULL;
+    for (Vertice* v = grafo->vertices; v; v = v->prox) {
+        if (v->codigo < 0) semIndice = 1;
+        if (v->codigo > maxCod) maxCod = v->codigo;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) {
+            if (adj->codigo < 0) semIndice = 1;
+            numArestas++;
+        }
+        cauda = v;
+    }
+    if (semIndice) return aplicarUmaAUma(grafo, operacoes, num, estados);
+    maxCod += num;
+
+    // Vértice de cada código (estado 1 = existe, 2 = removido no lote) e tabela de todas as arestas
+    TabelaArestas tabela;
+    tabela.cap = 16;
+    while (tabela.cap < 2 * (numArestas + num)) tabela.cap *= 2;
+    tabela.chaves = (unsigned long long*)calloc(tabela.cap, sizeof(unsigned long long));
+    tabela.estados = (char*)malloc(tabela.cap * sizeof(char));
+    tabela.ultima = (int*)malloc(tabela.cap * sizeof(int));
+    Vertice** porCodigo = (Vertice**)calloc((size_t)maxCod + 1, sizeof(Vertice*));
+    char* estadoVertice = (char*)calloc((size_t)maxCod + 1, sizeof(char));
+    int* removidoEm = (int*)malloc(((size_t)maxCod + 1) * sizeof(int));
+    Adjacente** caudas = (Adjacente**)calloc((size_t)maxCod + 1, sizeof(Adjacente*));
+    int alocado = tabela.chaves && tabela.estados && tabela.ultima && porCodigo && estadoVertice && removidoEm && caudas;
+    if (alocado) {
+        for (Vertice* v = grafo->vertices; v; v = v->prox) {
+            if (porCodigo[v->codigo]) semIndice = 1;
+            porCodigo[v->codigo] = v;
+        }
+    }
+    if (!alocado || semIndice) {
+        if (!alocado) printf("Erro ao alocar memoria!\n");
+        free(tabela.chaves);
+        free(tabela.estados);
+        free(tabela.ultima);
+        free(porCodigo);
+        free(estadoVertice);
+        free(removidoEm);
+        free(caudas);
+        return alocado ? aplicarUmaAUma(grafo, operacoes, num, estados) : -1;
+    }
+    invalidarIndiceGrafo(grafo);
+    for (Vertice* v = grafo->vertices; v; v = v->prox) {
+        estadoVertice[v->codigo] = 1;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) {
+            int p = procurarAresta(&tabela, v->codigo, adj->codigo, 1);
+            tabela.estados[p] = ARESTA_ORIGINAL;
+            tabela.ultima[p] = -1;
+        }
+    }
+
+    int aplicadas = 0, numVertices = grafo->numVertices;
+    for (int i = 0; i < num; i++) {
+        const OperacaoGrafo* op = &operacoes[i];
+        int ok = 0;
+        int origemExiste = op->origem >= 0 && op->origem <= maxCod && estadoVertice[op->origem] == 1;
+        if (op->tipo == INSERIR_VERTICE) {
+            Vertice* novo = criarVertice(grafo->proximoCodigo++, op->x, op->y, op->frequencia);
+            if (novo) {
+                if (!cauda) grafo->vertices = novo;
+                else cauda->prox = novo;
+                cauda = novo;
+                grafo->numVertices++;
+                numVertices++;
+                porCodigo[novo->codigo] = novo;
+                estadoVertice[novo->codigo] = 1;
+                ok = novo->codigo;
+            }
+        } else if (op->tipo == REMOVER_VERTICE && origemExiste) {
+            estadoVertice[op->origem] = 2;
+            removidoEm[op->origem] = i;
+            numVertices--;
+            ok = 1;
+        } else if (op->tipo == INSERIR_ARESTA && numVertices > 1 && origemExiste && op->destino >= 0) {
+            int p = procurarAresta(&tabela, op->origem, op->destino, 1);
+            if (!arestaExiste(&tabela, p, op->destino, estadoVertice, removidoEm, maxCod)) {
+                tabela.estados[p] = ARESTA_NOVA;
+                tabela.ultima[p] = i;
+                ok = 1;
+            }
+        } else if (op->tipo == REMOVER_ARESTA && origemExiste && op->destino >= 0) {
+            int p = procurarAresta(&tabela, op->origem, op->destino, 0);
+            if (p >= 0 && arestaExiste(&tabela, p, op->destino, estadoVertice, removidoEm, maxCod)) {
+                tabela.estados[p] = ARESTA_REMOVIDA;
+                ok = 1;
+            }
+        }
+        if (estados) estados[i] = ok;
+        aplicadas += ok != 0;
+    }
+
+    // Liberta os vértices removidos e retira as adjacências que já não existem
+    Vertice** ligacao = &grafo->vertices;
+    while (*ligacao) {
+        Vertice* v = *ligacao;
+        if (estadoVertice[v->codigo] == 2) {
+            *ligacao = v->prox;
+            for (Adjacente* adj = v->adjacentes; adj; ) {
+                Adjacente* seguinte = adj->prox;
+                free(adj);
+                adj = seguinte;
+            }
+            free(v);
+            grafo->numVertices--;
+            continue;
+        }
+        Adjacente** adjLigacao = &v->adjacentes;
+        Adjacente* ultimo = NULL;
+        while (*adjLigacao) {
+            Adjacente* adj = *adjLigacao;
+            int p = procurarAresta(&tabela, v->codigo, adj->codigo, 0);
+            if (tabela.estados[p] != ARESTA_ORIGINAL || !arestaExiste(&tabela, p, adj->codigo, estadoVertice, removidoEm, maxCod)) {
+                *adjLigacao = adj->prox;
+                free(adj);
+            } else {
+                ultimo = adj;
+                adjLigacao = &adj->prox;
+            }
+        }
+        caudas[v->codigo] = ultimo;
+        ligacao = &v->prox;
+    }
+
+    // Acrescenta as arestas novas no fim das listas, pela ordem da sua última inserção
+    for (int i = 0; i < num; i++) {
+        const OperacaoGrafo* op = &operacoes[i];
+        if (op->tipo != INSERIR_ARESTA || op->destino < 0) continue;
+        if (op->origem < 0 || op->origem > maxCod || estadoVertice[op->origem] != 1) continue;
+        int p = procurarAresta(&tabela, op->origem, op->destino, 0);
+        if (p < 0 || tabela.estados[p] != ARESTA_NOVA || tabela.ultima[p] != i) continue;
+        if (!arestaExiste(&tabela, p, op->destino, estadoVertice, removidoEm, maxCod)) continue;
+        Adjacente* novo = criarAdjacente(op->destino);
+        if (!novo) continue;
+        if (!caudas[op->origem]) porCodigo[op->origem]->adjacentes = novo;
+        else caudas[op->origem]->prox = novo;
+        caudas[op->origem] = novo;
+    }
+
+    free(tabela.chaves);
+    free(tabela.estados);
+    free(tabela.ultima);
+    free(porCodigo);
+    free(estadoVertice);
+    free(removidoEm);
+    free(caudas);
+    return aplicadas;
+}
+
+#pragma endregion
+
+
+
 #pragma region Buscas
 
 
 /**
  * @brief Encontra um vértice no grafo pelo seu código.
  * @internal
- * Esta função percorre todos os vértices do grafo e retorna o vértice que possui o código especificado. Esta função é usada internamente por outras funções e não deve ser chamada diretamente.
+ * Esta função percorre todos os vértices do grafo e retorna o vértice que possui o código especificado (se o grafo tiver índice, consulta-o diretamente). Esta função é usada internamente por outras funções e não deve ser chamada diretamente.
  * 
  * @param grafo O grafo onde procurar o vértice.
  * @param codigo O código do vértice a ser encontrado.
  * @return Vertice* Retorna um apontador para o vértice encontrado ou NULL se não encontrado.
  */
 static Vertice* encontrarVerticePorCod(Grafo grafo, int codigo) {
+    if (grafo.indice) return codigo >= 0 && codigo < grafo.indice->capCodigos ? grafo.indice->porCodigo[codigo] : NULL;
     for (Vertice* atual = grafo.vertices; atual; atual = atual->prox) {
         if (atual->codigo == codigo) {
             return atual;
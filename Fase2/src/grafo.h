@@ -34,7 +34,7 @@ Nefasto criarNefasto(int x, int y);
 /**
  * @brief Cria um novo grafo.
  * 
- * Esta função inicializa um grafo vazio, com 0 vértices.
+ * Esta função inicializa um grafo vazio, com 0 vértices. Os códigos dos vértices de cada grafo começam em 1.
  * 
  * @return Grafo Retorna o grafo criado.
  */
@@ -65,7 +65,8 @@ Adjacente* criarAdjacente(int codigo);
 /**
  * @brief Adiciona um vértice ao grafo.
  * 
- * Esta função cria um novo vértice e o adiciona ao grafo. Se o grafo estiver vazio, o novo vértice se torna o primeiro.
+ * Esta função cria um novo vértice e o adiciona ao fim da lista de vértices. Se o grafo estiver vazio, o novo vértice se torna o primeiro.
+ * Com o índice do grafo, o fim da lista é conhecido e o vértice reaproveita a memória de um vértice removido, se houver.
  * 
  * @param grafo O grafo onde adicionar o vértice.
  * @param x Coordenada x da antena.
@@ -79,7 +80,9 @@ int adicionarVertice(Grafo* grafo, int x, int y, char freq);
 /**
  * @brief Adiciona um vértice adjacente a um vértice existente no grafo.
  * 
- * Esta função percorre todos os vértices do grafo e adiciona o vértice adjacente ao vértice especificado.
+ * Esta função adiciona o vértice adjacente ao fim da lista de adjacências do vértice especificado, se ainda lá não estiver.
+ * Com o índice do grafo, o vértice, a aresta repetida e o fim da lista são encontrados em tempo constante (esperado);
+ * sem ele, percorre os vértices do grafo e a lista de adjacências.
  * 
  * @param grafo O grafo onde adicionar o adjacente.
  * @param vertice O código do vértice onde adicionar o adjacente.
@@ -87,6 +90,39 @@ int adicionarVertice(Grafo* grafo, int x, int y, char freq);
  * @return int Retorna 1 se a operação foi realizada com sucesso, 0 caso contrário.
  */
 int adicionarAdjacente(Grafo* grafo, int vertice, int adjacente);
+/**
+ * @brief Remove um vértice adjacente de um vértice do grafo.
+ * 
+ * A aresta é encontrada pelo índice do grafo e retirada da lista de adjacências em tempo constante (esperado).
+ * O nó da adjacência fica guardado no índice para a próxima inserção.
+ * 
+ * @param grafo O grafo onde remover o adjacente.
+ * @param vertice O código do vértice de onde remover o adjacente.
+ * @param adjacente O código do vértice adjacente a ser removido.
+ * @return int Retorna 1 se a aresta existia e foi removida, 0 caso contrário.
+ */
+int removerAdjacente(Grafo* grafo, int vertice, int adjacente);
+/**
+ * @brief Remove um vértice do grafo, com as arestas que saem dele e que chegam a ele.
+ * 
+ * O índice do grafo guarda, para cada vértice, o vértice anterior na lista e as arestas que chegam a ele,
+ * pelo que o custo é proporcional ao número de arestas do vértice. Os códigos dos restantes vértices não mudam
+ * e o código removido não volta a ser atribuído; a memória do vértice e das adjacências é reaproveitada nas
+ * inserções seguintes.
+ * 
+ * @param grafo O grafo onde remover o vértice.
+ * @param codigo O código do vértice a ser removido.
+ * @return int Retorna 1 se o vértice existia e foi removido, 0 caso contrário.
+ */
+int removerVertice(Grafo* grafo, int codigo);
+/**
+ * @brief Descarta o índice do grafo, que volta a ser criado na próxima inserção ou remoção.
+ * 
+ * Tem de ser chamada antes de qualquer alteração feita diretamente às listas de vértices ou de adjacências.
+ * 
+ * @param grafo O grafo.
+ */
+void invalidarIndiceGrafo(Grafo* grafo);
 /**
  * @brief Escreve o grafo na consola.
  * 
@@ -114,6 +150,69 @@ int libertarGrafo(Grafo* grafo);
  */
 Grafo lerGrafo(const char* nomeFicheiro);
 #pragma endregion
+#pragma region Construção por Proximidade
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando as antenas da mesma frequência a uma distância não superior a raio.
+ * 
+ * As antenas são agrupadas em células de lado raio, pelo que cada antena só é comparada com as das 9 células vizinhas.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param raio A distância euclidiana máxima entre antenas ligadas.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ */
+Grafo lerGrafoRaio(const char* nomeFicheiro, int raio);
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando cada antena às k antenas mais próximas da mesma frequência.
+ * 
+ * As ligações são simétricas: se B é um dos k vizinhos de A, A fica também adjacente a B.
+ * O lado das células é escolhido por frequência para que cada célula tenha cerca de k antenas,
+ * e a procura percorre anéis de células até nenhum anel seguinte poder ter uma antena mais próxima.
+ * Os empates na distância são resolvidos a favor do vértice lido primeiro.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param k O número de vizinhos de cada antena.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ */
+Grafo lerGrafoVizinhos(const char* nomeFicheiro, int k);
+/**
+ * @brief Lê um grafo a partir de um ficheiro, ligando também cada antena às antenas de outras frequências perto dos seus efeitos nefastos.
+ * 
+ * As antenas da mesma frequência ficam ligadas como em lerGrafo. Para cada par (A, B) da mesma frequência, o efeito
+ * nefasto 2A - B (o do lado de A) interfere com as antenas de outras frequências a uma distância euclidiana não
+ * superior a raio (0 para só as que estão em cima do efeito), e A fica adjacente a cada uma delas. A junção é feita
+ * com uma tabela de dispersão de células de lado raio com as antenas de todas as frequências, pelo que cada efeito
+ * só é comparado com as antenas das 9 células à sua volta.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @param raio A distância euclidiana máxima entre um efeito nefasto e as antenas com que interfere.
+ * @return Grafo Retorna o grafo lido do ficheiro, ou um grafo vazio em caso de erro.
+ * @attention As arestas de interferência só vão da antena que causa o efeito para as antenas afetadas.
+ */
+Grafo lerGrafoInterferencia(const char* nomeFicheiro, int raio);
+#pragma endregion
+#pragma region Operações em Lote
+/**
+ * @brief Aplica um lote de operações ao grafo, pela ordem dada.
+ * 
+ * O resultado, incluindo os estados, é o mesmo de aplicar as operações uma a uma com adicionarVertice,
+ * removerVertice, adicionarAdjacente e removerAdjacente, mas cada lista só é percorrida uma vez:
+ * as arestas ficam numa tabela de dispersão durante o lote e, no fim, os vértices removidos são
+ * libertados, as adjacências removidas são retiradas e as novas são acrescentadas no fim de cada
+ * lista, pela ordem em que foram inseridas. O custo é linear no tamanho do grafo e do lote.
+ * Como em adicionarAdjacente, uma aresta só é inserida num grafo com pelo menos dois vértices, a partir
+ * de um vértice existente, e o destino pode ser qualquer código não negativo, mesmo sem vértice.
+ * Remover um vértice remove também as arestas que saem dele e que chegam a ele. Num grafo com códigos
+ * negativos ou repetidos, que não admite índice, as operações são mesmo aplicadas uma a uma.
+ * O índice do grafo é descartado e volta a ser criado na próxima inserção ou remoção individual.
+ * 
+ * @param grafo O grafo a alterar.
+ * @param operacoes As operações a aplicar.
+ * @param num O número de operações.
+ * @param estados Vetor com espaço para num estados, ou NULL: 0 se a operação falhou; o código do novo vértice numa inserção de vértice; 1 nas restantes.
+ * @return int Retorna o número de operações aplicadas, ou -1 em caso de erro (o grafo não é alterado).
+ */
+int aplicarLoteGrafo(Grafo* grafo, const OperacaoGrafo* operacoes, int num, int* estados);
+#pragma endregion
 #pragma region Buscas
 /**
  * @brief Desvisita um vértice do grafo.
@@ -0,0 +1,263 @@
+/**
+ * @file leitor.c
+ * @author Hugo Baptista
+ * @brief Implementação da leitura paralela de ficheiros de mapas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "leitor.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Tamanho do buffer de linha usado por lerGrafo (as linhas maiores são divididas).
+ */
+#define TAMANHO_LINHA 100
+
+/**
+ * @brief Mapeia um ficheiro inteiro em memória, só para leitura.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ler.
+ * @param tamanho Número de bytes do ficheiro (saída).
+ * @return char* Retorna o conteúdo do ficheiro, ou NULL em caso de erro.
+ * @attention Em Windows o ficheiro é lido em modo de texto para um buffer, como faria o fgets.
+ */
+char* mapearFicheiro(const char* nomeFicheiro, size_t* tamanho) {
+    *tamanho = 0;
+#ifdef _WIN32
+    FILE* file = fopen(nomeFicheiro, "r");
+    if (!file) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return NULL;
+    }
+    size_t cap = TAMANHO_BLOCO, lidos;
+    char* dados = (char*)malloc(cap);
+    while (dados && (lidos = fread(dados + *tamanho, 1, cap - *tamanho, file)) > 0) {
+        *tamanho += lidos;
+        if (*tamanho == cap) {
+            char* novo = (char*)realloc(dados, cap * 2);
+            if (!novo) {
+                free(dados);
+                dados = NULL;
+                break;
+            }
+            dados = novo;
+            cap *= 2;
+        }
+    }
+    fclose(file);
+    if (!dados) printf("Erro ao alocar memoria!\n");
+    return dados;
+#else
+    int fd = open(nomeFicheiro, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        printf("Erro ao abrir o ficheiro!\n");
+        if (fd >= 0) close(fd);
+        return NULL;
+    }
+    if (info.st_size == 0) { // mmap não aceita ficheiros vazios
+        close(fd);
+        char* vazio = (char*)calloc(1, 1);
+        if (!vazio) printf("Erro ao alocar memoria!\n");
+        return vazio;
+    }
+    void* dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) {
+        printf("Erro ao abrir o ficheiro!\n");
+        return NULL;
+    }
+    madvise(dados, (size_t)info.st_size, MADV_SEQUENTIAL);
+    *tamanho = (size_t)info.st_size;
+    return (char*)dados;
+#endif
+}
+
+/**
+ * @brief Liberta um ficheiro mapeado com mapearFicheiro.
+ * 
+ * @param dados O conteúdo do ficheiro.
+ * @param tamanho Número de bytes do ficheiro.
+ */
+void libertarFicheiro(char* dados, size_t tamanho) {
+    if (!dados) return;
+#ifdef _WIN32
+    (void)tamanho;
+    free(dados);
+#else
+    if (tamanho == 0) free(dados);
+    else munmap(dados, tamanho);
+#endif
+}
+
+/**
+ * @brief Percorre um bloco de texto com as mesmas linhas que o fgets de lerGrafo produziria.
+ * @internal
+ * Uma linha termina num '\n' ou ao fim de TAMANHO_LINHA - 1 caracteres; um '\0' termina a leitura
+ * da linha atual, como no ciclo de lerGrafo. Sem vetor de destino só conta as linhas e as antenas.
+ * 
+ * @param inicio Início do bloco (início de uma linha).
+ * @param fim Fim do bloco.
+ * @param y0 Número da primeira linha do bloco.
+ * @param codigo0 Código do primeiro vértice do bloco.
+ * @param vetor Vetor onde colocar os vértices do bloco, pela ordem de leitura, ou NULL.
+ * @param numAntenas Número de antenas do bloco (saída).
+ * @return int Retorna o número de linhas do bloco.
+ */
+static int percorrerBloco(const char* inicio, const char* fim, int y0, int codigo0, Vertice** vetor, int* numAntenas) {
+    int linhas = 0, antenas = 0, x = 0, aberta = 0, ativa = 0;
+    for (const char* p = inicio; p < fim; p++) {
+        if (!aberta) {
+            aberta = ativa = 1;
+            x = 0;
+            linhas++;
+        }
+        char c = *p;
+        if (c != '\n') {
+            if (c == '\0') ativa = 0;
+            if (ativa && c != '.' && c != '#') {
+                // Como em adicionarVertice, o código é consumido mesmo que a criação falhe
+                if (vetor) vetor[antenas] = criarVertice(codigo0 + antenas, x, y0 + linhas - 1, c);
+                antenas++;
+            }
+            x++;
+        }
+        if (c == '\n' || x == TAMANHO_LINHA - 1) aberta = 0;
+    }
+    *numAntenas = antenas;
+    return linhas;
+}
+
+/**
+ * @brief Lê um grafo a partir de um ficheiro, lendo blocos do ficheiro em paralelo.
+ * 
+ * O ficheiro é dividido em blocos que começam no início de uma linha. Cada thread conta as linhas e as
+ * antenas dos seus blocos; uma soma de prefixos dá a linha inicial e o código do primeiro vértice de
+ * cada bloco, e cada thread cria os vértices dos seus blocos. As adjacências (todas as antenas da mesma
+ * frequência) são criadas em paralelo por vértice. O resultado é igual ao de lerGrafo, incluindo os
+ * códigos dos vértices, a ordem das adjacências e a divisão das linhas com mais de 99 caracteres.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @return Grafo Retorna o grafo lido do ficheiro.
+ */
+Grafo lerGrafoParalelo(const char* nomeFicheiro) {
+    Grafo grafo = criarGrafo();
+    size_t tamanho;
+    char* dados = mapearFicheiro(nomeFicheiro, &tamanho);
+    if (!dados) return grafo;
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    size_t maxBlocos = tamanho / TAMANHO_BLOCO + 1;
+    int numBlocos = maxBlocos < (size_t)numThreads * 4 ? (int)maxBlocos : numThreads * 4;
+    size_t* inicios = (size_t*)malloc(((size_t)numBlocos + 1) * sizeof(size_t));
+    int* primeiraLinha = (int*)malloc(((size_t)numBlocos + 1) * sizeof(int));
+    int* primeiraAntena = (int*)malloc(((size_t)numBlocos + 1) * sizeof(int));
+    if (!inicios || !primeiraLinha || !primeiraAntena) {
+        printf("Erro ao alocar memoria!\n");
+        free(inicios);
+        free(primeiraLinha);
+        free(primeiraAntena);
+        libertarFicheiro(dados, tamanho);
+        return grafo;
+    }
+
+    // Cada bloco começa depois do primeiro '\n' a partir da sua fração do ficheiro
+    inicios[0] = 0;
+    inicios[numBlocos] = tamanho;
+    for (int b = 1; b < numBlocos; b++) {
+        size_t p = tamanho / numBlocos * b;
+        if (p < inicios[b - 1]) p = inicios[b - 1];
+        const char* nl = p < tamanho ? (const char*)memchr(dados + p, '\n', tamanho - p) : NULL;
+        inicios[b] = nl ? (size_t)(nl - dados) + 1 : tamanho;
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < numBlocos; b++) {
+        primeiraLinha[b + 1] = percorrerBloco(dados + inicios[b], dados + inicios[b + 1], 0, 0, NULL, &primeiraAntena[b + 1]);
+    }
+    primeiraLinha[0] = primeiraAntena[0] = 0;
+    for (int b = 0; b < numBlocos; b++) {
+        primeiraLinha[b + 1] += primeiraLinha[b];
+        primeiraAntena[b + 1] += primeiraAntena[b];
+    }
+    int total = primeiraAntena[numBlocos];
+    Vertice** vetor = (Vertice**)malloc((size_t)(total > 0 ? total : 1) * sizeof(Vertice*));
+    int* membros = (int*)malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (!vetor || !membros) {
+        printf("Erro ao alocar memoria!\n");
+        free(vetor);
+        free(membros);
+        free(inicios);
+        free(primeiraLinha);
+        free(primeiraAntena);
+        libertarFicheiro(dados, tamanho);
+        return grafo;
+    }
+
+    int codigo0 = grafo.proximoCodigo;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < numBlocos; b++) {
+        int num;
+        percorrerBloco(dados + inicios[b], dados + inicios[b + 1], primeiraLinha[b], codigo0 + primeiraAntena[b], vetor + primeiraAntena[b], &num);
+    }
+    grafo.proximoCodigo += total;
+    libertarFicheiro(dados, tamanho);
+
+    // Liga os vértices pela ordem de leitura e agrupa-os por frequência (por ordem crescente de código)
+    int inicioFreq[NUM_FREQUENCIAS + 1] = {0};
+    Vertice** tail = &grafo.vertices;
+    for (int i = 0; i < total; i++) {
+        if (!vetor[i]) continue;
+        *tail = vetor[i];
+        tail = &vetor[i]->prox;
+        grafo.numVertices++;
+        inicioFreq[(unsigned char)vetor[i]->antena.frequencia + 1]++;
+    }
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFreq[f + 1] += inicioFreq[f];
+    int pos[NUM_FREQUENCIAS];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (int i = 0; i < total; i++) {
+        if (vetor[i]) membros[pos[(unsigned char)vetor[i]->antena.frequencia]++] = i;
+    }
+
+    // Em lerGrafo cada vértice fica adjacente a todos os outros da sua frequência, por ordem de código
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < total; i++) {
+        Vertice* v = vetor[i];
+        if (!v) continue;
+        int f = (unsigned char)v->antena.frequencia;
+        Adjacente** cauda = &v->adjacentes;
+        for (int m = inicioFreq[f]; m < inicioFreq[f + 1]; m++) {
+            if (membros[m] == i) continue;
+            Adjacente* novo = criarAdjacente(vetor[membros[m]]->codigo);
+            if (!novo) break;
+            *cauda = novo;
+            cauda = &novo->prox;
+        }
+    }
+
+    free(vetor);
+    free(membros);
+    free(inicios);
+    free(primeiraLinha);
+    free(primeiraAntena);
+    return grafo;
+}
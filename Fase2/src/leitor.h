@@ -0,0 +1,49 @@
+/**
+ * @file leitor.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de leitura paralela de ficheiros de mapas
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Tamanho mínimo de cada bloco do ficheiro lido por uma thread (1 MiB).
+ */
+#define TAMANHO_BLOCO (1 << 20)
+
+/**
+ * @brief Mapeia um ficheiro inteiro em memória, só para leitura.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ler.
+ * @param tamanho Número de bytes do ficheiro (saída).
+ * @return char* Retorna o conteúdo do ficheiro, ou NULL em caso de erro.
+ * @attention Em Windows o ficheiro é lido em modo de texto para um buffer, como faria o fgets.
+ */
+char* mapearFicheiro(const char* nomeFicheiro, size_t* tamanho);
+/**
+ * @brief Liberta um ficheiro mapeado com mapearFicheiro.
+ * 
+ * @param dados O conteúdo do ficheiro.
+ * @param tamanho Número de bytes do ficheiro.
+ */
+void libertarFicheiro(char* dados, size_t tamanho);
+/**
+ * @brief Lê um grafo a partir de um ficheiro, lendo blocos do ficheiro em paralelo.
+ * 
+ * O ficheiro é dividido em blocos que começam no início de uma linha. Cada thread conta as linhas e as
+ * antenas dos seus blocos; uma soma de prefixos dá a linha inicial e o código do primeiro vértice de
+ * cada bloco, e cada thread cria os vértices dos seus blocos. As adjacências (todas as antenas da mesma
+ * frequência) são criadas em paralelo por vértice. O resultado é igual ao de lerGrafo, incluindo os
+ * códigos dos vértices, a ordem das adjacências e a divisão das linhas com mais de 99 caracteres.
+ * 
+ * @param nomeFicheiro O nome do ficheiro a ser lido.
+ * @return Grafo Retorna o grafo lido do ficheiro.
+ */
+Grafo lerGrafoParalelo(const char* nomeFicheiro);
+
+#endif
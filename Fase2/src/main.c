@@ -8,21 +8,29 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "estruturasDados.h"
 #include "grafo.h"
+#include "servidor.h"
 
 
 /**
  * @brief Função principal do programa.
  * 
  * Esta função inicializa o grafo, lê os dados de um ficheiro e executa as operações de busca e listagem de caminhos.
+ * Com o argumento --servidor, carrega o mapa uma vez e responde a comandos no stdin (ou no socket Unix indicado a seguir).
  * 
+ * @param argc Número de argumentos.
+ * @param argv Argumentos do programa.
  * @return int Retorna 0 quando chega ao fim do programa.
  */
-int main() {
+int main(int argc, char* argv[]) {
     
     // Criação de um grafo
     char nomeFicheiro[] = "antenas.txt";
+    if (argc > 1 && strcmp(argv[1], "--servidor") == 0) {
+        return executarServidor(nomeFicheiro, argc > 2 ? argv[2] : NULL) ? 0 : 1;
+    }
     Grafo grafo = lerGrafo(nomeFicheiro);
     
     /* Teste de criação de grafo e adição de vértices e adjacentes
@@ -11,6 +11,26 @@
  * - @ref estruturasDados.h "estruturasDados.h"
  * - @ref grafo.h "grafo.h"
  * - @ref grafo.c "grafo.c"
+ * - @ref saida.h "saida.h"
+ * - @ref saida.c "saida.c"
+ * - @ref leitor.h "leitor.h"
+ * - @ref leitor.c "leitor.c"
+ * - @ref armazem.h "armazem.h"
+ * - @ref armazem.c "armazem.c"
+ * - @ref compacto.h "compacto.h"
+ * - @ref compacto.c "compacto.c"
+ * - @ref travessias.h "travessias.h"
+ * - @ref travessias.c "travessias.c"
+ * - @ref caminhos.h "caminhos.h"
+ * - @ref caminhos.c "caminhos.c"
+ * - @ref morton.h "morton.h"
+ * - @ref morton.c "morton.c"
+ * - @ref cache.h "cache.h"
+ * - @ref cache.c "cache.c"
+ * - @ref alcance.h "alcance.h"
+ * - @ref alcance.c "alcance.c"
+ * - @ref servidor.h "servidor.h"
+ * - @ref servidor.c "servidor.c"
  * - @ref main.c "main.c"
  *
  * Consulte a seção "Files" na barra lateral para ver todos os ficheiros documentados.
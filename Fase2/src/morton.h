@@ -0,0 +1,51 @@
+/**
+ * @file morton.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos da ordenação dos vértices pela curva de Morton (ordem Z)
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef MORTON_H
+#define MORTON_H
+
+#include <stdint.h>
+#include "estruturasDados.h"
+
+/**
+ * @brief Calcula o código de Morton de uma posição.
+ *
+ * Os bits de x ficam nas posições pares e os de y nas ímpares, pelo que posições próximas no mapa
+ * ficam, na maior parte dos casos, com códigos próximos. As coordenadas são deslocadas de 2^31 para
+ * que as negativas fiquem antes das positivas.
+ *
+ * @param x Coordenada x.
+ * @param y Coordenada y.
+ * @return uint64_t Retorna o código de Morton da posição.
+ */
+uint64_t codigoMorton(int x, int y);
+/**
+ * @brief Ordena a lista de vértices pelo código de Morton da posição das antenas (ordem Z).
+ *
+ * Os vértices são religados pela nova ordem sem mudar os códigos nem as adjacências, pelo que o grafo
+ * representa o mesmo; compactarGrafo segue a ordem da lista, pelo que o grafo compacto criado depois
+ * fica com as antenas próximas no mapa em índices próximos. Os códigos são calculados com PDEP quando
+ * o processador tem BMI2 e ordenados com um radix sort estável, em tempo linear. O índice do grafo
+ * é descartado, porque guarda a ordem da lista.
+ *
+ * @param grafo O grafo cujos vértices ordenar.
+ * @return int Retorna 1 se os vértices foram ordenados com sucesso, 0 caso contrário.
+ */
+int ordenarVerticesMorton(Grafo* grafo);
+/**
+ * @brief Cria o grafo compacto de um grafo com os vértices pela ordem de Morton, sem alterar o grafo.
+ *
+ * Igual a ordenarVerticesMorton seguido de compactarGrafo, mas a ordem de Morton só é aplicada ao grafo
+ * compacto: a lista de vértices, as adjacências e o índice do grafo ficam como estavam.
+ *
+ * @param grafo O grafo a compactar.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+GrafoCompacto* compactarGrafoMorton(Grafo grafo);
+
+#endif
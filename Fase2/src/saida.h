@@ -0,0 +1,103 @@
+/**
+ * @file saida.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das funções de escrita em bloco para ficheiros e para a consola
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief TAMANHO_SAIDA Tamanho do buffer de escrita (1 MiB)
+ */
+#define TAMANHO_SAIDA (1 << 20)
+
+/**
+ * @brief Abre uma saída em bloco
+ *
+ * @param saida Saída a inicializar
+ * @param filename Nome do ficheiro a escrever, ou NULL para a consola
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ * @attention Quando a saída é a consola, o buffer do stdio é despejado antes para manter a ordem do texto
+ */
+int abrirSaida(Saida* saida, const char* filename);
+/**
+ * @brief Abre uma saída em bloco para dados binários (sem conversão de fins de linha em Windows)
+ *
+ * @param saida Saída a inicializar
+ * @param filename Nome do ficheiro a escrever
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ */
+int abrirSaidaBinaria(Saida* saida, const char* filename);
+/**
+ * @brief Abre uma saída em bloco sobre um descritor já aberto (por exemplo, um socket)
+ *
+ * @param saida Saída a inicializar
+ * @param fd Descritor de destino (não é fechado por fecharSaida)
+ * @return int 1 se a saída foi aberta com sucesso, 0 caso contrário
+ */
+int abrirSaidaDescritor(Saida* saida, int fd);
+/**
+ * @brief Escreve todo o conteúdo do buffer no destino
+ *
+ * @param saida Saída a despejar
+ * @return int 1 se o buffer foi escrito com sucesso, 0 caso contrário
+ */
+int despejarSaida(Saida* saida);
+/**
+ * @brief Despeja o buffer, fecha o destino e liberta a memória da saída
+ *
+ * @param saida Saída a fechar
+ * @return int 1 se todas as escritas tiveram sucesso, 0 caso contrário
+ */
+int fecharSaida(Saida* saida);
+/**
+ * @brief Escreve um bloco de bytes na saída
+ *
+ * @param saida Saída onde escrever
+ * @param texto Bytes a escrever
+ * @param tamanho Número de bytes a escrever
+ * @return int 1 se os bytes foram escritos com sucesso, 0 caso contrário
+ */
+int escreverBytes(Saida* saida, const char* texto, size_t tamanho);
+/**
+ * @brief Escreve uma string terminada em '\0' na saída
+ *
+ * @param saida Saída onde escrever
+ * @param texto String a escrever
+ * @return int 1 se a string foi escrita com sucesso, 0 caso contrário
+ */
+int escreverTexto(Saida* saida, const char* texto);
+/**
+ * @brief Escreve um caracter na saída
+ *
+ * @param saida Saída onde escrever
+ * @param c Caracter a escrever
+ * @return int 1 se o caracter foi escrito com sucesso, 0 caso contrário
+ */
+int escreverCaracter(Saida* saida, char c);
+/**
+ * @brief Escreve um inteiro em base 10 na saída, sem passar pelo printf
+ *
+ * @param saida Saída onde escrever
+ * @param valor Inteiro a escrever
+ * @return int 1 se o inteiro foi escrito com sucesso, 0 caso contrário
+ */
+int escreverInteiro(Saida* saida, int valor);
+/**
+ * @brief Escreve várias linhas seguidas de '\n' na saída
+ *
+ * As linhas são enviadas diretamente com writev, sem serem copiadas para o buffer.
+ *
+ * @param saida Saída onde escrever
+ * @param linhas Linhas a escrever
+ * @param num Número de linhas
+ * @return int 1 se as linhas foram escritas com sucesso, 0 caso contrário
+ */
+int escreverLinhas(Saida* saida, char** linhas, int num);
+
+#endif
@@ -0,0 +1,613 @@
+/**
+ * @file servidor.c
+ * @author Hugo Baptista
+ * @brief Implementação do modo servidor, que mantém o grafo em memória e responde a comandos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "armazem.h"
+#include "compacto.h"
+#include "travessias.h"
+#include "caminhos.h"
+#include "alcance.h"
+#include "morton.h"
+#include "saida.h"
+#include "servidor.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+/**
+ * @brief Resultado de uma sessão: o cliente continua ligado.
+ */
+#define SESSAO_ATIVA 0
+/**
+ * @brief Resultado de uma sessão: o cliente terminou (SAIR ou fim da entrada).
+ */
+#define SESSAO_TERMINADA 1
+/**
+ * @brief Resultado de uma sessão: foi pedido o fim do servidor (DESLIGAR).
+ */
+#define SERVIDOR_DESLIGADO 2
+
+/**
+ * @brief Estado mantido pelo servidor entre comandos.
+ * @internal
+ */
+typedef struct EstadoServidor {
+    Grafo grafo; /**< Grafo das antenas. */
+    GrafoCompacto* compacto; /**< Grafo compacto usado nas consultas (NULL depois de uma alteração). */
+    FechoAlcance* fecho; /**< Fecho transitivo usado em ALCANCE (NULL depois de uma alteração). */
+    int* ocupantes; /**< Código da antena de cada célula do mapa (0 se a célula está livre). */
+    int linhas, colunas; /**< Dimensões do mapa. */
+} EstadoServidor;
+
+/**
+ * @brief Conta os bits a 1 de uma palavra.
+ * @internal
+ * @param v Palavra.
+ * @return int Retorna o número de bits a 1.
+ */
+static inline int contarBits(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    int n = 0;
+    for (; v; v &= v - 1) n++;
+    return n;
+#endif
+}
+
+/**
+ * @brief Devolve a posição do bit a 1 menos significativo de uma palavra não nula.
+ * @internal
+ * @param v Palavra (diferente de 0).
+ * @return int Retorna a posição do bit menos significativo.
+ */
+static inline int bitMaisBaixo(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int b = 0;
+    while (!(v >> b & 1)) b++;
+    return b;
+#endif
+}
+
+/**
+ * @brief Devolve o grafo compacto atualizado, reconstruindo-o se o grafo foi alterado.
+ * @internal
+ * Os vértices do grafo compacto ficam pela ordem da curva de Morton, para que as travessias percorram os
+ * seus vetores por zonas do mapa; a lista de vértices do grafo não é reordenada, pelo que a ordem das
+ * adjacências e das respostas não depende das consultas anteriores.
+ * @param estado O estado do servidor.
+ * @return GrafoCompacto* Retorna o grafo compacto, ou NULL em caso de erro.
+ */
+static GrafoCompacto* obterCompacto(EstadoServidor* estado) {
+    if (!estado->compacto) estado->compacto = compactarGrafoMorton(estado->grafo);
+    return estado->compacto;
+}
+
+/**
+ * @brief Devolve o fecho transitivo atualizado, criando-o se o grafo foi alterado.
+ * @internal
+ * @param estado O estado do servidor.
+ * @return FechoAlcance* Retorna o fecho, ou NULL se exceder ORCAMENTO_ALCANCE ou em caso de erro.
+ */
+static FechoAlcance* obterFecho(EstadoServidor* estado) {
+    GrafoCompacto* compacto = obterCompacto(estado);
+    if (!estado->fecho && compacto) estado->fecho = criarFechoAlcance(compacto, ORCAMENTO_ALCANCE);
+    return estado->fecho;
+}
+
+/**
+ * @brief Descarta o grafo compacto e o fecho transitivo depois de uma alteração ao grafo.
+ * @internal
+ * @param estado O estado do servidor.
+ */
+static void invalidarConsultas(EstadoServidor* estado) {
+    libertarGrafoCompacto(estado->compacto);
+    estado->compacto = NULL;
+    libertarFechoAlcance(estado->fecho);
+    estado->fecho = NULL;
+}
+
+/**
+ * @brief Escreve "OK", o número de vértices e os seus códigos, terminando a linha.
+ * @internal
+ * @param saida A saída onde escrever.
+ * @param compacto O grafo compacto.
+ * @param indices Os índices dos vértices.
+ * @param num O número de vértices.
+ */
+static void escreverCodigos(Saida* saida, const GrafoCompacto* compacto, const int* indices, int num) {
+    escreverBytes(saida, "OK ", 3);
+    escreverInteiro(saida, num);
+    for (int i = 0; i < num; i++) {
+        escreverCaracter(saida, ' ');
+        escreverInteiro(saida, compacto->codigos[indices[i]]);
+    }
+    escreverCaracter(saida, '\n');
+}
+
+/**
+ * @brief Insere uma antena e liga-a a todas as antenas da mesma frequência, como em lerGrafo.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ * @param freq A frequência da antena.
+ * @param x Coordenada x da antena.
+ * @param y Coordenada y da antena.
+ */
+static void comandoInserir(EstadoServidor* estado, Saida* saida, char freq, int x, int y) {
+    if (freq == '.' || freq == '#' || (unsigned char)freq <= ' ') {
+        escreverTexto(saida, "ERRO frequencia invalida\n");
+        return;
+    }
+    if (x < 0 || y < 0 || x >= estado->colunas || y >= estado->linhas) {
+        escreverTexto(saida, "ERRO posicao fora do mapa\n");
+        return;
+    }
+    size_t celula = (size_t)y * estado->colunas + x;
+    if (estado->ocupantes[celula]) {
+        escreverTexto(saida, "ERRO posicao ocupada\n");
+        return;
+    }
+    if (!adicionarVertice(&estado->grafo, x, y, freq)) {
+        escreverTexto(saida, "ERRO nao foi possivel inserir a antena\n");
+        return;
+    }
+    int codigo = estado->grafo.proximoCodigo - 1;
+    invalidarConsultas(estado);
+
+    // Cada aresta é acrescentada pelo índice do grafo, sem percorrer as listas de adjacências
+    for (Vertice* v = estado->grafo.vertices; v; v = v->prox) {
+        if (v->codigo == codigo || v->antena.frequencia != freq) continue;
+        if (!adicionarAdjacente(&estado->grafo, codigo, v->codigo) || !adicionarAdjacente(&estado->grafo, v->codigo, codigo)) {
+            // Desfaz a inserção, para o grafo não ficar com uma antena só com parte das arestas
+            removerVertice(&estado->grafo, codigo);
+            escreverTexto(saida, "ERRO nao foi possivel ligar a antena\n");
+            return;
+        }
+    }
+    estado->ocupantes[celula] = codigo;
+    escreverBytes(saida, "OK ", 3);
+    escreverInteiro(saida, codigo);
+    escreverCaracter(saida, '\n');
+}
+
+/**
+ * @brief Remove a antena de uma posição do mapa e as suas arestas.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ * @param x Coordenada x da antena.
+ * @param y Coordenada y da antena.
+ */
+static void comandoRemover(EstadoServidor* estado, Saida* saida, int x, int y) {
+    if (x < 0 || y < 0 || x >= estado->colunas || y >= estado->linhas) {
+        escreverTexto(saida, "ERRO posicao fora do mapa\n");
+        return;
+    }
+    size_t celula = (size_t)y * estado->colunas + x;
+    int codigo = estado->ocupantes[celula];
+    if (!codigo) {
+        escreverTexto(saida, "ERRO nao existe antena nessa posicao\n");
+        return;
+    }
+    if (!removerVertice(&estado->grafo, codigo)) {
+        escreverTexto(saida, "ERRO nao foi possivel remover a antena\n");
+        return;
+    }
+    estado->ocupantes[celula] = 0;
+    invalidarConsultas(estado);
+    escreverBytes(saida, "OK ", 3);
+    escreverInteiro(saida, codigo);
+    escreverCaracter(saida, '\n');
+}
+
+/**
+ * @brief Calcula os efeitos nefastos dentro do mapa e escreve-os por ordem de y e depois de x.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ */
+static void comandoNefastos(EstadoServidor* estado, Saida* saida) {
+    GrafoCompacto* compacto = obterCompacto(estado);
+    size_t celulas = (size_t)estado->linhas * estado->colunas, palavras = (celulas + 63) / 64;
+    int n = compacto ? compacto->numVertices : 0;
+    int* grupo = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    uint64_t* mapa = (uint64_t*)calloc(palavras > 0 ? palavras : 1, sizeof(uint64_t));
+    if (!compacto || !grupo || !mapa) {
+        free(grupo);
+        free(mapa);
+        escreverTexto(saida, "ERRO memoria insuficiente\n");
+        return;
+    }
+
+    // Agrupa os vértices por frequência e marca os efeitos de cada par do mesmo grupo
+    int inicioFreq[NUM_FREQUENCIAS + 1] = {0}, pos[NUM_FREQUENCIAS];
+    for (int i = 0; i < n; i++) inicioFreq[(unsigned char)compacto->antenas[i].frequencia + 1]++;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFreq[f + 1] += inicioFreq[f];
+    memcpy(pos, inicioFreq, sizeof(pos));
+    for (int i = 0; i < n; i++) grupo[pos[(unsigned char)compacto->antenas[i].frequencia]++] = i;
+    unsigned linhas = (unsigned)estado->linhas, colunas = (unsigned)estado->colunas;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        for (int i = inicioFreq[f]; i < inicioFreq[f + 1]; i++) {
+            const Antena* a = &compacto->antenas[grupo[i]];
+            for (int j = inicioFreq[f]; j < inicioFreq[f + 1]; j++) {
+                const Antena* b = &compacto->antenas[grupo[j]];
+                int x = 2 * a->x - b->x, y = 2 * a->y - b->y;
+                if (i == j || (unsigned)x >= colunas || (unsigned)y >= linhas) continue;
+                size_t c = (size_t)y * colunas + (unsigned)x;
+                mapa[c / 64] |= 1ULL << (c % 64);
+            }
+        }
+    }
+
+    int total = 0;
+    for (size_t w = 0; w < palavras; w++) total += contarBits(mapa[w]);
+    escreverBytes(saida, "OK ", 3);
+    escreverInteiro(saida, total);
+    for (size_t w = 0; w < palavras; w++) {
+        for (uint64_t m = mapa[w]; m; m &= m - 1) {
+            size_t c = w * 64 + (size_t)bitMaisBaixo(m);
+            escreverCaracter(saida, ' ');
+            escreverInteiro(saida, (int)(c % colunas));
+            escreverCaracter(saida, ',');
+            escreverInteiro(saida, (int)(c / colunas));
+        }
+    }
+    escreverCaracter(saida, '\n');
+    free(grupo);
+    free(mapa);
+}
+
+/**
+ * @brief Escreve os códigos visitados numa busca em largura ou em profundidade.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ * @param codigo O código do vértice inicial.
+ * @param profundidade 1 para a busca em profundidade, 0 para a busca em largura.
+ */
+static void comandoPercurso(EstadoServidor* estado, Saida* saida, int codigo, int profundidade) {
+    GrafoCompacto* compacto = obterCompacto(estado);
+    if (!compacto) {
+        escreverTexto(saida, "ERRO memoria insuficiente\n");
+        return;
+    }
+    int origem = indiceCompacto(compacto, codigo);
+    if (origem < 0) {
+        escreverTexto(saida, "ERRO vertice inexistente\n");
+        return;
+    }
+    int* ordem = (int*)malloc((size_t)compacto->numVertices * sizeof(int));
+    int num = !ordem ? -1 : profundidade ? percursoProfundidade(compacto, origem, ordem) : percursoLargura(compacto, origem, ordem);
+    if (num < 0) escreverTexto(saida, "ERRO memoria insuficiente\n");
+    else escreverCodigos(saida, compacto, ordem, num);
+    free(ordem);
+}
+
+/**
+ * @brief Conta os caminhos entre dois vértices ou escreve o caminho mais curto entre eles.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param contar 1 para contar os caminhos, 0 para o caminho mais curto.
+ */
+static void comandoCaminhos(EstadoServidor* estado, Saida* saida, int inicial, int final, int contar) {
+    GrafoCompacto* compacto = obterCompacto(estado);
+    if (!compacto) {
+        escreverTexto(saida, "ERRO memoria insuficiente\n");
+        return;
+    }
+    int origem = indiceCompacto(compacto, inicial), destino = indiceCompacto(compacto, final);
+    if (origem < 0 || destino < 0) {
+        escreverTexto(saida, "ERRO vertice inexistente\n");
+        return;
+    }
+    if (contar) {
+        if (compacto->antenas[origem].frequencia != compacto->antenas[destino].frequencia) {
+            escreverTexto(saida, "ERRO frequencias diferentes\n");
+            return;
+        }
+        long long total = contarCaminhosParalelo(compacto, inicial, final);
+        if (total < 0) {
+            escreverTexto(saida, "ERRO memoria insuficiente\n");
+            return;
+        }
+        char texto[32];
+        snprintf(texto, sizeof(texto), "OK %lld\n", total);
+        escreverTexto(saida, texto);
+        return;
+    }
+    // As arestas do grafo das antenas são simétricas, pelo que a busca do destino usa as mesmas adjacências
+    int* caminho = (int*)malloc((size_t)compacto->numVertices * sizeof(int));
+    int num = caminho ? caminhoBidirecional(compacto, NULL, inicial, final, caminho) : -1;
+    if (num < 0) {
+        escreverTexto(saida, "ERRO memoria insuficiente\n");
+    } else {
+        escreverBytes(saida, "OK ", 3);
+        escreverInteiro(saida, num);
+        for (int i = 0; i < num; i++) {
+            escreverCaracter(saida, ' ');
+            escreverInteiro(saida, caminho[i]);
+        }
+        escreverCaracter(saida, '\n');
+    }
+    free(caminho);
+}
+
+/**
+ * @brief Indica se um vértice é alcançável a partir de outro, com o fecho transitivo.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ * @param origem O código do vértice de origem.
+ * @param destino O código do vértice de destino.
+ */
+static void comandoAlcance(EstadoServidor* estado, Saida* saida, int origem, int destino) {
+    FechoAlcance* fecho = obterFecho(estado);
+    if (!fecho) {
+        escreverTexto(saida, "ERRO orcamento de memoria excedido\n");
+        return;
+    }
+    int r = alcancavel(fecho, origem, destino);
+    if (r < 0) escreverTexto(saida, "ERRO vertice inexistente\n");
+    else escreverTexto(saida, r ? "OK 1\n" : "OK 0\n");
+}
+
+/**
+ * @brief Escreve o número de vértices, de arestas e as dimensões do mapa.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param saida A saída onde escrever a resposta.
+ */
+static void comandoEstado(EstadoServidor* estado, Saida* saida) {
+    GrafoCompacto* compacto = obterCompacto(estado);
+    if (!compacto) {
+        escreverTexto(saida, "ERRO memoria insuficiente\n");
+        return;
+    }
+    escreverTexto(saida, "OK vertices=");
+    escreverInteiro(saida, compacto->numVertices);
+    escreverTexto(saida, " arestas=");
+    escreverInteiro(saida, compacto->numArestas);
+    escreverTexto(saida, " linhas=");
+    escreverInteiro(saida, estado->linhas);
+    escreverTexto(saida, " colunas=");
+    escreverInteiro(saida, estado->colunas);
+    escreverCaracter(saida, '\n');
+}
+
+/**
+ * @brief Interpreta e responde a uma linha de comando.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param linha A linha de comando (sem o '\n').
+ * @param saida A saída onde escrever a resposta.
+ * @return int Retorna SESSAO_ATIVA, SESSAO_TERMINADA ou SERVIDOR_DESLIGADO.
+ */
+static int responderComando(EstadoServidor* estado, const char* linha, Saida* saida) {
+    char comando[16], freq;
+    int a, b;
+    if (sscanf(linha, "%15s", comando) != 1) return SESSAO_ATIVA; // Linha vazia
+    if (strcmp(comando, "INSERIR") == 0 && sscanf(linha, "%*s %c %d %d", &freq, &a, &b) == 3) {
+        comandoInserir(estado, saida, freq, a, b);
+    } else if (strcmp(comando, "REMOVER") == 0 && sscanf(linha, "%*s %d %d", &a, &b) == 2) {
+        comandoRemover(estado, saida, a, b);
+    } else if (strcmp(comando, "NEFASTOS") == 0) {
+        comandoNefastos(estado, saida);
+    } else if (strcmp(comando, "BFS") == 0 && sscanf(linha, "%*s %d", &a) == 1) {
+        comandoPercurso(estado, saida, a, 0);
+    } else if (strcmp(comando, "DFS") == 0 && sscanf(linha, "%*s %d", &a) == 1) {
+        comandoPercurso(estado, saida, a, 1);
+    } else if (strcmp(comando, "CAMINHOS") == 0 && sscanf(linha, "%*s %d %d", &a, &b) == 2) {
+        comandoCaminhos(estado, saida, a, b, 1);
+    } else if (strcmp(comando, "CAMINHO") == 0 && sscanf(linha, "%*s %d %d", &a, &b) == 2) {
+        comandoCaminhos(estado, saida, a, b, 0);
+    } else if (strcmp(comando, "ALCANCE") == 0 && sscanf(linha, "%*s %d %d", &a, &b) == 2) {
+        comandoAlcance(estado, saida, a, b);
+    } else if (strcmp(comando, "ESTADO") == 0) {
+        comandoEstado(estado, saida);
+    } else if (strcmp(comando, "SAIR") == 0) {
+        escreverTexto(saida, "OK\n");
+        return SESSAO_TERMINADA;
+    } else if (strcmp(comando, "DESLIGAR") == 0) {
+        escreverTexto(saida, "OK\n");
+        return SERVIDOR_DESLIGADO;
+    } else {
+        escreverTexto(saida, "ERRO comando desconhecido\n");
+    }
+    return SESSAO_ATIVA;
+}
+
+/**
+ * @brief Lê e responde a comandos até ao fim da entrada, a SAIR ou a DESLIGAR.
+ * @internal
+ * Cada resposta é enviada assim que é escrita, para o cliente poder esperar por ela.
+ *
+ * @param estado O estado do servidor.
+ * @param entrada De onde ler os comandos.
+ * @param saida Onde escrever as respostas.
+ * @return int Retorna SESSAO_TERMINADA ou SERVIDOR_DESLIGADO.
+ */
+static int atenderSessao(EstadoServidor* estado, FILE* entrada, Saida* saida) {
+    char linha[MAX_COMANDO];
+    while (fgets(linha, sizeof(linha), entrada)) {
+        size_t tamanho = strlen(linha);
+        int resultado = SESSAO_ATIVA;
+        if (tamanho > 0 && linha[tamanho - 1] == '\n') {
+            linha[--tamanho] = '\0';
+            if (tamanho > 0 && linha[tamanho - 1] == '\r') linha[--tamanho] = '\0';
+            resultado = responderComando(estado, linha, saida);
+        } else if (!feof(entrada)) {
+            // Linha demasiado comprida: descarta o resto
+            int ch;
+            while ((ch = fgetc(entrada)) != EOF && ch != '\n');
+            escreverTexto(saida, "ERRO comando demasiado comprido\n");
+        } else {
+            resultado = responderComando(estado, linha, saida);
+        }
+        if (!despejarSaida(saida)) return SESSAO_TERMINADA;
+        if (resultado != SESSAO_ATIVA) return resultado;
+    }
+    return SESSAO_TERMINADA;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Escuta num socket Unix e atende os clientes, um de cada vez, até DESLIGAR.
+ * @internal
+ * @param estado O estado do servidor.
+ * @param caminhoSocket O caminho do socket.
+ * @return int Retorna 1 se o servidor terminou normalmente, 0 em caso de erro.
+ */
+static int escutarSocket(EstadoServidor* estado, const char* caminhoSocket) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (strlen(caminhoSocket) >= sizeof(endereco.sun_path)) {
+        printf("Caminho do socket demasiado comprido!\n");
+        return 0;
+    }
+    strcpy(endereco.sun_path, caminhoSocket);
+    int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0) {
+        printf("Erro ao criar o socket!\n");
+        return 0;
+    }
+    unlink(caminhoSocket);
+    if (bind(servidor, (struct sockaddr*)&endereco, sizeof(endereco)) < 0 || listen(servidor, 8) < 0) {
+        printf("Erro ao criar o socket!\n");
+        close(servidor);
+        return 0;
+    }
+    signal(SIGPIPE, SIG_IGN); // Um cliente que fecha a ligação não termina o servidor
+
+    int resultado = SESSAO_TERMINADA, ok = 1;
+    while (resultado != SERVIDOR_DESLIGADO) {
+        int cliente = accept(servidor, NULL, NULL);
+        if (cliente < 0) {
+            // Só os erros transitórios são repetidos; os restantes (EMFILE, ENFILE, ...) repetir-se-iam sem fim
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            printf("Erro ao aceitar um cliente: %s\n", strerror(errno));
+            ok = 0;
+            break;
+        }
+        FILE* entrada = fdopen(cliente, "r");
+        Saida saida;
+        if (!entrada) {
+            close(cliente);
+            continue;
+        }
+        if (abrirSaidaDescritor(&saida, cliente)) {
+            resultado = atenderSessao(estado, entrada, &saida);
+            fecharSaida(&saida);
+        }
+        fclose(entrada);
+    }
+    close(servidor);
+    unlink(caminhoSocket);
+    return ok;
+}
+#endif
+
+/**
+ * @brief Carrega o mapa uma vez e responde a comandos, um por linha, até ao fim da entrada.
+ *
+ * Os comandos são lidos do stdin, ou de cada cliente de um socket Unix (um cliente de cada vez), e cada
+ * resposta é uma linha que começa por "OK" ou "ERRO":
+ * - INSERIR f x y: insere uma antena e liga-a às antenas da mesma frequência (responde o código);
+ * - REMOVER x y: remove a antena dessa posição e as suas arestas (responde o código);
+ * - NEFASTOS: efeitos nefastos dentro do mapa (número seguido de x,y por y e x);
+ * - BFS c, DFS c: códigos visitados a partir do vértice c (número seguido dos códigos);
+ * - CAMINHOS a b: número de caminhos entre a e b (antenas da mesma frequência), contados em paralelo;
+ * - CAMINHO a b: caminho mais curto entre a e b, por busca bidirecional (número de vértices seguido dos códigos, 0 se não existir);
+ * - ALCANCE a b: 1 se b é alcançável a partir de a, 0 caso contrário (consultado no fecho transitivo);
+ * - ESTADO: número de vértices, de arestas e dimensões do mapa;
+ * - SAIR: termina a sessão do cliente (ou a leitura do stdin); DESLIGAR: termina o servidor.
+ * O grafo compacto e o fecho transitivo usados nas consultas só são reconstruídos depois de uma alteração.
+ * Com o stdin, só as respostas vão para o stdout: as mensagens de erro das funções do grafo vão para o stderr.
+ *
+ * @param nomeFicheiro O nome do ficheiro com o mapa.
+ * @param caminhoSocket O caminho do socket Unix onde escutar, ou NULL para usar o stdin e o stdout.
+ * @return int Retorna 1 se o servidor terminou normalmente, 0 em caso de erro.
+ */
+int executarServidor(const char* nomeFicheiro, const char* caminhoSocket) {
+    ArmazemAntenas* armazem = lerArmazem(nomeFicheiro);
+    if (!armazem) return 0;
+    EstadoServidor estado;
+    estado.linhas = armazem->linhas;
+    estado.colunas = armazem->colunas;
+    estado.grafo = grafoDeArmazem(armazem);
+    estado.compacto = NULL;
+    estado.fecho = NULL;
+    libertarArmazem(armazem);
+    size_t celulas = (size_t)estado.linhas * estado.colunas;
+    estado.ocupantes = (int*)calloc(celulas > 0 ? celulas : 1, sizeof(int));
+    if (!estado.ocupantes) {
+        printf("Erro ao alocar memoria!\n");
+        libertarGrafo(&estado.grafo);
+        return 0;
+    }
+    for (Vertice* v = estado.grafo.vertices; v; v = v->prox) {
+        estado.ocupantes[(size_t)v->antena.y * estado.colunas + v->antena.x] = v->codigo;
+    }
+
+    int ok = 1;
+    if (caminhoSocket) {
+#ifdef _WIN32
+        printf("Sockets Unix nao suportados neste sistema!\n");
+        ok = 0;
+#else
+        ok = escutarSocket(&estado, caminhoSocket);
+#endif
+    } else {
+        Saida saida;
+        int respostas = -1;
+#ifndef _WIN32
+        // As respostas seguem por uma cópia do stdout e o stdout passa a ser o stderr, para que as mensagens
+        // escritas com printf pelas funções do grafo (falta de memória, orçamento do fecho) não se misturem com elas
+        fflush(stdout);
+        respostas = dup(STDOUT_FILENO);
+        if (respostas >= 0 && dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+            close(respostas);
+            respostas = -1;
+        }
+#endif
+        ok = respostas >= 0 ? abrirSaidaDescritor(&saida, respostas) : abrirSaida(&saida, NULL);
+        if (ok) {
+            atenderSessao(&estado, stdin, &saida);
+            ok = fecharSaida(&saida);
+        }
+#ifndef _WIN32
+        if (respostas >= 0) {
+            fflush(stdout);
+            dup2(respostas, STDOUT_FILENO);
+            close(respostas);
+        }
+#endif
+    }
+
+    libertarGrafoCompacto(estado.compacto);
+    libertarFechoAlcance(estado.fecho);
+    free(estado.ocupantes);
+    libertarGrafo(&estado.grafo);
+    return ok;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file servidor.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos do modo servidor, que mantém o grafo em memória e responde a comandos
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Tamanho máximo de uma linha de comando do servidor.
+ */
+#define MAX_COMANDO 256
+
+/**
+ * @brief Carrega o mapa uma vez e responde a comandos, um por linha, até ao fim da entrada.
+ *
+ * Os comandos são lidos do stdin, ou de cada cliente de um socket Unix (um cliente de cada vez), e cada
+ * resposta é uma linha que começa por "OK" ou "ERRO":
+ * - INSERIR f x y: insere uma antena e liga-a às antenas da mesma frequência (responde o código);
+ * - REMOVER x y: remove a antena dessa posição e as suas arestas (responde o código);
+ * - NEFASTOS: efeitos nefastos dentro do mapa (número seguido de x,y por y e x);
+ * - BFS c, DFS c: códigos visitados a partir do vértice c (número seguido dos códigos);
+ * - CAMINHOS a b: número de caminhos entre a e b (antenas da mesma frequência), contados em paralelo;
+ * - CAMINHO a b: caminho mais curto entre a e b, por busca bidirecional (número de vértices seguido dos códigos, 0 se não existir);
+ * - ALCANCE a b: 1 se b é alcançável a partir de a, 0 caso contrário (consultado no fecho transitivo);
+ * - ESTADO: número de vértices, de arestas e dimensões do mapa;
+ * - SAIR: termina a sessão do cliente (ou a leitura do stdin); DESLIGAR: termina o servidor.
+ * O grafo compacto e o fecho transitivo usados nas consultas só são reconstruídos depois de uma alteração.
+ * Com o stdin, só as respostas vão para o stdout: as mensagens de erro das funções do grafo vão para o stderr.
+ *
+ * @param nomeFicheiro O nome do ficheiro com o mapa.
+ * @param caminhoSocket O caminho do socket Unix onde escutar, ou NULL para usar o stdin e o stdout.
+ * @return int Retorna 1 se o servidor terminou normalmente, 0 em caso de erro.
+ */
+int executarServidor(const char* nomeFicheiro, const char* caminhoSocket);
+
+#endif
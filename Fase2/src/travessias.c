@@ -0,0 +1,325 @@
+/**
+ * @file travessias.c
+ * @author Hugo Baptista
+ * @brief Implementação das buscas em largura por níveis (sequencial e paralela) sobre o grafo compacto
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "estruturasDados.h"
+#include "compacto.h"
+#include "travessias.h"
+
+/**
+ * @brief Número de vértices que cada thread junta antes de os acrescentar à próxima fronteira.
+ */
+#define TAMANHO_LOCAL 256
+
+/**
+ * @brief Devolve a posição do bit a 1 menos significativo de uma palavra não nula.
+ * @internal
+ * @param v Palavra (diferente de 0).
+ * @return int Retorna a posição do bit menos significativo.
+ */
+static inline int bitMaisBaixo(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int b = 0;
+    while (!(v >> b & 1)) b++;
+    return b;
+#endif
+}
+
+/**
+ * @brief Calcula a profundidade (número de arestas) de cada vértice a partir de um vértice, com uma busca em largura sequencial.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param profundidades Vetor com espaço para numVertices profundidades (-1 nos vértices não alcançados).
+ * @return int Retorna o número de vértices alcançados, ou -1 em caso de erro.
+ */
+int profundidadesLargura(const GrafoCompacto* compacto, int origem, int* profundidades) {
+    int n = compacto->numVertices;
+    if (origem < 0 || origem >= n) return -1;
+    int* fila = (int*)malloc((size_t)n * sizeof(int));
+    if (!fila) {
+        printf("Erro ao alocar memoria!\n");
+        return -1;
+    }
+    for (int v = 0; v < n; v++) profundidades[v] = -1;
+    int frente = 0, fim = 0;
+    fila[fim++] = origem;
+    profundidades[origem] = 0;
+    while (frente < fim) {
+        int v = fila[frente++];
+        for (int p = compacto->inicio[v]; p < compacto->inicio[v + 1]; p++) {
+            int d = compacto->destinos[p];
+            if (profundidades[d] < 0) {
+                profundidades[d] = profundidades[v] + 1;
+                fila[fim++] = d;
+            }
+        }
+    }
+    free(fila);
+    return fim;
+}
+
+/**
+ * @brief Calcula a profundidade de cada vértice a partir de um vértice, com uma busca em largura paralela por níveis.
+ *
+ * Cada nível é processado por todas as threads. Na busca descendente, cada vértice da fronteira percorre
+ * os seus adjacentes e os vértices são reclamados num conjunto de bits de visitados com operações atómicas.
+ * Quando as arestas a sair da fronteira passam de 1/ALFA_LARGURA das arestas por explorar, a busca passa a
+ * ascendente: cada vértice por visitar procura no transposto um antecessor na fronteira (guardada em bits)
+ * e pára no primeiro. Volta à busca descendente quando a fronteira tem menos de 1/BETA_LARGURA dos vértices.
+ * O resultado é igual ao de profundidadesLargura.
+ *
+ * @param compacto O grafo compacto.
+ * @param transposto O grafo transposto (transporGrafoCompacto), ou NULL para usar só a busca descendente.
+ * @param origem O índice do vértice inicial.
+ * @param profundidades Vetor com espaço para numVertices profundidades (-1 nos vértices não alcançados).
+ * @return int Retorna o número de vértices alcançados, ou -1 em caso de erro.
+ */
+int profundidadesLarguraParalela(const GrafoCompacto* compacto, const GrafoCompacto* transposto, int origem, int* profundidades) {
+    int n = compacto->numVertices;
+    if (origem < 0 || origem >= n) return -1;
+    if (transposto && transposto->numVertices != n) return -1;
+    long palavras = (long)(((size_t)n + 63) / 64);
+    int* fronteira = (int*)malloc((size_t)n * sizeof(int));
+    int* proxima = (int*)malloc((size_t)n * sizeof(int));
+    uint64_t* visitados = (uint64_t*)calloc((size_t)palavras, sizeof(uint64_t));
+    uint64_t* bitsFronteira = transposto ? (uint64_t*)calloc((size_t)palavras, sizeof(uint64_t)) : NULL;
+    uint64_t* bitsProxima = transposto ? (uint64_t*)calloc((size_t)palavras, sizeof(uint64_t)) : NULL;
+    if (!fronteira || !proxima || !visitados || (transposto && (!bitsFronteira || !bitsProxima))) {
+        printf("Erro ao alocar memoria!\n");
+        free(fronteira);
+        free(proxima);
+        free(visitados);
+        free(bitsFronteira);
+        free(bitsProxima);
+        return -1;
+    }
+    const int* inicio = compacto->inicio;
+    const int* destinos = compacto->destinos;
+
+    #pragma omp parallel for schedule(static)
+    for (int v = 0; v < n; v++) profundidades[v] = -1;
+    profundidades[origem] = 0;
+    visitados[origem / 64] |= 1ULL << (origem % 64);
+    fronteira[0] = origem;
+    int numFronteira = 1, alcancados = 1, nivel = 0, ascendente = 0;
+    long long arestasFronteira = inicio[origem + 1] - inicio[origem];
+    long long arestasPorExplorar = compacto->numArestas - arestasFronteira;
+
+    while (numFronteira > 0) {
+        // Escolha da direção (Beamer): a fronteira passa de fila para bits e vice-versa
+        if (transposto && !ascendente && arestasFronteira > arestasPorExplorar / ALFA_LARGURA) {
+            memset(bitsFronteira, 0, (size_t)palavras * sizeof(uint64_t));
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < numFronteira; i++) {
+                int v = fronteira[i];
+                uint64_t* palavra = &bitsFronteira[v / 64];
+                #pragma omp atomic
+                *palavra |= 1ULL << (v % 64);
+            }
+            ascendente = 1;
+        } else if (ascendente && numFronteira < n / BETA_LARGURA) {
+            numFronteira = 0;
+            for (long w = 0; w < palavras; w++) {
+                for (uint64_t m = bitsFronteira[w]; m; m &= m - 1) fronteira[numFronteira++] = (int)(w * 64 + bitMaisBaixo(m));
+            }
+            ascendente = 0;
+        }
+
+        long long novasArestas = 0;
+        int numProxima = 0;
+        if (!ascendente) {
+            // Descendente: os vértices da fronteira reclamam os adjacentes por visitar
+            #pragma omp parallel reduction(+:novasArestas)
+            {
+                int local[TAMANHO_LOCAL], numLocal = 0, pos;
+                #pragma omp for schedule(dynamic, 64)
+                for (int i = 0; i < numFronteira; i++) {
+                    int v = fronteira[i];
+                    for (int p = inicio[v]; p < inicio[v + 1]; p++) {
+                        int d = destinos[p];
+                        uint64_t* palavra = &visitados[d / 64];
+                        uint64_t bit = 1ULL << (d % 64), antes;
+                        #pragma omp atomic read
+                        antes = *palavra;
+                        if (antes & bit) continue;
+                        #pragma omp atomic capture
+                        { antes = *palavra; *palavra |= bit; }
+                        if (antes & bit) continue; // Outra thread chegou primeiro
+                        profundidades[d] = nivel + 1;
+                        novasArestas += inicio[d + 1] - inicio[d];
+                        local[numLocal++] = d;
+                        if (numLocal == TAMANHO_LOCAL) {
+                            #pragma omp atomic capture
+                            { pos = numProxima; numProxima += numLocal; }
+                            memcpy(proxima + pos, local, (size_t)numLocal * sizeof(int));
+                            numLocal = 0;
+                        }
+                    }
+                }
+                if (numLocal > 0) {
+                    #pragma omp atomic capture
+                    { pos = numProxima; numProxima += numLocal; }
+                    memcpy(proxima + pos, local, (size_t)numLocal * sizeof(int));
+                }
+            }
+            int* t = fronteira;
+            fronteira = proxima;
+            proxima = t;
+        } else {
+            // Ascendente: cada palavra de vértices por visitar pertence a uma só thread, sem operações atómicas
+            const int* inicioT = transposto->inicio;
+            const int* antecessores = transposto->destinos;
+            #pragma omp parallel for schedule(dynamic, 16) reduction(+:novasArestas, numProxima)
+            for (long w = 0; w < palavras; w++) {
+                uint64_t novos = 0;
+                for (uint64_t m = ~visitados[w]; m; m &= m - 1) {
+                    int v = (int)(w * 64 + bitMaisBaixo(m));
+                    if (v >= n) break;
+                    for (int p = inicioT[v]; p < inicioT[v + 1]; p++) {
+                        int u = antecessores[p];
+                        if (bitsFronteira[u / 64] >> (u % 64) & 1) {
+                            novos |= 1ULL << (v % 64);
+                            profundidades[v] = nivel + 1;
+                            novasArestas += inicio[v + 1] - inicio[v];
+                            numProxima++;
+                            break;
+                        }
+                    }
+                }
+                bitsProxima[w] = novos;
+                visitados[w] |= novos;
+            }
+            uint64_t* t = bitsFronteira;
+            bitsFronteira = bitsProxima;
+            bitsProxima = t;
+        }
+        numFronteira = numProxima;
+        alcancados += numProxima;
+        arestasFronteira = novasArestas;
+        arestasPorExplorar -= novasArestas;
+        nivel++;
+    }
+
+    free(fronteira);
+    free(proxima);
+    free(visitados);
+    free(bitsFronteira);
+    free(bitsProxima);
+    return alcancados;
+}
+
+/**
+ * @brief Procura um caminho com o menor número de arestas entre dois vértices, com uma busca em largura bidirecional.
+ *
+ * São feitas duas buscas em largura, uma a partir de cada extremo (a do destino segue as arestas ao
+ * contrário), e em cada passo é expandido um nível inteiro do lado com a fronteira mais pequena. A busca
+ * termina no fim do primeiro nível em que as duas se encontram, pelo que só é explorada a vizinhança
+ * dos dois extremos até metade da distância. Os vetores de marcação são criados com calloc, pelo que
+ * só são tocadas as páginas dos vértices visitados.
+ *
+ * @param compacto O grafo compacto.
+ * @param transposto O grafo transposto (transporGrafoCompacto), ou NULL se o grafo for simétrico (como o das antenas).
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param caminho Vetor com espaço para numVertices códigos, onde fica o caminho (do vértice inicial ao final).
+ * @return int Retorna o número de vértices do caminho (a distância mais 1), 0 se não existir caminho, ou -1 se um dos vértices não existir ou em caso de erro.
+ */
+int caminhoBidirecional(const GrafoCompacto* compacto, const GrafoCompacto* transposto, int inicial, int final, int* caminho) {
+    int origem = indiceCompacto(compacto, inicial), destino = indiceCompacto(compacto, final);
+    if (origem < 0 || destino < 0) return -1;
+    if (transposto && transposto->numVertices != compacto->numVertices) return -1;
+    if (origem == destino) {
+        caminho[0] = inicial;
+        return 1;
+    }
+    int n = compacto->numVertices;
+    const GrafoCompacto* lados[2] = { compacto, transposto ? transposto : compacto };
+    // pai[s][v] e dist[s][v] guardam o valor mais 1, para que 0 signifique "não visitado"
+    int* pai[2], *dist[2], *fila[2];
+    int frente[2] = { 0, 0 }, fim[2] = { 1, 1 };
+    int erro = 0;
+    for (int s = 0; s < 2; s++) {
+        pai[s] = (int*)calloc((size_t)n, sizeof(int));
+        dist[s] = (int*)calloc((size_t)n, sizeof(int));
+        fila[s] = (int*)malloc((size_t)n * sizeof(int));
+        if (!pai[s] || !dist[s] || !fila[s]) erro = 1;
+    }
+    if (erro) {
+        printf("Erro ao alocar memoria!\n");
+        for (int s = 0; s < 2; s++) {
+            free(pai[s]);
+            free(dist[s]);
+            free(fila[s]);
+        }
+        return -1;
+    }
+    fila[0][0] = origem;
+    pai[0][origem] = origem + 1;
+    dist[0][origem] = 1;
+    fila[1][0] = destino;
+    pai[1][destino] = destino + 1;
+    dist[1][destino] = 1;
+
+    // Aresta a -> b onde as buscas se encontram (a do lado da origem, b do lado do destino)
+    int melhor = -1, a = -1, b = -1;
+    while (melhor < 0 && frente[0] < fim[0] && frente[1] < fim[1]) {
+        int s = fim[0] - frente[0] <= fim[1] - frente[1] ? 0 : 1;
+        const GrafoCompacto* g = lados[s];
+        int* paiOutro = pai[1 - s];
+        int fimNivel = fim[s];
+        for (; frente[s] < fimNivel; frente[s]++) {
+            int v = fila[s][frente[s]];
+            for (int p = g->inicio[v]; p < g->inicio[v + 1]; p++) {
+                int d = g->destinos[p];
+                if (paiOutro[d]) {
+                    int total = dist[s][v] + dist[1 - s][d] - 1;
+                    if (melhor < 0 || total < melhor) {
+                        melhor = total;
+                        a = s == 0 ? v : d;
+                        b = s == 0 ? d : v;
+                    }
+                }
+                if (!pai[s][d]) {
+                    pai[s][d] = v + 1;
+                    dist[s][d] = dist[s][v] + 1;
+                    fila[s][fim[s]++] = d;
+                }
+            }
+        }
+    }
+
+    int tamanho = 0;
+    if (melhor >= 0) {
+        // Da origem até a (pelos pais da busca direta, invertido) e de b até ao destino
+        for (int v = a; ; v = pai[0][v] - 1) {
+            caminho[tamanho++] = compacto->codigos[v];
+            if (v == origem) break;
+        }
+        for (int i = 0, j = tamanho - 1; i < j; i++, j--) {
+            int t = caminho[i];
+            caminho[i] = caminho[j];
+            caminho[j] = t;
+        }
+        for (int v = b; ; v = pai[1][v] - 1) {
+            caminho[tamanho++] = compacto->codigos[v];
+            if (v == destino) break;
+        }
+    }
+    for (int s = 0; s < 2; s++) {
+        free(pai[s]);
+        free(dist[s]);
+        free(fila[s]);
+    }
+    return tamanho;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file travessias.h
+ * @author Hugo Baptista
+ * @brief Cabeçalhos das buscas em largura por níveis (sequencial e paralela) sobre o grafo compacto
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef TRAVESSIAS_H
+#define TRAVESSIAS_H
+
+#include "estruturasDados.h"
+
+/**
+ * @brief Divisor da heurística de passagem para a busca ascendente (alfa de Beamer).
+ */
+#define ALFA_LARGURA 14
+/**
+ * @brief Divisor da heurística de regresso à busca descendente (beta de Beamer).
+ */
+#define BETA_LARGURA 24
+
+/**
+ * @brief Calcula a profundidade (número de arestas) de cada vértice a partir de um vértice, com uma busca em largura sequencial.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice inicial.
+ * @param profundidades Vetor com espaço para numVertices profundidades (-1 nos vértices não alcançados).
+ * @return int Retorna o número de vértices alcançados, ou -1 em caso de erro.
+ */
+int profundidadesLargura(const GrafoCompacto* compacto, int origem, int* profundidades);
+/**
+ * @brief Calcula a profundidade de cada vértice a partir de um vértice, com uma busca em largura paralela por níveis.
+ *
+ * Cada nível é processado por todas as threads. Na busca descendente, cada vértice da fronteira percorre
+ * os seus adjacentes e os vértices são reclamados num conjunto de bits de visitados com operações atómicas.
+ * Quando as arestas a sair da fronteira passam de 1/ALFA_LARGURA das arestas por explorar, a busca passa a
+ * ascendente: cada vértice por visitar procura no transposto um antecessor na fronteira (guardada em bits)
+ * e pára no primeiro. Volta à busca descendente quando a fronteira tem menos de 1/BETA_LARGURA dos vértices.
+ * O resultado é igual ao de profundidadesLargura.
+ *
+ * @param compacto O grafo compacto.
+ * @param transposto O grafo transposto (transporGrafoCompacto), ou NULL para usar só a busca descendente.
+ * @param origem O índice do vértice inicial.
+ * @param profundidades Vetor com espaço para numVertices profundidades (-1 nos vértices não alcançados).
+ * @return int Retorna o número de vértices alcançados, ou -1 em caso de erro.
+ */
+int profundidadesLarguraParalela(const GrafoCompacto* compacto, const GrafoCompacto* transposto, int origem, int* profundidades);
+/**
+ * @brief Procura um caminho com o menor número de arestas entre dois vértices, com uma busca em largura bidirecional.
+ *
+ * São feitas duas buscas em largura, uma a partir de cada extremo (a do destino segue as arestas ao
+ * contrário), e em cada passo é expandido um nível inteiro do lado com a fronteira mais pequena. A busca
+ * termina no fim do primeiro nível em que as duas se encontram, pelo que só é explorada a vizinhança
+ * dos dois extremos até metade da distância. Os vetores de marcação são criados com calloc, pelo que
+ * só são tocadas as páginas dos vértices visitados.
+ *
+ * @param compacto O grafo compacto.
+ * @param transposto O grafo transposto (transporGrafoCompacto), ou NULL se o grafo for simétrico (como o das antenas).
+ * @param inicial O código do vértice inicial.
+ * @param final O código do vértice final.
+ * @param caminho Vetor com espaço para numVertices códigos, onde fica o caminho (do vértice inicial ao final).
+ * @return int Retorna o número de vértices do caminho (a distância mais 1), 0 se não existir caminho, ou -1 se um dos vértices não existir ou em caso de erro.
+ */
+int caminhoBidirecional(const GrafoCompacto* compacto, const GrafoCompacto* transposto, int inicial, int final, int* caminho);
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file teste.h
+ * @author Hugo Baptista
+ * @brief Utilitários partilhados pelos testes: contagem de falhas, gerador reprodutível e comparação de grafos.
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+#include "estruturasDados.h"
+
+/**
+ * @brief Número de verificações que falharam (cada teste é um programa com um só ficheiro).
+ */
+static int falhas = 0;
+
+/**
+ * @brief Verifica uma condição e escreve a linha de cada verificação que falha.
+ */
+#define VERIFICAR(condicao) do { if (!(condicao)) { printf("FALHOU %s:%d: %s\n", __FILE__, __LINE__, #condicao); falhas++; } } while (0)
+
+/**
+ * @brief Gerador pseudo-aleatório (xorshift), para os testes serem reprodutíveis.
+ *
+ * @param estado Estado do gerador (diferente de 0).
+ * @return unsigned int Retorna o próximo número.
+ */
+static inline unsigned int aleatorio(unsigned int* estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+/**
+ * @brief Indica se dois grafos são iguais, incluindo a ordem dos vértices, os códigos e a ordem das adjacências.
+ *
+ * @param a O primeiro grafo.
+ * @param b O segundo grafo.
+ * @return int Retorna 1 se os grafos são iguais, 0 caso contrário.
+ */
+static inline int grafosIguais(Grafo a, Grafo b) {
+    if (a.numVertices != b.numVertices || a.proximoCodigo != b.proximoCodigo) return 0;
+    Vertice* va = a.vertices, *vb = b.vertices;
+    for (; va && vb; va = va->prox, vb = vb->prox) {
+        if (va->codigo != vb->codigo || va->antena.frequencia != vb->antena.frequencia ||
+            va->antena.x != vb->antena.x || va->antena.y != vb->antena.y) return 0;
+        Adjacente* aa = va->adjacentes, *ab = vb->adjacentes;
+        for (; aa && ab; aa = aa->prox, ab = ab->prox) {
+            if (aa->codigo != ab->codigo) return 0;
+        }
+        if (aa || ab) return 0;
+    }
+    return !va && !vb;
+}
+
+/**
+ * @brief Escreve o resultado de um teste.
+ *
+ * @param nome O nome do teste.
+ * @return int Retorna o código de saída do teste: 0 se nenhuma verificação falhou, 1 caso contrário.
+ */
+static inline int terminarTeste(const char* nome) {
+    printf("%s: %s\n", nome, falhas ? "FALHOU" : "OK");
+    return falhas ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file teste_armazem.c
+ * @author Hugo Baptista
+ * @brief Testes do armazém de antenas (um vetor por campo), comparado com lerGrafo
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "armazem.h"
+#include "teste.h"
+
+/**
+ * @brief Ficheiro temporário com o mapa.
+ */
+#define FICHEIRO_MAPA "teste_armazem_mapa.tmp"
+
+/**
+ * @brief O armazém lido de um ficheiro dá o mesmo grafo que lerGrafo e conta as linhas como fins de linha mais 1.
+ */
+static void testarIgualLerGrafo(void) {
+    unsigned int semente = 4036;
+    // Até 98 colunas: lerGrafo divide as linhas com 99 caracteres ou mais, e o armazém não
+    for (int caso = 0; caso < 60; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 60), colunas = 1 + (int)(aleatorio(&semente) % 98);
+        int fimDeLinha = caso % 2, percentagem = 2 + (int)(aleatorio(&semente) % 10);
+        FILE* file = fopen(FICHEIRO_MAPA, "w");
+        for (int y = 0; y < linhas; y++) {
+            for (int x = 0; x < colunas; x++) {
+                unsigned int r = aleatorio(&semente) % 100;
+                fputc(r < (unsigned)percentagem ? "aAb0"[aleatorio(&semente) % 4] : r == 99 ? '#' : '.', file);
+            }
+            if (y + 1 < linhas || fimDeLinha) fputc('\n', file);
+        }
+        fclose(file);
+
+        ArmazemAntenas* armazem = lerArmazem(FICHEIRO_MAPA);
+        VERIFICAR(armazem != NULL);
+        if (!armazem) continue;
+        // Um fim de linha no fim do ficheiro abre uma linha vazia
+        VERIFICAR(armazem->linhas == linhas + fimDeLinha && armazem->colunas == colunas);
+        Grafo esperado = lerGrafo(FICHEIRO_MAPA);
+        Grafo obtido = grafoDeArmazem(armazem);
+        if (!grafosIguais(esperado, obtido)) {
+            printf("FALHOU caso %d (%dx%d, fim de linha %d): grafos diferentes\n", caso, colunas, linhas, fimDeLinha);
+            falhas++;
+        }
+        libertarGrafo(&esperado);
+        libertarGrafo(&obtido);
+        libertarArmazem(armazem);
+    }
+    remove(FICHEIRO_MAPA);
+}
+
+int main(void) {
+    testarIgualLerGrafo();
+    return terminarTeste("teste_armazem");
+}
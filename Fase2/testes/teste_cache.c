@@ -0,0 +1,330 @@
+/**
+ * @file teste_cache.c
+ * @author Hugo Baptista
+ * @brief Testes da cache persistente de resultados, comparada com a leitura sem cache
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "cache.h"
+#include "teste.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <time.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Ficheiro temporário com o mapa.
+ */
+#define FICHEIRO_MAPA "teste_cache_mapa.tmp"
+/**
+ * @brief Diretório temporário da cache.
+ */
+#define DIRETORIO_CACHE "teste_cache_dir.tmp"
+/**
+ * @brief Segundo diretório temporário, só para medir o tamanho de um ficheiro da cache.
+ */
+#define DIRETORIO_MEDIR "teste_cache_medir.tmp"
+/**
+ * @brief Tamanho máximo de um caminho nos testes.
+ */
+#define TAMANHO_CAMINHO 512
+
+/**
+ * @brief Escreve um mapa aleatório num ficheiro, com pelo menos uma antena.
+ *
+ * @param nomeFicheiro O nome do ficheiro.
+ * @param linhas Número de linhas.
+ * @param colunas Número de colunas.
+ * @param semente Estado do gerador.
+ */
+static void escreverMapa(const char* nomeFicheiro, int linhas, int colunas, unsigned int* semente) {
+    FILE* file = fopen(nomeFicheiro, "w");
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            int antena = (x == 0 && y == 0) || aleatorio(semente) % 10 == 0;
+            fputc(antena ? "aAb0"[aleatorio(semente) % 4] : '.', file);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Remove os ficheiros de um diretório e o próprio diretório, se existir.
+ *
+ * @param diretorio Diretório a remover.
+ */
+static void removerDiretorio(const char* diretorio) {
+    DIR* dir = opendir(diretorio);
+    if (!dir) return;
+    struct dirent* e;
+    char caminho[TAMANHO_CAMINHO];
+    while ((e = readdir(dir))) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, e->d_name);
+        remove(caminho);
+    }
+    closedir(dir);
+    rmdir(diretorio);
+}
+
+/**
+ * @brief Procura um ficheiro da cache que não seja nenhum dos conhecidos.
+ *
+ * @param diretorio Diretório da cache.
+ * @param conhecidos Caminhos a ignorar.
+ * @param numConhecidos Número de caminhos a ignorar.
+ * @param caminho Caminho do ficheiro encontrado (saída).
+ * @return int Retorna o número de ficheiros da cache no diretório que não são conhecidos.
+ */
+static int ficheiroCache(const char* diretorio, char conhecidos[][TAMANHO_CAMINHO], int numConhecidos, char* caminho) {
+    DIR* dir = opendir(diretorio);
+    if (!dir) return 0;
+    int num = 0;
+    size_t tamExtensao = strlen(EXTENSAO_CACHE);
+    struct dirent* e;
+    char atual[TAMANHO_CAMINHO];
+    while ((e = readdir(dir))) {
+        size_t tam = strlen(e->d_name);
+        if (tam <= tamExtensao || strcmp(e->d_name + tam - tamExtensao, EXTENSAO_CACHE) != 0) continue;
+        snprintf(atual, sizeof(atual), "%s/%s", diretorio, e->d_name);
+        int conhecido = 0;
+        for (int i = 0; i < numConhecidos; i++) conhecido |= strcmp(atual, conhecidos[i]) == 0;
+        if (conhecido) continue;
+        if (num++ == 0) strcpy(caminho, atual);
+    }
+    closedir(dir);
+    return num;
+}
+
+/**
+ * @brief Tamanho de um ficheiro.
+ *
+ * @param caminho Caminho do ficheiro.
+ * @return long long Retorna o número de bytes do ficheiro, ou -1 se não existir.
+ */
+static long long tamanhoFicheiro(const char* caminho) {
+    struct stat info;
+    return stat(caminho, &info) == 0 ? (long long)info.st_size : -1;
+}
+
+/**
+ * @brief Recua a data de modificação de um ficheiro.
+ *
+ * @param caminho Caminho do ficheiro.
+ * @param segundos Número de segundos a recuar.
+ */
+static void envelhecer(const char* caminho, int segundos) {
+    struct utimbuf datas;
+    datas.actime = datas.modtime = time(NULL) - segundos;
+    utime(caminho, &datas);
+}
+
+/**
+ * @brief Reescreve um ficheiro com os primeiros bytes e, opcionalmente, um byte trocado.
+ *
+ * @param caminho Caminho do ficheiro.
+ * @param tamanho Número de bytes a manter (ou mais, para acrescentar zeros).
+ * @param trocar Posição do byte a trocar, ou -1 para não trocar nenhum.
+ */
+static void reescrever(const char* caminho, long long tamanho, long long trocar) {
+    long long original = tamanhoFicheiro(caminho);
+    unsigned char* dados = (unsigned char*)calloc((size_t)(tamanho > original ? tamanho : original) + 1, 1);
+    FILE* file = fopen(caminho, "rb");
+    if (!dados || !file) {
+        free(dados);
+        if (file) fclose(file);
+        return;
+    }
+    size_t lidos = fread(dados, 1, (size_t)original, file);
+    fclose(file);
+    (void)lidos;
+    if (trocar >= 0 && trocar < tamanho) dados[trocar] ^= 1;
+    file = fopen(caminho, "wb");
+    fwrite(dados, 1, (size_t)tamanho, file);
+    fclose(file);
+    free(dados);
+}
+
+/**
+ * @brief Corre lerGrafoCache e compara o grafo com o lido sem cache.
+ *
+ * @param diretorio Diretório da cache.
+ * @param limite Tamanho máximo da cache.
+ * @param esperado Valor esperado de reaproveitado (1 se o grafo vem da cache, 0 se é lido do mapa).
+ * @param descricao Descrição do caso, para as mensagens de falha.
+ */
+static void compararSemCache(const char* diretorio, size_t limite, int esperado, const char* descricao) {
+    int reaproveitado = -1, reaproveitadoSemCache = -1;
+    Grafo semCache = lerGrafoCache(FICHEIRO_MAPA, NULL, limite, &reaproveitadoSemCache);
+    Grafo grafo = lerGrafoCache(FICHEIRO_MAPA, diretorio, limite, &reaproveitado);
+    if (reaproveitadoSemCache != 0 || reaproveitado != esperado || semCache.numVertices == 0 || !grafosIguais(grafo, semCache)) {
+        printf("FALHOU %s: reaproveitado %d, esperado %d\n", descricao, reaproveitado, esperado);
+        falhas++;
+    }
+    libertarGrafo(&grafo);
+    libertarGrafo(&semCache);
+}
+
+/**
+ * @brief O grafo reaproveitado é igual ao lido sem cache, em 20 mapas, e a variável VARIAVEL_SEM_CACHE
+ * faz ignorar a cache.
+ */
+static void testarReaproveitamento(void) {
+    unsigned int semente = 4404;
+    char descricao[64];
+    for (int caso = 0; caso < 20; caso++) {
+        removerDiretorio(DIRETORIO_CACHE);
+        escreverMapa(FICHEIRO_MAPA, 1 + (int)(aleatorio(&semente) % 40), 1 + (int)(aleatorio(&semente) % 60), &semente);
+        snprintf(descricao, sizeof(descricao), "mapa %d, primeira leitura", caso);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, descricao);
+        snprintf(descricao, sizeof(descricao), "mapa %d, leitura da cache", caso);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, descricao);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, descricao);
+    }
+    setenv(VARIAVEL_SEM_CACHE, "1", 1);
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, VARIAVEL_SEM_CACHE);
+    unsetenv(VARIAVEL_SEM_CACHE);
+    removerDiretorio(DIRETORIO_CACHE);
+}
+
+/**
+ * @brief Alterar o mapa (com o mesmo tamanho) invalida o grafo guardado, e repor o mapa volta a aproveitá-lo.
+ */
+static void testarMapaAlterado(void) {
+    unsigned int semente = 4405;
+    removerDiretorio(DIRETORIO_CACHE);
+    escreverMapa(FICHEIRO_MAPA, 20, 30, &semente);
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, "mapa original");
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, "mapa original da cache");
+    long long tamanho = tamanhoFicheiro(FICHEIRO_MAPA);
+    for (long long posicao = 1; posicao < 6; posicao++) {
+        // Troca uma célula ('.' <-> 'b'), sem mudar o tamanho do ficheiro
+        FILE* file = fopen(FICHEIRO_MAPA, "r+b");
+        fseek(file, (long)posicao, SEEK_SET);
+        int c = fgetc(file);
+        fseek(file, (long)posicao, SEEK_SET);
+        fputc(c == '.' ? 'b' : '.', file);
+        fclose(file);
+        VERIFICAR(tamanhoFicheiro(FICHEIRO_MAPA) == tamanho);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, "mapa alterado");
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, "mapa alterado da cache");
+        file = fopen(FICHEIRO_MAPA, "r+b");
+        fseek(file, (long)posicao, SEEK_SET);
+        fputc(c, file);
+        fclose(file);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, "mapa reposto");
+    }
+    removerDiretorio(DIRETORIO_CACHE);
+}
+
+/**
+ * @brief Um ficheiro da cache truncado, corrompido ou com bytes a mais é ignorado, o grafo é lido de novo
+ * e o ficheiro é reescrito.
+ */
+static void testarFicheiroCorrompido(void) {
+    unsigned int semente = 4406;
+    removerDiretorio(DIRETORIO_CACHE);
+    escreverMapa(FICHEIRO_MAPA, 25, 35, &semente);
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, "antes de corromper");
+    char caminho[TAMANHO_CAMINHO];
+    VERIFICAR(ficheiroCache(DIRETORIO_CACHE, NULL, 0, caminho) == 1);
+    long long tamanho = tamanhoFicheiro(caminho);
+    VERIFICAR(tamanho > 64);
+    // Tamanho a manter e byte a trocar: vazio, cabeçalho incompleto, corpo truncado, número mágico, número de
+    // vértices, última adjacência (de modo a continuar válido) e um byte a mais
+    long long casos[][2] = {
+        { 0, -1 }, { 10, -1 }, { tamanho / 2, -1 }, { tamanho - 1, -1 },
+        { tamanho, 0 }, { tamanho, 40 }, { tamanho, tamanho - 4 }, { tamanho + 1, -1 },
+    };
+    char descricao[64];
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        reescrever(caminho, casos[i][0], casos[i][1]);
+        snprintf(descricao, sizeof(descricao), "ficheiro corrompido %d", (int)i);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, descricao);
+        VERIFICAR(tamanhoFicheiro(caminho) == tamanho);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, descricao);
+    }
+    removerDiretorio(DIRETORIO_CACHE);
+}
+
+/**
+ * @brief Quando a cache passa do limite são removidos os ficheiros menos usados, contando o reaproveitamento como uso.
+ */
+static void testarLimite(void) {
+    unsigned int semente = 4407;
+    char caminhos[3][TAMANHO_CAMINHO];
+    removerDiretorio(DIRETORIO_CACHE);
+    removerDiretorio(DIRETORIO_MEDIR);
+    VERIFICAR(limitarCache(DIRETORIO_CACHE, 0) == -1);
+
+    // Três mapas A, B e C
+    unsigned int sementes[3];
+    for (int i = 0; i < 3; i++) sementes[i] = aleatorio(&semente);
+    for (int i = 0; i < 2; i++) {
+        unsigned int s = sementes[i];
+        escreverMapa(FICHEIRO_MAPA, 15, 20, &s);
+        compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, "limite, primeira leitura");
+        VERIFICAR(ficheiroCache(DIRETORIO_CACHE, caminhos, i, caminhos[i]) == 1);
+    }
+    envelhecer(caminhos[0], 100);
+    envelhecer(caminhos[1], 50);
+
+    // Reaproveitar A torna-o o mais recente, e então o menos usado é B
+    unsigned int s = sementes[0];
+    escreverMapa(FICHEIRO_MAPA, 15, 20, &s);
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 1, "limite, leitura de A");
+
+    // O tamanho do ficheiro de C, medido noutro diretório
+    s = sementes[2];
+    escreverMapa(FICHEIRO_MAPA, 15, 20, &s);
+    compararSemCache(DIRETORIO_MEDIR, LIMITE_CACHE, 0, "limite, medir C");
+    VERIFICAR(ficheiroCache(DIRETORIO_MEDIR, NULL, 0, caminhos[2]) == 1);
+    long long tamanhoC = tamanhoFicheiro(caminhos[2]);
+    removerDiretorio(DIRETORIO_MEDIR);
+
+    // Com espaço só para A e C, guardar C remove B
+    size_t limite = (size_t)(tamanhoFicheiro(caminhos[0]) + tamanhoC);
+    compararSemCache(DIRETORIO_CACHE, limite, 0, "limite, primeira leitura de C");
+    VERIFICAR(tamanhoFicheiro(caminhos[0]) > 0 && tamanhoFicheiro(caminhos[1]) == -1);
+    VERIFICAR(ficheiroCache(DIRETORIO_CACHE, caminhos, 2, caminhos[2]) == 1);
+    compararSemCache(DIRETORIO_CACHE, limite, 1, "limite, C da cache");
+    s = sementes[0];
+    escreverMapa(FICHEIRO_MAPA, 15, 20, &s);
+    compararSemCache(DIRETORIO_CACHE, limite, 1, "limite, A da cache");
+    s = sementes[1];
+    escreverMapa(FICHEIRO_MAPA, 15, 20, &s);
+    compararSemCache(DIRETORIO_CACHE, LIMITE_CACHE, 0, "limite, B removido");
+
+    // Os outros ficheiros do diretório não contam, e sem limite não fica nenhum ficheiro da cache
+    FILE* file = fopen(DIRETORIO_CACHE "/outro.txt", "w");
+    fputs("nao e da cache", file);
+    fclose(file);
+    VERIFICAR(limitarCache(DIRETORIO_CACHE, LIMITE_CACHE) == 0);
+    VERIFICAR(limitarCache(DIRETORIO_CACHE, 0) == 3);
+    VERIFICAR(ficheiroCache(DIRETORIO_CACHE, NULL, 0, caminhos[0]) == 0);
+    VERIFICAR(tamanhoFicheiro(DIRETORIO_CACHE "/outro.txt") > 0);
+    removerDiretorio(DIRETORIO_CACHE);
+}
+
+#endif
+
+int main(void) {
+#ifndef _WIN32
+    testarReaproveitamento();
+    testarMapaAlterado();
+    testarFicheiroCorrompido();
+    testarLimite();
+    remove(FICHEIRO_MAPA);
+#endif
+    return terminarTeste("teste_cache");
+}
@@ -0,0 +1,192 @@
+/**
+ * @file teste_grafo.c
+ * @author Hugo Baptista
+ * @brief Testes do grafo, do seu índice de vértices e arestas e da construção de vários grafos em paralelo
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "compacto.h"
+#include "morton.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Enche a pilha com lixo, para que um campo por inicializar numa chamada seguinte não fique a 0.
+ *
+ * @param valor Byte com que a pilha é enchida.
+ * @return int Retorna um valor derivado do lixo, para o compilador não eliminar o vetor.
+ */
+static int sujarPilha(int valor) {
+    volatile unsigned char lixo[4096];
+    for (size_t i = 0; i < sizeof(lixo); i++) lixo[i] = (unsigned char)valor;
+    return lixo[valor % sizeof(lixo)];
+}
+
+/**
+ * @brief Cria o grafo depois de sujar a pilha, na mesma profundidade em que sujarPilha correu.
+ *
+ * @return Grafo Retorna o grafo criado.
+ */
+static Grafo criarGrafoSujo(void) {
+    sujarPilha(0xAB);
+    return criarGrafo();
+}
+
+/**
+ * @brief Conta as adjacências de um vértice.
+ *
+ * @param grafo O grafo.
+ * @param codigo O código do vértice.
+ * @return int Retorna o número de adjacências, ou -1 se o vértice não existir.
+ */
+static int contarAdjacentes(Grafo grafo, int codigo) {
+    for (Vertice* v = grafo.vertices; v; v = v->prox) {
+        if (v->codigo != codigo) continue;
+        int num = 0;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) num++;
+        return num;
+    }
+    return -1;
+}
+
+/**
+ * @brief criarGrafo inicializa o índice, e as inserções e remoções indexadas funcionam a partir daí.
+ */
+static void testarCriarGrafo(void) {
+    Grafo grafo = criarGrafoSujo();
+    VERIFICAR(grafo.indice == NULL);
+    VERIFICAR(grafo.vertices == NULL && grafo.numVertices == 0 && grafo.proximoCodigo == 1);
+
+    int a = 1, b = 2, c = 3;
+    VERIFICAR(adicionarVertice(&grafo, 1, 1, 'A') && adicionarVertice(&grafo, 2, 3, 'A') && adicionarVertice(&grafo, 4, 0, 'A'));
+    VERIFICAR(grafo.numVertices == 3 && grafo.proximoCodigo == 4);
+    VERIFICAR(adicionarAdjacente(&grafo, a, b) && adicionarAdjacente(&grafo, b, a));
+    VERIFICAR(adicionarAdjacente(&grafo, a, c) && adicionarAdjacente(&grafo, c, a));
+    VERIFICAR(contarAdjacentes(grafo, a) == 2);
+
+    VERIFICAR(removerAdjacente(&grafo, a, c));
+    VERIFICAR(!removerAdjacente(&grafo, a, c));
+    VERIFICAR(contarAdjacentes(grafo, a) == 1);
+    VERIFICAR(removerVertice(&grafo, b));
+    VERIFICAR(grafo.numVertices == 2 && contarAdjacentes(grafo, a) == 0 && contarAdjacentes(grafo, b) == -1);
+
+    // O vértice novo reaproveita a memória do removido e recebe um código novo
+    VERIFICAR(adicionarVertice(&grafo, 5, 5, 'A'));
+    VERIFICAR(grafo.numVertices == 3 && contarAdjacentes(grafo, 4) == 0);
+    VERIFICAR(adicionarAdjacente(&grafo, 4, a) && contarAdjacentes(grafo, 4) == 1);
+    libertarGrafo(&grafo);
+    VERIFICAR(grafo.indice == NULL);
+
+    // Libertar um grafo criado sobre a pilha suja não pode libertar um índice inexistente
+    Grafo vazio = criarGrafoSujo();
+    libertarGrafo(&vazio);
+}
+
+/**
+ * @brief compactarGrafoMorton só reordena o grafo compacto: a lista de vértices e o índice não mudam.
+ */
+static void testarCompactarMorton(void) {
+    Grafo grafo = criarGrafo();
+    const int xs[] = {9, 0, 5, 2, 7, 1, 8, 3}, ys[] = {9, 0, 5, 7, 2, 8, 1, 3};
+    int num = 8;
+    for (int i = 0; i < num; i++) adicionarVertice(&grafo, xs[i], ys[i], i % 2 ? 'A' : 'B');
+    for (int a = 1; a <= num; a++) {
+        for (int b = 1; b <= num; b++) {
+            if (a != b && a % 2 == b % 2) adicionarAdjacente(&grafo, a, b);
+        }
+    }
+    int ordem[8], i = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) ordem[i++] = v->codigo;
+
+    GrafoCompacto* porLista = compactarGrafo(grafo);
+    GrafoCompacto* porMorton = compactarGrafoMorton(grafo);
+    VERIFICAR(porLista && porMorton);
+    i = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox) VERIFICAR(v->codigo == ordem[i++]);
+    VERIFICAR(i == num && grafo.indice != NULL);
+    VERIFICAR(porMorton->numVertices == num && porMorton->numArestas == porLista->numArestas);
+    VERIFICAR(porMorton->codigos[0] == 2); // (0, 0) é a primeira posição na ordem de Morton
+
+    // As adjacências de cada código são as mesmas e pela mesma ordem
+    for (int c = 1; c <= num; c++) {
+        int l = indiceCompacto(porLista, c), m = indiceCompacto(porMorton, c);
+        VERIFICAR(porLista->inicio[l + 1] - porLista->inicio[l] == porMorton->inicio[m + 1] - porMorton->inicio[m]);
+        for (int p = porLista->inicio[l], q = porMorton->inicio[m]; p < porLista->inicio[l + 1]; p++, q++) {
+            VERIFICAR(porLista->codigos[porLista->destinos[p]] == porMorton->codigos[porMorton->destinos[q]]);
+        }
+    }
+    libertarGrafoCompacto(porLista);
+    libertarGrafoCompacto(porMorton);
+
+    // O índice continua válido: a inserção seguinte liga-se pelo fim da lista
+    VERIFICAR(adicionarVertice(&grafo, 4, 4, 'A') && adicionarAdjacente(&grafo, num + 1, 1));
+    Vertice* ultimo = grafo.vertices;
+    while (ultimo->prox) ultimo = ultimo->prox;
+    VERIFICAR(ultimo->codigo == num + 1 && contarAdjacentes(grafo, num + 1) == 1);
+    libertarGrafo(&grafo);
+}
+
+/**
+ * @brief Número de grafos construídos ao mesmo tempo no teste de reentrância.
+ */
+#define NUM_GRAFOS 16
+
+/**
+ * @brief Constrói um grafo com inserções e remoções pseudo-aleatórias, só com o estado do próprio grafo.
+ *
+ * @param semente Semente do grafo (diferente de 0); grafos com a mesma semente ficam iguais.
+ * @return Grafo Retorna o grafo construído.
+ */
+static Grafo construirGrafo(unsigned int semente) {
+    Grafo grafo = criarGrafo();
+    for (int i = 0; i < 300; i++) {
+        aleatorio(&semente);
+        int codigo = 1 + (int)(semente % (unsigned)grafo.proximoCodigo);
+        if (semente % 7 == 0) removerVertice(&grafo, codigo);
+        else if (semente % 3 == 0 && grafo.proximoCodigo > 2) {
+            int outro = 1 + (int)((semente >> 8) % (unsigned)(grafo.proximoCodigo - 1));
+            if (outro != codigo && adicionarAdjacente(&grafo, codigo, outro)) adicionarAdjacente(&grafo, outro, codigo);
+        } else adicionarVertice(&grafo, (int)(semente % 50), (int)((semente >> 6) % 50), "AB0"[semente % 3]);
+    }
+    return grafo;
+}
+
+/**
+ * @brief Os códigos dos vértices são de cada grafo, e grafos construídos em threads diferentes ficam iguais aos sequenciais.
+ */
+static void testarGrafosConcorrentes(void) {
+    // Dois grafos no mesmo processo começam os dois no código 1
+    Grafo a = criarGrafo(), b = criarGrafo();
+    VERIFICAR(adicionarVertice(&a, 0, 0, 'A') && adicionarVertice(&a, 1, 0, 'A') && adicionarVertice(&b, 5, 5, 'B'));
+    VERIFICAR(a.proximoCodigo == 3 && b.proximoCodigo == 2 && b.vertices->codigo == 1);
+    libertarGrafo(&a);
+    libertarGrafo(&b);
+
+    Grafo sequenciais[NUM_GRAFOS], paralelos[NUM_GRAFOS];
+    for (int i = 0; i < NUM_GRAFOS; i++) sequenciais[i] = construirGrafo(1000u + (unsigned)i);
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < NUM_GRAFOS; i++) paralelos[i] = construirGrafo(1000u + (unsigned)i);
+    for (int i = 0; i < NUM_GRAFOS; i++) {
+        VERIFICAR(grafosIguais(sequenciais[i], paralelos[i]));
+        libertarGrafo(&sequenciais[i]);
+        libertarGrafo(&paralelos[i]);
+    }
+}
+
+int main(void) {
+    testarCriarGrafo();
+    testarCompactarMorton();
+    testarGrafosConcorrentes();
+    return terminarTeste("teste_grafo");
+}
@@ -0,0 +1,81 @@
+/**
+ * @file teste_leitor.c
+ * @author Hugo Baptista
+ * @brief Testes da leitura paralela do grafo, comparada com lerGrafo
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "leitor.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Ficheiro temporário com o mapa.
+ */
+#define FICHEIRO_MAPA "teste_leitor_mapa.tmp"
+
+/**
+ * @brief Escreve um mapa aleatório com linhas de comprimento variável, algumas com mais de 99 caracteres.
+ *
+ * @param nomeFicheiro O nome do ficheiro a escrever.
+ * @param tamanho Número aproximado de bytes do mapa.
+ * @param densidade Uma célula em cada densidade tem uma antena.
+ * @param fimLinha 1 para acabar o ficheiro com '\n'.
+ * @param semente Estado do gerador.
+ */
+static void escreverMapa(const char* nomeFicheiro, size_t tamanho, unsigned int densidade, int fimLinha, unsigned int* semente) {
+    static const char frequencias[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    FILE* file = fopen(nomeFicheiro, "w");
+    size_t escritos = 0;
+    while (escritos < tamanho) {
+        int comprimento = (int)(aleatorio(semente) % 260);
+        for (int x = 0; x < comprimento; x++) {
+            unsigned int r = aleatorio(semente) % densidade;
+            fputc(r == 0 ? frequencias[aleatorio(semente) % (sizeof(frequencias) - 1)] : r == 1 ? '#' : '.', file);
+        }
+        escritos += (size_t)comprimento + 1;
+        if (escritos < tamanho || fimLinha) fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief lerGrafoParalelo devolve o mesmo grafo que lerGrafo, em ficheiros de um e de vários blocos, com 1 a 4 threads.
+ */
+static void testarIgualSequencial(void) {
+    unsigned int semente = 4034;
+    size_t tamanhos[] = { 0, 1, 150, 5000, 3 * (size_t)TAMANHO_BLOCO + 12345 };
+    for (size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        for (int fimLinha = 0; fimLinha <= 1; fimLinha++) {
+            // Os mapas grandes têm poucas antenas, porque lerGrafo liga os pares em tempo quadrático
+            escreverMapa(FICHEIRO_MAPA, tamanhos[t], tamanhos[t] > 100000 ? 2000 : 8, fimLinha, &semente);
+            Grafo sequencial = lerGrafo(FICHEIRO_MAPA);
+            for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+                omp_set_num_threads(threads);
+#endif
+                Grafo paralelo = lerGrafoParalelo(FICHEIRO_MAPA);
+                if (!grafosIguais(sequencial, paralelo)) {
+                    printf("FALHOU %zu bytes, fim de linha %d, %d threads: grafos diferentes\n", tamanhos[t], fimLinha, threads);
+                    falhas++;
+                }
+                libertarGrafo(&paralelo);
+            }
+            libertarGrafo(&sequencial);
+        }
+    }
+    remove(FICHEIRO_MAPA);
+}
+
+int main(void) {
+    testarIgualSequencial();
+    return terminarTeste("teste_leitor");
+}
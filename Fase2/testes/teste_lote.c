@@ -0,0 +1,177 @@
+/**
+ * @file teste_lote.c
+ * @author Hugo Baptista
+ * @brief Testes do lote de operações do grafo, comparado com as inserções e remoções feitas uma a uma
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "teste.h"
+
+/**
+ * @brief Número máximo de operações de um lote.
+ */
+#define MAX_OPERACOES 40
+
+/**
+ * @brief Aplica uma operação com as funções individuais do grafo.
+ *
+ * @param grafo O grafo a alterar.
+ * @param op A operação.
+ * @return int Retorna o estado da operação, como em aplicarLoteGrafo.
+ */
+static int aplicarOperacao(Grafo* grafo, const OperacaoGrafo* op) {
+    if (op->tipo == INSERIR_VERTICE) {
+        int codigo = grafo->proximoCodigo;
+        return adicionarVertice(grafo, op->x, op->y, op->frequencia) ? codigo : 0;
+    }
+    if (op->tipo == REMOVER_VERTICE) return removerVertice(grafo, op->origem);
+    if (op->tipo == INSERIR_ARESTA) return adicionarAdjacente(grafo, op->origem, op->destino);
+    return removerAdjacente(grafo, op->origem, op->destino);
+}
+
+/**
+ * @brief Gera uma operação pseudo-aleatória, com códigos de vértices existentes, removidos, futuros e inválidos.
+ *
+ * @param grafo O grafo (só para o próximo código).
+ * @param semente Estado do gerador.
+ * @return OperacaoGrafo Retorna a operação.
+ */
+static OperacaoGrafo gerarOperacao(Grafo grafo, unsigned int* semente) {
+    OperacaoGrafo op;
+    unsigned int r = aleatorio(semente) % 10;
+    op.tipo = r < 2 ? INSERIR_VERTICE : r < 3 ? REMOVER_VERTICE : r < 7 ? INSERIR_ARESTA : REMOVER_ARESTA;
+    // Códigos de -1 até alguns depois do próximo, para incluir vértices que só vão ser criados mais à frente
+    unsigned int limite = (unsigned)grafo.proximoCodigo + 4;
+    op.origem = (int)(aleatorio(semente) % limite) - 1;
+    op.destino = (int)(aleatorio(semente) % limite) - 1;
+    op.x = (int)(aleatorio(semente) % 20);
+    op.y = (int)(aleatorio(semente) % 20);
+    op.frequencia = "AB0"[aleatorio(semente) % 3];
+    return op;
+}
+
+/**
+ * @brief Aplica um lote pseudo-aleatório a dois grafos iguais, num com aplicarLoteGrafo e no outro uma a uma.
+ *
+ * @param lote O grafo onde aplicar o lote.
+ * @param sequencial O grafo onde aplicar as operações uma a uma.
+ * @param semente Estado do gerador.
+ * @return int Retorna 1 se os resultados, os estados e os grafos ficaram iguais, 0 caso contrário.
+ */
+static int compararLote(Grafo* lote, Grafo* sequencial, unsigned int* semente) {
+    OperacaoGrafo operacoes[MAX_OPERACOES];
+    int estadosLote[MAX_OPERACOES], estadosSequencial[MAX_OPERACOES];
+    int num = 1 + (int)(aleatorio(semente) % MAX_OPERACOES);
+    for (int i = 0; i < num; i++) operacoes[i] = gerarOperacao(*sequencial, semente);
+
+    int aplicadas = aplicarLoteGrafo(lote, operacoes, num, estadosLote);
+    int aplicadasSequencial = 0;
+    for (int i = 0; i < num; i++) {
+        estadosSequencial[i] = aplicarOperacao(sequencial, &operacoes[i]);
+        aplicadasSequencial += estadosSequencial[i] != 0;
+    }
+    if (aplicadas != aplicadasSequencial || !grafosIguais(*lote, *sequencial)) return 0;
+    for (int i = 0; i < num; i++) {
+        if (estadosLote[i] != estadosSequencial[i]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief aplicarLoteGrafo dá os mesmos grafos, estados e contagens que as operações uma a uma, em 2000 ensaios.
+ *
+ * Cada ensaio aplica dois lotes seguidos, para o segundo partir de um grafo cujo índice foi descartado pelo primeiro.
+ */
+static void testarIgualSequencial(void) {
+    unsigned int semente = 3303;
+    for (int ensaio = 0; ensaio < 2000; ensaio++) {
+        Grafo lote = criarGrafo(), sequencial = criarGrafo();
+        // Grafos pequenos, incluindo o vazio e o de um só vértice, em que as arestas não podem ser inseridas
+        int numVertices = (int)(aleatorio(&semente) % 9);
+        for (int i = 0; i < numVertices; i++) {
+            int x = (int)(aleatorio(&semente) % 20), y = (int)(aleatorio(&semente) % 20);
+            adicionarVertice(&lote, x, y, 'A');
+            adicionarVertice(&sequencial, x, y, 'A');
+        }
+        int numArestas = numVertices > 1 ? (int)(aleatorio(&semente) % (unsigned)(2 * numVertices)) : 0;
+        for (int i = 0; i < numArestas; i++) {
+            int origem = 1 + (int)(aleatorio(&semente) % (unsigned)numVertices);
+            int destino = 1 + (int)(aleatorio(&semente) % (unsigned)numVertices);
+            adicionarAdjacente(&lote, origem, destino);
+            adicionarAdjacente(&sequencial, origem, destino);
+        }
+        for (int passo = 0; passo < 2; passo++) {
+            if (!compararLote(&lote, &sequencial, &semente)) {
+                printf("FALHOU ensaio %d, lote %d\n", ensaio, passo + 1);
+                falhas++;
+                break;
+            }
+        }
+        libertarGrafo(&lote);
+        libertarGrafo(&sequencial);
+    }
+}
+
+/**
+ * @brief Num grafo com códigos repetidos, que não admite índice, o lote também dá o resultado das operações uma a uma.
+ */
+static void testarSemIndice(void) {
+    unsigned int semente = 77;
+    for (int ensaio = 0; ensaio < 50; ensaio++) {
+        Grafo lote = criarGrafo(), sequencial = criarGrafo();
+        for (int i = 0; i < 4; i++) {
+            adicionarVertice(&lote, i, 0, 'A');
+            adicionarVertice(&sequencial, i, 0, 'A');
+        }
+        invalidarIndiceGrafo(&lote);
+        invalidarIndiceGrafo(&sequencial);
+        lote.vertices->prox->codigo = 1;
+        sequencial.vertices->prox->codigo = 1;
+        if (!compararLote(&lote, &sequencial, &semente)) {
+            printf("FALHOU ensaio %d sem indice\n", ensaio);
+            falhas++;
+        }
+        libertarGrafo(&lote);
+        libertarGrafo(&sequencial);
+    }
+}
+
+/**
+ * @brief Casos em que as regras das operações individuais são menos óbvias.
+ */
+static void testarCasosLimite(void) {
+    Grafo grafo = criarGrafo();
+    VERIFICAR(adicionarVertice(&grafo, 0, 0, 'A') && adicionarVertice(&grafo, 1, 1, 'A') && adicionarVertice(&grafo, 2, 2, 'A'));
+    OperacaoGrafo operacoes[] = {
+        { INSERIR_ARESTA, 1, 2, 0, 0, 0 },
+        { REMOVER_VERTICE, 2, 0, 0, 0, 0 },
+        { INSERIR_ARESTA, 1, 5, 0, 0, 0 },  // O destino ainda não existe, mas a aresta é aceite
+        { REMOVER_VERTICE, 3, 0, 0, 0, 0 },
+        { INSERIR_ARESTA, 1, 1, 0, 0, 0 },  // Só há um vértice
+        { INSERIR_VERTICE, 0, 0, 3, 3, 'B' },
+        { INSERIR_VERTICE, 0, 0, 4, 4, 'B' },
+        { INSERIR_ARESTA, 1, 2, 0, 0, 0 },  // O destino foi removido, mas a aresta é aceite
+        { REMOVER_VERTICE, 5, 0, 0, 0, 0 },  // Remove também a aresta 1 -> 5, inserida antes de o vértice 5 existir
+    };
+    int num = (int)(sizeof(operacoes) / sizeof(operacoes[0]));
+    int estados[9];
+    int esperados[9] = { 1, 1, 1, 1, 0, 4, 5, 1, 1 };
+    VERIFICAR(aplicarLoteGrafo(&grafo, operacoes, num, estados) == 8);
+    for (int i = 0; i < num; i++) VERIFICAR(estados[i] == esperados[i]);
+    VERIFICAR(grafo.numVertices == 2 && grafo.vertices->codigo == 1 && grafo.vertices->prox->codigo == 4);
+    Adjacente* adj = grafo.vertices->adjacentes;
+    VERIFICAR(adj && adj->codigo == 2 && !adj->prox);
+    libertarGrafo(&grafo);
+}
+
+int main(void) {
+    testarIgualSequencial();
+    testarSemIndice();
+    testarCasosLimite();
+    return terminarTeste("teste_lote");
+}
@@ -0,0 +1,257 @@
+/**
+ * @file teste_proximidade.c
+ * @author Hugo Baptista
+ * @brief Testes das construções do grafo por proximidade, comparadas com construções por força bruta
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "teste.h"
+
+/**
+ * @brief Ficheiro temporário com o mapa.
+ */
+#define FICHEIRO_MAPA "teste_proximidade_mapa.tmp"
+/**
+ * @brief Número máximo de antenas de um mapa de teste.
+ */
+#define MAX_ANTENAS 400
+
+/**
+ * @brief Antenas de um mapa de teste, pela ordem de leitura (o vértice i tem o código i + 1).
+ */
+typedef struct MapaTeste {
+    int num;
+    Antena antenas[MAX_ANTENAS];
+} MapaTeste;
+
+/**
+ * @brief Escreve um mapa aleatório e guarda as suas antenas pela ordem de leitura.
+ *
+ * @param mapa As antenas do mapa (saída).
+ * @param linhas Número de linhas.
+ * @param colunas Número de colunas.
+ * @param percentagem Percentagem de células com antena.
+ * @param frequencias Frequências possíveis.
+ * @param semente Estado do gerador.
+ */
+static void escreverMapa(MapaTeste* mapa, int linhas, int colunas, int percentagem, const char* frequencias, unsigned int* semente) {
+    FILE* file = fopen(FICHEIRO_MAPA, "w");
+    int numFrequencias = (int)strlen(frequencias);
+    mapa->num = 0;
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            char c = '.';
+            if (mapa->num < MAX_ANTENAS && (int)(aleatorio(semente) % 100) < percentagem) {
+                c = frequencias[aleatorio(semente) % (unsigned)numFrequencias];
+                Antena a = { c, x, y };
+                mapa->antenas[mapa->num++] = a;
+            }
+            fputc(c, file);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Compara as adjacências de um grafo com uma matriz de adjacências esperada.
+ *
+ * @param grafo O grafo lido do mapa.
+ * @param mapa As antenas do mapa.
+ * @param esperado Matriz num x num; esperado[i * num + j] indica a aresta do vértice i para o vértice j.
+ * @return int Retorna 1 se os vértices e as adjacências (por ordem crescente de código) são os esperados, 0 caso contrário.
+ */
+static int mesmasArestas(Grafo grafo, const MapaTeste* mapa, const unsigned char* esperado) {
+    if (grafo.numVertices != mapa->num) return 0;
+    int i = 0;
+    for (Vertice* v = grafo.vertices; v; v = v->prox, i++) {
+        Antena a = mapa->antenas[i];
+        if (v->codigo != i + 1 || v->antena.x != a.x || v->antena.y != a.y || v->antena.frequencia != a.frequencia) return 0;
+        Adjacente* adj = v->adjacentes;
+        for (int j = 0; j < mapa->num; j++) {
+            if (!esperado[i * mapa->num + j]) continue;
+            if (!adj || adj->codigo != j + 1) return 0;
+            adj = adj->prox;
+        }
+        if (adj) return 0;
+    }
+    return i == mapa->num;
+}
+
+/**
+ * @brief Indica se todas as arestas de um grafo têm a aresta inversa.
+ *
+ * @param grafo O grafo.
+ * @return int Retorna 1 se o grafo é simétrico, 0 caso contrário.
+ */
+static int simetrico(Grafo grafo) {
+    for (Vertice* v = grafo.vertices; v; v = v->prox) {
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) {
+            Vertice* w = grafo.vertices;
+            while (w && w->codigo != adj->codigo) w = w->prox;
+            if (!w) return 0;
+            Adjacente* volta = w->adjacentes;
+            while (volta && volta->codigo != v->codigo) volta = volta->prox;
+            if (!volta) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Calcula o quadrado da distância entre duas antenas.
+ *
+ * @param a Primeira antena.
+ * @param b Segunda antena.
+ * @return long long Retorna o quadrado da distância euclidiana.
+ */
+static long long distancia2(Antena a, Antena b) {
+    long long dx = a.x - b.x, dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief lerGrafoRaio liga exatamente os pares da mesma frequência a uma distância não superior a raio.
+ */
+static void testarRaio(void) {
+    static MapaTeste mapa;
+    static unsigned char esperado[MAX_ANTENAS * MAX_ANTENAS];
+    unsigned int semente = 4028;
+    for (int caso = 0; caso < 40; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 40), colunas = 1 + (int)(aleatorio(&semente) % 60);
+        escreverMapa(&mapa, linhas, colunas, 3 + caso % 15, "aAb", &semente);
+        int raio = 1 + (int)(aleatorio(&semente) % 12);
+        memset(esperado, 0, sizeof(esperado));
+        for (int i = 0; i < mapa.num; i++) {
+            for (int j = 0; j < mapa.num; j++) {
+                esperado[i * mapa.num + j] = i != j && mapa.antenas[i].frequencia == mapa.antenas[j].frequencia &&
+                                              distancia2(mapa.antenas[i], mapa.antenas[j]) <= (long long)raio * raio;
+            }
+        }
+        Grafo grafo = lerGrafoRaio(FICHEIRO_MAPA, raio);
+        if (!mesmasArestas(grafo, &mapa, esperado) || !simetrico(grafo)) {
+            printf("FALHOU raio: caso %d (%dx%d, raio %d)\n", caso, colunas, linhas, raio);
+            falhas++;
+        }
+        libertarGrafo(&grafo);
+    }
+}
+
+/**
+ * @brief lerGrafoVizinhos liga cada antena aos k vizinhos da mesma frequência por (distância, ordem de leitura), nos dois sentidos.
+ */
+static void testarVizinhos(void) {
+    static MapaTeste mapa;
+    static unsigned char escolhido[MAX_ANTENAS * MAX_ANTENAS], esperado[MAX_ANTENAS * MAX_ANTENAS];
+    unsigned int semente = 4029;
+    for (int caso = 0; caso < 40; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 40), colunas = 1 + (int)(aleatorio(&semente) % 60);
+        escreverMapa(&mapa, linhas, colunas, 3 + caso % 15, "aAb", &semente);
+        int k = 1 + (int)(aleatorio(&semente) % 6), n = mapa.num;
+        // Força bruta: cada antena escolhe k vezes o melhor ainda livre por (distância, índice)
+        memset(escolhido, 0, sizeof(escolhido));
+        for (int i = 0; i < n; i++) {
+            for (int v = 0; v < k; v++) {
+                int melhor = -1;
+                for (int j = 0; j < n; j++) {
+                    if (j == i || mapa.antenas[j].frequencia != mapa.antenas[i].frequencia || escolhido[i * n + j]) continue;
+                    if (melhor < 0 || distancia2(mapa.antenas[i], mapa.antenas[j]) < distancia2(mapa.antenas[i], mapa.antenas[melhor])) melhor = j;
+                }
+                if (melhor < 0) break;
+                escolhido[i * n + melhor] = 1;
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) esperado[i * n + j] = escolhido[i * n + j] || escolhido[j * n + i];
+        }
+        Grafo grafo = lerGrafoVizinhos(FICHEIRO_MAPA, k);
+        if (!mesmasArestas(grafo, &mapa, esperado) || !simetrico(grafo)) {
+            printf("FALHOU vizinhos: caso %d (%dx%d, k %d)\n", caso, colunas, linhas, k);
+            falhas++;
+        }
+        libertarGrafo(&grafo);
+    }
+
+    // Empates: códigos 1 (1,0), 2 (0,1), 3 (1,1), 4 (2,1) e 5 (1,2). Com k = 2, o centro (3) escolhe 1 e 2
+    // entre quatro vizinhos à distância 1, e os outros escolhem 3 e, entre dois à distância raiz de 2, o lido
+    // primeiro: 1 -> 2, 2 -> 1, 4 -> 1, 5 -> 2
+    FILE* file = fopen(FICHEIRO_MAPA, "w");
+    fputs(".a.\naaa\n.a.\n", file);
+    fclose(file);
+    static const int adjacencias[5][5] = { { 2, 3, 4 }, { 1, 3, 5 }, { 1, 2, 4, 5 }, { 1, 3 }, { 2, 3 } };
+    Grafo grafo = lerGrafoVizinhos(FICHEIRO_MAPA, 2);
+    VERIFICAR(grafo.numVertices == 5);
+    int i = 0;
+    for (Vertice* v = grafo.vertices; v && i < 5; v = v->prox, i++) {
+        int a = 0;
+        for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox, a++) VERIFICAR(a < 5 && adj->codigo == adjacencias[i][a]);
+        VERIFICAR(a == 5 || adjacencias[i][a] == 0);
+    }
+    libertarGrafo(&grafo);
+}
+
+/**
+ * @brief lerGrafoInterferencia liga o clique de cada frequência e cada antena A às antenas de outras frequências perto de 2A - B.
+ */
+static void testarInterferencia(void) {
+    static MapaTeste mapa;
+    static unsigned char esperado[MAX_ANTENAS * MAX_ANTENAS];
+    unsigned int semente = 4046;
+    for (int caso = 0; caso < 40; caso++) {
+        int linhas = 1 + (int)(aleatorio(&semente) % 30), colunas = 1 + (int)(aleatorio(&semente) % 40);
+        escreverMapa(&mapa, linhas, colunas, 3 + caso % 12, "aAb0", &semente);
+        int raio = (int)(aleatorio(&semente) % 5), n = mapa.num;
+        memset(esperado, 0, sizeof(esperado));
+        for (int i = 0; i < n; i++) {
+            Antena a = mapa.antenas[i];
+            for (int j = 0; j < n; j++) {
+                if (j == i || mapa.antenas[j].frequencia != a.frequencia) continue;
+                esperado[i * n + j] = 1;
+                Antena efeito = { a.frequencia, 2 * a.x - mapa.antenas[j].x, 2 * a.y - mapa.antenas[j].y };
+                for (int c = 0; c < n; c++) {
+                    if (mapa.antenas[c].frequencia == a.frequencia) continue;
+                    if (distancia2(efeito, mapa.antenas[c]) <= (long long)raio * raio) esperado[i * n + c] = 1;
+                }
+            }
+        }
+        Grafo grafo = lerGrafoInterferencia(FICHEIRO_MAPA, raio);
+        if (!mesmasArestas(grafo, &mapa, esperado)) {
+            printf("FALHOU interferencia: caso %d (%dx%d, raio %d)\n", caso, colunas, linhas, raio);
+            falhas++;
+        }
+        libertarGrafo(&grafo);
+    }
+}
+
+/**
+ * @brief Um ficheiro que não existe ou um parâmetro inválido dão um grafo vazio.
+ */
+static void testarErros(void) {
+    Grafo grafo = lerGrafoRaio("teste_proximidade_inexistente.tmp", 3);
+    VERIFICAR(grafo.vertices == NULL && grafo.numVertices == 0);
+    grafo = lerGrafoVizinhos("teste_proximidade_inexistente.tmp", 3);
+    VERIFICAR(grafo.vertices == NULL && grafo.numVertices == 0);
+    grafo = lerGrafoRaio(FICHEIRO_MAPA, 0);
+    VERIFICAR(grafo.vertices == NULL);
+    grafo = lerGrafoVizinhos(FICHEIRO_MAPA, 0);
+    VERIFICAR(grafo.vertices == NULL);
+    grafo = lerGrafoInterferencia("teste_proximidade_inexistente.tmp", 1);
+    VERIFICAR(grafo.vertices == NULL && grafo.numVertices == 0);
+    grafo = lerGrafoInterferencia(FICHEIRO_MAPA, -1);
+    VERIFICAR(grafo.vertices == NULL);
+}
+
+int main(void) {
+    testarRaio();
+    testarVizinhos();
+    testarInterferencia();
+    testarErros();
+    remove(FICHEIRO_MAPA);
+    return terminarTeste("teste_proximidade");
+}
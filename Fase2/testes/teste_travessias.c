@@ -0,0 +1,265 @@
+/**
+ * @file teste_travessias.c
+ * @author Hugo Baptista
+ * @brief Testes das buscas em largura por níveis, da busca bidirecional e da contagem paralela de caminhos sobre o
+ * grafo compacto, comparadas com as versões sequenciais
+ * @version 1.0
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "estruturasDados.h"
+#include "grafo.h"
+#include "compacto.h"
+#include "travessias.h"
+#include "caminhos.h"
+#include "teste.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Constrói um grafo dirigido pseudo-aleatório, com uma densidade que muda de grafo para grafo.
+ *
+ * @param numVertices O número de vértices.
+ * @param grau O número médio de arestas que saem de cada vértice.
+ * @param semente Estado do gerador.
+ * @return Grafo Retorna o grafo construído.
+ */
+static Grafo construirGrafo(int numVertices, int grau, unsigned int* semente) {
+    Grafo grafo = criarGrafo();
+    for (int i = 0; i < numVertices; i++) adicionarVertice(&grafo, i % 50, i / 50, 'A');
+    for (long long a = 0; a < (long long)numVertices * grau; a++) {
+        int origem = 1 + (int)(aleatorio(semente) % (unsigned)numVertices);
+        int destino = 1 + (int)(aleatorio(semente) % (unsigned)numVertices);
+        adicionarAdjacente(&grafo, origem, destino);
+    }
+    return grafo;
+}
+
+/**
+ * @brief Indica se existe a aresta entre dois vértices do grafo compacto.
+ *
+ * @param compacto O grafo compacto.
+ * @param origem O índice do vértice de origem.
+ * @param destino O índice do vértice de destino.
+ * @return int Retorna 1 se a aresta existe, 0 caso contrário.
+ */
+static int existeAresta(const GrafoCompacto* compacto, int origem, int destino) {
+    for (int a = compacto->inicio[origem]; a < compacto->inicio[origem + 1]; a++) {
+        if (compacto->destinos[a] == destino) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief profundidadesLarguraParalela dá as mesmas profundidades que profundidadesLargura em 300 grafos, com e sem
+ * transposto e com 1 a 4 threads.
+ *
+ * Os grafos densos passam pela busca ascendente; os esparsos e os desligados ficam na descendente.
+ */
+static void testarLarguraParalela(void) {
+    unsigned int semente = 4040;
+    for (int caso = 0; caso < 300; caso++) {
+        int numVertices = 1 + (int)(aleatorio(&semente) % 400);
+        int grau = (int)(aleatorio(&semente) % (caso % 3 == 0 ? 2 : 24));
+        Grafo grafo = construirGrafo(numVertices, grau, &semente);
+        GrafoCompacto* compacto = compactarGrafo(grafo);
+        GrafoCompacto* transposto = compacto ? transporGrafoCompacto(compacto) : NULL;
+        int* esperadas = (int*)malloc((size_t)numVertices * sizeof(int));
+        int* obtidas = (int*)malloc((size_t)numVertices * sizeof(int));
+        VERIFICAR(compacto && transposto && esperadas && obtidas);
+        if (!compacto || !transposto || !esperadas || !obtidas) {
+            libertarGrafoCompacto(compacto);
+            libertarGrafoCompacto(transposto);
+            free(esperadas);
+            free(obtidas);
+            libertarGrafo(&grafo);
+            continue;
+        }
+        int origem = (int)(aleatorio(&semente) % (unsigned)numVertices);
+        int alcancados = profundidadesLargura(compacto, origem, esperadas);
+        for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            for (int comTransposto = 0; comTransposto < 2; comTransposto++) {
+                memset(obtidas, 0x55, (size_t)numVertices * sizeof(int));
+                int num = profundidadesLarguraParalela(compacto, comTransposto ? transposto : NULL, origem, obtidas);
+                if (num != alcancados || memcmp(obtidas, esperadas, (size_t)numVertices * sizeof(int)) != 0) {
+                    printf("FALHOU caso %d (%d vertices, grau %d), %d threads%s\n", caso, numVertices, grau, threads,
+                           comTransposto ? ", com transposto" : "");
+                    falhas++;
+                }
+            }
+        }
+        libertarGrafoCompacto(compacto);
+        libertarGrafoCompacto(transposto);
+        free(esperadas);
+        free(obtidas);
+        libertarGrafo(&grafo);
+    }
+}
+
+/**
+ * @brief caminhoBidirecional devolve um caminho válido com a distância da busca sequencial, ou 0 quando o final
+ * não é alcançado, em 300 grafos dirigidos (com transposto) e simétricos (sem transposto).
+ */
+static void testarBidirecional(void) {
+    unsigned int semente = 4141;
+    int semCaminho = 0;
+    for (int caso = 0; caso < 300; caso++) {
+        int numVertices = 1 + (int)(aleatorio(&semente) % 300);
+        int grau = (int)(aleatorio(&semente) % 4);
+        int simetrico = caso % 2;
+        Grafo grafo = construirGrafo(numVertices, grau, &semente);
+        if (simetrico) {
+            for (Vertice* v = grafo.vertices; v; v = v->prox) {
+                for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) adicionarAdjacente(&grafo, adj->codigo, v->codigo);
+            }
+        }
+        GrafoCompacto* compacto = compactarGrafo(grafo);
+        GrafoCompacto* transposto = compacto && !simetrico ? transporGrafoCompacto(compacto) : NULL;
+        int* profundidades = (int*)malloc((size_t)numVertices * sizeof(int));
+        int* caminho = (int*)malloc((size_t)numVertices * sizeof(int));
+        VERIFICAR(compacto && (simetrico || transposto) && profundidades && caminho);
+        for (int par = 0; compacto && (simetrico || transposto) && profundidades && caminho && par < 5; par++) {
+            int origem = (int)(aleatorio(&semente) % (unsigned)numVertices);
+            int destino = (int)(aleatorio(&semente) % (unsigned)numVertices);
+            profundidadesLargura(compacto, origem, profundidades);
+            int num = caminhoBidirecional(compacto, transposto, compacto->codigos[origem], compacto->codigos[destino], caminho);
+            int ok = num == profundidades[destino] + 1;
+            if (ok && num > 0) {
+                ok = caminho[0] == compacto->codigos[origem] && caminho[num - 1] == compacto->codigos[destino];
+                for (int i = 0; ok && i + 1 < num; i++) {
+                    ok = existeAresta(compacto, indiceCompacto(compacto, caminho[i]), indiceCompacto(compacto, caminho[i + 1]));
+                }
+            }
+            semCaminho += num == 0;
+            if (!ok) {
+                printf("FALHOU caso %d, de %d a %d: %d vertices no caminho, distancia %d\n", caso, origem, destino, num,
+                       profundidades[destino]);
+                falhas++;
+            }
+        }
+        libertarGrafoCompacto(compacto);
+        libertarGrafoCompacto(transposto);
+        free(profundidades);
+        free(caminho);
+        libertarGrafo(&grafo);
+    }
+    // Os grafos esparsos têm de dar casos sem caminho, para o resultado 0 ficar testado
+    VERIFICAR(semCaminho > 0);
+}
+
+/**
+ * @brief Casos limite de caminhoBidirecional: o mesmo vértice, um vértice sem caminho e códigos que não existem.
+ */
+static void testarBidirecionalLimites(void) {
+    Grafo grafo = criarGrafo();
+    for (int i = 0; i < 4; i++) adicionarVertice(&grafo, i, 0, 'A');
+    // 1 -> 2 -> 3; o 4 só tem uma aresta a sair, pelo que não é alcançado
+    adicionarAdjacente(&grafo, 1, 2);
+    adicionarAdjacente(&grafo, 2, 3);
+    adicionarAdjacente(&grafo, 4, 1);
+    GrafoCompacto* compacto = compactarGrafo(grafo);
+    GrafoCompacto* transposto = compacto ? transporGrafoCompacto(compacto) : NULL;
+    VERIFICAR(compacto && transposto);
+    if (compacto && transposto) {
+        int caminho[4];
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 2, 2, caminho) == 1 && caminho[0] == 2);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 1, 3, caminho) == 3 && caminho[1] == 2);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 4, 3, caminho) == 4);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 1, 4, caminho) == 0);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 3, 1, caminho) == 0);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, 1, 9, caminho) == -1);
+        VERIFICAR(caminhoBidirecional(compacto, transposto, -1, 1, caminho) == -1);
+    }
+    libertarGrafoCompacto(compacto);
+    libertarGrafoCompacto(transposto);
+    libertarGrafo(&grafo);
+}
+
+/**
+ * @brief Conta as linhas de caminhos de um ficheiro escrito por listarTodosCaminhosParalelo.
+ *
+ * @param filename O nome do ficheiro.
+ * @return long long Retorna o número de linhas começadas por "Caminho:", ou -1 se o ficheiro não abrir.
+ */
+static long long contarLinhasCaminho(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return -1;
+    char linha[4096];
+    long long num = 0;
+    while (fgets(linha, sizeof(linha), file)) num += strncmp(linha, "Caminho:", 8) == 0;
+    fclose(file);
+    return num;
+}
+
+/**
+ * @brief contarCaminhosParalelo e listarTodosCaminhosParalelo dão o número de caminhos de contarCaminhos, em 200
+ * grafos pequenos (dirigidos e simétricos) e com 1 a 4 threads.
+ */
+static void testarContarCaminhos(void) {
+    unsigned int semente = 4242;
+    for (int caso = 0; caso < 200; caso++) {
+        // Grafos pequenos, porque o número de caminhos simples cresce de forma exponencial
+        int numVertices = 1 + (int)(aleatorio(&semente) % 11);
+        int grau = 1 + (int)(aleatorio(&semente) % 3);
+        Grafo grafo = construirGrafo(numVertices, grau, &semente);
+        if (caso % 2) {
+            for (Vertice* v = grafo.vertices; v; v = v->prox) {
+                for (Adjacente* adj = v->adjacentes; adj; adj = adj->prox) adicionarAdjacente(&grafo, adj->codigo, v->codigo);
+            }
+        }
+        GrafoCompacto* compacto = compactarGrafo(grafo);
+        VERIFICAR(compacto != NULL);
+        for (int par = 0; compacto && par < 3; par++) {
+            int origem = (int)(aleatorio(&semente) % (unsigned)numVertices);
+            int destino = (int)(aleatorio(&semente) % (unsigned)numVertices);
+            long long esperado = contarCaminhos(compacto, origem, destino);
+            int inicial = compacto->codigos[origem], final = compacto->codigos[destino];
+            for (int threads = 1; threads <= 4; threads++) {
+#ifdef _OPENMP
+                omp_set_num_threads(threads);
+#endif
+                long long num = contarCaminhosParalelo(compacto, inicial, final);
+                long long escritos = listarTodosCaminhosParalelo(compacto, inicial, final, "caminhos.tmp");
+                long long linhas = contarLinhasCaminho("caminhos.tmp");
+                if (num != esperado || escritos != esperado || linhas != esperado) {
+                    printf("FALHOU caso %d, de %d a %d, %d threads: %lld, %lld escritos e %lld linhas, esperados %lld\n",
+                           caso, inicial, final, threads, num, escritos, linhas, esperado);
+                    falhas++;
+                }
+            }
+        }
+        libertarGrafoCompacto(compacto);
+        libertarGrafo(&grafo);
+    }
+    remove("caminhos.tmp");
+
+    // Códigos que não existem e antenas com frequências diferentes
+    Grafo grafo = criarGrafo();
+    adicionarVertice(&grafo, 0, 0, 'A');
+    adicionarVertice(&grafo, 1, 0, 'B');
+    adicionarAdjacente(&grafo, 1, 2);
+    GrafoCompacto* compacto = compactarGrafo(grafo);
+    VERIFICAR(compacto != NULL);
+    if (compacto) {
+        VERIFICAR(contarCaminhosParalelo(compacto, 1, 1) == 1);
+        VERIFICAR(contarCaminhosParalelo(compacto, 1, 2) == -1);
+        VERIFICAR(contarCaminhosParalelo(compacto, 1, 3) == -1);
+    }
+    libertarGrafoCompacto(compacto);
+    libertarGrafo(&grafo);
+}
+
+int main(void) {
+    testarLarguraParalela();
+    testarBidirecional();
+    testarBidirecionalLimites();
+    testarContarCaminhos();
+    return terminarTeste("teste_travessias");
+}